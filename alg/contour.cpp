@@ -18,18 +18,25 @@
 #include "utility.h"
 #include "contour_generator.h"
 #include "segment_merger.h"
+#include "strip_merger.h"
 #include <algorithm>
 
 #include "gdal.h"
 #include "gdal_alg.h"
+#include "gdal_thread_pool.h"
 #include "cpl_conv.h"
+#include "cpl_error_internal.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_srs_api.h"
 #include "ogr_geometry.h"
 
+#include <atomic>
 #include <climits>
+#include <condition_variable>
 #include <limits>
+#include <mutex>
 
 static CPLErr OGRPolygonContourWriter(double dfLevelMin, double dfLevelMax,
                                       const OGRMultiPolygon &multipoly,
@@ -387,6 +394,165 @@ CPLErr GDALContourGenerate(GDALRasterBandH hBand, double dfContourInterval,
     return err;
 }
 
+/************************************************************************/
+/*                     ContourGenerateMultiThreaded()                   */
+/************************************************************************/
+
+// Minimum height of the strips processed concurrently
+constexpr int CONTOUR_MIN_STRIP_HEIGHT = 128;
+// Maximum size of the buffer of a strip
+constexpr size_t CONTOUR_MAX_STRIP_BUFFER_SIZE = 64 * 1024 * 1024;
+
+// Generate the contours of a band by splitting it into horizontal strips that
+// are contoured concurrently by the threads of poPool, each one with its own
+// SegmentMerger. Each strip also reads the line above it, so that the squares
+// between two strips are processed. The lines of the strips are then stitched
+// in order by the calling thread, which is the only one writing to lineWriter.
+template <typename LineWriter, typename LevelGenerator>
+static bool ContourGenerateMultiThreaded(
+    GDALRasterBandH hBand, bool useNoData, double noDataValue,
+    LineWriter &lineWriter, LevelGenerator &levels, bool polygonize,
+    const std::vector<int> &skipLevels, CPLWorkerThreadPool *poPool,
+    int nThreads, GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    using namespace marching_squares;
+    typedef StripMerger<LineWriter> StripMergerT;
+    typedef typename StripMergerT::StripLines StripLines;
+
+    const int nXSize = GDALGetRasterBandXSize(hBand);
+    const int nYSize = GDALGetRasterBandYSize(hBand);
+
+    // Use a few strips per thread so that they are balanced
+    int nStripHeight = std::max(CONTOUR_MIN_STRIP_HEIGHT,
+                                (nYSize + 4 * nThreads - 1) / (4 * nThreads));
+    nStripHeight = static_cast<int>(std::max<size_t>(
+        1, std::min<size_t>(nStripHeight, CONTOUR_MAX_STRIP_BUFFER_SIZE /
+                                                  (sizeof(double) * nXSize) -
+                                              1)));
+    const int nStrips = (nYSize + nStripHeight - 1) / nStripHeight;
+
+    struct Strip
+    {
+        std::vector<typename StripMergerT::Line> lines{};
+        bool bDone = false;
+        bool bOK = true;
+    };
+
+    std::vector<Strip> aoStrips(nStrips);
+    std::mutex oMutex;
+    std::condition_variable oCV;
+    std::mutex oIOMutex;
+    std::atomic<bool> bStop{false};
+    CPLErrorAccumulator oErrorAccumulator;
+
+    auto poJobQueue = poPool->CreateJobQueue();
+    for (int iStrip = 0; iStrip < nStrips; ++iStrip)
+    {
+        poJobQueue->SubmitJob(
+            [&, iStrip]()
+            {
+                auto oAccumulator = oErrorAccumulator.InstallForCurrentScope();
+                CPL_IGNORE_RET_VAL(oAccumulator);
+
+                StripLines stripLines;
+                bool bOK = !bStop;
+                if (bOK)
+                {
+                    const int nFirstLine = iStrip * nStripHeight;
+                    const int nLines =
+                        std::min(nStripHeight, nYSize - nFirstLine);
+                    const int nFirstReadLine = std::max(0, nFirstLine - 1);
+                    const int nReadLines = nFirstLine + nLines - nFirstReadLine;
+                    std::vector<double> adfBuffer;
+                    try
+                    {
+                        adfBuffer.resize(static_cast<size_t>(nXSize) *
+                                         nReadLines);
+                    }
+                    catch (const std::exception &)
+                    {
+                        CPLError(CE_Failure, CPLE_OutOfMemory,
+                                 "Cannot allocate strip buffer");
+                        bOK = false;
+                    }
+
+                    if (bOK)
+                    {
+                        std::lock_guard<std::mutex> oLock(oIOMutex);
+                        bOK = GDALRasterIO(hBand, GF_Read, 0, nFirstReadLine,
+                                           nXSize, nReadLines, adfBuffer.data(),
+                                           nXSize, nReadLines, GDT_Float64, 0,
+                                           0) == CE_None;
+                    }
+
+                    if (bOK)
+                    {
+                        SegmentMerger<StripLines, LevelGenerator> merger(
+                            stripLines, levels, polygonize);
+                        if (polygonize)
+                            merger.setSkipLevels(skipLevels);
+                        ContourGenerator<decltype(merger), LevelGenerator> cg(
+                            nXSize, nYSize, useNoData, noDataValue, merger,
+                            levels);
+                        if (nFirstLine > 0)
+                            cg.startAtLine(nFirstLine, adfBuffer.data());
+                        const double *pdfLine =
+                            adfBuffer.data() +
+                            static_cast<size_t>(nFirstLine - nFirstReadLine) *
+                                nXSize;
+                        for (int i = 0; i < nLines && !bStop; ++i)
+                        {
+                            cg.feedLine(pdfLine);
+                            pdfLine += nXSize;
+                        }
+                    }
+                }
+
+                std::lock_guard<std::mutex> oLock(oMutex);
+                aoStrips[iStrip].lines = std::move(stripLines.lines);
+                aoStrips[iStrip].bOK = bOK;
+                aoStrips[iStrip].bDone = true;
+                oCV.notify_one();
+            });
+    }
+
+    bool ok = true;
+    {
+        StripMergerT stripMerger(lineWriter, polygonize);
+        for (int iStrip = 0; iStrip < nStrips && ok; ++iStrip)
+        {
+            std::vector<typename StripMergerT::Line> lines;
+            {
+                std::unique_lock<std::mutex> oLock(oMutex);
+                oCV.wait(oLock, [&aoStrips, iStrip]
+                         { return aoStrips[iStrip].bDone; });
+                ok = aoStrips[iStrip].bOK;
+                lines = std::move(aoStrips[iStrip].lines);
+            }
+            if (!ok)
+                break;
+
+            const double topSeamY =
+                iStrip > 0 ? iStrip * nStripHeight - .5 : NaN;
+            const double bottomSeamY =
+                iStrip + 1 < nStrips ? (iStrip + 1) * nStripHeight - .5 : NaN;
+            stripMerger.addStrip(lines, topSeamY, bottomSeamY);
+
+            if (!pfnProgress(double(iStrip + 1) / nStrips, "Processing line",
+                             pProgressArg))
+            {
+                ok = false;
+            }
+        }
+        bStop = !ok;
+    }
+
+    poJobQueue->WaitCompletion();
+    oErrorAccumulator.ReplayErrors();
+
+    return ok;
+}
+
 /**
  * Create vector contours from raster DEM.
  *
@@ -563,6 +729,15 @@ mode.
  * A negative value means a single transaction. The function takes care of
  * issuing the starting transaction and committing the final one.
  *
+ *   NUM_THREADS=num|ALL_CPUS
+ *
+ * (GDAL >= 3.12) Number of threads to use. Defaults to the value of the
+ * GDAL_NUM_THREADS configuration option, or 1. When greater than 1, the raster
+ * is split into horizontal strips that are contoured concurrently, and the
+ * contours crossing the strip boundaries are joined afterwards. The generated
+ * geometries are the same as with a single thread, but the order of features
+ * (and thus their ids) may differ.
+ *
  * @return CE_None on success or CE_Failure if an error occurs.
  */
 CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
@@ -680,6 +855,18 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
 
     bool polygonize = CPLFetchBool(options, "POLYGONIZE", false);
 
+    const char *pszNumThreads = CSLFetchNameValueDef(
+        options, "NUM_THREADS", CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
+    const int nThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                             ? CPLGetNumCPUs()
+                             : std::clamp(atoi(pszNumThreads), 1, 128);
+    // Not worth using several threads on small rasters
+    CPLWorkerThreadPool *poPool =
+        nThreads > 1 && GDALGetRasterBandYSize(hBand) >=
+                            2 * CONTOUR_MIN_STRIP_HEIGHT
+            ? GDALGetGlobalThreadPool(nThreads)
+            : nullptr;
+
     using namespace marching_squares;
 
     OGRContourWriterInfo oCWI;
@@ -847,17 +1034,27 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
                 FixedLevelRangeIterator levels(
                     &fixedLevels[0], fixedLevels.size(),
                     -std::numeric_limits<double>::infinity(), dfMaximum);
-                SegmentMerger<RingAppender, FixedLevelRangeIterator> writer(
-                    appender, levels, /* polygonize */ true);
                 std::vector<int> aoiSkipLevels;
                 // Skip first and last levels (min/max) in polygonal case
                 aoiSkipLevels.push_back(0);
                 aoiSkipLevels.push_back(static_cast<int>(levels.levelsCount()));
-                writer.setSkipLevels(aoiSkipLevels);
-                ContourGeneratorFromRaster<decltype(writer),
-                                           FixedLevelRangeIterator>
-                    cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                if (poPool)
+                {
+                    ok = ContourGenerateMultiThreaded(
+                        hBand, useNoData, noDataValue, appender, levels,
+                        /* polygonize */ true, aoiSkipLevels, poPool, nThreads,
+                        pfnProgress, pProgressArg);
+                }
+                else
+                {
+                    SegmentMerger<RingAppender, FixedLevelRangeIterator>
+                        writer(appender, levels, /* polygonize */ true);
+                    writer.setSkipLevels(aoiSkipLevels);
+                    ContourGeneratorFromRaster<decltype(writer),
+                                               FixedLevelRangeIterator>
+                        cg(hBand, useNoData, noDataValue, writer, levels);
+                    ok = cg.process(pfnProgress, pProgressArg);
+                }
             }
         }
         else
@@ -895,12 +1092,22 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
                 fixedLevels.erase(uniqueIt, fixedLevels.end());
                 FixedLevelRangeIterator levels(
                     &fixedLevels[0], fixedLevels.size(), dfMinimum, dfMaximum);
-                SegmentMerger<GDALRingAppender, FixedLevelRangeIterator> writer(
-                    appender, levels, /* polygonize */ false);
-                ContourGeneratorFromRaster<decltype(writer),
-                                           FixedLevelRangeIterator>
-                    cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                if (poPool)
+                {
+                    ok = ContourGenerateMultiThreaded(
+                        hBand, useNoData, noDataValue, appender, levels,
+                        /* polygonize */ false, std::vector<int>(), poPool,
+                        nThreads, pfnProgress, pProgressArg);
+                }
+                else
+                {
+                    SegmentMerger<GDALRingAppender, FixedLevelRangeIterator>
+                        writer(appender, levels, /* polygonize */ false);
+                    ContourGeneratorFromRaster<decltype(writer),
+                                               FixedLevelRangeIterator>
+                        cg(hBand, useNoData, noDataValue, writer, levels);
+                    ok = cg.process(pfnProgress, pProgressArg);
+                }
             }
         }
     }
@@ -177,6 +177,23 @@ int CPL_DLL GDALHomographyTransform(void *pTransformArg, int bDstToSrc,
                                     int nPointCount, double *x, double *y,
                                     double *z, int *panSuccess);
 
+/* Warp plan transformer ... destination to source pixel/line coordinates
+ * precomputed once and stored in a file */
+CPLErr CPL_DLL GDALCreateWarpPlan(const char *pszFilename, GDALDatasetH hSrcDS,
+                                  GDALDatasetH hDstDS,
+                                  GDALTransformerFunc pfnTransformer,
+                                  void *pTransformArg,
+                                  CSLConstList papszOptions,
+                                  GDALProgressFunc pfnProgress,
+                                  void *pProgressArg);
+void CPL_DLL *GDALCreateWarpPlanTransformer(const char *pszFilename,
+                                            GDALDatasetH hSrcDS,
+                                            GDALDatasetH hDstDS);
+void CPL_DLL GDALDestroyWarpPlanTransformer(void *pTransformArg);
+int CPL_DLL GDALWarpPlanTransform(void *pTransformArg, int bDstToSrc,
+                                  int nPointCount, double *x, double *y,
+                                  double *z, int *panSuccess);
+
 /* Thin Plate Spine transformer ... forward is to georef coordinates */
 
 void CPL_DLL *GDALCreateTPSTransformer(int nGCPCount,
@@ -18,13 +18,30 @@
 #include <cstdlib>
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <new>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
+#include "gdal_thread_pool.h"
+
+namespace
+{
+enum class ProximityOutput
+{
+    DISTANCE,
+    NEAREST_VALUE,
+    NEAREST_INDEX,
+};
+}  // namespace
 
 static CPLErr ProcessProximityLine(GInt32 *panSrcScanline, int *panNearX,
                                    int *panNearY, int bForward, int iLine,
@@ -33,6 +50,13 @@ static CPLErr ProcessProximityLine(GInt32 *panSrcScanline, int *panNearX,
                                    double *pdfSrcNoDataValue, int nTargetValues,
                                    int *panTargetValues);
 
+static CPLErr ComputeProximityEDT(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hProximityBand,
+    ProximityOutput eOutput, double dfDistMult, double dfMaxDist,
+    const double *pdfSrcNoDataValue, double dfNoDataValue, bool bFixedBufVal,
+    double dfFixedBufVal, int nTargetValues, const int *panTargetValues,
+    GDALProgressFunc pfnProgress, void *pProgressArg);
+
 /************************************************************************/
 /*                        GDALComputeProximity()                        */
 /************************************************************************/
@@ -89,6 +113,25 @@ the proximity output.
 
 If this option is set, all pixels within the MAXDIST threshold are
 set to this fixed value instead of to a proximity distance.
+
+  ALGORITHM=[SWEEP]/EDT
+
+Selects the algorithm used to compute distances. SWEEP (the default)
+performs a top-down and a bottom-up pass over the image, keeping a
+single scanline in memory. EDT computes an exact Euclidean distance
+transform, separable by lines and then by columns, which is
+multithreaded according to the GDAL_NUM_THREADS configuration option.
+EDT holds the whole image in memory (about 10 bytes per pixel).
+(GDAL >= 3.12)
+
+  OUTPUT=[DISTANCE]/NEAREST_VALUE/NEAREST_INDEX
+
+Selects what is written to hProximityBand. DISTANCE (the default) is the
+proximity distance. NEAREST_VALUE is the value of the nearest target
+pixel, and NEAREST_INDEX is the index of the nearest target pixel, as
+line * width + column. Pixels beyond MAXDIST, or that are input nodata
+when USE_INPUT_NODATA is set, are set to the nodata value. Values other
+than DISTANCE imply ALGORITHM=EDT. (GDAL >= 3.12)
 */
 
 CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
@@ -225,6 +268,55 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
         CSLDestroy(papszValuesTokens);
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      What are we computing, and how?                                 */
+    /* -------------------------------------------------------------------- */
+    ProximityOutput eOutput = ProximityOutput::DISTANCE;
+    pszOpt = CSLFetchNameValue(papszOptions, "OUTPUT");
+    if (pszOpt)
+    {
+        if (EQUAL(pszOpt, "NEAREST_VALUE"))
+            eOutput = ProximityOutput::NEAREST_VALUE;
+        else if (EQUAL(pszOpt, "NEAREST_INDEX"))
+            eOutput = ProximityOutput::NEAREST_INDEX;
+        else if (!EQUAL(pszOpt, "DISTANCE"))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Unrecognized OUTPUT value '%s', should be DISTANCE, "
+                     "NEAREST_VALUE or NEAREST_INDEX.",
+                     pszOpt);
+            CPLFree(panTargetValues);
+            return CE_Failure;
+        }
+    }
+
+    bool bUseEDT = eOutput != ProximityOutput::DISTANCE;
+    pszOpt = CSLFetchNameValue(papszOptions, "ALGORITHM");
+    if (pszOpt)
+    {
+        if (EQUAL(pszOpt, "EDT"))
+        {
+            bUseEDT = true;
+        }
+        else if (!EQUAL(pszOpt, "SWEEP"))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Unrecognized ALGORITHM value '%s', should be SWEEP or "
+                     "EDT.",
+                     pszOpt);
+            CPLFree(panTargetValues);
+            return CE_Failure;
+        }
+        else if (bUseEDT)
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "OUTPUT=%s requires ALGORITHM=EDT.",
+                     CSLFetchNameValue(papszOptions, "OUTPUT"));
+            CPLFree(panTargetValues);
+            return CE_Failure;
+        }
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Initialize progress counter.                                    */
     /* -------------------------------------------------------------------- */
@@ -235,6 +327,16 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
         return CE_Failure;
     }
 
+    if (bUseEDT)
+    {
+        const CPLErr eErr = ComputeProximityEDT(
+            hSrcBand, hProximityBand, eOutput, dfDistMult, dfMaxDist,
+            pdfSrcNoData, fNoDataValue, bFixedBufVal, dfFixedBufVal,
+            nTargetValues, panTargetValues, pfnProgress, pProgressArg);
+        CPLFree(panTargetValues);
+        return eErr;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      We need a signed type for the working proximity values kept     */
     /*      on disk.  If our proximity band is not signed, then create a    */
@@ -431,6 +533,23 @@ end:
     return eErr;
 }
 
+/************************************************************************/
+/*                           IsTargetValue()                            */
+/************************************************************************/
+
+static bool IsTargetValue(GInt32 nValue, int nTargetValues,
+                          const int *panTargetValues)
+{
+    if (nTargetValues == 0)
+        return nValue != 0;
+    for (int i = 0; i < nTargetValues; i++)
+    {
+        if (nValue == panTargetValues[i])
+            return true;
+    }
+    return false;
+}
+
 /************************************************************************/
 /*                         SquareDistance()                             */
 /************************************************************************/
@@ -575,3 +694,369 @@ static CPLErr ProcessProximityLine(GInt32 *panSrcScanline, int *panNearX,
 
     return CE_None;
 }
+
+/************************************************************************/
+/*                        ComputeProximityEDT()                         */
+/*                                                                      */
+/*      Exact Euclidean distance transform, computed separably (as in   */
+/*      Meijster et al. and Felzenszwalb & Huttenlocher). A first pass  */
+/*      finds, for each pixel, the nearest target pixel in its line.    */
+/*      A second pass computes, for each column, the lower envelope of  */
+/*      the parabolas rooted at the line-nearest targets of the         */
+/*      column, which gives for each pixel its nearest target pixel.    */
+/*      Lines, and then columns, are processed in parallel when         */
+/*      GDAL_NUM_THREADS allows it. The whole raster is processed in    */
+/*      memory.                                                         */
+/************************************************************************/
+
+static CPLErr ComputeProximityEDT(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hProximityBand,
+    ProximityOutput eOutput, double dfDistMult, double dfMaxDist,
+    const double *pdfSrcNoDataValue, double dfNoDataValue, bool bFixedBufVal,
+    double dfFixedBufVal, int nTargetValues, const int *panTargetValues,
+    GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    const int nXSize = GDALGetRasterBandXSize(hSrcBand);
+    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
+    const size_t nPixels = static_cast<size_t>(nXSize) * nYSize;
+
+    /* -------------------------------------------------------------------- */
+    /*      Check that we have enough memory.                               */
+    /* -------------------------------------------------------------------- */
+    const bool bNeedSrcValues = eOutput == ProximityOutput::NEAREST_VALUE;
+    const bool bNeedNoDataMask = pdfSrcNoDataValue != nullptr;
+    const GDALDataType eOutDT =
+        eOutput == ProximityOutput::DISTANCE ? GDT_Float32 : GDT_Float64;
+    const double dfBytesPerPixel =
+        sizeof(GInt32) + (bNeedSrcValues ? sizeof(GInt32) : 0) +
+        (bNeedNoDataMask ? 1 : 0) + GDALGetDataTypeSizeBytes(eOutDT);
+    const GIntBig nUsableRAM = CPLGetUsablePhysicalRAM();
+    if (nUsableRAM > 0 &&
+        static_cast<double>(nPixels) * dfBytesPerPixel > nUsableRAM)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "GDALComputeProximity(): ALGORITHM=EDT would require %.0f MB "
+                 "of RAM, which exceeds the usable physical RAM. Use "
+                 "ALGORITHM=SWEEP instead.",
+                 static_cast<double>(nPixels) * dfBytesPerPixel / 1e6);
+        return CE_Failure;
+    }
+
+    std::vector<GInt32> anNearestCol;
+    std::vector<GInt32> anSrcValues;
+    std::vector<GByte> abyNoData;
+    std::vector<GByte> abyOut;
+    std::vector<GInt32> anChunk;
+    constexpr int CHUNK_LINES = 64;
+    try
+    {
+        anNearestCol.resize(nPixels);
+        if (bNeedSrcValues)
+            anSrcValues.resize(nPixels);
+        if (bNeedNoDataMask)
+            abyNoData.resize(nPixels);
+        abyOut.resize(nPixels * GDALGetDataTypeSizeBytes(eOutDT));
+        anChunk.resize(static_cast<size_t>(nXSize) *
+                       std::min(nYSize, CHUNK_LINES));
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "GDALComputeProximity(): out of memory");
+        return CE_Failure;
+    }
+
+    const int nThreads = GDALGetNumThreads();
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+    std::atomic<bool> bStop{false};
+    std::atomic<int> nItemsDone{0};
+
+    // Run oFunc(iStart, iEnd) over sub-ranges of [0, nItems), with the
+    // thread pool if available, and report progress in the
+    // [dfProgressStart, dfProgressEnd] range.
+    const auto RunParallel =
+        [&](int nItems, const std::function<void(int, int)> &oFunc,
+            double dfProgressStart, double dfProgressEnd)
+    {
+        nItemsDone = 0;
+        const auto oJob = [&oFunc, &bStop, &nItemsDone](int iStart, int iEnd)
+        {
+            try
+            {
+                if (!bStop)
+                    oFunc(iStart, iEnd);
+            }
+            catch (const std::bad_alloc &)
+            {
+                bStop = true;
+            }
+            nItemsDone += iEnd - iStart;
+        };
+
+        const int nJobs =
+            poJobQueue ? std::min(nItems, 4 * nThreads) : std::min(nItems, 1);
+        for (int i = 0; i < nJobs; ++i)
+        {
+            const int iStart =
+                static_cast<int>(static_cast<GIntBig>(nItems) * i / nJobs);
+            const int iEnd = static_cast<int>(static_cast<GIntBig>(nItems) *
+                                              (i + 1) / nJobs);
+            if (!poJobQueue ||
+                !poJobQueue->SubmitJob([&oJob, iStart, iEnd]()
+                                       { oJob(iStart, iEnd); }))
+            {
+                oJob(iStart, iEnd);
+            }
+        }
+
+        while (true)
+        {
+            const bool bRemaining = poJobQueue && poJobQueue->WaitEvent();
+            if (!bStop &&
+                !pfnProgress(dfProgressStart +
+                                 (dfProgressEnd - dfProgressStart) *
+                                     nItemsDone / std::max(1, nItems),
+                             "", pProgressArg))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                bStop = true;
+            }
+            if (!bRemaining)
+                break;
+        }
+        if (poJobQueue)
+            poJobQueue->WaitCompletion();
+    };
+
+    /* -------------------------------------------------------------------- */
+    /*      First pass: nearest target column within each line.             */
+    /* -------------------------------------------------------------------- */
+    CPLErr eErr = CE_None;
+    for (int iChunkLine = 0; eErr == CE_None && iChunkLine < nYSize;
+         iChunkLine += CHUNK_LINES)
+    {
+        const int nLines = std::min(CHUNK_LINES, nYSize - iChunkLine);
+        eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iChunkLine, nXSize, nLines,
+                            anChunk.data(), nXSize, nLines, GDT_Int32, 0, 0);
+        if (eErr != CE_None)
+            break;
+
+        const auto ProcessLines = [&](int iStart, int iEnd)
+        {
+            for (int iLine = iStart; iLine < iEnd; ++iLine)
+            {
+                const GInt32 *panSrcScanline =
+                    anChunk.data() + static_cast<size_t>(iLine) * nXSize;
+                const size_t nOffset =
+                    static_cast<size_t>(iChunkLine + iLine) * nXSize;
+                GInt32 *panNearestCol = anNearestCol.data() + nOffset;
+
+                // Left to right: nearest target on the left.
+                int nLastTarget = -1;
+                for (int iPixel = 0; iPixel < nXSize; ++iPixel)
+                {
+                    if (IsTargetValue(panSrcScanline[iPixel], nTargetValues,
+                                      panTargetValues))
+                        nLastTarget = iPixel;
+                    panNearestCol[iPixel] = nLastTarget;
+                }
+
+                // Right to left: nearest target on the right, if closer.
+                nLastTarget = -1;
+                for (int iPixel = nXSize - 1; iPixel >= 0; --iPixel)
+                {
+                    if (panNearestCol[iPixel] == iPixel)
+                        nLastTarget = iPixel;
+                    else if (nLastTarget >= 0 &&
+                             (panNearestCol[iPixel] < 0 ||
+                              nLastTarget - iPixel <
+                                  iPixel - panNearestCol[iPixel]))
+                        panNearestCol[iPixel] = nLastTarget;
+                }
+
+                if (bNeedSrcValues)
+                {
+                    memcpy(anSrcValues.data() + nOffset, panSrcScanline,
+                           sizeof(GInt32) * nXSize);
+                }
+                if (bNeedNoDataMask)
+                {
+                    for (int iPixel = 0; iPixel < nXSize; ++iPixel)
+                        abyNoData[nOffset + iPixel] =
+                            panSrcScanline[iPixel] == *pdfSrcNoDataValue;
+                }
+            }
+        };
+
+        const double dfChunkStart = 0.4 * iChunkLine / nYSize;
+        const double dfChunkEnd = 0.4 * (iChunkLine + nLines) / nYSize;
+        RunParallel(nLines, ProcessLines, dfChunkStart, dfChunkEnd);
+        if (bStop)
+            eErr = CE_Failure;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Second pass: nearest target of each pixel, column per column,   */
+    /*      and computation of the output values.                           */
+    /* -------------------------------------------------------------------- */
+    const double dfMaxDistSq = dfMaxDist * dfMaxDist;
+    // Columns are processed by blocks, gathered from / scattered to the
+    // line-major arrays, to avoid a cache miss per pixel.
+    constexpr int COLUMN_BLOCK_SIZE = 16;
+    const auto ProcessColumns = [&](int iStart, int iEnd)
+    {
+        std::vector<GInt32> anBlockNearest(static_cast<size_t>(nYSize) *
+                                           COLUMN_BLOCK_SIZE);
+        std::vector<double> adfBlockOut(static_cast<size_t>(nYSize) *
+                                        COLUMN_BLOCK_SIZE);
+        std::vector<double> adfF(nYSize);
+        std::vector<int> anV(nYSize);
+        std::vector<double> adfZ(static_cast<size_t>(nYSize) + 1);
+        constexpr double INF = std::numeric_limits<double>::infinity();
+
+        for (int iBlockCol = iStart; iBlockCol < iEnd && !bStop;
+             iBlockCol += COLUMN_BLOCK_SIZE)
+        {
+            const int nCols = std::min(COLUMN_BLOCK_SIZE, iEnd - iBlockCol);
+            for (int y = 0; y < nYSize; ++y)
+            {
+                const GInt32 *panNearestCol =
+                    anNearestCol.data() + static_cast<size_t>(y) * nXSize +
+                    iBlockCol;
+                for (int iCol = 0; iCol < nCols; ++iCol)
+                    anBlockNearest[static_cast<size_t>(iCol) * nYSize + y] =
+                        panNearestCol[iCol];
+            }
+
+            for (int iColInBlock = 0; iColInBlock < nCols; ++iColInBlock)
+            {
+                const int iCol = iBlockCol + iColInBlock;
+                const GInt32 *panColNearest =
+                    anBlockNearest.data() +
+                    static_cast<size_t>(iColInBlock) * nYSize;
+                double *padfColOut = adfBlockOut.data() +
+                                     static_cast<size_t>(iColInBlock) * nYSize;
+
+                // Build the lower envelope of the parabolas
+                // y -> (y - q)^2 + (iCol - nearest_col(q))^2
+                int k = -1;
+                for (int q = 0; q < nYSize; ++q)
+                {
+                    const GInt32 nNearestCol = panColNearest[q];
+                    if (nNearestCol < 0)
+                        continue;
+                    const double dfDX =
+                        static_cast<double>(iCol) - nNearestCol;
+                    adfF[q] = dfDX * dfDX + static_cast<double>(q) * q;
+
+                    double dfS = -INF;
+                    while (k >= 0)
+                    {
+                        const int v = anV[k];
+                        dfS = (adfF[q] - adfF[v]) / (2.0 * (q - v));
+                        if (dfS > adfZ[k])
+                            break;
+                        --k;
+                    }
+                    ++k;
+                    anV[k] = q;
+                    adfZ[k] = k == 0 ? -INF : dfS;
+                    adfZ[k + 1] = INF;
+                }
+
+                // Compute the output values.
+                int iEnvelope = 0;
+                for (int y = 0; y < nYSize; ++y)
+                {
+                    double dfOut = dfNoDataValue;
+                    if (k >= 0)
+                    {
+                        while (adfZ[iEnvelope + 1] < y)
+                            ++iEnvelope;
+                        const int nNearestLine = anV[iEnvelope];
+                        const double dfDY =
+                            static_cast<double>(y) - nNearestLine;
+                        const double dfDistSq =
+                            dfDY * dfDY + adfF[nNearestLine] -
+                            static_cast<double>(nNearestLine) * nNearestLine;
+                        const bool bIsTarget = panColNearest[y] == iCol;
+                        if (bIsTarget ||
+                            ((!bNeedNoDataMask ||
+                              !abyNoData[static_cast<size_t>(y) * nXSize +
+                                         iCol]) &&
+                             dfDistSq <= dfMaxDistSq))
+                        {
+                            const size_t nNearestOffset =
+                                static_cast<size_t>(nNearestLine) * nXSize +
+                                panColNearest[nNearestLine];
+                            if (eOutput == ProximityOutput::NEAREST_VALUE)
+                                dfOut = anSrcValues[nNearestOffset];
+                            else if (eOutput == ProximityOutput::NEAREST_INDEX)
+                                dfOut = static_cast<double>(nNearestOffset);
+                            else if (bIsTarget)
+                                dfOut = 0;
+                            else if (bFixedBufVal)
+                                dfOut = static_cast<float>(dfFixedBufVal);
+                            else
+                                dfOut = static_cast<float>(sqrt(dfDistSq)) *
+                                        static_cast<float>(dfDistMult);
+                        }
+                    }
+                    padfColOut[y] = dfOut;
+                }
+            }
+
+            for (int y = 0; y < nYSize; ++y)
+            {
+                const size_t nOffset =
+                    static_cast<size_t>(y) * nXSize + iBlockCol;
+                for (int iCol = 0; iCol < nCols; ++iCol)
+                {
+                    const double dfOut =
+                        adfBlockOut[static_cast<size_t>(iCol) * nYSize + y];
+                    if (eOutDT == GDT_Float32)
+                        reinterpret_cast<float *>(
+                            abyOut.data())[nOffset + iCol] =
+                            static_cast<float>(dfOut);
+                    else
+                        reinterpret_cast<double *>(
+                            abyOut.data())[nOffset + iCol] = dfOut;
+                }
+            }
+        }
+    };
+
+    if (eErr == CE_None)
+    {
+        RunParallel(nXSize, ProcessColumns, 0.4, 0.8);
+        if (bStop)
+            eErr = CE_Failure;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Write the result.                                               */
+    /* -------------------------------------------------------------------- */
+    const int nOutDTSize = GDALGetDataTypeSizeBytes(eOutDT);
+    for (int iChunkLine = 0; eErr == CE_None && iChunkLine < nYSize;
+         iChunkLine += CHUNK_LINES)
+    {
+        const int nLines = std::min(CHUNK_LINES, nYSize - iChunkLine);
+        eErr = GDALRasterIO(
+            hProximityBand, GF_Write, 0, iChunkLine, nXSize, nLines,
+            abyOut.data() + static_cast<size_t>(iChunkLine) * nXSize *
+                                nOutDTSize,
+            nXSize, nLines, eOutDT, 0, 0);
+
+        if (eErr == CE_None &&
+            !pfnProgress(0.8 + 0.2 * (iChunkLine + nLines) / nYSize, "",
+                         pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    return eErr;
+}
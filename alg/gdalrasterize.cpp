@@ -16,22 +16,29 @@
 #include "gdal_alg_priv.h"
 
 #include <climits>
+#include <cmath>
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
 #include <cfloat>
+#include <atomic>
+#include <condition_variable>
 #include <limits>
+#include <mutex>
 #include <vector>
 #include <algorithm>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
@@ -925,6 +932,15 @@ static CPLErr GDALRasterizeGeometriesInternal(
  * with tiled images to be efficient. The auto mode (the default) will chose
  * the algorithm based on input and output properties.
  * </li>
+ * <li>"NUM_THREADS": (GDAL >= 3.12) Number of threads to use, as an integer
+ * or ALL_CPUS. Defaults to the value of the GDAL_NUM_THREADS configuration
+ * option, or 1. When greater than 1, the raster is split into tiles of about
+ * one million pixels, aligned on the block size, that are rasterized
+ * concurrently, each with the geometries whose envelope intersects it.
+ * The result does not depend on the number of threads. OPTIM and CHUNKYSIZE
+ * are then ignored. The transformer, if provided, must support
+ * GDALCreateSimilarTransformer().
+ * </li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -1016,6 +1032,375 @@ CPLErr GDALRasterizeGeometriesInt64(
         pfnProgress, pProgressArg);
 }
 
+/************************************************************************/
+/*                   GDALRasterizeCanCloneTransformer()                 */
+/************************************************************************/
+
+static bool GDALRasterizeCanCloneTransformer(void *pTransformArg)
+{
+    const GDALTransformerInfo *psInfo =
+        static_cast<const GDALTransformerInfo *>(pTransformArg);
+    return psInfo != nullptr &&
+           memcmp(psInfo->abySignature, GDAL_GTI2_SIGNATURE,
+                  strlen(GDAL_GTI2_SIGNATURE)) == 0 &&
+           psInfo->pfnCreateSimilar != nullptr;
+}
+
+/************************************************************************/
+/*                     GDALRasterizeGeometriesMT()                      */
+/*                                                                      */
+/*      Multi-threaded variant of GDALRasterizeGeometriesInternal().    */
+/*      The raster is partitioned into tiles aligned on the block       */
+/*      size, and geometries are binned into the tiles their pixel      */
+/*      envelope intersects. Tiles are then rasterized concurrently,    */
+/*      each visiting its geometries in their original order, with      */
+/*      raster I/O serialized. As tiles are disjoint, the result does   */
+/*      not depend on the number of threads, with MERGE_ALG=REPLACE or  */
+/*      ADD.                                                            */
+/*                                                                      */
+/*      Returns false, without doing anything, if this code path        */
+/*      cannot be used.                                                 */
+/************************************************************************/
+
+static bool GDALRasterizeGeometriesMT(
+    GDALDataset *poDS, int nBandCount, const int *panBandList, int nGeomCount,
+    const OGRGeometryH *pahGeometries, GDALTransformerFunc pfnTransformer,
+    void *pTransformArg, GDALDataType eBurnValueType,
+    const double *padfGeomBurnValues, const int64_t *panGeomBurnValues,
+    int bAllTouched, GDALBurnValueSrc eBurnValueSource,
+    GDALRasterMergeAlg eMergeAlg, int nThreads, GDALProgressFunc pfnProgress,
+    void *pProgressArg, CPLErr &eErr)
+{
+    GDALRasterBand *poBand = poDS->GetRasterBand(panBandList[0]);
+    const int nRasterXSize = poDS->GetRasterXSize();
+    const int nRasterYSize = poDS->GetRasterYSize();
+
+    /* -------------------------------------------------------------------- */
+    /*      Establish a tiling of about one million pixels, aligned on      */
+    /*      the block size.                                                 */
+    /* -------------------------------------------------------------------- */
+    constexpr int TARGET_TILE_DIM = 1024;
+    int nXBlockSize, nYBlockSize;
+    poBand->GetBlockSize(&nXBlockSize, &nYBlockSize);
+    const int nTileXSize = static_cast<int>(
+        std::min<GIntBig>(nRasterXSize,
+                          static_cast<GIntBig>(nXBlockSize) *
+                              std::max(1, TARGET_TILE_DIM / nXBlockSize)));
+    const int nTileYSize = static_cast<int>(std::min<GIntBig>(
+        nRasterYSize,
+        static_cast<GIntBig>(nYBlockSize) *
+            std::max<GIntBig>(1, static_cast<GIntBig>(TARGET_TILE_DIM) *
+                                     TARGET_TILE_DIM / nTileXSize /
+                                     nYBlockSize)));
+    const int nTilesX = DIV_ROUND_UP(nRasterXSize, nTileXSize);
+    const int nTilesY = DIV_ROUND_UP(nRasterYSize, nTileYSize);
+    if (static_cast<GIntBig>(nTilesX) * nTilesY < 2 ||
+        static_cast<GIntBig>(nTilesX) * nTilesY >
+            std::numeric_limits<int>::max())
+    {
+        return false;
+    }
+    const int nTiles = nTilesX * nTilesY;
+    nThreads = std::min(nThreads, nTiles);
+
+    if (pfnTransformer && !GDALRasterizeCanCloneTransformer(pTransformArg))
+    {
+        CPLDebug("GDAL", "Rasterizer cannot use several threads, as the "
+                         "transformer cannot be cloned.");
+        return false;
+    }
+
+    CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+    if (poThreadPool == nullptr)
+        return false;
+
+    const GDALDataType eType =
+        GDALGetNonComplexDataType(poBand->GetRasterDataType());
+    const size_t nTileBufferSize = static_cast<size_t>(nTileXSize) *
+                                   nTileYSize * nBandCount *
+                                   GDALGetDataTypeSizeBytes(eType);
+
+    // Each thread uses its own transformer, as most are not thread-safe.
+    std::vector<void *> apTransformArgs(nThreads, nullptr);
+    const auto DestroyTransformers = [&apTransformArgs]()
+    {
+        for (void *pArg : apTransformArgs)
+        {
+            if (pArg)
+                GDALDestroyTransformer(pArg);
+        }
+    };
+    if (pfnTransformer)
+    {
+        for (auto &pArg : apTransformArgs)
+        {
+            pArg = GDALCreateSimilarTransformer(pTransformArg, 1.0, 1.0);
+            if (pArg == nullptr)
+            {
+                DestroyTransformers();
+                eErr = CE_Failure;
+                return true;
+            }
+        }
+    }
+
+    CPLDebug("GDAL",
+             "Rasterizer operating on %d tiles of %dx%d pixels with %d "
+             "threads.",
+             nTiles, nTileXSize, nTileYSize, nThreads);
+
+    pfnProgress(0.0, nullptr, pProgressArg);
+
+    /* -------------------------------------------------------------------- */
+    /*      Bin geometries into tiles, from the envelope of each geometry   */
+    /*      transformed to pixel coordinates. The 4 corners of the          */
+    /*      envelopes are transformed by batches.                           */
+    /* -------------------------------------------------------------------- */
+    std::vector<std::vector<int>> aanTileGeoms;
+    try
+    {
+        aanTileGeoms.resize(nTiles);
+
+        constexpr int BATCH_SIZE = 1024;
+        std::vector<double> adfX, adfY;
+        std::vector<int> abSuccess;
+        std::vector<int> anBatchGeoms;
+        for (int iStart = 0; iStart < nGeomCount; iStart += BATCH_SIZE)
+        {
+            const int iEnd = std::min(nGeomCount, iStart + BATCH_SIZE);
+            adfX.clear();
+            adfY.clear();
+            anBatchGeoms.clear();
+            for (int iShape = iStart; iShape < iEnd; ++iShape)
+            {
+                const OGRGeometry *poGeometry =
+                    OGRGeometry::FromHandle(pahGeometries[iShape]);
+                if (poGeometry == nullptr || poGeometry->IsEmpty())
+                    continue;
+                OGREnvelope sGeomEnvelope;
+                poGeometry->getEnvelope(&sGeomEnvelope);
+                anBatchGeoms.push_back(iShape);
+                adfX.push_back(sGeomEnvelope.MinX);
+                adfY.push_back(sGeomEnvelope.MinY);
+                adfX.push_back(sGeomEnvelope.MaxX);
+                adfY.push_back(sGeomEnvelope.MinY);
+                adfX.push_back(sGeomEnvelope.MaxX);
+                adfY.push_back(sGeomEnvelope.MaxY);
+                adfX.push_back(sGeomEnvelope.MinX);
+                adfY.push_back(sGeomEnvelope.MaxY);
+            }
+            if (anBatchGeoms.empty())
+                continue;
+
+            abSuccess.assign(adfX.size(), TRUE);
+            if (pfnTransformer)
+            {
+                pfnTransformer(pTransformArg, FALSE,
+                               static_cast<int>(adfX.size()), adfX.data(),
+                               adfY.data(), nullptr, abSuccess.data());
+            }
+
+            for (size_t i = 0; i < anBatchGeoms.size(); ++i)
+            {
+                OGREnvelope sPixelEnvelope;
+                bool bOK = true;
+                for (size_t j = 4 * i; j < 4 * i + 4; ++j)
+                {
+                    if (!abSuccess[j] || !std::isfinite(adfX[j]) ||
+                        !std::isfinite(adfY[j]))
+                    {
+                        bOK = false;
+                        break;
+                    }
+                    sPixelEnvelope.Merge(adfX[j], adfY[j]);
+                }
+                int nMinTileX = 0;
+                int nMinTileY = 0;
+                int nMaxTileX = nTilesX - 1;
+                int nMaxTileY = nTilesY - 1;
+                // If the envelope could not be transformed, let each tile
+                // deal with the geometry.
+                if (bOK)
+                {
+                    // Margin of one pixel, as in the OPTIM=VECTOR mode
+                    if (sPixelEnvelope.MaxX + 1 < 0 ||
+                        sPixelEnvelope.MaxY + 1 < 0 ||
+                        sPixelEnvelope.MinX - 1 >= nRasterXSize ||
+                        sPixelEnvelope.MinY - 1 >= nRasterYSize)
+                    {
+                        continue;
+                    }
+                    const auto ToTile = [](double dfVal, int nTileSize,
+                                           int nMaxTile)
+                    {
+                        return static_cast<int>(std::clamp(
+                            std::floor(dfVal / nTileSize), 0.0,
+                            static_cast<double>(nMaxTile)));
+                    };
+                    nMinTileX = ToTile(sPixelEnvelope.MinX - 1, nTileXSize,
+                                       nTilesX - 1);
+                    nMinTileY = ToTile(sPixelEnvelope.MinY - 1, nTileYSize,
+                                       nTilesY - 1);
+                    nMaxTileX = ToTile(sPixelEnvelope.MaxX + 1, nTileXSize,
+                                       nTilesX - 1);
+                    nMaxTileY = ToTile(sPixelEnvelope.MaxY + 1, nTileYSize,
+                                       nTilesY - 1);
+                }
+                for (int iTileY = nMinTileY; iTileY <= nMaxTileY; ++iTileY)
+                {
+                    for (int iTileX = nMinTileX; iTileX <= nMaxTileX; ++iTileX)
+                    {
+                        aanTileGeoms[static_cast<size_t>(iTileY) * nTilesX +
+                                     iTileX]
+                            .push_back(anBatchGeoms[i]);
+                    }
+                }
+            }
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALRasterizeGeometries()");
+        DestroyTransformers();
+        eErr = CE_Failure;
+        return true;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Rasterize tiles concurrently. Each job processes tiles until    */
+    /*      there are no more, with its own transformer and buffer.         */
+    /* -------------------------------------------------------------------- */
+    std::mutex oIOMutex;
+    std::mutex oMutex;
+    std::condition_variable oCV;
+    int nFinishedJobs = 0;  // protected by oMutex
+    std::atomic<int> nNextTile{0};
+    std::atomic<int> nProcessedTiles{0};
+    std::atomic<bool> bStop{false};
+    CPLErrorAccumulator oErrorAccumulator;
+    auto poJobQueue = poThreadPool->CreateJobQueue();
+
+    const auto ProcessTile = [&](int iTile, void *pTransformArgThread,
+                                 GByte *pabyTileBuf)
+    {
+        const auto &anGeoms = aanTileGeoms[iTile];
+        if (anGeoms.empty())
+            return true;
+
+        const int nXOff = (iTile % nTilesX) * nTileXSize;
+        const int nYOff = (iTile / nTilesX) * nTileYSize;
+        const int nThisXSize = std::min(nTileXSize, nRasterXSize - nXOff);
+        const int nThisYSize = std::min(nTileYSize, nRasterYSize - nYOff);
+
+        {
+            std::lock_guard oLock(oIOMutex);
+            if (poDS->RasterIO(GF_Read, nXOff, nYOff, nThisXSize, nThisYSize,
+                               pabyTileBuf, nThisXSize, nThisYSize, eType,
+                               nBandCount, panBandList, 0, 0, 0,
+                               nullptr) != CE_None)
+            {
+                return false;
+            }
+        }
+
+        for (const int iShape : anGeoms)
+        {
+            gv_rasterize_one_shape(
+                pabyTileBuf, nXOff, nYOff, nThisXSize, nThisYSize, nBandCount,
+                eType, 0, 0, 0, bAllTouched,
+                OGRGeometry::FromHandle(pahGeometries[iShape]), eBurnValueType,
+                padfGeomBurnValues
+                    ? padfGeomBurnValues +
+                          static_cast<size_t>(iShape) * nBandCount
+                    : nullptr,
+                panGeomBurnValues ? panGeomBurnValues +
+                                        static_cast<size_t>(iShape) * nBandCount
+                                  : nullptr,
+                eBurnValueSource, eMergeAlg, pfnTransformer,
+                pTransformArgThread);
+        }
+
+        std::lock_guard oLock(oIOMutex);
+        return poDS->RasterIO(GF_Write, nXOff, nYOff, nThisXSize, nThisYSize,
+                              pabyTileBuf, nThisXSize, nThisYSize, eType,
+                              nBandCount, panBandList, 0, 0, 0,
+                              nullptr) == CE_None;
+    };
+
+    for (int iJob = 0; iJob < nThreads; ++iJob)
+    {
+        const auto oTask = [&, iJob]()
+        {
+            {
+                auto oAccumulator = oErrorAccumulator.InstallForCurrentScope();
+                CPL_IGNORE_RET_VAL(oAccumulator);
+                GByte *pabyTileBuf =
+                    static_cast<GByte *>(VSI_MALLOC_VERBOSE(nTileBufferSize));
+                if (pabyTileBuf == nullptr)
+                    bStop = true;
+                while (!bStop)
+                {
+                    const int iTile = nNextTile++;
+                    if (iTile >= nTiles)
+                        break;
+                    if (!ProcessTile(iTile, apTransformArgs[iJob],
+                                     pabyTileBuf))
+                    {
+                        bStop = true;
+                    }
+                    ++nProcessedTiles;
+                    oCV.notify_one();
+                }
+                VSIFree(pabyTileBuf);
+            }
+            std::lock_guard oLock(oMutex);
+            ++nFinishedJobs;
+            oCV.notify_one();
+        };
+        if (!poJobQueue->SubmitJob(oTask))
+            oTask();
+    }
+
+    bool bUserInterrupt = false;
+    {
+        std::unique_lock oLock(oMutex);
+        while (nFinishedJobs < nThreads)
+        {
+            oCV.wait(oLock);
+            oLock.unlock();
+            if (!bStop &&
+                !pfnProgress(nProcessedTiles / static_cast<double>(nTiles), "",
+                             pProgressArg))
+            {
+                bUserInterrupt = true;
+                bStop = true;
+            }
+            oLock.lock();
+        }
+    }
+    poJobQueue->WaitCompletion();
+
+    oErrorAccumulator.ReplayErrors();
+    DestroyTransformers();
+
+    if (bUserInterrupt)
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        eErr = CE_Failure;
+    }
+    else if (bStop)
+    {
+        eErr = CE_Failure;
+    }
+    else
+    {
+        eErr = CE_None;
+        pfnProgress(1.0, "", pProgressArg);
+    }
+    return true;
+}
+
 static CPLErr GDALRasterizeGeometriesInternal(
     GDALDatasetH hDS, int nBandCount, const int *panBandList, int nGeomCount,
     const OGRGeometryH *pahGeometries, GDALTransformerFunc pfnTransformer,
@@ -1106,6 +1491,31 @@ static CPLErr GDALRasterizeGeometriesInternal(
         }
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Multi-threaded tiled rasterization, if requested.               */
+    /* -------------------------------------------------------------------- */
+    const char *pszNumThreads = CSLFetchNameValueDef(
+        papszOptions, "NUM_THREADS",
+        CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
+    const int nThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                             ? CPLGetNumCPUs()
+                             : std::clamp(atoi(pszNumThreads), 1, 128);
+    if (nThreads > 1)
+    {
+        CPLErr eErr = CE_None;
+        if (GDALRasterizeGeometriesMT(
+                poDS, nBandCount, panBandList, nGeomCount, pahGeometries,
+                pfnTransformer, pTransformArg, eBurnValueType,
+                padfGeomBurnValues, panGeomBurnValues, bAllTouched,
+                eBurnValueSource, eMergeAlg, nThreads, pfnProgress,
+                pProgressArg, eErr))
+        {
+            if (bNeedToFreeTransformer)
+                GDALDestroyTransformer(pTransformArg);
+            return eErr;
+        }
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Choice of optimisation in auto mode. Use vector optim :         */
     /*      1) if output is tiled                                           */
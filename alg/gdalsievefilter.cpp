@@ -17,19 +17,31 @@
 #include <cstring>
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <vector>
 #include <utility>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_progress.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_alg_priv.h"
+#include "gdal_thread_pool.h"
 
 #define MY_MAX_INT 2147483647
 
+// Minimum height of the strips processed in parallel.
+constexpr int GS_MIN_STRIP_HEIGHT = 32;
+
 /*
  * General Plan
  *
@@ -125,6 +137,759 @@ static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
         anBigNeighbour[nPolyId2] = nPolyId1;
 }
 
+/************************************************************************/
+/*                       GSResolveBigNeighbour()                        */
+/*                                                                      */
+/*      If the biggest neighbour of a polygon smaller than the          */
+/*      threshold is itself smaller than the threshold, then track to   */
+/*      that polygon's biggest neighbour, and so forth, until a large   */
+/*      enough polygon is found. The whole chain is then mapped to it.  */
+/*      Otherwise, the polygon will not be merged.                      */
+/************************************************************************/
+
+static void GSResolveBigNeighbour(int iPoly,
+                                  const std::vector<int> &anPolySizes,
+                                  std::vector<int> &anBigNeighbour,
+                                  int nSizeThreshold, int &nSieveTargets,
+                                  int &nIsolatedSmall, int &nFailedMerges)
+{
+    // Don't try to merge polygons larger than the threshold.
+    if (anPolySizes[iPoly] >= nSizeThreshold)
+    {
+        anBigNeighbour[iPoly] = -1;
+        return;
+    }
+
+    nSieveTargets++;
+
+    // if we have no neighbours but we are small, what shall we do?
+    if (anBigNeighbour[iPoly] == -1)
+    {
+        nIsolatedSmall++;
+        return;
+    }
+
+    std::set<int> oSetVisitedPoly;
+    oSetVisitedPoly.insert(iPoly);
+
+    // Walk through our neighbours until we find a polygon large enough.
+    int iFinalId = iPoly;
+    bool bFoundBigEnoughPoly = false;
+    while (true)
+    {
+        iFinalId = anBigNeighbour[iFinalId];
+        if (iFinalId < 0)
+        {
+            break;
+        }
+        // If the biggest neighbour is larger than the threshold
+        // then we are golden.
+        if (anPolySizes[iFinalId] >= nSizeThreshold)
+        {
+            bFoundBigEnoughPoly = true;
+            break;
+        }
+        // Check that we don't cycle on an already visited polygon.
+        if (oSetVisitedPoly.find(iFinalId) != oSetVisitedPoly.end())
+            break;
+        oSetVisitedPoly.insert(iFinalId);
+    }
+
+    if (!bFoundBigEnoughPoly)
+    {
+        nFailedMerges++;
+        anBigNeighbour[iPoly] = -1;
+        return;
+    }
+
+    // Map the whole intermediate chain to it.
+    int iPolyCur = iPoly;
+    while (anBigNeighbour[iPolyCur] != iFinalId)
+    {
+        int iNextPoly = anBigNeighbour[iPolyCur];
+        anBigNeighbour[iPolyCur] = iFinalId;
+        iPolyCur = iNextPoly;
+    }
+}
+
+/************************************************************************/
+/*                           GSFindRoot()                               */
+/*                                                                      */
+/*      Lock-free union-find of polygon ids. A root is always linked    */
+/*      under a root of lower id, so parent links only ever decrease,   */
+/*      which makes path halving safe with concurrent unions.           */
+/************************************************************************/
+
+static GInt32 GSFindRoot(std::vector<std::atomic<GInt32>> &anParent,
+                         GInt32 nId)
+{
+    while (true)
+    {
+        GInt32 nParent = anParent[nId].load(std::memory_order_relaxed);
+        if (nParent == nId)
+            return nId;
+        const GInt32 nGrandParent =
+            anParent[nParent].load(std::memory_order_relaxed);
+        if (nGrandParent != nParent)
+            anParent[nId].compare_exchange_weak(nParent, nGrandParent,
+                                                std::memory_order_relaxed);
+        nId = nGrandParent;
+    }
+}
+
+/************************************************************************/
+/*                           GSMergeRoots()                             */
+/************************************************************************/
+
+static void GSMergeRoots(std::vector<std::atomic<GInt32>> &anParent,
+                         GInt32 nId1, GInt32 nId2)
+{
+    while (true)
+    {
+        nId1 = GSFindRoot(anParent, nId1);
+        nId2 = GSFindRoot(anParent, nId2);
+        if (nId1 == nId2)
+            return;
+        if (nId1 < nId2)
+            std::swap(nId1, nId2);
+        GInt32 nExpected = nId1;
+        if (anParent[nId1].compare_exchange_weak(nExpected, nId2,
+                                                 std::memory_order_relaxed))
+            return;
+    }
+}
+
+namespace
+{
+
+/************************************************************************/
+/*                            GSNeighbour                               */
+/************************************************************************/
+
+// Largest neighbour of a polygon found so far, and the position at which
+// it has been found in the scan order of the single-threaded version, to
+// retain the first one when several neighbours have the same size.
+struct GSNeighbour
+{
+    GInt32 nId = -1;
+    GIntBig nPos = 0;
+};
+
+/************************************************************************/
+/*                              GSStrip                                 */
+/************************************************************************/
+
+struct GSStrip
+{
+    CPL_DISALLOW_COPY_ASSIGN(GSStrip)
+
+    int nYOff = 0;
+    int nYSize = 0;
+    CPLErr eErr = CE_None;
+
+    // First pass enumeration of the strip, sizes of its polygon fragments,
+    // and its first and last lines.
+    GDALRasterPolygonEnumerator oFirstEnum;
+    std::vector<int> anPolySizes{};
+    std::vector<std::int64_t> anFirstLineVal{};
+    std::vector<GInt32> anFirstLineId{};
+    std::vector<std::int64_t> anLastLineVal{};
+    std::vector<GInt32> anLastLineId{};
+
+    // Maps polygon ids of oFirstEnum to global polygon ids.
+    GInt32 nIdOffset = 0;
+    std::vector<GInt32> anGlobalId{};
+
+    // Largest neighbours found in the strip, for its polygons (indexed by
+    // final polygon id of oFirstEnum), and for polygons of the last line
+    // of the previous strip (indexed by global id).
+    std::vector<GSNeighbour> aoBigNeighbour{};
+    std::vector<std::pair<GInt32, GSNeighbour>> aoSeamBigNeighbour{};
+
+    explicit GSStrip(int nConnectedness) : oFirstEnum(nConnectedness)
+    {
+    }
+};
+
+}  // namespace
+
+/************************************************************************/
+/*                          GDALSieveFilterMT()                         */
+/*                                                                      */
+/*      Multi-threaded version of GDALSieveFilter(). The raster is      */
+/*      split into horizontal strips whose connected components are     */
+/*      labelled concurrently. Labels are then merged across strip      */
+/*      seams with a lock-free union-find, and polygon sizes are        */
+/*      reduced over strips. Largest neighbours are searched, and       */
+/*      pixel values remapped, strip by strip in parallel. The result   */
+/*      is identical to the one of the single-threaded version.         */
+/************************************************************************/
+
+static CPLErr GDALSieveFilterMT(GDALRasterBandH hSrcBand,
+                                GDALRasterBandH hMaskBand,
+                                GDALRasterBandH hDstBand, int nSizeThreshold,
+                                int nConnectedness,
+                                CPLWorkerThreadPool *poThreadPool,
+                                int nStrips, GDALProgressFunc pfnProgress,
+                                void *pProgressArg)
+{
+    const int nXSize = GDALGetRasterBandXSize(hSrcBand);
+    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
+
+    std::vector<std::unique_ptr<GSStrip>> apoStrips;
+    for (int i = 0; i < nStrips; ++i)
+    {
+        auto poStrip = std::make_unique<GSStrip>(nConnectedness);
+        poStrip->nYOff =
+            static_cast<int>(static_cast<GIntBig>(nYSize) * i / nStrips);
+        poStrip->nYSize =
+            static_cast<int>(static_cast<GIntBig>(nYSize) * (i + 1) /
+                             nStrips) -
+            poStrip->nYOff;
+        apoStrips.push_back(std::move(poStrip));
+    }
+
+    std::mutex oIOMutex;
+    std::mutex oMutex;
+    std::condition_variable oCV;
+    int nFinishedJobs = 0;  // protected by oMutex
+    std::atomic<int> nProcessedLines{0};
+    std::atomic<bool> bStop{false};
+    CPLErrorAccumulator oErrorAccumulator;
+    auto poJobQueue = poThreadPool->CreateJobQueue();
+
+    // Raster I/O is serialized, as drivers are generally not thread-safe.
+    const auto ReadLine = [hSrcBand, hMaskBand, nXSize,
+                           &oIOMutex](int iY, std::int64_t *panLineVal,
+                                      GByte *pabyMaskLine,
+                                      std::int64_t *panWriteVal = nullptr)
+    {
+        std::lock_guard oLock(oIOMutex);
+        CPLErr eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iY, nXSize, 1,
+                                   panLineVal, nXSize, 1, GDT_Int64, 0, 0);
+        if (eErr == CE_None && panWriteVal != nullptr)
+            memcpy(panWriteVal, panLineVal, sizeof(panLineVal[0]) * nXSize);
+        if (eErr == CE_None && hMaskBand != nullptr)
+            eErr = GPMaskImageData(hMaskBand, pabyMaskLine, iY, nXSize,
+                                   panLineVal);
+        return eErr;
+    };
+
+    // Run oJob(0) ... oJob(nJobs - 1) with the thread pool, while reporting
+    // progress from the calling thread.
+    const auto RunJobs = [&](int nJobs, const std::function<void(int)> &oJob,
+                             double dfProgressBase, double dfProgressScale)
+    {
+        nFinishedJobs = 0;
+        nProcessedLines = 0;
+        for (int iJob = 0; iJob < nJobs; ++iJob)
+        {
+            const auto oTask = [&, iJob]()
+            {
+                {
+                    auto oAccumulator =
+                        oErrorAccumulator.InstallForCurrentScope();
+                    CPL_IGNORE_RET_VAL(oAccumulator);
+                    try
+                    {
+                        oJob(iJob);
+                    }
+                    catch (const std::bad_alloc &)
+                    {
+                        CPLError(CE_Failure, CPLE_OutOfMemory,
+                                 "Out of memory in GDALSieveFilter()");
+                        bStop = true;
+                    }
+                }
+                std::lock_guard oLock(oMutex);
+                ++nFinishedJobs;
+                oCV.notify_one();
+            };
+            if (!poJobQueue->SubmitJob(oTask))
+                oTask();
+        }
+
+        std::unique_lock oLock(oMutex);
+        while (nFinishedJobs < nJobs)
+        {
+            oCV.wait(oLock);
+            oLock.unlock();
+            if (!bStop &&
+                !pfnProgress(dfProgressBase +
+                                 dfProgressScale * nProcessedLines / nYSize,
+                             "", pProgressArg))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                bStop = true;
+            }
+            oLock.lock();
+        }
+        oLock.unlock();
+        poJobQueue->WaitCompletion();
+
+        for (const auto &poStrip : apoStrips)
+        {
+            if (poStrip->eErr != CE_None)
+                bStop = true;
+        }
+        return !bStop;
+    };
+
+    const auto NotifyLineProcessed = [&nProcessedLines, &oCV]()
+    {
+        ++nProcessedLines;
+        oCV.notify_one();
+    };
+
+    const auto ReportErrors = [&oErrorAccumulator]()
+    {
+        oErrorAccumulator.ReplayErrors();
+        return CE_Failure;
+    };
+
+    /* ==================================================================== */
+    /*      First pass: label the connected components of each strip,      */
+    /*      and accumulate their sizes.                                     */
+    /* ==================================================================== */
+    const auto LabelStrip = [&](int iStrip)
+    {
+        GSStrip &oStrip = *(apoStrips[iStrip]);
+        std::vector<std::int64_t> anLastLineVal(nXSize);
+        std::vector<std::int64_t> anThisLineVal(nXSize);
+        std::vector<GInt32> anLastLineId(nXSize);
+        std::vector<GInt32> anThisLineId(nXSize);
+        std::vector<GByte> abyMaskLine(nXSize);
+
+        const int nYEnd = oStrip.nYOff + oStrip.nYSize;
+        for (int iY = oStrip.nYOff; iY < nYEnd && !bStop; iY++)
+        {
+            oStrip.eErr =
+                ReadLine(iY, anThisLineVal.data(), abyMaskLine.data());
+            if (oStrip.eErr != CE_None)
+                return;
+
+            const bool bFirstLine = iY == oStrip.nYOff;
+            if (!oStrip.oFirstEnum.ProcessLine(
+                    bFirstLine ? nullptr : anLastLineVal.data(),
+                    anThisLineVal.data(),
+                    bFirstLine ? nullptr : anLastLineId.data(),
+                    anThisLineId.data(), nXSize))
+            {
+                oStrip.eErr = CE_Failure;
+                return;
+            }
+
+            if (oStrip.oFirstEnum.nNextPolygonId >
+                static_cast<int>(oStrip.anPolySizes.size()))
+                oStrip.anPolySizes.resize(oStrip.oFirstEnum.nNextPolygonId);
+
+            for (int iX = 0; iX < nXSize; iX++)
+            {
+                const int iPoly = anThisLineId[iX];
+
+                if (iPoly >= 0 && oStrip.anPolySizes[iPoly] < MY_MAX_INT)
+                    oStrip.anPolySizes[iPoly] += 1;
+            }
+
+            if (bFirstLine)
+            {
+                oStrip.anFirstLineVal = anThisLineVal;
+                oStrip.anFirstLineId = anThisLineId;
+            }
+            if (iY == nYEnd - 1)
+            {
+                oStrip.anLastLineVal = anThisLineVal;
+                oStrip.anLastLineId = anThisLineId;
+            }
+
+            std::swap(anLastLineVal, anThisLineVal);
+            std::swap(anLastLineId, anThisLineId);
+
+            NotifyLineProcessed();
+        }
+
+        oStrip.oFirstEnum.CompleteMerges();
+    };
+
+    if (!RunJobs(nStrips, LabelStrip, 0.0, 0.25))
+        return ReportErrors();
+
+    GIntBig nTotalPolygons = 0;
+    for (auto &poStrip : apoStrips)
+    {
+        poStrip->nIdOffset = static_cast<GInt32>(nTotalPolygons);
+        nTotalPolygons += poStrip->oFirstEnum.nNextPolygonId;
+        if (nTotalPolygons > std::numeric_limits<GInt32>::max())
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "GDALSieveFilter(): too many polygons");
+            return CE_Failure;
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Check if there are polygons                                     */
+    /* -------------------------------------------------------------------- */
+    if (nTotalPolygons == 0)
+    {
+        // Can happen if all pixels are masked
+        if (hSrcBand == hDstBand)
+        {
+            pfnProgress(1.0, "", pProgressArg);
+            return CE_None;
+        }
+        else
+        {
+            return GDALRasterBandCopyWholeRaster(hSrcBand, hDstBand, nullptr,
+                                                 pfnProgress, pProgressArg);
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Merge the polygons that touch across strip seams.               */
+    /* -------------------------------------------------------------------- */
+    const size_t nPolygons = static_cast<size_t>(nTotalPolygons);
+    std::vector<std::atomic<GInt32>> anParent(nPolygons);
+    for (const auto &poStrip : apoStrips)
+    {
+        const GInt32 *panPolyIdMap = poStrip->oFirstEnum.panPolyIdMap;
+        for (int i = 0; i < poStrip->oFirstEnum.nNextPolygonId; i++)
+        {
+            anParent[poStrip->nIdOffset + i].store(poStrip->nIdOffset +
+                                                   panPolyIdMap[i]);
+        }
+    }
+
+    const auto StitchSeam = [&](int iSeam)
+    {
+        const GSStrip &oUpper = *(apoStrips[iSeam]);
+        const GSStrip &oLower = *(apoStrips[iSeam + 1]);
+        const auto GlobalId = [](const GSStrip &oStrip, GInt32 nId)
+        { return oStrip.nIdOffset + oStrip.oFirstEnum.panPolyIdMap[nId]; };
+        const auto Merge = [&](int iUpper, int iLower)
+        {
+            if (oUpper.anLastLineId[iUpper] >= 0 &&
+                oUpper.anLastLineVal[iUpper] == oLower.anFirstLineVal[iLower])
+            {
+                GSMergeRoots(anParent,
+                             GlobalId(oUpper, oUpper.anLastLineId[iUpper]),
+                             GlobalId(oLower, oLower.anFirstLineId[iLower]));
+            }
+        };
+
+        for (int iX = 0; iX < nXSize; iX++)
+        {
+            if (oLower.anFirstLineId[iX] < 0)
+                continue;
+            Merge(iX, iX);
+            if (nConnectedness == 8 && iX > 0)
+                Merge(iX - 1, iX);
+            if (nConnectedness == 8 && iX < nXSize - 1)
+                Merge(iX + 1, iX);
+        }
+    };
+
+    if (!RunJobs(nStrips - 1, StitchSeam, 0.25, 0.0))
+        return ReportErrors();
+
+    /* -------------------------------------------------------------------- */
+    /*      Map polygon ids of each strip to their final global id, and     */
+    /*      reduce polygon sizes.                                           */
+    /* -------------------------------------------------------------------- */
+    std::vector<int> anPolySizes(nPolygons);
+    std::vector<std::int64_t> anPolyValue(nPolygons);
+    for (auto &poStrip : apoStrips)
+    {
+        const auto &oEnum = poStrip->oFirstEnum;
+        poStrip->anGlobalId.resize(oEnum.nNextPolygonId);
+        for (int i = 0; i < oEnum.nNextPolygonId; i++)
+        {
+            const GInt32 nId = GSFindRoot(
+                anParent, poStrip->nIdOffset + oEnum.panPolyIdMap[i]);
+            poStrip->anGlobalId[i] = nId;
+            anPolyValue[nId] = oEnum.panPolyValue[i];
+
+            const GIntBig nSize = static_cast<GIntBig>(anPolySizes[nId]) +
+                                  poStrip->anPolySizes[i];
+            anPolySizes[nId] = static_cast<int>(
+                std::min<GIntBig>(nSize, MY_MAX_INT));
+        }
+        poStrip->anPolySizes.clear();
+        poStrip->anPolySizes.shrink_to_fit();
+    }
+
+    int nFinalPolyCount = 0;
+    for (size_t i = 0; i < nPolygons; i++)
+    {
+        if (anParent[i].load() == static_cast<GInt32>(i))
+            nFinalPolyCount++;
+    }
+    CPLDebug("GDALSieveFilter",
+             "Counted " CPL_FRMT_GIB " polygon fragments in %d strips "
+             "forming %d final polygons.",
+             nTotalPolygons, nStrips, nFinalPolyCount);
+
+    /* ==================================================================== */
+    /*      Second pass ... identify the largest neighbour for each         */
+    /*      polygon, strip by strip.                                        */
+    /* ==================================================================== */
+    const auto UpdateBigNeighbour =
+        [&anPolySizes](GSNeighbour &oNeighbour, GInt32 nId, GIntBig nPos)
+    {
+        if (oNeighbour.nId == -1 ||
+            anPolySizes[oNeighbour.nId] < anPolySizes[nId])
+        {
+            oNeighbour.nId = nId;
+            oNeighbour.nPos = nPos;
+        }
+    };
+
+    const auto FindStripNeighbours = [&](int iStrip)
+    {
+        GSStrip &oStrip = *(apoStrips[iStrip]);
+        const GInt32 *panPolyIdMap = oStrip.oFirstEnum.panPolyIdMap;
+        oStrip.aoBigNeighbour.resize(oStrip.oFirstEnum.nNextPolygonId);
+
+        GDALRasterPolygonEnumerator oSecondEnum(nConnectedness);
+        std::vector<std::int64_t> anLastLineVal(nXSize);
+        std::vector<std::int64_t> anThisLineVal(nXSize);
+        std::vector<GInt32> anLastLineId(nXSize);
+        std::vector<GInt32> anThisLineId(nXSize);
+        std::vector<GByte> abyMaskLine(nXSize);
+
+        // Compare the polygon of pixel iX of the current line, with
+        // the one of pixel iOtherX of the previous or current line.
+        const auto CompareNeighbourMT =
+            [&](int iX, GInt32 nOtherId, bool bOtherInStrip, GIntBig nPos)
+        {
+            if (anThisLineId[iX] < 0 || nOtherId < 0)
+                return;
+            const GInt32 nLocalId = panPolyIdMap[anThisLineId[iX]];
+            const GInt32 nPolyId1 = oStrip.anGlobalId[nLocalId];
+            const GInt32 nPolyId2 =
+                bOtherInStrip
+                    ? oStrip.anGlobalId[panPolyIdMap[nOtherId]]
+                    : nOtherId;
+            if (nPolyId1 == nPolyId2)
+                return;
+
+            UpdateBigNeighbour(oStrip.aoBigNeighbour[nLocalId], nPolyId2,
+                               nPos);
+            if (bOtherInStrip)
+            {
+                UpdateBigNeighbour(
+                    oStrip.aoBigNeighbour[panPolyIdMap[nOtherId]], nPolyId1,
+                    nPos);
+            }
+            else
+            {
+                GSNeighbour oNeighbour;
+                UpdateBigNeighbour(oNeighbour, nPolyId1, nPos);
+                oStrip.aoSeamBigNeighbour.emplace_back(nPolyId2, oNeighbour);
+            }
+        };
+
+        // Global ids of the last line of the previous strip.
+        std::vector<GInt32> anSeamLineId;
+        if (iStrip > 0)
+        {
+            const GSStrip &oPrevStrip = *(apoStrips[iStrip - 1]);
+            anSeamLineId.resize(nXSize);
+            for (int iX = 0; iX < nXSize; iX++)
+            {
+                const GInt32 nId = oPrevStrip.anLastLineId[iX];
+                anSeamLineId[iX] =
+                    nId < 0 ? -1
+                            : oPrevStrip.anGlobalId
+                                  [oPrevStrip.oFirstEnum.panPolyIdMap[nId]];
+            }
+        }
+
+        const int nYEnd = oStrip.nYOff + oStrip.nYSize;
+        for (int iY = oStrip.nYOff; iY < nYEnd && !bStop; iY++)
+        {
+            oStrip.eErr =
+                ReadLine(iY, anThisLineVal.data(), abyMaskLine.data());
+            if (oStrip.eErr != CE_None)
+                return;
+
+            const bool bFirstLine = iY == oStrip.nYOff;
+            if (!oSecondEnum.ProcessLine(
+                    bFirstLine ? nullptr : anLastLineVal.data(),
+                    anThisLineVal.data(),
+                    bFirstLine ? nullptr : anLastLineId.data(),
+                    anThisLineId.data(), nXSize))
+            {
+                oStrip.eErr = CE_Failure;
+                return;
+            }
+
+            // Same comparisons, in the same order, as in the
+            // single-threaded version.
+            const bool bHasLastLine = !bFirstLine || iStrip > 0;
+            const GInt32 *panOtherLineId =
+                bFirstLine ? anSeamLineId.data() : anLastLineId.data();
+            for (int iX = 0; iX < nXSize; iX++)
+            {
+                const GIntBig nPos =
+                    (static_cast<GIntBig>(iY) * nXSize + iX) * 4;
+                if (bHasLastLine)
+                {
+                    CompareNeighbourMT(iX, panOtherLineId[iX], !bFirstLine,
+                                       nPos);
+
+                    if (iX > 0 && nConnectedness == 8)
+                        CompareNeighbourMT(iX, panOtherLineId[iX - 1],
+                                           !bFirstLine, nPos + 1);
+
+                    if (iX < nXSize - 1 && nConnectedness == 8)
+                        CompareNeighbourMT(iX, panOtherLineId[iX + 1],
+                                           !bFirstLine, nPos + 2);
+                }
+
+                if (iX > 0)
+                    CompareNeighbourMT(iX, anThisLineId[iX - 1], true,
+                                       nPos + 3);
+            }
+
+            std::swap(anLastLineVal, anThisLineVal);
+            std::swap(anLastLineId, anThisLineId);
+
+            NotifyLineProcessed();
+        }
+    };
+
+    if (!RunJobs(nStrips, FindStripNeighbours, 0.25, 0.25))
+        return ReportErrors();
+
+    /* -------------------------------------------------------------------- */
+    /*      Reduce the largest neighbours found in each strip, retaining    */
+    /*      the first largest one in scan order.                            */
+    /* -------------------------------------------------------------------- */
+    std::vector<int> anBigNeighbour(nPolygons, -1);
+    {
+        std::vector<GIntBig> anBigNeighbourPos(nPolygons);
+        const auto Reduce = [&](GInt32 nId, const GSNeighbour &oNeighbour)
+        {
+            if (oNeighbour.nId < 0)
+                return;
+            const int nCur = anBigNeighbour[nId];
+            if (nCur == -1 || anPolySizes[nCur] < anPolySizes[oNeighbour.nId] ||
+                (anPolySizes[nCur] == anPolySizes[oNeighbour.nId] &&
+                 oNeighbour.nPos < anBigNeighbourPos[nId]))
+            {
+                anBigNeighbour[nId] = oNeighbour.nId;
+                anBigNeighbourPos[nId] = oNeighbour.nPos;
+            }
+        };
+        for (auto &poStrip : apoStrips)
+        {
+            const GInt32 *panPolyIdMap = poStrip->oFirstEnum.panPolyIdMap;
+            for (int i = 0; i < poStrip->oFirstEnum.nNextPolygonId; i++)
+            {
+                if (panPolyIdMap[i] == i)
+                    Reduce(poStrip->anGlobalId[i], poStrip->aoBigNeighbour[i]);
+            }
+            for (const auto &oSeamNeighbour : poStrip->aoSeamBigNeighbour)
+                Reduce(oSeamNeighbour.first, oSeamNeighbour.second);
+            poStrip->aoBigNeighbour.clear();
+            poStrip->aoBigNeighbour.shrink_to_fit();
+            poStrip->aoSeamBigNeighbour.clear();
+            poStrip->aoSeamBigNeighbour.shrink_to_fit();
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      If our biggest neighbour is still smaller than the              */
+    /*      threshold, then try tracking to that polygons biggest           */
+    /*      neighbour, and so forth.                                        */
+    /* -------------------------------------------------------------------- */
+    int nFailedMerges = 0;
+    int nIsolatedSmall = 0;
+    int nSieveTargets = 0;
+
+    for (size_t iPoly = 0; iPoly < nPolygons; iPoly++)
+    {
+        if (anParent[iPoly].load() != static_cast<GInt32>(iPoly))
+            continue;
+
+        GSResolveBigNeighbour(static_cast<int>(iPoly), anPolySizes,
+                              anBigNeighbour, nSizeThreshold, nSieveTargets,
+                              nIsolatedSmall, nFailedMerges);
+    }
+
+    CPLDebug("GDALSieveFilter",
+             "Small Polygons: %d, Isolated: %d, Unmergable: %d", nSieveTargets,
+             nIsolatedSmall, nFailedMerges);
+
+    /* ==================================================================== */
+    /*      Third pass, applying the merges strip by strip.                 */
+    /* ==================================================================== */
+    const auto ApplyStripMerges = [&](int iStrip)
+    {
+        GSStrip &oStrip = *(apoStrips[iStrip]);
+        const GInt32 *panPolyIdMap = oStrip.oFirstEnum.panPolyIdMap;
+
+        GDALRasterPolygonEnumerator oThirdEnum(nConnectedness);
+        std::vector<std::int64_t> anLastLineVal(nXSize);
+        std::vector<std::int64_t> anThisLineVal(nXSize);
+        std::vector<std::int64_t> anThisLineWriteVal(nXSize);
+        std::vector<GInt32> anLastLineId(nXSize);
+        std::vector<GInt32> anThisLineId(nXSize);
+        std::vector<GByte> abyMaskLine(nXSize);
+
+        const int nYEnd = oStrip.nYOff + oStrip.nYSize;
+        for (int iY = oStrip.nYOff; iY < nYEnd && !bStop; iY++)
+        {
+            oStrip.eErr = ReadLine(iY, anThisLineVal.data(), abyMaskLine.data(),
+                                   anThisLineWriteVal.data());
+            if (oStrip.eErr != CE_None)
+                return;
+
+            const bool bFirstLine = iY == oStrip.nYOff;
+            oThirdEnum.ProcessLine(bFirstLine ? nullptr : anLastLineVal.data(),
+                                   anThisLineVal.data(),
+                                   bFirstLine ? nullptr : anLastLineId.data(),
+                                   anThisLineId.data(), nXSize);
+
+            for (int iX = 0; iX < nXSize; iX++)
+            {
+                int iThisPoly = anThisLineId[iX];
+                if (iThisPoly >= 0)
+                {
+                    iThisPoly = oStrip.anGlobalId[panPolyIdMap[iThisPoly]];
+
+                    if (anBigNeighbour[iThisPoly] != -1)
+                    {
+                        anThisLineWriteVal[iX] =
+                            anPolyValue[anBigNeighbour[iThisPoly]];
+                    }
+                }
+            }
+
+            {
+                std::lock_guard oLock(oIOMutex);
+                oStrip.eErr = GDALRasterIO(hDstBand, GF_Write, 0, iY, nXSize,
+                                           1, anThisLineWriteVal.data(),
+                                           nXSize, 1, GDT_Int64, 0, 0);
+            }
+            if (oStrip.eErr != CE_None)
+                return;
+
+            std::swap(anLastLineVal, anThisLineVal);
+            std::swap(anLastLineId, anThisLineId);
+
+            NotifyLineProcessed();
+        }
+    };
+
+    if (!RunJobs(nStrips, ApplyStripMerges, 0.5, 0.5))
+        return ReportErrors();
+
+    oErrorAccumulator.ReplayErrors();
+    return CE_None;
+}
+
 /************************************************************************/
 /*                          GDALSieveFilter()                           */
 /************************************************************************/
@@ -156,6 +921,11 @@ static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
  * extremely noisy rasters with many one pixel polygons will end up being
  * expensive (in memory) to process.
  *
+ * Starting with GDAL 3.12, when the GDAL_NUM_THREADS configuration option is
+ * set to a value greater than one, the raster is split into horizontal strips
+ * whose polygons are enumerated in parallel, and merged across strip
+ * boundaries. The result is identical to the single-threaded one.
+ *
  * @param hSrcBand the source raster band to be processed.
  * @param hMaskBand an optional mask band.  All pixels in the mask band with a
  * value other than zero will be considered suitable for inclusion in polygons.
@@ -189,11 +959,27 @@ CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
     if (pfnProgress == nullptr)
         pfnProgress = GDALDummyProgress;
 
+    int nXSize = GDALGetRasterBandXSize(hSrcBand);
+    int nYSize = GDALGetRasterBandYSize(hSrcBand);
+
+    /* -------------------------------------------------------------------- */
+    /*      Process horizontal strips in parallel if GDAL_NUM_THREADS       */
+    /*      allows it.                                                      */
+    /* -------------------------------------------------------------------- */
+    const int nThreads =
+        GDALGetNumThreads(std::max(1, nYSize / GS_MIN_STRIP_HEIGHT));
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    if (poThreadPool)
+    {
+        return GDALSieveFilterMT(hSrcBand, hMaskBand, hDstBand, nSizeThreshold,
+                                 nConnectedness, poThreadPool, nThreads,
+                                 pfnProgress, pProgressArg);
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Allocate working buffers.                                       */
     /* -------------------------------------------------------------------- */
-    int nXSize = GDALGetRasterBandXSize(hSrcBand);
-    int nYSize = GDALGetRasterBandYSize(hSrcBand);
     auto panLastLineValKeeper = std::unique_ptr<std::int64_t, VSIFreeReleaser>(
         static_cast<std::int64_t *>(
             VSI_MALLOC2_VERBOSE(sizeof(std::int64_t), nXSize)));
@@ -481,63 +1267,9 @@ CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
         if (oFirstEnum.panPolyValue[iPoly] == GP_NODATA_MARKER)
             continue;
 
-        // Don't try to merge polygons larger than the threshold.
-        if (anPolySizes[iPoly] >= nSizeThreshold)
-        {
-            anBigNeighbour[iPoly] = -1;
-            continue;
-        }
-
-        nSieveTargets++;
-
-        // if we have no neighbours but we are small, what shall we do?
-        if (anBigNeighbour[iPoly] == -1)
-        {
-            nIsolatedSmall++;
-            continue;
-        }
-
-        std::set<int> oSetVisitedPoly;
-        oSetVisitedPoly.insert(iPoly);
-
-        // Walk through our neighbours until we find a polygon large enough.
-        int iFinalId = iPoly;
-        bool bFoundBigEnoughPoly = false;
-        while (true)
-        {
-            iFinalId = anBigNeighbour[iFinalId];
-            if (iFinalId < 0)
-            {
-                break;
-            }
-            // If the biggest neighbour is larger than the threshold
-            // then we are golden.
-            if (anPolySizes[iFinalId] >= nSizeThreshold)
-            {
-                bFoundBigEnoughPoly = true;
-                break;
-            }
-            // Check that we don't cycle on an already visited polygon.
-            if (oSetVisitedPoly.find(iFinalId) != oSetVisitedPoly.end())
-                break;
-            oSetVisitedPoly.insert(iFinalId);
-        }
-
-        if (!bFoundBigEnoughPoly)
-        {
-            nFailedMerges++;
-            anBigNeighbour[iPoly] = -1;
-            continue;
-        }
-
-        // Map the whole intermediate chain to it.
-        int iPolyCur = iPoly;
-        while (anBigNeighbour[iPolyCur] != iFinalId)
-        {
-            int iNextPoly = anBigNeighbour[iPolyCur];
-            anBigNeighbour[iPolyCur] = iFinalId;
-            iPolyCur = iNextPoly;
-        }
+        GSResolveBigNeighbour(iPoly, anPolySizes, anBigNeighbour,
+                              nSizeThreshold, nSieveTargets, nIsolatedSmall,
+                              nFailedMerges);
     }
 
     CPLDebug("GDALSieveFilter",
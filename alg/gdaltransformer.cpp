@@ -47,6 +47,7 @@ void *GDALDeserializeTPSTransformer(CPLXMLNode *psTree);
 void *GDALDeserializeGeoLocTransformer(CPLXMLNode *psTree);
 void *GDALDeserializeRPCTransformer(CPLXMLNode *psTree);
 void *GDALDeserializeHomographyTransformer(CPLXMLNode *psTree);
+void *GDALDeserializeWarpPlanTransformer(CPLXMLNode *psTree);
 CPL_C_END
 
 static CPLXMLNode *GDALSerializeReprojectionTransformer(void *pTransformArg);
@@ -4755,6 +4756,11 @@ CPLErr GDALDeserializeTransformer(CPLXMLNode *psTree,
         *ppfnFunc = GDALHomographyTransform;
         *ppTransformArg = GDALDeserializeHomographyTransformer(psTree);
     }
+    else if (EQUAL(psTree->pszValue, "WarpPlanTransformer"))
+    {
+        *ppfnFunc = GDALWarpPlanTransform;
+        *ppTransformArg = GDALDeserializeWarpPlanTransformer(psTree);
+    }
     else
     {
         GDALTransformDeserializeFunc pfnDeserializeFunc = nullptr;
@@ -1265,6 +1265,12 @@ const char *GDALWarpGetOptionList(void)
            "  <Value>MIN</Value>"
            "  <Value>MAX</Value>"
            "</Option>"
+           "<Option name='WARP_PLAN' type='string' description='"
+           "Filename of a warp plan, storing the source pixel/line location "
+           "of each target pixel. It is created from the transformer if it "
+           "does not exist yet, and used instead of the transformer "
+           "otherwise. Source and target datasets must have the same grid "
+           "as the ones the plan was created for.'/>"
            "</OptionList>";
 }
 
@@ -1503,6 +1509,17 @@ const char *GDALWarpGetOptionList(void)
  * ties with MODE resampling. By default, the first value encountered will be used.
  * Alternatively, the minimum or maximum value can be selected.</li>
  *
+ * <li>WARP_PLAN=filename: (GDAL >= 3.12) Filename of a warp plan, that is a
+ * GeoTIFF file storing the source pixel/line location of the center of each
+ * target pixel, as created by GDALCreateWarpPlan(). If the file does not
+ * exist, it is created from the transformer. Otherwise, the transformer is
+ * replaced by the one returned by GDALCreateWarpPlanTransformer(), which
+ * avoids any coordinate transformation computation. This is useful when
+ * warping many source datasets sharing the same grid (dimensions,
+ * geotransform and CRS) onto the same target grid. An error is emitted if
+ * the source or target dataset does not match the grids the plan was
+ * created for.</li>
+ *
  * </ul>
  */
 
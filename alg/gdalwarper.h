@@ -508,9 +508,11 @@ class CPL_DLL GDALWarpOperation final
   private:
     GDALWarpOptions *psOptions = nullptr;
     GDALTransformerArgUniquePtr m_psOwnedTransformerArg{nullptr};
+    GDALTransformerArgUniquePtr m_psWarpPlanTransformerArg{nullptr};
 
     void WipeOptions();
     int ValidateOptions();
+    CPLErr SetupWarpPlan(const char *pszFilename);
 
     bool ComputeSourceWindowTransformPoints(
         int nDstXOff, int nDstYOff, int nDstXSize, int nDstYSize, bool bUseGrid,
@@ -661,6 +661,21 @@ GDALWarpOperation::Initialize(const GDALWarpOptions *psNewOptions,
     if (!ValidateOptions())
         eErr = CE_Failure;
 
+    /* -------------------------------------------------------------------- */
+    /*      Substitute the transformer with a warp plan if asked to.        */
+    /* -------------------------------------------------------------------- */
+    GDALTransformerFunc pfnOriginalTransformer = nullptr;
+    void *pOriginalTransformerArg = nullptr;
+    if (eErr == CE_None)
+    {
+        pfnOriginalTransformer = psOptions->pfnTransformer;
+        pOriginalTransformerArg = psOptions->pTransformerArg;
+        const char *pszWarpPlan =
+            CSLFetchNameValue(psOptions->papszWarpOptions, "WARP_PLAN");
+        if (pszWarpPlan && SetupWarpPlan(pszWarpPlan) != CE_None)
+            eErr = CE_Failure;
+    }
+
     if (eErr != CE_None)
     {
         WipeOptions();
@@ -684,14 +699,14 @@ GDALWarpOperation::Initialize(const GDALWarpOptions *psNewOptions,
         for (double dfY : {-89.9999, 89.9999})
         {
             double dfX = 0;
-            if ((GDALIsTransformer(psOptions->pTransformerArg,
+            if ((GDALIsTransformer(pOriginalTransformerArg,
                                    GDAL_APPROX_TRANSFORMER_CLASS_NAME) &&
                  GDALTransformLonLatToDestApproxTransformer(
-                     psOptions->pTransformerArg, &dfX, &dfY)) ||
-                (GDALIsTransformer(psOptions->pTransformerArg,
+                     pOriginalTransformerArg, &dfX, &dfY)) ||
+                (GDALIsTransformer(pOriginalTransformerArg,
                                    GDAL_GEN_IMG_TRANSFORMER_CLASS_NAME) &&
                  GDALTransformLonLatToDestGenImgProjTransformer(
-                     psOptions->pTransformerArg, &dfX, &dfY)))
+                     pOriginalTransformerArg, &dfX, &dfY)))
             {
                 aDstXYSpecialPoints.emplace_back(
                     std::pair<double, double>(dfX, dfY));
@@ -700,7 +715,7 @@ GDALWarpOperation::Initialize(const GDALWarpOptions *psNewOptions,
 
         m_bIsTranslationOnPixelBoundaries =
             GDALTransformIsTranslationOnPixelBoundaries(
-                psOptions->pfnTransformer, psOptions->pTransformerArg) &&
+                pfnOriginalTransformer, pOriginalTransformerArg) &&
             CPLTestBool(
                 CPLGetConfigOption("GDAL_WARP_USE_TRANSLATION_OPTIM", "YES"));
         if (m_bIsTranslationOnPixelBoundaries)
@@ -713,6 +728,47 @@ GDALWarpOperation::Initialize(const GDALWarpOptions *psNewOptions,
     return eErr;
 }
 
+/************************************************************************/
+/*                           SetupWarpPlan()                            */
+/************************************************************************/
+
+// Creates the warp plan pszFilename from the current transformer if it does
+// not exist yet, and substitutes the transformer with the one of the plan.
+CPLErr GDALWarpOperation::SetupWarpPlan(const char *pszFilename)
+{
+    if (psOptions->hSrcDS == nullptr || psOptions->hDstDS == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "WARP_PLAN requires source and destination datasets");
+        return CE_Failure;
+    }
+
+    VSIStatBufL sStat;
+    if (VSIStatL(pszFilename, &sStat) != 0)
+    {
+        CPLDebug("WARP", "Creating warp plan %s", pszFilename);
+        if (GDALCreateWarpPlan(pszFilename, psOptions->hSrcDS,
+                               psOptions->hDstDS, psOptions->pfnTransformer,
+                               psOptions->pTransformerArg, nullptr, nullptr,
+                               nullptr) != CE_None)
+        {
+            return CE_Failure;
+        }
+    }
+    else
+    {
+        CPLDebug("WARP", "Using warp plan %s", pszFilename);
+    }
+
+    m_psWarpPlanTransformerArg.reset(GDALCreateWarpPlanTransformer(
+        pszFilename, psOptions->hSrcDS, psOptions->hDstDS));
+    if (!m_psWarpPlanTransformerArg)
+        return CE_Failure;
+    psOptions->pfnTransformer = GDALWarpPlanTransform;
+    psOptions->pTransformerArg = m_psWarpPlanTransformerArg.get();
+    return CE_None;
+}
+
 /**
  * \fn void* GDALWarpOperation::CreateDestinationBuffer(
             int nDstXSize, int nDstYSize, int *pbInitialized);
@@ -0,0 +1,726 @@
+/******************************************************************************
+ *
+ * Project:  GDAL
+ * Purpose:  Warp plan: precomputed destination to source coordinate map.
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "cpl_port.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "cpl_conv.h"
+#include "cpl_error.h"
+#include "cpl_minixml.h"
+#include "cpl_string.h"
+#include "cpl_vsi.h"
+#include "gdal.h"
+#include "gdal_alg.h"
+#include "ogr_srs_api.h"
+
+CPL_C_START
+CPLXMLNode *GDALSerializeWarpPlanTransformer(void *pTransformArg);
+void *GDALDeserializeWarpPlanTransformer(CPLXMLNode *psTree);
+CPL_C_END
+
+constexpr const char *WARP_PLAN_VERSION_ITEM = "WARP_PLAN_VERSION";
+constexpr const char *WARP_PLAN_VERSION = "1";
+
+namespace
+{
+struct WarpPlanCachedLine
+{
+    int nLine = -1;
+    GUIntBig nLastUse = 0;
+    std::vector<double> adfX{};
+    std::vector<double> adfY{};
+};
+}  // namespace
+
+struct WarpPlanTransformInfo
+{
+    GDALTransformerInfo sTI{};
+
+    std::string osFilename{};
+    GDALDatasetH hDS = nullptr;
+    int nXSize = 0;
+    int nYSize = 0;
+
+    // Ratio between the size of the source raster the plan was computed for
+    // and the one it is applied to (e.g. when warping from an overview).
+    double dfRatioX = 1.0;
+    double dfRatioY = 1.0;
+
+    // Most recently used lines of the coordinate map. The warp kernel
+    // transforms destination lines one after the other, so a few lines are
+    // enough.
+    std::array<WarpPlanCachedLine, 4> aoCache{};
+    GUIntBig nUseCounter = 0;
+};
+
+static void *GDALCreateSimilarWarpPlanTransformer(void *hTransformArg,
+                                                  double dfRatioX,
+                                                  double dfRatioY);
+
+/************************************************************************/
+/*                          GDALWarpPlanOpen()                          */
+/************************************************************************/
+
+static WarpPlanTransformInfo *GDALWarpPlanOpen(const char *pszFilename)
+{
+    GDALDatasetH hDS =
+        GDALOpenEx(pszFilename, GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR,
+                   nullptr, nullptr, nullptr);
+    if (hDS == nullptr)
+        return nullptr;
+
+    const char *pszVersion =
+        GDALGetMetadataItem(hDS, WARP_PLAN_VERSION_ITEM, nullptr);
+    if (GDALGetRasterCount(hDS) != 2 || pszVersion == nullptr ||
+        GDALGetRasterDataType(GDALGetRasterBand(hDS, 1)) != GDT_Float64 ||
+        GDALGetRasterDataType(GDALGetRasterBand(hDS, 2)) != GDT_Float64)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "%s is not a warp plan",
+                 pszFilename);
+        GDALClose(hDS);
+        return nullptr;
+    }
+    if (!EQUAL(pszVersion, WARP_PLAN_VERSION))
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "%s: unsupported warp plan version %s", pszFilename,
+                 pszVersion);
+        GDALClose(hDS);
+        return nullptr;
+    }
+
+    WarpPlanTransformInfo *psInfo = new WarpPlanTransformInfo();
+
+    memcpy(psInfo->sTI.abySignature, GDAL_GTI2_SIGNATURE,
+           strlen(GDAL_GTI2_SIGNATURE));
+    psInfo->sTI.pszClassName = "GDALWarpPlanTransformer";
+    psInfo->sTI.pfnTransform = GDALWarpPlanTransform;
+    psInfo->sTI.pfnCleanup = GDALDestroyWarpPlanTransformer;
+    psInfo->sTI.pfnSerialize = GDALSerializeWarpPlanTransformer;
+    psInfo->sTI.pfnCreateSimilar = GDALCreateSimilarWarpPlanTransformer;
+
+    psInfo->osFilename = pszFilename;
+    psInfo->hDS = hDS;
+    psInfo->nXSize = GDALGetRasterXSize(hDS);
+    psInfo->nYSize = GDALGetRasterYSize(hDS);
+
+    return psInfo;
+}
+
+/************************************************************************/
+/*               GDALCreateSimilarWarpPlanTransformer()                 */
+/************************************************************************/
+
+static void *GDALCreateSimilarWarpPlanTransformer(void *hTransformArg,
+                                                  double dfRatioX,
+                                                  double dfRatioY)
+{
+    VALIDATE_POINTER1(hTransformArg, "GDALCreateSimilarWarpPlanTransformer",
+                      nullptr);
+
+    const WarpPlanTransformInfo *psInfo =
+        static_cast<const WarpPlanTransformInfo *>(hTransformArg);
+
+    // Each instance has its own dataset handle, so that clones can be used
+    // concurrently by the warping threads.
+    WarpPlanTransformInfo *psNewInfo =
+        GDALWarpPlanOpen(psInfo->osFilename.c_str());
+    if (psNewInfo)
+    {
+        psNewInfo->dfRatioX = psInfo->dfRatioX * dfRatioX;
+        psNewInfo->dfRatioY = psInfo->dfRatioY * dfRatioY;
+    }
+    return psNewInfo;
+}
+
+/************************************************************************/
+/*                      GDALWarpPlanGetLine()                           */
+/************************************************************************/
+
+static const WarpPlanCachedLine *
+GDALWarpPlanGetLine(WarpPlanTransformInfo *psInfo, int nLine)
+{
+    ++psInfo->nUseCounter;
+
+    WarpPlanCachedLine *poLRU = &psInfo->aoCache[0];
+    for (auto &oLine : psInfo->aoCache)
+    {
+        if (oLine.nLine == nLine)
+        {
+            oLine.nLastUse = psInfo->nUseCounter;
+            return &oLine;
+        }
+        if (oLine.nLastUse < poLRU->nLastUse)
+            poLRU = &oLine;
+    }
+
+    try
+    {
+        poLRU->adfX.resize(psInfo->nXSize);
+        poLRU->adfY.resize(psInfo->nXSize);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALWarpPlanTransform()");
+        return nullptr;
+    }
+    poLRU->nLine = -1;
+    if (GDALRasterIO(GDALGetRasterBand(psInfo->hDS, 1), GF_Read, 0, nLine,
+                     psInfo->nXSize, 1, poLRU->adfX.data(), psInfo->nXSize, 1,
+                     GDT_Float64, 0, 0) != CE_None ||
+        GDALRasterIO(GDALGetRasterBand(psInfo->hDS, 2), GF_Read, 0, nLine,
+                     psInfo->nXSize, 1, poLRU->adfY.data(), psInfo->nXSize, 1,
+                     GDT_Float64, 0, 0) != CE_None)
+    {
+        return nullptr;
+    }
+    poLRU->nLine = nLine;
+    poLRU->nLastUse = psInfo->nUseCounter;
+    return poLRU;
+}
+
+/************************************************************************/
+/*                    AreGeoTransformsEqual()                           */
+/************************************************************************/
+
+static bool AreGeoTransformsEqual(const double *padfGT1, const double *padfGT2)
+{
+    for (int i = 0; i < 6; ++i)
+    {
+        const double dfTol =
+            1e-10 * std::max(1.0, std::max(std::fabs(padfGT1[i]),
+                                           std::fabs(padfGT2[i])));
+        if (!(std::fabs(padfGT1[i] - padfGT2[i]) <= dfTol))
+            return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                         AreSRSEqual()                                */
+/************************************************************************/
+
+static bool AreSRSEqual(OGRSpatialReferenceH hSRS1, OGRSpatialReferenceH hSRS2)
+{
+    if (hSRS1 == nullptr || hSRS2 == nullptr)
+        return hSRS1 == hSRS2;
+    return OSRIsSame(hSRS1, hSRS2) != FALSE;
+}
+
+/************************************************************************/
+/*                        GDALCreateWarpPlan()                          */
+/************************************************************************/
+
+/**
+ * Create a warp plan.
+ *
+ * A warp plan stores, for the center of each pixel of the destination
+ * dataset, the corresponding source pixel/line location computed with
+ * the provided transformer. It can be applied afterwards, through
+ * GDALCreateWarpPlanTransformer(), to any source dataset with the same
+ * grid (size, geotransform and CRS) as hSrcDS and any destination dataset
+ * with the same grid as hDstDS, without calling the transformer again.
+ *
+ * The plan is written as a 2-band Float64 GeoTIFF file, with the
+ * georeferencing of the destination dataset. Points that failed to
+ * transform are set to NaN.
+ *
+ * This is what the WARP_PLAN warping option of GDALWarpOptions uses.
+ *
+ * @param pszFilename output filename.
+ * @param hSrcDS source dataset.
+ * @param hDstDS destination dataset.
+ * @param pfnTransformer transformer function from destination pixel/line
+ * to source pixel/line coordinates (bDstToSrc = TRUE).
+ * @param pTransformArg argument of pfnTransformer.
+ * @param papszOptions unused currently. Should be NULL.
+ * @param pfnProgress a GDALProgressFunc() compatible callback function for
+ * reporting progress or NULL.
+ * @param pProgressArg argument to be passed to pfnProgress. May be NULL.
+ *
+ * @return CE_None on success or CE_Failure if an error occurs.
+ *
+ * @since GDAL 3.12
+ */
+
+CPLErr GDALCreateWarpPlan(const char *pszFilename, GDALDatasetH hSrcDS,
+                          GDALDatasetH hDstDS,
+                          GDALTransformerFunc pfnTransformer,
+                          void *pTransformArg,
+                          CPL_UNUSED CSLConstList papszOptions,
+                          GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    VALIDATE_POINTER1(pszFilename, "GDALCreateWarpPlan", CE_Failure);
+    VALIDATE_POINTER1(hSrcDS, "GDALCreateWarpPlan", CE_Failure);
+    VALIDATE_POINTER1(hDstDS, "GDALCreateWarpPlan", CE_Failure);
+    VALIDATE_POINTER1(pfnTransformer, "GDALCreateWarpPlan", CE_Failure);
+
+    GDALDriverH hDriver = GDALGetDriverByName("GTiff");
+    if (hDriver == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "GDALCreateWarpPlan() requires the GTiff driver");
+        return CE_Failure;
+    }
+
+    const int nXSize = GDALGetRasterXSize(hDstDS);
+    const int nYSize = GDALGetRasterYSize(hDstDS);
+
+    // Write to a temporary file first, so that a concurrent process does not
+    // pick up a partially written plan.
+    const std::string osTmpFilename = std::string(pszFilename) + ".tmp.tif";
+
+    CPLStringList aosCO;
+    aosCO.SetNameValue("TILED", "YES");
+    aosCO.SetNameValue("COMPRESS", "DEFLATE");
+    aosCO.SetNameValue("PREDICTOR", "3");
+    aosCO.SetNameValue("BIGTIFF", "IF_SAFER");
+    GDALDatasetH hPlanDS = GDALCreate(hDriver, osTmpFilename.c_str(), nXSize,
+                                      nYSize, 2, GDT_Float64, aosCO.List());
+    if (hPlanDS == nullptr)
+        return CE_Failure;
+
+    double adfGT[6];
+    if (GDALGetGeoTransform(hDstDS, adfGT) == CE_None)
+        GDALSetGeoTransform(hPlanDS, adfGT);
+    GDALSetSpatialRef(hPlanDS, GDALGetSpatialRef(hDstDS));
+
+    GDALSetMetadataItem(hPlanDS, WARP_PLAN_VERSION_ITEM, WARP_PLAN_VERSION,
+                        nullptr);
+    GDALSetMetadataItem(hPlanDS, "SRC_XSIZE",
+                        CPLSPrintf("%d", GDALGetRasterXSize(hSrcDS)), nullptr);
+    GDALSetMetadataItem(hPlanDS, "SRC_YSIZE",
+                        CPLSPrintf("%d", GDALGetRasterYSize(hSrcDS)), nullptr);
+    if (GDALGetGeoTransform(hSrcDS, adfGT) == CE_None)
+    {
+        GDALSetMetadataItem(
+            hPlanDS, "SRC_GEOTRANSFORM",
+            CPLSPrintf("%.17g,%.17g,%.17g,%.17g,%.17g,%.17g", adfGT[0],
+                       adfGT[1], adfGT[2], adfGT[3], adfGT[4], adfGT[5]),
+            nullptr);
+    }
+    if (OGRSpatialReferenceH hSrcSRS = GDALGetSpatialRef(hSrcDS))
+    {
+        char *pszWKT = nullptr;
+        const char *const apszWKTOptions[] = {"FORMAT=WKT2_2019", nullptr};
+        if (OSRExportToWktEx(hSrcSRS, &pszWKT, apszWKTOptions) == OGRERR_NONE)
+            GDALSetMetadataItem(hPlanDS, "SRC_SRS", pszWKT, nullptr);
+        CPLFree(pszWKT);
+    }
+
+    GDALRasterBandH hBandX = GDALGetRasterBand(hPlanDS, 1);
+    GDALRasterBandH hBandY = GDALGetRasterBand(hPlanDS, 2);
+    GDALSetDescription(hBandX, "source_pixel");
+    GDALSetDescription(hBandY, "source_line");
+    GDALSetRasterNoDataValue(hBandX, std::numeric_limits<double>::quiet_NaN());
+    GDALSetRasterNoDataValue(hBandY, std::numeric_limits<double>::quiet_NaN());
+
+    CPLErr eErr = CE_None;
+    std::vector<double> adfX, adfY, adfZ;
+    std::vector<int> abSuccess;
+    try
+    {
+        adfX.resize(nXSize);
+        adfY.resize(nXSize);
+        adfZ.resize(nXSize);
+        abSuccess.resize(nXSize);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALCreateWarpPlan()");
+        eErr = CE_Failure;
+    }
+
+    for (int iLine = 0; eErr == CE_None && iLine < nYSize; ++iLine)
+    {
+        for (int iCol = 0; iCol < nXSize; ++iCol)
+        {
+            adfX[iCol] = iCol + 0.5;
+            adfY[iCol] = iLine + 0.5;
+            adfZ[iCol] = 0.0;
+        }
+        pfnTransformer(pTransformArg, TRUE, nXSize, adfX.data(), adfY.data(),
+                       adfZ.data(), abSuccess.data());
+        for (int iCol = 0; iCol < nXSize; ++iCol)
+        {
+            if (!abSuccess[iCol] || std::isnan(adfX[iCol]) ||
+                std::isnan(adfY[iCol]))
+            {
+                adfX[iCol] = std::numeric_limits<double>::quiet_NaN();
+                adfY[iCol] = std::numeric_limits<double>::quiet_NaN();
+            }
+        }
+
+        eErr = GDALRasterIO(hBandX, GF_Write, 0, iLine, nXSize, 1, adfX.data(),
+                            nXSize, 1, GDT_Float64, 0, 0);
+        if (eErr == CE_None)
+            eErr = GDALRasterIO(hBandY, GF_Write, 0, iLine, nXSize, 1,
+                                adfY.data(), nXSize, 1, GDT_Float64, 0, 0);
+
+        if (eErr == CE_None && pfnProgress &&
+            !pfnProgress(static_cast<double>(iLine + 1) / nYSize, "",
+                         pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    if (GDALClose(hPlanDS) != CE_None)
+        eErr = CE_Failure;
+
+    if (eErr == CE_None &&
+        VSIRename(osTmpFilename.c_str(), pszFilename) != 0)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot rename %s to %s",
+                 osTmpFilename.c_str(), pszFilename);
+        eErr = CE_Failure;
+    }
+    if (eErr != CE_None)
+        VSIUnlink(osTmpFilename.c_str());
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                   GDALCreateWarpPlanTransformer()                    */
+/************************************************************************/
+
+/**
+ * Create a transformer from a warp plan.
+ *
+ * The transformer maps destination pixel/line coordinates to source
+ * pixel/line coordinates by bilinear interpolation of the coordinate map
+ * stored in the warp plan created by GDALCreateWarpPlan(), which is exact
+ * at the center of destination pixels. The reverse direction is not
+ * supported.
+ *
+ * If hSrcDS and/or hDstDS are provided, they are checked to be compatible
+ * with the datasets the plan has been computed for. hSrcDS may be an
+ * overview (or have any other resolution over the same extent) of the
+ * dataset the plan was computed for.
+ *
+ * Warp plan transformers are serializable.
+ *
+ * @param pszFilename warp plan filename.
+ * @param hSrcDS source dataset, or NULL.
+ * @param hDstDS destination dataset, or NULL.
+ *
+ * @return the transform argument or NULL if creation fails.
+ *
+ * @since GDAL 3.12
+ */
+
+void *GDALCreateWarpPlanTransformer(const char *pszFilename,
+                                    GDALDatasetH hSrcDS, GDALDatasetH hDstDS)
+{
+    VALIDATE_POINTER1(pszFilename, "GDALCreateWarpPlanTransformer", nullptr);
+
+    WarpPlanTransformInfo *psInfo = GDALWarpPlanOpen(pszFilename);
+    if (psInfo == nullptr)
+        return nullptr;
+
+    double adfGT[6];
+    double adfPlanGT[6];
+    const auto Mismatch = [psInfo, pszFilename](const char *pszWhat)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Warp plan %s does not match the %s", pszFilename, pszWhat);
+        GDALDestroyWarpPlanTransformer(psInfo);
+        return nullptr;
+    };
+
+    if (hDstDS)
+    {
+        const bool bHasGT = GDALGetGeoTransform(hDstDS, adfGT) == CE_None;
+        const bool bPlanHasGT =
+            GDALGetGeoTransform(psInfo->hDS, adfPlanGT) == CE_None;
+        if (GDALGetRasterXSize(hDstDS) != psInfo->nXSize ||
+            GDALGetRasterYSize(hDstDS) != psInfo->nYSize ||
+            bHasGT != bPlanHasGT ||
+            (bHasGT && !AreGeoTransformsEqual(adfGT, adfPlanGT)) ||
+            !AreSRSEqual(GDALGetSpatialRef(hDstDS),
+                         GDALGetSpatialRef(psInfo->hDS)))
+        {
+            return Mismatch("destination dataset");
+        }
+    }
+
+    if (hSrcDS)
+    {
+        const int nPlanSrcXSize =
+            atoi(CSLFetchNameValueDef(GDALGetMetadata(psInfo->hDS, nullptr),
+                                      "SRC_XSIZE", "0"));
+        const int nPlanSrcYSize =
+            atoi(CSLFetchNameValueDef(GDALGetMetadata(psInfo->hDS, nullptr),
+                                      "SRC_YSIZE", "0"));
+        const int nSrcXSize = GDALGetRasterXSize(hSrcDS);
+        const int nSrcYSize = GDALGetRasterYSize(hSrcDS);
+        if (nPlanSrcXSize <= 0 || nPlanSrcYSize <= 0 || nSrcXSize <= 0 ||
+            nSrcYSize <= 0)
+        {
+            return Mismatch("source dataset");
+        }
+        psInfo->dfRatioX = static_cast<double>(nPlanSrcXSize) / nSrcXSize;
+        psInfo->dfRatioY = static_cast<double>(nPlanSrcYSize) / nSrcYSize;
+
+        const char *pszPlanGT =
+            GDALGetMetadataItem(psInfo->hDS, "SRC_GEOTRANSFORM", nullptr);
+        const bool bHasGT = GDALGetGeoTransform(hSrcDS, adfGT) == CE_None;
+        if ((pszPlanGT != nullptr) != bHasGT)
+            return Mismatch("source dataset");
+        if (bHasGT)
+        {
+            const CPLStringList aosTokens(
+                CSLTokenizeString2(pszPlanGT, ",", 0));
+            if (aosTokens.size() != 6)
+                return Mismatch("source dataset");
+            for (int i = 0; i < 6; ++i)
+                adfPlanGT[i] = CPLAtof(aosTokens[i]);
+            // Express the geotransform of the plan at the resolution of
+            // hSrcDS.
+            adfPlanGT[1] *= psInfo->dfRatioX;
+            adfPlanGT[4] *= psInfo->dfRatioX;
+            adfPlanGT[2] *= psInfo->dfRatioY;
+            adfPlanGT[5] *= psInfo->dfRatioY;
+            if (!AreGeoTransformsEqual(adfGT, adfPlanGT))
+                return Mismatch("source dataset");
+        }
+
+        OGRSpatialReferenceH hPlanSrcSRS = nullptr;
+        if (const char *pszSRS =
+                GDALGetMetadataItem(psInfo->hDS, "SRC_SRS", nullptr))
+        {
+            hPlanSrcSRS = OSRNewSpatialReference(nullptr);
+            OSRSetAxisMappingStrategy(hPlanSrcSRS, OAMS_TRADITIONAL_GIS_ORDER);
+            if (OSRSetFromUserInput(hPlanSrcSRS, pszSRS) != OGRERR_NONE)
+            {
+                OSRDestroySpatialReference(hPlanSrcSRS);
+                return Mismatch("source dataset");
+            }
+        }
+        const bool bSameSRS =
+            AreSRSEqual(GDALGetSpatialRef(hSrcDS), hPlanSrcSRS);
+        if (hPlanSrcSRS)
+            OSRDestroySpatialReference(hPlanSrcSRS);
+        if (!bSameSRS)
+            return Mismatch("source dataset");
+    }
+
+    return psInfo;
+}
+
+/************************************************************************/
+/*                   GDALDestroyWarpPlanTransformer()                   */
+/************************************************************************/
+
+/**
+ * Destroy a warp plan transformer.
+ *
+ * This function is used to destroy information about a warp plan
+ * transformer created with GDALCreateWarpPlanTransformer().
+ *
+ * @param pTransformArg the transform arg previously returned by
+ * GDALCreateWarpPlanTransformer().
+ *
+ * @since GDAL 3.12
+ */
+
+void GDALDestroyWarpPlanTransformer(void *pTransformArg)
+
+{
+    if (pTransformArg == nullptr)
+        return;
+
+    WarpPlanTransformInfo *psInfo =
+        static_cast<WarpPlanTransformInfo *>(pTransformArg);
+    if (psInfo->hDS)
+        GDALClose(psInfo->hDS);
+    delete psInfo;
+}
+
+/************************************************************************/
+/*                       GDALWarpPlanTransform()                        */
+/************************************************************************/
+
+/**
+ * Transforms destination pixel/line coordinates into source pixel/line
+ * coordinates by looking up the warp plan.
+ *
+ * This function matches the GDALTransformerFunc signature. Only
+ * bDstToSrc = TRUE is supported.
+ *
+ * @param pTransformArg return value from GDALCreateWarpPlanTransformer().
+ * @param bDstToSrc must be TRUE.
+ * @param nPointCount the number of values in the x, y and z arrays.
+ * @param x array containing the X values to be transformed.
+ * @param y array containing the Y values to be transformed.
+ * @param z array containing the Z values to be transformed (unchanged).
+ * @param panSuccess array in which a flag indicating success (TRUE) or
+ * failure (FALSE) of the transformation are placed.
+ *
+ * @return TRUE if all points have been successfully transformed.
+ *
+ * @since GDAL 3.12
+ */
+
+int GDALWarpPlanTransform(void *pTransformArg, int bDstToSrc, int nPointCount,
+                          double *x, double *y, CPL_UNUSED double *z,
+                          int *panSuccess)
+{
+    VALIDATE_POINTER1(pTransformArg, "GDALWarpPlanTransform", 0);
+
+    WarpPlanTransformInfo *psInfo =
+        static_cast<WarpPlanTransformInfo *>(pTransformArg);
+
+    if (!bDstToSrc)
+    {
+        for (int i = 0; i < nPointCount; i++)
+            panSuccess[i] = FALSE;
+        return FALSE;
+    }
+
+    const double dfMaxCol = std::max(0, psInfo->nXSize - 2);
+    const double dfMaxLine = std::max(0, psInfo->nYSize - 2);
+
+    int ret = TRUE;
+    for (int i = 0; i < nPointCount; i++)
+    {
+        panSuccess[i] = FALSE;
+
+        // The plan is sampled at the center of destination pixels.
+        const double dfCol = x[i] - 0.5;
+        const double dfLine = y[i] - 0.5;
+        if (!std::isfinite(dfCol) || !std::isfinite(dfLine))
+        {
+            ret = FALSE;
+            continue;
+        }
+
+        // Bilinear interpolation, or linear extrapolation from the nearest
+        // cells beyond the edges.
+        const int iCol =
+            static_cast<int>(std::clamp(std::floor(dfCol), 0.0, dfMaxCol));
+        const int iLine =
+            static_cast<int>(std::clamp(std::floor(dfLine), 0.0, dfMaxLine));
+        const double dfFracX = psInfo->nXSize > 1 ? dfCol - iCol : 0.0;
+        const double dfFracY = psInfo->nYSize > 1 ? dfLine - iLine : 0.0;
+
+        double adfSrcX[2] = {0, 0};
+        double adfSrcY[2] = {0, 0};
+        const int nLines = dfFracY != 0.0 ? 2 : 1;
+        bool bOK = true;
+        for (int j = 0; bOK && j < nLines; ++j)
+        {
+            const WarpPlanCachedLine *poLine =
+                GDALWarpPlanGetLine(psInfo, iLine + j);
+            if (poLine == nullptr)
+            {
+                bOK = false;
+                break;
+            }
+            adfSrcX[j] = poLine->adfX[iCol];
+            adfSrcY[j] = poLine->adfY[iCol];
+            if (dfFracX != 0.0)
+            {
+                adfSrcX[j] +=
+                    dfFracX * (poLine->adfX[iCol + 1] - poLine->adfX[iCol]);
+                adfSrcY[j] +=
+                    dfFracX * (poLine->adfY[iCol + 1] - poLine->adfY[iCol]);
+            }
+        }
+        if (!bOK)
+        {
+            ret = FALSE;
+            continue;
+        }
+
+        double dfSrcX = adfSrcX[0];
+        double dfSrcY = adfSrcY[0];
+        if (nLines == 2)
+        {
+            dfSrcX += dfFracY * (adfSrcX[1] - adfSrcX[0]);
+            dfSrcY += dfFracY * (adfSrcY[1] - adfSrcY[0]);
+        }
+        if (std::isnan(dfSrcX) || std::isnan(dfSrcY))
+        {
+            ret = FALSE;
+            continue;
+        }
+
+        x[i] = dfSrcX / psInfo->dfRatioX;
+        y[i] = dfSrcY / psInfo->dfRatioY;
+        panSuccess[i] = TRUE;
+    }
+
+    return ret;
+}
+
+/************************************************************************/
+/*                  GDALSerializeWarpPlanTransformer()                  */
+/************************************************************************/
+
+CPLXMLNode *GDALSerializeWarpPlanTransformer(void *pTransformArg)
+
+{
+    VALIDATE_POINTER1(pTransformArg, "GDALSerializeWarpPlanTransformer",
+                      nullptr);
+
+    const WarpPlanTransformInfo *psInfo =
+        static_cast<const WarpPlanTransformInfo *>(pTransformArg);
+
+    CPLXMLNode *psTree =
+        CPLCreateXMLNode(nullptr, CXT_Element, "WarpPlanTransformer");
+
+    CPLCreateXMLElementAndValue(psTree, "Filename",
+                                psInfo->osFilename.c_str());
+    if (psInfo->dfRatioX != 1.0 || psInfo->dfRatioY != 1.0)
+    {
+        CPLCreateXMLElementAndValue(psTree, "RatioX",
+                                    CPLSPrintf("%.17g", psInfo->dfRatioX));
+        CPLCreateXMLElementAndValue(psTree, "RatioY",
+                                    CPLSPrintf("%.17g", psInfo->dfRatioY));
+    }
+
+    return psTree;
+}
+
+/************************************************************************/
+/*                 GDALDeserializeWarpPlanTransformer()                 */
+/************************************************************************/
+
+void *GDALDeserializeWarpPlanTransformer(CPLXMLNode *psTree)
+
+{
+    const char *pszFilename = CPLGetXMLValue(psTree, "Filename", nullptr);
+    if (pszFilename == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Missing Filename in WarpPlanTransformer");
+        return nullptr;
+    }
+
+    WarpPlanTransformInfo *psInfo = GDALWarpPlanOpen(pszFilename);
+    if (psInfo)
+    {
+        psInfo->dfRatioX = CPLAtof(CPLGetXMLValue(psTree, "RatioX", "1"));
+        psInfo->dfRatioY = CPLAtof(CPLGetXMLValue(psTree, "RatioY", "1"));
+    }
+    return psInfo;
+}
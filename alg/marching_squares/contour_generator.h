@@ -54,6 +54,20 @@ class ContourGenerator
         return CE_None;
     }
 
+    // Start the generation at line lineIdx (instead of 0), previousLine
+    // being the content of line lineIdx - 1 (or nullptr if lineIdx is 0).
+    // This allows processing a horizontal strip of the raster independently
+    // of the lines above it.
+    void startAtLine(size_t lineIdx, const double *previousLine)
+    {
+        lineIdx_ = lineIdx;
+        if (previousLine != nullptr)
+            std::copy(previousLine, previousLine + width_,
+                      previousLine_.begin());
+        else
+            std::fill(previousLine_.begin(), previousLine_.end(), NaN);
+    }
+
   private:
     size_t width_;
     size_t height_;
@@ -0,0 +1,202 @@
+/******************************************************************************
+ *
+ * Project:  Marching square algorithm
+ * Purpose:  Stitching of contour lines generated by horizontal strips.
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+#ifndef MARCHING_SQUARES_STRIP_MERGER_H
+#define MARCHING_SQUARES_STRIP_MERGER_H
+
+#include "point.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace marching_squares
+{
+
+// StripMerger: join the lines generated independently (typically by several
+// threads) for consecutive horizontal strips of a raster.
+//
+// Each strip is contoured with its own SegmentMerger, so that a contour
+// crossing the boundary ("seam") between two strips is cut into pieces whose
+// ends lie exactly on the seam. Points on a seam are interpolated from the
+// same pixel values by the squares of both strips, hence pieces can be joined
+// by exact equality of their end points, as SegmentMerger does.
+//
+// Strips must be added in order, from top to bottom.
+template <typename LineWriter> class StripMerger
+{
+  public:
+    struct Line
+    {
+        double level;
+        LineString ls;
+        bool closed;
+    };
+
+    // LineWriter collecting the lines of a strip
+    struct StripLines
+    {
+        void addLine(double level, LineString &ls, bool closed)
+        {
+            // empty lines correspond to skipped levels
+            if (ls.empty())
+                return;
+            lines.push_back(Line{level, LineString(), closed});
+            lines.back().ls.swap(ls);
+        }
+
+        std::vector<Line> lines{};
+    };
+
+    StripMerger(LineWriter &lineWriter, bool polygonize)
+        : lineWriter_(lineWriter), polygonize_(polygonize)
+    {
+    }
+
+    ~StripMerger()
+    {
+        // write all remaining (non-closed) lines
+        for (auto &l : pending_)
+        {
+            for (auto &ls : l.second)
+                lineWriter_.addLine(l.first, ls, /* closed */ false);
+        }
+    }
+
+    // non copyable
+    StripMerger(const StripMerger &) = delete;
+    StripMerger &operator=(const StripMerger &) = delete;
+
+    /**
+     * @brief addStrip consumes the lines of the next strip.
+     * @param lines lines of the strip
+     * @param topSeamY ordinate of the seam with the previous strip, or NaN
+     *        for the first strip.
+     * @param bottomSeamY ordinate of the seam with the next strip, or NaN
+     *        for the last strip.
+     */
+    void addStrip(std::vector<Line> &lines, double topSeamY,
+                  double bottomSeamY)
+    {
+        // lines that can be joined on the top seam, per level. All pending
+        // lines of the previous strip end on it.
+        std::map<double, std::vector<LineString>> toJoin;
+        toJoin.swap(pending_);
+
+        for (auto &line : lines)
+        {
+            if (line.closed)
+                lineWriter_.addLine(line.level, line.ls, /* closed */ true);
+            else if (touches_(line.ls, topSeamY))
+                toJoin[line.level].push_back(std::move(line.ls));
+            else
+                emitOrKeep_(line.level, line.ls, bottomSeamY);
+        }
+
+        for (auto &l : toJoin)
+            join_(l.first, l.second, topSeamY, bottomSeamY);
+    }
+
+  private:
+    LineWriter &lineWriter_;
+    const bool polygonize_;
+    // lines ending on the bottom seam of the last added strip, per level
+    std::map<double, std::vector<LineString>> pending_{};
+
+    static bool touches_(const LineString &ls, double seamY)
+    {
+        return ls.front().y == seamY || ls.back().y == seamY;
+    }
+
+    void emitOrKeep_(double level, LineString &ls, double bottomSeamY)
+    {
+        if (ls.front() == ls.back())
+            lineWriter_.addLine(level, ls, /* closed */ polygonize_);
+        else if (touches_(ls, bottomSeamY))
+            pending_[level].push_back(std::move(ls));
+        else
+            lineWriter_.addLine(level, ls, /* closed */ false);
+    }
+
+    // join lines of a given level sharing an end point on the seam
+    void join_(double level, std::vector<LineString> &pieces, double seamY,
+               double bottomSeamY)
+    {
+        // index of the pieces by abscissa of their ends on the seam
+        std::multimap<double, size_t> ends;
+        for (size_t i = 0; i < pieces.size(); ++i)
+        {
+            if (pieces[i].front().y == seamY)
+                ends.emplace(pieces[i].front().x, i);
+            if (pieces[i].back().y == seamY)
+                ends.emplace(pieces[i].back().x, i);
+        }
+
+        std::vector<bool> used(pieces.size(), false);
+        const auto findPiece = [&](const Point &p) -> LineString *
+        {
+            if (p.y != seamY)
+                return nullptr;
+            const auto range = ends.equal_range(p.x);
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                const size_t i = it->second;
+                if (!used[i] &&
+                    (pieces[i].front() == p || pieces[i].back() == p))
+                {
+                    used[i] = true;
+                    return &pieces[i];
+                }
+            }
+            return nullptr;
+        };
+
+        for (size_t i = 0; i < pieces.size(); ++i)
+        {
+            if (used[i])
+                continue;
+            used[i] = true;
+            LineString ls;
+            ls.swap(pieces[i]);
+
+            // extend the line at its end
+            while (!(ls.front() == ls.back()))
+            {
+                LineString *other = findPiece(ls.back());
+                if (other == nullptr)
+                    break;
+                if (!(other->front() == ls.back()))
+                    other->reverse();
+                ls.pop_back();
+                ls.splice(ls.end(), *other);
+            }
+
+            // and at its start
+            while (!(ls.front() == ls.back()))
+            {
+                LineString *other = findPiece(ls.front());
+                if (other == nullptr)
+                    break;
+                if (!(other->back() == ls.front()))
+                    other->reverse();
+                ls.pop_front();
+                ls.splice(ls.begin(), *other);
+            }
+
+            emitOrKeep_(level, ls, bottomSeamY);
+        }
+    }
+};
+
+}  // namespace marching_squares
+#endif
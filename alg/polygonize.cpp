@@ -19,9 +19,14 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <iterator>
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -31,14 +36,20 @@
 #include "ogr_core.h"
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 
 #include "polygonize_polygonizer.h"
 
 using namespace gdal::polygonizer;
 
+// Minimum height of the strips processed in parallel.
+constexpr int GP_MIN_STRIP_HEIGHT = 32;
+
 /************************************************************************/
 /*                          GPMaskImageData()                           */
 /*                                                                      */
@@ -65,6 +76,636 @@ static CPLErr GPMaskImageData(GDALRasterBandH hMaskBand, GByte *pabyMaskLine,
     return CE_None;
 }
 
+/************************************************************************/
+/*                         GPFindPolygonRoot()                          */
+/************************************************************************/
+
+static GInt32 GPFindPolygonRoot(std::vector<GInt32> &anParent, GInt32 nId)
+{
+    while (anParent[nId] != nId)
+    {
+        anParent[nId] = anParent[anParent[nId]];
+        nId = anParent[nId];
+    }
+    return nId;
+}
+
+/************************************************************************/
+/*                         GPStitchStripSeam()                          */
+/*                                                                      */
+/*      Merge the polygons that touch across the boundary between two   */
+/*      horizontal strips, by replaying the decisions that              */
+/*      GDALRasterPolygonEnumeratorT::ProcessLine() takes between the   */
+/*      last line of the upper strip and the first line of the lower    */
+/*      one. Polygon ids are global ids, or -1 for nodata.              */
+/************************************************************************/
+
+template <class DataType, class EqualityTest>
+static void GPStitchStripSeam(int nConnectedness, int nXSize,
+                              const DataType *panLastLineVal,
+                              const DataType *panThisLineVal,
+                              const GInt32 *panLastLineId,
+                              const GInt32 *panThisLineId,
+                              std::vector<GInt32> &anParent,
+                              std::vector<GInt32> &anMergedIds)
+{
+    EqualityTest eq;
+
+    const auto Merge = [&](int iLast, int iThis)
+    {
+        if (panLastLineId[iLast] < 0)
+            return;
+        const GInt32 nRoot1 =
+            GPFindPolygonRoot(anParent, panLastLineId[iLast]);
+        const GInt32 nRoot2 =
+            GPFindPolygonRoot(anParent, panThisLineId[iThis]);
+        if (nRoot1 != nRoot2)
+        {
+            anParent[std::max(nRoot1, nRoot2)] = std::min(nRoot1, nRoot2);
+            anMergedIds.push_back(nRoot1);
+        }
+    };
+
+    for (int i = 0; i < nXSize; i++)
+    {
+        if (panThisLineId[i] < 0)
+            continue;
+
+        if (i > 0 && eq(panThisLineVal[i], panThisLineVal[i - 1]))
+        {
+            if (eq(panLastLineVal[i], panThisLineVal[i]))
+                Merge(i, i);
+            if (nConnectedness == 8 &&
+                eq(panLastLineVal[i - 1], panThisLineVal[i]))
+                Merge(i - 1, i);
+            if (nConnectedness == 8 && i < nXSize - 1 &&
+                eq(panLastLineVal[i + 1], panThisLineVal[i]))
+                Merge(i + 1, i);
+        }
+        else if (eq(panLastLineVal[i], panThisLineVal[i]))
+        {
+            Merge(i, i);
+        }
+        else if (i > 0 && nConnectedness == 8 &&
+                 eq(panLastLineVal[i - 1], panThisLineVal[i]))
+        {
+            Merge(i - 1, i);
+            if (i < nXSize - 1 &&
+                eq(panLastLineVal[i + 1], panThisLineVal[i]))
+                Merge(i + 1, i);
+        }
+        else if (i < nXSize - 1 && nConnectedness == 8 &&
+                 eq(panLastLineVal[i + 1], panThisLineVal[i]))
+        {
+            Merge(i + 1, i);
+        }
+    }
+}
+
+namespace
+{
+
+/************************************************************************/
+/*                           GPPolygonPiece                             */
+/************************************************************************/
+
+// Part, within a strip, of a polygon that spans several strips.
+template <class DataType> struct GPPolygonPiece
+{
+    GInt32 nPolygonId = 0;
+    Point oBottomRight{};
+    DataType nValue{};
+    std::vector<Arc> aoRings{};
+};
+
+/************************************************************************/
+/*                       GPStripPolygonReceiver                         */
+/************************************************************************/
+
+// Write polygons that are entirely within a strip, and collect the pieces
+// of the other ones, to be merged once all strips have been processed.
+template <class DataType>
+class GPStripPolygonReceiver final : public PolygonReceiver<DataType>
+{
+    OGRPolygonWriter<DataType> &oWriter_;
+    const std::vector<bool> &abCrossStrip_;
+    std::vector<GPPolygonPiece<DataType>> &aoPieces_;
+
+  public:
+    GPStripPolygonReceiver(OGRPolygonWriter<DataType> &oWriter,
+                           const std::vector<bool> &abCrossStrip,
+                           std::vector<GPPolygonPiece<DataType>> &aoPieces)
+        : oWriter_(oWriter), abCrossStrip_(abCrossStrip), aoPieces_(aoPieces)
+    {
+    }
+
+    void receive(RPolygon *poPolygon, DataType nPolygonCellValue) override
+    {
+        oWriter_.receive(poPolygon, nPolygonCellValue);
+    }
+
+    void receiveWithId(std::int64_t nPolygonId, RPolygon *poPolygon,
+                       DataType nPolygonCellValue) override
+    {
+        if (!abCrossStrip_[static_cast<size_t>(nPolygonId)])
+        {
+            oWriter_.receive(poPolygon, nPolygonCellValue);
+            return;
+        }
+
+        GPPolygonPiece<DataType> oPiece;
+        oPiece.nPolygonId = static_cast<GInt32>(nPolygonId);
+        oPiece.oBottomRight =
+            Point{poPolygon->iBottomRightRow, poPolygon->iBottomRightCol};
+        oPiece.nValue = nPolygonCellValue;
+        GetRPolygonRings(*poPolygon, oPiece.aoRings);
+        aoPieces_.push_back(std::move(oPiece));
+    }
+};
+
+/************************************************************************/
+/*                              GPStrip                                 */
+/************************************************************************/
+
+template <class DataType, class EqualityTest> struct GPStrip
+{
+    CPL_DISALLOW_COPY_ASSIGN(GPStrip)
+
+    int nYOff = 0;
+    int nYSize = 0;
+    CPLErr eErr = CE_None;
+
+    // First pass enumeration of the strip, and its first and last lines.
+    GDALRasterPolygonEnumeratorT<DataType, EqualityTest> oFirstEnum;
+    std::vector<DataType> anFirstLineVal{};
+    std::vector<GInt32> anFirstLineId{};
+    std::vector<DataType> anLastLineVal{};
+    std::vector<GInt32> anLastLineId{};
+
+    // Maps polygon ids of oFirstEnum to global polygon ids.
+    GInt32 nIdOffset = 0;
+    std::vector<GInt32> anGlobalId{};
+
+    std::unique_ptr<OGRPolygonWriter<DataType>> poWriter{};
+    std::vector<GPPolygonPiece<DataType>> aoPieces{};
+
+    explicit GPStrip(int nConnectedness) : oFirstEnum(nConnectedness)
+    {
+    }
+};
+
+}  // namespace
+
+/************************************************************************/
+/*                          GDALPolygonizeMT()                          */
+/*                                                                      */
+/*      Multi-threaded version of GDALPolygonizeT(). The raster is      */
+/*      split into horizontal strips that are enumerated and traced     */
+/*      independently. Polygons that span several strips are merged     */
+/*      along strip boundaries before being written, so that the        */
+/*      output only differs from the one of the single-threaded         */
+/*      version by the order of features.                               */
+/************************************************************************/
+
+template <class DataType, class EqualityTest>
+static CPLErr GDALPolygonizeMT(GDALRasterBandH hSrcBand,
+                               GDALRasterBandH hMaskBand, OGRLayerH hOutLayer,
+                               int iPixValField, int nConnectedness,
+                               double *padfGeoTransform,
+                               CPLWorkerThreadPool *poThreadPool, int nStrips,
+                               GDALProgressFunc pfnProgress,
+                               void *pProgressArg, GDALDataType eDT)
+{
+    using Strip = GPStrip<DataType, EqualityTest>;
+
+    const int nXSize = GDALGetRasterBandXSize(hSrcBand);
+    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
+
+    std::vector<std::unique_ptr<Strip>> apoStrips;
+    for (int i = 0; i < nStrips; ++i)
+    {
+        auto poStrip = std::make_unique<Strip>(nConnectedness);
+        poStrip->nYOff =
+            static_cast<int>(static_cast<GIntBig>(nYSize) * i / nStrips);
+        poStrip->nYSize =
+            static_cast<int>(static_cast<GIntBig>(nYSize) * (i + 1) /
+                             nStrips) -
+            poStrip->nYOff;
+        apoStrips.push_back(std::move(poStrip));
+    }
+
+    std::mutex oIOMutex;
+    std::mutex oLayerMutex;
+    std::mutex oMutex;
+    std::condition_variable oCV;
+    int nFinishedStrips = 0;  // protected by oMutex
+    std::atomic<int> nProcessedLines{0};
+    std::atomic<bool> bStop{false};
+    CPLErrorAccumulator oErrorAccumulator;
+    auto poJobQueue = poThreadPool->CreateJobQueue();
+
+    // Source band reads are serialized, as drivers are generally not
+    // thread-safe.
+    const auto ReadLine = [hSrcBand, hMaskBand, nXSize, eDT,
+                           &oIOMutex](int iY, DataType *panLineVal,
+                                      GByte *pabyMaskLine)
+    {
+        std::lock_guard oLock(oIOMutex);
+        CPLErr eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iY, nXSize, 1,
+                                   panLineVal, nXSize, 1, eDT, 0, 0);
+        if (eErr == CE_None && hMaskBand != nullptr)
+            eErr = GPMaskImageData(hMaskBand, pabyMaskLine, iY, nXSize,
+                                   panLineVal);
+        return eErr;
+    };
+
+    const auto NotifyLineProcessed = [&nProcessedLines, &oCV]()
+    {
+        ++nProcessedLines;
+        oCV.notify_one();
+    };
+
+    // Run oJob on all strips with the thread pool, while reporting progress
+    // from the calling thread.
+    const auto RunStripJobs =
+        [&](const std::function<void(Strip &)> &oJob, double dfProgressBase,
+            double dfProgressScale)
+    {
+        nFinishedStrips = 0;
+        nProcessedLines = 0;
+        for (auto &poStrip : apoStrips)
+        {
+            Strip *poThisStrip = poStrip.get();
+            const auto oTask = [&, poThisStrip]()
+            {
+                {
+                    auto oAccumulator =
+                        oErrorAccumulator.InstallForCurrentScope();
+                    CPL_IGNORE_RET_VAL(oAccumulator);
+                    try
+                    {
+                        oJob(*poThisStrip);
+                    }
+                    catch (const std::bad_alloc &)
+                    {
+                        CPLError(CE_Failure, CPLE_OutOfMemory,
+                                 "Out of memory in GDALPolygonize()");
+                        poThisStrip->eErr = CE_Failure;
+                    }
+                    if (poThisStrip->eErr != CE_None)
+                        bStop = true;
+                }
+                std::lock_guard oLock(oMutex);
+                ++nFinishedStrips;
+                oCV.notify_one();
+            };
+            if (!poJobQueue->SubmitJob(oTask))
+                oTask();
+        }
+
+        std::unique_lock oLock(oMutex);
+        while (nFinishedStrips < nStrips)
+        {
+            oCV.wait(oLock);
+            oLock.unlock();
+            if (!bStop &&
+                !pfnProgress(dfProgressBase +
+                                 dfProgressScale * nProcessedLines / nYSize,
+                             "", pProgressArg))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                bStop = true;
+            }
+            oLock.lock();
+        }
+        oLock.unlock();
+        poJobQueue->WaitCompletion();
+
+        return !bStop;
+    };
+
+    /* -------------------------------------------------------------------- */
+    /*      First pass: enumerate the polygons of each strip.               */
+    /* -------------------------------------------------------------------- */
+    const auto EnumerateStrip =
+        [nXSize, &ReadLine, &NotifyLineProcessed, &bStop](Strip &oStrip)
+    {
+        std::vector<DataType> anLastLineVal(nXSize);
+        std::vector<DataType> anThisLineVal(nXSize);
+        std::vector<GInt32> anLastLineId(nXSize);
+        std::vector<GInt32> anThisLineId(nXSize);
+        std::vector<GByte> abyMaskLine(nXSize);
+
+        for (int iY = oStrip.nYOff; iY < oStrip.nYOff + oStrip.nYSize; iY++)
+        {
+            if (bStop)
+            {
+                oStrip.eErr = CE_Failure;
+                return;
+            }
+
+            oStrip.eErr =
+                ReadLine(iY, anThisLineVal.data(), abyMaskLine.data());
+            if (oStrip.eErr != CE_None)
+                return;
+
+            const bool bFirstLine = iY == oStrip.nYOff;
+            if (!oStrip.oFirstEnum.ProcessLine(
+                    bFirstLine ? nullptr : anLastLineVal.data(),
+                    anThisLineVal.data(),
+                    bFirstLine ? nullptr : anLastLineId.data(),
+                    anThisLineId.data(), nXSize))
+            {
+                oStrip.eErr = CE_Failure;
+                return;
+            }
+
+            if (bFirstLine)
+            {
+                oStrip.anFirstLineVal = anThisLineVal;
+                oStrip.anFirstLineId = anThisLineId;
+            }
+
+            std::swap(anLastLineVal, anThisLineVal);
+            std::swap(anLastLineId, anThisLineId);
+
+            NotifyLineProcessed();
+        }
+
+        oStrip.anLastLineVal = std::move(anLastLineVal);
+        oStrip.anLastLineId = std::move(anLastLineId);
+        oStrip.oFirstEnum.CompleteMerges();
+    };
+
+    bool bOK = RunStripJobs(EnumerateStrip, 0.0, 0.10);
+
+    /* -------------------------------------------------------------------- */
+    /*      Assign global polygon ids, and merge polygons touching across   */
+    /*      strip boundaries.                                               */
+    /* -------------------------------------------------------------------- */
+    std::vector<bool> abCrossStrip;
+    if (bOK)
+    {
+        GIntBig nTotalIds = 0;
+        for (auto &poStrip : apoStrips)
+        {
+            poStrip->nIdOffset = static_cast<GInt32>(nTotalIds);
+            nTotalIds += poStrip->oFirstEnum.nNextPolygonId;
+            // Keep one value for the id of the outer polygon.
+            if (nTotalIds >= std::numeric_limits<GInt32>::max())
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "GDALPolygonize(): maximum number of polygons "
+                         "reached");
+                bOK = false;
+                break;
+            }
+        }
+
+        try
+        {
+            std::vector<GInt32> anParent;
+            std::vector<GInt32> anMergedIds;
+            if (bOK)
+            {
+                anParent.resize(static_cast<size_t>(nTotalIds));
+                for (size_t i = 0; i < anParent.size(); ++i)
+                    anParent[i] = static_cast<GInt32>(i);
+
+                for (auto &poStrip : apoStrips)
+                {
+                    for (auto *panLineId :
+                         {&poStrip->anFirstLineId, &poStrip->anLastLineId})
+                    {
+                        for (GInt32 &nId : *panLineId)
+                        {
+                            if (nId >= 0)
+                                nId = poStrip->nIdOffset +
+                                      poStrip->oFirstEnum.panPolyIdMap[nId];
+                        }
+                    }
+                }
+            }
+
+            for (int i = 0; bOK && i + 1 < nStrips; ++i)
+            {
+                const Strip &oUpper = *(apoStrips[i]);
+                const Strip &oLower = *(apoStrips[i + 1]);
+                GPStitchStripSeam<DataType, EqualityTest>(
+                    nConnectedness, nXSize, oUpper.anLastLineVal.data(),
+                    oLower.anFirstLineVal.data(), oUpper.anLastLineId.data(),
+                    oLower.anFirstLineId.data(), anParent, anMergedIds);
+            }
+
+            if (bOK)
+            {
+                abCrossStrip.resize(static_cast<size_t>(nTotalIds));
+                for (const GInt32 nId : anMergedIds)
+                    abCrossStrip[GPFindPolygonRoot(anParent, nId)] = true;
+
+                for (auto &poStrip : apoStrips)
+                {
+                    auto &oEnum = poStrip->oFirstEnum;
+                    poStrip->anGlobalId.resize(oEnum.nNextPolygonId);
+                    for (int i = 0; i < oEnum.nNextPolygonId; ++i)
+                    {
+                        poStrip->anGlobalId[i] = GPFindPolygonRoot(
+                            anParent,
+                            poStrip->nIdOffset + oEnum.panPolyIdMap[i]);
+                    }
+                    oEnum.Clear();
+                    poStrip->anFirstLineVal = std::vector<DataType>();
+                    poStrip->anFirstLineId = std::vector<GInt32>();
+                    poStrip->anLastLineVal = std::vector<DataType>();
+                    poStrip->anLastLineId = std::vector<GInt32>();
+                    poStrip->poWriter =
+                        std::make_unique<OGRPolygonWriter<DataType>>(
+                            hOutLayer, iPixValField, padfGeoTransform,
+                            &oLayerMutex);
+                }
+            }
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory in GDALPolygonize()");
+            bOK = false;
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Second pass: trace the polygons of each strip. Those entirely   */
+    /*      within the strip are written, while the pieces of the others    */
+    /*      are collected.                                                  */
+    /* -------------------------------------------------------------------- */
+    const auto TraceStrip = [nXSize, nConnectedness, &abCrossStrip, &ReadLine,
+                             &NotifyLineProcessed, &bStop](Strip &oStrip)
+    {
+        GDALRasterPolygonEnumeratorT<DataType, EqualityTest> oSecondEnum(
+            nConnectedness);
+        GPStripPolygonReceiver<DataType> oReceiver(
+            *(oStrip.poWriter), abCrossStrip, oStrip.aoPieces);
+        Polygonizer<GInt32, DataType> oPolygonizer{-1, &oReceiver};
+
+        std::vector<DataType> anLastLineVal(nXSize);
+        std::vector<DataType> anThisLineVal(nXSize);
+        std::vector<GInt32> anLastLineId(nXSize);
+        std::vector<GInt32> anThisLineId(nXSize);
+        std::vector<GByte> abyMaskLine(nXSize);
+        std::vector<TwoArm> aoLastLineArm(nXSize + 2);
+        std::vector<TwoArm> aoThisLineArm(nXSize + 2);
+        for (auto &oArm : aoLastLineArm)
+            oArm.poPolyInside = oPolygonizer.getTheOuterPolygon();
+
+        const int nYEnd = oStrip.nYOff + oStrip.nYSize;
+        for (int iY = oStrip.nYOff; iY <= nYEnd; iY++)
+        {
+            if (bStop)
+            {
+                oStrip.eErr = CE_Failure;
+                return;
+            }
+
+            bool bLineOK;
+            if (iY < nYEnd)
+            {
+                oStrip.eErr =
+                    ReadLine(iY, anThisLineVal.data(), abyMaskLine.data());
+                if (oStrip.eErr != CE_None)
+                    return;
+
+                const bool bFirstLine = iY == oStrip.nYOff;
+                if (!oSecondEnum.ProcessLine(
+                        bFirstLine ? nullptr : anLastLineVal.data(),
+                        anThisLineVal.data(),
+                        bFirstLine ? nullptr : anLastLineId.data(),
+                        anThisLineId.data(), nXSize))
+                {
+                    oStrip.eErr = CE_Failure;
+                    return;
+                }
+
+                for (int iX = 0; iX < nXSize; iX++)
+                {
+                    anLastLineId[iX] =
+                        anThisLineId[iX] == -1
+                            ? -1
+                            : oStrip.anGlobalId[anThisLineId[iX]];
+                }
+
+                bLineOK = oPolygonizer.processLine(
+                    anLastLineId.data(), anLastLineVal.data(),
+                    aoThisLineArm.data(), aoLastLineArm.data(), iY, nXSize);
+            }
+            else
+            {
+                // The line below the strip is considered as outside.
+                for (int iX = 0; iX < nXSize; iX++)
+                    anThisLineId[iX] =
+                        decltype(oPolygonizer)::THE_OUTER_POLYGON_ID;
+
+                bLineOK = oPolygonizer.processLine(
+                    anThisLineId.data(), anLastLineVal.data(),
+                    aoThisLineArm.data(), aoLastLineArm.data(), iY, nXSize);
+            }
+
+            oStrip.eErr = bLineOK ? oStrip.poWriter->getErr() : CE_Failure;
+            if (oStrip.eErr != CE_None)
+                return;
+
+            std::swap(anLastLineVal, anThisLineVal);
+            std::swap(anLastLineId, anThisLineId);
+            std::swap(aoThisLineArm, aoLastLineArm);
+
+            if (iY < nYEnd)
+                NotifyLineProcessed();
+        }
+    };
+
+    if (bOK)
+        bOK = RunStripJobs(TraceStrip, 0.10, 0.80);
+
+    /* -------------------------------------------------------------------- */
+    /*      Merge and write polygons that span several strips.              */
+    /* -------------------------------------------------------------------- */
+    if (bOK)
+    {
+        try
+        {
+            std::vector<GPPolygonPiece<DataType>> aoPieces;
+            for (auto &poStrip : apoStrips)
+            {
+                std::move(poStrip->aoPieces.begin(), poStrip->aoPieces.end(),
+                          std::back_inserter(aoPieces));
+                poStrip->aoPieces.clear();
+            }
+            std::stable_sort(aoPieces.begin(), aoPieces.end(),
+                             [](const GPPolygonPiece<DataType> &a,
+                                const GPPolygonPiece<DataType> &b)
+                             { return a.nPolygonId < b.nPolygonId; });
+
+            OGRPolygonWriter<DataType> oWriter{hOutLayer, iPixValField,
+                                               padfGeoTransform};
+            std::vector<Arc> aoRings;
+            for (size_t iFirst = 0; bOK && iFirst < aoPieces.size();)
+            {
+                // The value of a polygon is the one of its bottom-right
+                // most pixel.
+                size_t iLast = iFirst;
+                size_t iBottomRight = iFirst;
+                aoRings.clear();
+                while (iLast < aoPieces.size() &&
+                       aoPieces[iLast].nPolygonId ==
+                           aoPieces[iFirst].nPolygonId)
+                {
+                    if (aoPieces[iBottomRight].oBottomRight <
+                        aoPieces[iLast].oBottomRight)
+                        iBottomRight = iLast;
+                    std::move(aoPieces[iLast].aoRings.begin(),
+                              aoPieces[iLast].aoRings.end(),
+                              std::back_inserter(aoRings));
+                    ++iLast;
+                }
+
+                if (!MergeRPolygonPieces(aoRings))
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "GDALPolygonize(): cannot merge polygon pieces");
+                    bOK = false;
+                    break;
+                }
+                oWriter.receiveRings(aoRings, aoPieces[iBottomRight].nValue);
+                if (oWriter.getErr() != CE_None)
+                    bOK = false;
+                else if (!pfnProgress(0.90 + 0.10 * static_cast<double>(
+                                                        iLast) /
+                                                 aoPieces.size(),
+                                      "", pProgressArg))
+                {
+                    CPLError(CE_Failure, CPLE_UserInterrupt,
+                             "User terminated");
+                    bOK = false;
+                }
+
+                iFirst = iLast;
+            }
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory in GDALPolygonize()");
+            bOK = false;
+        }
+    }
+
+    if (bOK)
+        pfnProgress(1.0, "", pProgressArg);
+
+    oErrorAccumulator.ReplayErrors();
+
+    return bOK ? CE_None : CE_Failure;
+}
+
 /************************************************************************/
 /*                           GDALPolygonizeT()                          */
 /************************************************************************/
@@ -98,7 +739,7 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
     }
 
     /* -------------------------------------------------------------------- */
-    /*      Allocate working buffers.                                       */
+    /*      Check raster dimensions.                                        */
     /* -------------------------------------------------------------------- */
     const int nXSize = GDALGetRasterBandXSize(hSrcBand);
     const int nYSize = GDALGetRasterBandYSize(hSrcBand);
@@ -108,29 +749,6 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
         return CE_Failure;
     }
 
-    DataType *panLastLineVal =
-        static_cast<DataType *>(VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize));
-    DataType *panThisLineVal =
-        static_cast<DataType *>(VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize));
-    GInt32 *panLastLineId =
-        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
-    GInt32 *panThisLineId =
-        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
-
-    GByte *pabyMaskLine = static_cast<GByte *>(VSI_MALLOC_VERBOSE(nXSize));
-
-    if (panLastLineVal == nullptr || panThisLineVal == nullptr ||
-        panLastLineId == nullptr || panThisLineId == nullptr ||
-        pabyMaskLine == nullptr)
-    {
-        CPLFree(panThisLineId);
-        CPLFree(panLastLineId);
-        CPLFree(panThisLineVal);
-        CPLFree(panLastLineVal);
-        CPLFree(pabyMaskLine);
-        return CE_Failure;
-    }
-
     /* -------------------------------------------------------------------- */
     /*      Get the geotransform, if there is one, so we can convert the    */
     /*      vectors into georeferenced coordinates.                         */
@@ -166,6 +784,48 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
         adfGeoTransform[5] = 1;
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Process horizontal strips in parallel if GDAL_NUM_THREADS       */
+    /*      allows it.                                                      */
+    /* -------------------------------------------------------------------- */
+    const int nThreads =
+        GDALGetNumThreads(std::max(1, nYSize / GP_MIN_STRIP_HEIGHT));
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    if (poThreadPool)
+    {
+        return GDALPolygonizeMT<DataType, EqualityTest>(
+            hSrcBand, hMaskBand, hOutLayer, iPixValField, nConnectedness,
+            adfGeoTransform, poThreadPool, nThreads, pfnProgress, pProgressArg,
+            eDT);
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Allocate working buffers.                                       */
+    /* -------------------------------------------------------------------- */
+    DataType *panLastLineVal =
+        static_cast<DataType *>(VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize));
+    DataType *panThisLineVal =
+        static_cast<DataType *>(VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize));
+    GInt32 *panLastLineId =
+        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
+    GInt32 *panThisLineId =
+        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
+
+    GByte *pabyMaskLine = static_cast<GByte *>(VSI_MALLOC_VERBOSE(nXSize));
+
+    if (panLastLineVal == nullptr || panThisLineVal == nullptr ||
+        panLastLineId == nullptr || panThisLineId == nullptr ||
+        pabyMaskLine == nullptr)
+    {
+        CPLFree(panThisLineId);
+        CPLFree(panLastLineId);
+        CPLFree(panThisLineVal);
+        CPLFree(panLastLineVal);
+        CPLFree(pabyMaskLine);
+        return CE_Failure;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      The first pass over the raster is only used to build up the     */
     /*      polygon id map so we will know in advance what polygons are     */
@@ -473,6 +1133,12 @@ GBool GDALFloatEquals(float A, float B)
  * sizes will be substantial.  The algorithm is primarily intended for
  * relatively simple thematic imagery, masks, and classification results.
  *
+ * Starting with GDAL 3.12, if the GDAL_NUM_THREADS configuration option is
+ * set to a value greater than 1 (or ALL_CPUS), the raster is split into
+ * horizontal strips that are processed in parallel, polygons spanning several
+ * strips being merged afterwards. The resulting polygons are the same as with
+ * a single thread, but features may be written in a different order.
+ *
  * @param hSrcBand the source raster band to be processed.
  * @param hMaskBand an optional mask band.  All pixels in the mask band with a
  * value other than zero will be considered suitable for collection as
@@ -547,6 +1213,12 @@ CPLErr CPL_STDCALL GDALPolygonize(GDALRasterBandH hSrcBand,
  * sizes will be substantial.  The algorithm is primarily intended for
  * relatively simple thematic imagery, masks, and classification results.
  *
+ * Starting with GDAL 3.12, if the GDAL_NUM_THREADS configuration option is
+ * set to a value greater than 1 (or ALL_CPUS), the raster is split into
+ * horizontal strips that are processed in parallel, polygons spanning several
+ * strips being merged afterwards. The resulting polygons are the same as with
+ * a single thread, but features may be written in a different order.
+ *
  * @param hSrcBand the source raster band to be processed.
  * @param hMaskBand an optional mask band.  All pixels in the mask band with a
  * value other than zero will be considered suitable for collection as
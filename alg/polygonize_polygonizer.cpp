@@ -39,6 +39,242 @@ void RPolygon::updateBottomRightPos(IndexType iRow, IndexType iCol)
     iBottomRightCol = iCol;
 }
 
+void GetRPolygonRings(const RPolygon &oPolygon, std::vector<Arc> &aoRings)
+{
+    std::vector<bool> oAccessedArc(oPolygon.oArcs.size(), false);
+    for (std::size_t iFirstArcIndex = 0; iFirstArcIndex < oAccessedArc.size();
+         ++iFirstArcIndex)
+    {
+        if (oAccessedArc[iFirstArcIndex])
+            continue;
+
+        Arc oRing;
+        std::size_t iArcIndex = iFirstArcIndex;
+        do
+        {
+            const auto &oArc = oPolygon.oArcs[iArcIndex];
+            if (oArc.bFollowRighthand)
+                oRing.insert(oRing.end(), oArc.poArc->begin(),
+                             oArc.poArc->end());
+            else
+                oRing.insert(oRing.end(), oArc.poArc->rbegin(),
+                             oArc.poArc->rend());
+            oAccessedArc[iArcIndex] = true;
+            iArcIndex = oArc.nConnection;
+        } while (iArcIndex != iFirstArcIndex);
+
+        aoRings.push_back(std::move(oRing));
+    }
+}
+
+bool MergeRPolygonPieces(std::vector<Arc> &aoRings)
+{
+    struct Edge
+    {
+        Point oStart;
+        Point oEnd;
+    };
+
+    // Split edges into vertical ones, that are kept as such, and horizontal
+    // ones, that may overlap an edge of opposite direction of another piece.
+    std::vector<Edge> aoEdges;
+    std::vector<Edge> aoHorEdges;
+    for (const Arc &oRing : aoRings)
+    {
+        const std::size_t nPoints = oRing.size();
+        for (std::size_t i = 0; i < nPoints; ++i)
+        {
+            const Point &oStart = oRing[i];
+            const Point &oEnd = oRing[(i + 1) % nPoints];
+            if (oStart == oEnd)
+                continue;
+            if (oStart[0] == oEnd[0])
+                aoHorEdges.push_back(Edge{oStart, oEnd});
+            else if (oStart[1] == oEnd[1])
+                aoEdges.push_back(Edge{oStart, oEnd});
+            else
+                return false;
+        }
+    }
+
+    // Within each row, only keep the portions of horizontal edges that are
+    // covered by edges going in a single direction: the others separate two
+    // pieces of the polygon.
+    std::sort(aoHorEdges.begin(), aoHorEdges.end(),
+              [](const Edge &a, const Edge &b)
+              { return a.oStart[0] < b.oStart[0]; });
+    std::vector<IndexType> anBreaks;
+    std::vector<int> anCoverRight;
+    std::vector<int> anCoverLeft;
+    for (std::size_t iFirst = 0; iFirst < aoHorEdges.size();)
+    {
+        const IndexType nRow = aoHorEdges[iFirst].oStart[0];
+        std::size_t iLast = iFirst;
+        bool bHasRight = false;
+        bool bHasLeft = false;
+        while (iLast < aoHorEdges.size() && aoHorEdges[iLast].oStart[0] == nRow)
+        {
+            if (aoHorEdges[iLast].oStart[1] < aoHorEdges[iLast].oEnd[1])
+                bHasRight = true;
+            else
+                bHasLeft = true;
+            ++iLast;
+        }
+
+        if (!bHasRight || !bHasLeft)
+        {
+            aoEdges.insert(aoEdges.end(), aoHorEdges.begin() + iFirst,
+                           aoHorEdges.begin() + iLast);
+            iFirst = iLast;
+            continue;
+        }
+
+        anBreaks.clear();
+        for (std::size_t i = iFirst; i < iLast; ++i)
+        {
+            anBreaks.push_back(aoHorEdges[i].oStart[1]);
+            anBreaks.push_back(aoHorEdges[i].oEnd[1]);
+        }
+        std::sort(anBreaks.begin(), anBreaks.end());
+        anBreaks.erase(std::unique(anBreaks.begin(), anBreaks.end()),
+                       anBreaks.end());
+
+        anCoverRight.assign(anBreaks.size(), 0);
+        anCoverLeft.assign(anBreaks.size(), 0);
+        for (std::size_t i = iFirst; i < iLast; ++i)
+        {
+            const Edge &oEdge = aoHorEdges[i];
+            const bool bRight = oEdge.oStart[1] < oEdge.oEnd[1];
+            const auto nMinCol = std::min(oEdge.oStart[1], oEdge.oEnd[1]);
+            const auto nMaxCol = std::max(oEdge.oStart[1], oEdge.oEnd[1]);
+            auto &anCover = bRight ? anCoverRight : anCoverLeft;
+            const auto iBegin = static_cast<std::size_t>(
+                std::lower_bound(anBreaks.begin(), anBreaks.end(), nMinCol) -
+                anBreaks.begin());
+            const auto iEnd = static_cast<std::size_t>(
+                std::lower_bound(anBreaks.begin(), anBreaks.end(), nMaxCol) -
+                anBreaks.begin());
+            ++anCover[iBegin];
+            --anCover[iEnd];
+        }
+
+        for (std::size_t j = 0; j + 1 < anBreaks.size(); ++j)
+        {
+            if (j > 0)
+            {
+                anCoverRight[j] += anCoverRight[j - 1];
+                anCoverLeft[j] += anCoverLeft[j - 1];
+            }
+            if (anCoverRight[j] > 0 && anCoverLeft[j] == 0)
+                aoEdges.push_back(Edge{Point{nRow, anBreaks[j]},
+                                       Point{nRow, anBreaks[j + 1]}});
+            else if (anCoverLeft[j] > 0 && anCoverRight[j] == 0)
+                aoEdges.push_back(Edge{Point{nRow, anBreaks[j + 1]},
+                                       Point{nRow, anBreaks[j]}});
+        }
+
+        iFirst = iLast;
+    }
+
+    // Index edges by their start point.
+    const auto GetKey = [](const Point &oPoint)
+    { return (static_cast<std::uint64_t>(oPoint[0]) << 32) | oPoint[1]; };
+    std::vector<std::pair<std::uint64_t, std::size_t>> aoStartIndex;
+    aoStartIndex.reserve(aoEdges.size());
+    for (std::size_t i = 0; i < aoEdges.size(); ++i)
+        aoStartIndex.emplace_back(GetKey(aoEdges[i].oStart), i);
+    std::sort(aoStartIndex.begin(), aoStartIndex.end());
+
+    const auto GetDirection = [](const Edge &oEdge)
+    {
+        return std::array<int, 2>{
+            (oEdge.oEnd[0] > oEdge.oStart[0]) -
+                (oEdge.oEnd[0] < oEdge.oStart[0]),
+            (oEdge.oEnd[1] > oEdge.oStart[1]) -
+                (oEdge.oEnd[1] < oEdge.oStart[1])};
+    };
+
+    // Relink edges into rings. When two rings touch at a vertex, the
+    // single pass tracer turns right (the polygon being on the left side
+    // of the edges), which joins cells diagonally adjacent at that vertex.
+    std::vector<bool> abUsed(aoEdges.size(), false);
+    std::vector<Arc> aoNewRings;
+    for (std::size_t iStart = 0; iStart < aoEdges.size(); ++iStart)
+    {
+        if (abUsed[iStart])
+            continue;
+
+        Arc oRing;
+        std::size_t iCur = iStart;
+        while (true)
+        {
+            abUsed[iCur] = true;
+            oRing.push_back(aoEdges[iCur].oStart);
+
+            const auto oRange = std::equal_range(
+                aoStartIndex.begin(), aoStartIndex.end(),
+                std::pair<std::uint64_t, std::size_t>(
+                    GetKey(aoEdges[iCur].oEnd), 0),
+                [](const std::pair<std::uint64_t, std::size_t> &a,
+                   const std::pair<std::uint64_t, std::size_t> &b)
+                { return a.first < b.first; });
+            const auto nCandidates = oRange.second - oRange.first;
+            std::size_t iNext;
+            if (nCandidates == 1)
+            {
+                iNext = oRange.first->second;
+            }
+            else if (nCandidates == 2)
+            {
+                const auto oDir = GetDirection(aoEdges[iCur]);
+                const std::array<int, 2> oRightDir{oDir[1], -oDir[0]};
+                iNext =
+                    GetDirection(aoEdges[oRange.first->second]) == oRightDir
+                        ? oRange.first->second
+                        : (oRange.first + 1)->second;
+            }
+            else
+            {
+                return false;
+            }
+
+            if (iNext == iStart)
+                break;
+            if (abUsed[iNext])
+                return false;
+            iCur = iNext;
+        }
+
+        // Only keep corners.
+        const std::size_t nPoints = oRing.size();
+        Arc oCorners;
+        for (std::size_t i = 0; i < nPoints; ++i)
+        {
+            const Point &oPrev = oRing[(i + nPoints - 1) % nPoints];
+            const Point &oCur = oRing[i];
+            const Point &oNext = oRing[(i + 1) % nPoints];
+            if (!(oPrev[0] == oCur[0] && oCur[0] == oNext[0]) &&
+                !(oPrev[1] == oCur[1] && oCur[1] == oNext[1]))
+            {
+                oCorners.push_back(oCur);
+            }
+        }
+        if (oCorners.empty())
+            return false;
+
+        // Start at the top-left most vertex.
+        std::rotate(oCorners.begin(),
+                    std::min_element(oCorners.begin(), oCorners.end()),
+                    oCorners.end());
+        aoNewRings.push_back(std::move(oCorners));
+    }
+
+    std::sort(aoNewRings.begin(), aoNewRings.end(),
+              [](const Arc &a, const Arc &b) { return a.front() < b.front(); });
+    aoRings = std::move(aoNewRings);
+    return true;
+}
+
 /**
  * Process different kinds of Arm connections.
  */
@@ -425,8 +661,9 @@ bool Polygonizer<PolyIdType, DataType>::processLine(
             // emit valid polygon only
             if (nPolyId != nInvalidPolyId_)
             {
-                poPolygonReceiver_->receive(
-                    poPolygon, panLastLineVal[poPolygon->iBottomRightCol]);
+                poPolygonReceiver_->receiveWithId(
+                    nPolyId, poPolygon,
+                    panLastLineVal[poPolygon->iBottomRightCol]);
             }
 
             destroyPolygon(nPolyId);
@@ -444,9 +681,11 @@ bool Polygonizer<PolyIdType, DataType>::processLine(
 template <typename DataType>
 OGRPolygonWriter<DataType>::OGRPolygonWriter(OGRLayerH hOutLayer,
                                              int iPixValField,
-                                             double *padfGeoTransform)
+                                             double *padfGeoTransform,
+                                             std::mutex *poLayerMutex)
     : PolygonReceiver<DataType>(), poOutLayer_(OGRLayer::FromHandle(hOutLayer)),
-      iPixValField_(iPixValField), padfGeoTransform_(padfGeoTransform)
+      iPixValField_(iPixValField), padfGeoTransform_(padfGeoTransform),
+      poLayerMutex_(poLayerMutex)
 {
     poFeature_ = std::make_unique<OGRFeature>(poOutLayer_->GetLayerDefn());
     poPolygon_ = new OGRPolygon();
@@ -555,6 +794,49 @@ void OGRPolygonWriter<DataType>::receive(RPolygon *poPolygon,
         }
     }
 
+    writeFeature(nPolygonCellValue);
+}
+
+template <typename DataType>
+void OGRPolygonWriter<DataType>::receiveRings(const std::vector<Arc> &aoRings,
+                                              DataType nPolygonCellValue)
+{
+    const double *padfGeoTransform = padfGeoTransform_;
+    poPolygon_->empty();
+
+    for (const Arc &oRingPoints : aoRings)
+    {
+        auto poRing = std::make_unique<OGRLinearRing>();
+        const int nPointCount = static_cast<int>(oRingPoints.size());
+        poRing->setNumPoints(nPointCount, /* bZeroizeNewContent = */ false);
+        if (poRing->getNumPoints() < nPointCount)
+        {
+            eErr_ = CE_Failure;
+            return;
+        }
+        for (int i = 0; i < nPointCount; ++i)
+        {
+            const Point &oPixel = oRingPoints[i];
+
+            const double dfX = padfGeoTransform[0] +
+                               oPixel[1] * padfGeoTransform[1] +
+                               oPixel[0] * padfGeoTransform[2];
+            const double dfY = padfGeoTransform[3] +
+                               oPixel[1] * padfGeoTransform[4] +
+                               oPixel[0] * padfGeoTransform[5];
+
+            poRing->setPoint(i, dfX, dfY);
+        }
+        poRing->closeRings();
+        poPolygon_->addRingDirectly(poRing.release());
+    }
+
+    writeFeature(nPolygonCellValue);
+}
+
+template <typename DataType>
+void OGRPolygonWriter<DataType>::writeFeature(DataType nPolygonCellValue)
+{
     // Create the feature object
     poFeature_->SetFID(OGRNullFID);
     if (iPixValField_ >= 0)
@@ -562,7 +844,17 @@ void OGRPolygonWriter<DataType>::receive(RPolygon *poPolygon,
                              static_cast<double>(nPolygonCellValue));
 
     // Write the to the layer.
-    if (poOutLayer_->CreateFeature(poFeature_.get()) != OGRERR_NONE)
+    OGRErr eErr;
+    if (poLayerMutex_)
+    {
+        std::lock_guard oLock(*poLayerMutex_);
+        eErr = poOutLayer_->CreateFeature(poFeature_.get());
+    }
+    else
+    {
+        eErr = poOutLayer_->CreateFeature(poFeature_.get());
+    }
+    if (eErr != OGRERR_NONE)
         eErr_ = CE_Failure;
 
     // Shouldn't happen for well behaved drivers, but better check...
@@ -22,6 +22,7 @@
 #include <vector>
 #include <limits>
 #include <map>
+#include <mutex>
 
 #include "cpl_error.h"
 #include "ogr_api.h"
@@ -128,8 +129,40 @@ template <typename DataType> class PolygonReceiver
     operator=(const PolygonReceiver<DataType> &) = delete;
 
     virtual void receive(RPolygon *poPolygon, DataType nPolygonCellValue) = 0;
+
+    /**
+     * Receive a completed polygon together with the id it was traced with.
+     * Defaults to forwarding to receive().
+     */
+    virtual void receiveWithId(std::int64_t /* nPolygonId */,
+                               RPolygon *poPolygon, DataType nPolygonCellValue)
+    {
+        receive(poPolygon, nPolygonCellValue);
+    }
 };
 
+/**
+ * Collect the rings of a raster polygon as lists of grid points (not closed).
+ */
+void GetRPolygonRings(const RPolygon &oPolygon, std::vector<Arc> &aoRings);
+
+/**
+ * Merge the rings of the pieces of a raster polygon that has been traced
+ * over several horizontal strips, each strip being traced independently.
+ *
+ * Horizontal edges shared by two pieces along a strip boundary are removed,
+ * and the remaining edges are relinked into rings that are identical to the
+ * ones a single pass over the whole raster would have produced: vertices are
+ * only emitted at corners, each ring starts at its top-left most vertex, and
+ * rings are ordered by that vertex (the exterior ring first).
+ *
+ * On input, aoRings contains the rings of all pieces. On output, it contains
+ * the rings of the merged polygon.
+ *
+ * @return false in case of inconsistent input
+ */
+bool MergeRPolygonPieces(std::vector<Arc> &aoRings);
+
 /**
  * Polygonizer is used to manage polygon memory and do the edge tracing process
  */
@@ -189,12 +222,20 @@ class OGRPolygonWriter : public PolygonReceiver<DataType>
     std::unique_ptr<OGRFeature> poFeature_{};
     OGRPolygon *poPolygon_ =
         nullptr;  // = poFeature_->GetGeometryRef(), owned by poFeature
+    std::mutex *poLayerMutex_ = nullptr;
 
     CPLErr eErr_{CE_None};
 
+    void writeFeature(DataType nPolygonCellValue);
+
   public:
+    /**
+     * If poLayerMutex is not null, it is held while writing features to
+     * the layer, so that several writers can share the same layer.
+     */
     OGRPolygonWriter(OGRLayerH hOutLayer, int iPixValField,
-                     double *padfGeoTransform);
+                     double *padfGeoTransform,
+                     std::mutex *poLayerMutex = nullptr);
 
     OGRPolygonWriter(const OGRPolygonWriter<DataType> &) = delete;
 
@@ -203,6 +244,13 @@ class OGRPolygonWriter : public PolygonReceiver<DataType>
 
     void receive(RPolygon *poPolygon, DataType nPolygonCellValue) override;
 
+    /**
+     * Write a polygon given as a list of rings of grid points (not closed),
+     * the first one being the exterior ring.
+     */
+    void receiveRings(const std::vector<Arc> &aoRings,
+                      DataType nPolygonCellValue);
+
     inline CPLErr getErr()
     {
         return eErr_;
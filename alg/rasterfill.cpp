@@ -19,16 +19,23 @@
 #include <cstring>
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <new>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 /************************************************************************/
 /*                           GDALFilterLine()                           */
@@ -344,6 +351,640 @@ inline void QUAD_CHECK(double &dfQuadDist, float &fQuadValue, int target_x,
     }
 }
 
+/************************************************************************/
+/*                         GDALFillNodataLine()                         */
+/*                                                                      */
+/*      Interpolate the pixels of columns [iXStart, iXEnd) of line iY   */
+/*      that are not valid in pabyMask, from the last known values of   */
+/*      the top to bottom pass (for line iY) and of the bottom to top   */
+/*      pass (for line iY + 1). Columns are relative to the start of    */
+/*      the buffers, which are nXSize wide. Interpolated pixels are     */
+/*      updated in pafScanline, pabyMask and pabyFiltMask.              */
+/************************************************************************/
+
+namespace
+{
+struct GDALFillNodataParams
+{
+    double dfMaxSearchDist = 0;
+    int nMaxSearchDist = 0;
+    bool bNearest = false;
+    bool bHasNoData = false;
+    float fNoData = 0.0f;
+    GUInt32 nNoDataVal = 0;
+};
+}  // namespace
+
+static void GDALFillNodataLine(const GDALFillNodataParams &sParams, int iY,
+                               int iXStart, int iXEnd, int nXSize,
+                               const GUInt32 *panTopDownY,
+                               const float *pafTopDownValue,
+                               const GUInt32 *panLastY,
+                               const float *pafLastValue, GByte *pabyMask,
+                               float *pafScanline, GByte *pabyFiltMask)
+{
+    const double dfMaxSearchDist = sParams.dfMaxSearchDist;
+    const int nMaxSearchDist = sParams.nMaxSearchDist;
+    const bool bNearest = sParams.bNearest;
+    const bool bHasNoData = sParams.bHasNoData;
+    const float fNoData = sParams.fNoData;
+    const GUInt32 nNoDataVal = sParams.nNoDataVal;
+
+    for (int iX = iXStart; iX < iXEnd; iX++)
+    {
+        int nThisMaxSearchDist = nMaxSearchDist;
+
+        // If this was a valid target - no change.
+        if (pabyMask[iX])
+            continue;
+
+        enum Quadrants
+        {
+            QUAD_TOP_LEFT = 0,
+            QUAD_BOTTOM_LEFT = 1,
+            QUAD_TOP_RIGHT = 2,
+            QUAD_BOTTOM_RIGHT = 3,
+        };
+
+        constexpr int QUAD_COUNT = 4;
+        double adfQuadDist[QUAD_COUNT] = {};
+        float afQuadValue[QUAD_COUNT] = {};
+
+        for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
+        {
+            adfQuadDist[iQuad] = dfMaxSearchDist + 1.0;
+            afQuadValue[iQuad] = 0.0;
+        }
+
+        // Step left and right by one pixel searching for the closest
+        // target value for each quadrant.
+        for (int iStep = 0; iStep <= nThisMaxSearchDist; iStep++)
+        {
+            const int iLeftX = std::max(0, iX - iStep);
+            const int iRightX = std::min(nXSize - 1, iX + iStep);
+
+            // Top left includes current line.
+            QUAD_CHECK(adfQuadDist[QUAD_TOP_LEFT],
+                       afQuadValue[QUAD_TOP_LEFT], iLeftX,
+                       panTopDownY[iLeftX], iX, iY, pafTopDownValue[iLeftX],
+                       nNoDataVal);
+
+            // Bottom left.
+            QUAD_CHECK(adfQuadDist[QUAD_BOTTOM_LEFT],
+                       afQuadValue[QUAD_BOTTOM_LEFT], iLeftX,
+                       panLastY[iLeftX], iX, iY, pafLastValue[iLeftX],
+                       nNoDataVal);
+
+            // Top right and bottom right do no include center pixel.
+            if (iStep == 0)
+                continue;
+
+            // Top right includes current line.
+            QUAD_CHECK(adfQuadDist[QUAD_TOP_RIGHT],
+                       afQuadValue[QUAD_TOP_RIGHT], iRightX,
+                       panTopDownY[iRightX], iX, iY,
+                       pafTopDownValue[iRightX], nNoDataVal);
+
+            // Bottom right.
+            QUAD_CHECK(adfQuadDist[QUAD_BOTTOM_RIGHT],
+                       afQuadValue[QUAD_BOTTOM_RIGHT], iRightX,
+                       panLastY[iRightX], iX, iY, pafLastValue[iRightX],
+                       nNoDataVal);
+
+            // Every four steps, recompute maximum distance.
+            if ((iStep & 0x3) == 0)
+                nThisMaxSearchDist = static_cast<int>(floor(
+                    std::max(std::max(adfQuadDist[0], adfQuadDist[1]),
+                             std::max(adfQuadDist[2], adfQuadDist[3]))));
+        }
+
+        bool bHasSrcValues = false;
+        if (bNearest)
+        {
+            double dfNearestDist = dfMaxSearchDist + 1;
+            float fNearestValue = 0.0f;
+
+            for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
+            {
+                if (adfQuadDist[iQuad] < dfNearestDist)
+                {
+                    bHasSrcValues = true;
+                    if (!bHasNoData || afQuadValue[iQuad] != fNoData)
+                    {
+                        fNearestValue = afQuadValue[iQuad];
+                        dfNearestDist = adfQuadDist[iQuad];
+                    }
+                }
+            }
+
+            if (bHasSrcValues)
+            {
+                pabyFiltMask[iX] = 255;
+                if (dfNearestDist <= dfMaxSearchDist)
+                {
+                    pabyMask[iX] = 255;
+                    pafScanline[iX] = fNearestValue;
+                }
+                else
+                    pafScanline[iX] = fNoData;
+            }
+        }
+        else
+        {
+            double dfWeightSum = 0.0;
+            double dfValueSum = 0.0;
+
+            for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
+            {
+                if (adfQuadDist[iQuad] <= dfMaxSearchDist)
+                {
+                    bHasSrcValues = true;
+                    if (!bHasNoData || afQuadValue[iQuad] != fNoData)
+                    {
+                        const double dfWeight = 1.0 / adfQuadDist[iQuad];
+                        dfWeightSum += dfWeight;
+                        dfValueSum += double(afQuadValue[iQuad]) * dfWeight;
+                    }
+                }
+            }
+
+            if (bHasSrcValues)
+            {
+                pabyFiltMask[iX] = 255;
+                if (dfWeightSum > 0.0)
+                {
+                    pabyMask[iX] = 255;
+                    pafScanline[iX] =
+                        static_cast<float>(dfValueSum / dfWeightSum);
+                }
+                else
+                    pafScanline[iX] = fNoData;
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                        GDALFillNodataTiled()                         */
+/*                                                                      */
+/*      Multithreaded implementation of GDALFillNodata(). The raster    */
+/*      is split in square tiles that are processed on the global       */
+/*      thread pool. Each tile is computed from a window extended by a  */
+/*      halo of the maximum search distance (for the interpolation) or  */
+/*      of the number of iterations (for the smoothing filter), so      */
+/*      that its result is identical to the one of the line by line     */
+/*      implementation. Only the interior of tiles is written, to a     */
+/*      work file that is copied to the target band once all tiles are  */
+/*      done, so that no tile ever reads values modified by another     */
+/*      one. Reads and writes are serialized with a mutex.              */
+/************************************************************************/
+
+// Above this halo, windows get too large compared to their interior, and
+// we use the line by line implementation.
+constexpr int FILL_NODATA_MAX_TILED_HALO = 1024;
+
+namespace
+{
+struct GDALFillNodataTile
+{
+    // Interior of the tile, written to the output.
+    int nXOff = 0;
+    int nYOff = 0;
+    int nXSize = 0;
+    int nYSize = 0;
+    // Interior extended by the halo, and clipped to the raster, read from
+    // the inputs.
+    int nWinXOff = 0;
+    int nWinYOff = 0;
+    int nWinXSize = 0;
+    int nWinYSize = 0;
+};
+}  // namespace
+
+static CPLErr GDALFillNodataTiled(
+    GDALRasterBandH hTargetBand, GDALRasterBandH hMaskBand,
+    const GDALFillNodataParams &sParams, int nSmoothingIterations,
+    int nThreads, int nTileSize, GDALDriverH hDriver,
+    const CPLString &osTmpFile, const CPLStringList &aosWorkFileOptionsIn,
+    double dfProgressRatio, GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    const int nXSize = GDALGetRasterBandXSize(hTargetBand);
+    const int nYSize = GDALGetRasterBandYSize(hTargetBand);
+    const GUInt32 nNoDataVal = sParams.nNoDataVal;
+
+    // The mask band is not updated with the filled pixels, as other tiles
+    // may still need to read it. For a mask band that is not the one of the
+    // target band, the filter mask records which pixels have been filled
+    // (255) or have been considered but not filled (1).
+    const bool bUserMaskBand = hMaskBand != GDALGetMaskBand(hTargetBand);
+
+    /* -------------------------------------------------------------------- */
+    /*      Create the work files, with blocks aligned on tiles.            */
+    /* -------------------------------------------------------------------- */
+    CPLStringList aosWorkFileOptions(aosWorkFileOptionsIn);
+    if (EQUAL(GDALGetDriverShortName(hDriver), "GTiff") &&
+        (nTileSize % 16) == 0)
+    {
+        aosWorkFileOptions.SetNameValue("TILED", "YES");
+        aosWorkFileOptions.SetNameValue("BLOCKXSIZE",
+                                        CPLSPrintf("%d", nTileSize));
+        aosWorkFileOptions.SetNameValue("BLOCKYSIZE",
+                                        CPLSPrintf("%d", nTileSize));
+    }
+
+    const CPLString osValTmpFile = osTmpFile + "fill_val_work.tif";
+    auto poValDS =
+        std::unique_ptr<GDALDataset>(GDALDataset::FromHandle(GDALCreate(
+            hDriver, osValTmpFile, nXSize, nYSize, 1,
+            GDALGetRasterDataType(hTargetBand), aosWorkFileOptions.List())));
+    if (poValDS == nullptr)
+    {
+        CPLError(
+            CE_Failure, CPLE_AppDefined,
+            "Could not create XY value work file. Check driver capabilities.");
+        return CE_Failure;
+    }
+    poValDS->MarkSuppressOnClose();
+    GDALRasterBandH hValBand =
+        GDALRasterBand::ToHandle(poValDS->GetRasterBand(1));
+
+    std::unique_ptr<GDALDataset> poFiltMaskDS;
+    GDALRasterBandH hFiltMaskBand = nullptr;
+    if (nSmoothingIterations > 0)
+    {
+        const CPLString osFiltMaskTmpFile =
+            osTmpFile + "fill_filtmask_work.tif";
+        poFiltMaskDS.reset(GDALDataset::FromHandle(
+            GDALCreate(hDriver, osFiltMaskTmpFile, nXSize, nYSize, 1,
+                       GDT_Byte, aosWorkFileOptions.List())));
+        if (poFiltMaskDS == nullptr)
+        {
+            CPLError(
+                CE_Failure, CPLE_AppDefined,
+                "Could not create mask work file. Check driver capabilities.");
+            return CE_Failure;
+        }
+        poFiltMaskDS->MarkSuppressOnClose();
+        hFiltMaskBand =
+            GDALRasterBand::ToHandle(poFiltMaskDS->GetRasterBand(1));
+    }
+
+    CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+
+    std::mutex oIOMutex;
+    std::atomic<bool> bStop{false};
+    std::atomic<int> nTilesDone{0};
+
+    // Run oFunc() over all tiles, with a window extended by nHalo pixels
+    // around them, and report progress in [dfProgressStart, dfProgressEnd].
+    const auto RunTiles =
+        [&](int nHalo,
+            const std::function<bool(const GDALFillNodataTile &)> &oFunc,
+            const char *pszMessage, double dfProgressStart,
+            double dfProgressEnd)
+    {
+        std::vector<GDALFillNodataTile> asTiles;
+        for (int nYOff = 0; nYOff < nYSize; nYOff += nTileSize)
+        {
+            for (int nXOff = 0; nXOff < nXSize; nXOff += nTileSize)
+            {
+                GDALFillNodataTile sTile;
+                sTile.nXOff = nXOff;
+                sTile.nYOff = nYOff;
+                sTile.nXSize = std::min(nTileSize, nXSize - nXOff);
+                sTile.nYSize = std::min(nTileSize, nYSize - nYOff);
+                sTile.nWinXOff = std::max(0, nXOff - nHalo);
+                sTile.nWinYOff = std::max(0, nYOff - nHalo);
+                sTile.nWinXSize =
+                    std::min(nXSize, nXOff + sTile.nXSize + nHalo) -
+                    sTile.nWinXOff;
+                sTile.nWinYSize =
+                    std::min(nYSize, nYOff + sTile.nYSize + nHalo) -
+                    sTile.nWinYOff;
+                asTiles.push_back(sTile);
+            }
+        }
+
+        nTilesDone = 0;
+        const auto oJob = [&oFunc, &bStop, &nTilesDone](
+                              const GDALFillNodataTile &sTile)
+        {
+            try
+            {
+                if (!bStop && !oFunc(sTile))
+                    bStop = true;
+            }
+            catch (const std::bad_alloc &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "GDALFillNodata(): out of memory");
+                bStop = true;
+            }
+            ++nTilesDone;
+        };
+
+        for (const auto &sTile : asTiles)
+        {
+            if (!poJobQueue ||
+                !poJobQueue->SubmitJob([&oJob, &sTile]() { oJob(sTile); }))
+            {
+                oJob(sTile);
+            }
+        }
+
+        while (true)
+        {
+            const bool bRemaining = poJobQueue && poJobQueue->WaitEvent();
+            if (!bStop &&
+                !pfnProgress(dfProgressStart +
+                                 (dfProgressEnd - dfProgressStart) *
+                                     nTilesDone /
+                                     static_cast<double>(asTiles.size()),
+                             pszMessage, pProgressArg))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                bStop = true;
+            }
+            if (!bRemaining)
+                break;
+        }
+        if (poJobQueue)
+            poJobQueue->WaitCompletion();
+
+        return !bStop;
+    };
+
+    /* ==================================================================== */
+    /*      Interpolation of the nodata pixels of a tile, with the same     */
+    /*      top to bottom and bottom to top passes as the line by line      */
+    /*      implementation, but restricted to the tile window.              */
+    /* ==================================================================== */
+    const auto FillTile = [&](const GDALFillNodataTile &sTile)
+    {
+        const int nWinXSize = sTile.nWinXSize;
+        const size_t nWinPixels =
+            static_cast<size_t>(nWinXSize) * sTile.nWinYSize;
+        std::vector<GByte> abyWinMask(nWinPixels);
+        std::vector<float> afWinValue(nWinPixels);
+        {
+            std::lock_guard<std::mutex> oLock(oIOMutex);
+            if (GDALRasterIO(hMaskBand, GF_Read, sTile.nWinXOff,
+                             sTile.nWinYOff, nWinXSize, sTile.nWinYSize,
+                             abyWinMask.data(), nWinXSize, sTile.nWinYSize,
+                             GDT_Byte, 0, 0) != CE_None ||
+                GDALRasterIO(hTargetBand, GF_Read, sTile.nWinXOff,
+                             sTile.nWinYOff, nWinXSize, sTile.nWinYSize,
+                             afWinValue.data(), nWinXSize, sTile.nWinYSize,
+                             GDT_Float32, 0, 0) != CE_None)
+            {
+                return false;
+            }
+        }
+
+        const int iXStart = sTile.nXOff - sTile.nWinXOff;
+        const int iXEnd = iXStart + sTile.nXSize;
+        std::vector<GUInt32> anLastY(nWinXSize, nNoDataVal);
+        std::vector<GUInt32> anThisY(nWinXSize);
+        std::vector<float> afLastValue(nWinXSize);
+        std::vector<float> afThisValue(nWinXSize);
+
+        /* ---------------------------------------------------------------- */
+        /*      Top to bottom pass, keeping the result for tile lines.      */
+        /* ---------------------------------------------------------------- */
+        const size_t nTileLinesPixels =
+            static_cast<size_t>(nWinXSize) * sTile.nYSize;
+        std::vector<GUInt32> anTopDownY(nTileLinesPixels);
+        std::vector<float> afTopDownValue(nTileLinesPixels);
+        for (int iY = sTile.nWinYOff; iY < sTile.nYOff + sTile.nYSize; iY++)
+        {
+            const size_t nWinOffset =
+                static_cast<size_t>(iY - sTile.nWinYOff) * nWinXSize;
+            const GByte *pabyMask = abyWinMask.data() + nWinOffset;
+            const float *pafScanline = afWinValue.data() + nWinOffset;
+            for (int iX = 0; iX < nWinXSize; iX++)
+            {
+                if (pabyMask[iX])
+                {
+                    afThisValue[iX] = pafScanline[iX];
+                    anThisY[iX] = iY;
+                }
+                else if (iY <= sParams.dfMaxSearchDist + anLastY[iX])
+                {
+                    afThisValue[iX] = afLastValue[iX];
+                    anThisY[iX] = anLastY[iX];
+                }
+                else
+                {
+                    anThisY[iX] = nNoDataVal;
+                }
+            }
+
+            if (iY >= sTile.nYOff)
+            {
+                const size_t nOffset =
+                    static_cast<size_t>(iY - sTile.nYOff) * nWinXSize;
+                memcpy(anTopDownY.data() + nOffset, anThisY.data(),
+                       sizeof(GUInt32) * nWinXSize);
+                memcpy(afTopDownValue.data() + nOffset, afThisValue.data(),
+                       sizeof(float) * nWinXSize);
+            }
+
+            std::swap(afThisValue, afLastValue);
+            std::swap(anThisY, anLastY);
+        }
+
+        /* ---------------------------------------------------------------- */
+        /*      Bottom to top pass, interpolating tile lines.               */
+        /* ---------------------------------------------------------------- */
+        std::fill(anLastY.begin(), anLastY.end(), nNoDataVal);
+        std::vector<GByte> abyMask(nWinXSize);
+        std::vector<float> afScanline(nWinXSize);
+        std::vector<GByte> abyFiltMask(nWinXSize);
+        const size_t nTilePixels =
+            static_cast<size_t>(sTile.nXSize) * sTile.nYSize;
+        std::vector<float> afOutValue(nTilePixels);
+        std::vector<GByte> abyOutFiltMask(nTilePixels);
+        for (int iY = sTile.nWinYOff + sTile.nWinYSize - 1; iY >= sTile.nYOff;
+             iY--)
+        {
+            const size_t nWinOffset =
+                static_cast<size_t>(iY - sTile.nWinYOff) * nWinXSize;
+            const GByte *pabyWinMask = abyWinMask.data() + nWinOffset;
+            const float *pafWinScanline = afWinValue.data() + nWinOffset;
+            for (int iX = 0; iX < nWinXSize; iX++)
+            {
+                if (pabyWinMask[iX])
+                {
+                    afThisValue[iX] = pafWinScanline[iX];
+                    anThisY[iX] = iY;
+                }
+                else if (anLastY[iX] - iY <= sParams.dfMaxSearchDist)
+                {
+                    afThisValue[iX] = afLastValue[iX];
+                    anThisY[iX] = anLastY[iX];
+                }
+                else
+                {
+                    anThisY[iX] = nNoDataVal;
+                }
+            }
+
+            if (iY < sTile.nYOff + sTile.nYSize)
+            {
+                const size_t nTopDownOffset =
+                    static_cast<size_t>(iY - sTile.nYOff) * nWinXSize;
+                memcpy(abyMask.data(), pabyWinMask, nWinXSize);
+                memcpy(afScanline.data(), pafWinScanline,
+                       sizeof(float) * nWinXSize);
+                memset(abyFiltMask.data(), 0, nWinXSize);
+                GDALFillNodataLine(sParams, iY, iXStart, iXEnd, nWinXSize,
+                                   anTopDownY.data() + nTopDownOffset,
+                                   afTopDownValue.data() + nTopDownOffset,
+                                   anLastY.data(), afLastValue.data(),
+                                   abyMask.data(), afScanline.data(),
+                                   abyFiltMask.data());
+
+                const size_t nOutOffset =
+                    static_cast<size_t>(iY - sTile.nYOff) * sTile.nXSize;
+                memcpy(afOutValue.data() + nOutOffset,
+                       afScanline.data() + iXStart,
+                       sizeof(float) * sTile.nXSize);
+                for (int iX = iXStart; iX < iXEnd; iX++)
+                {
+                    abyOutFiltMask[nOutOffset + iX - iXStart] =
+                        !abyFiltMask[iX] ? 0 : abyMask[iX] ? 255 : 1;
+                }
+            }
+
+            std::swap(afThisValue, afLastValue);
+            std::swap(anThisY, anLastY);
+        }
+
+        std::lock_guard<std::mutex> oLock(oIOMutex);
+        if (GDALRasterIO(hValBand, GF_Write, sTile.nXOff, sTile.nYOff,
+                         sTile.nXSize, sTile.nYSize, afOutValue.data(),
+                         sTile.nXSize, sTile.nYSize, GDT_Float32, 0,
+                         0) != CE_None)
+        {
+            return false;
+        }
+        return hFiltMaskBand == nullptr ||
+               GDALRasterIO(hFiltMaskBand, GF_Write, sTile.nXOff, sTile.nYOff,
+                            sTile.nXSize, sTile.nYSize, abyOutFiltMask.data(),
+                            sTile.nXSize, sTile.nYSize, GDT_Byte, 0,
+                            0) == CE_None;
+    };
+
+    if (!RunTiles(sParams.nMaxSearchDist + 1, FillTile, "Filling...", 0.0,
+                  dfProgressRatio) ||
+        GDALRasterBandCopyWholeRaster(hValBand, hTargetBand, nullptr, nullptr,
+                                      nullptr) != CE_None)
+    {
+        return CE_Failure;
+    }
+
+    if (nSmoothingIterations == 0)
+        return CE_None;
+
+    /* ==================================================================== */
+    /*      Iterative 3x3 average filter over the interpolated pixels of    */
+    /*      a tile. As in GDALMultiFilter(), each iteration is computed     */
+    /*      from the result of the previous one, and the first and last     */
+    /*      lines of the raster are left untouched.                         */
+    /* ==================================================================== */
+    if (!bUserMaskBand)
+    {
+        // Force masks to be to flushed and recomputed from the filled
+        // values.
+        GDALFlushRasterCache(hMaskBand);
+    }
+
+    const auto SmoothTile = [&](const GDALFillNodataTile &sTile)
+    {
+        const int nWinXSize = sTile.nWinXSize;
+        const int nWinYSize = sTile.nWinYSize;
+        const size_t nWinPixels = static_cast<size_t>(nWinXSize) * nWinYSize;
+        std::vector<GByte> abyTMask(nWinPixels);
+        std::vector<GByte> abyFMask(nWinPixels);
+        std::vector<float> afThisPass(nWinPixels);
+        {
+            std::lock_guard<std::mutex> oLock(oIOMutex);
+            if (GDALRasterIO(hMaskBand, GF_Read, sTile.nWinXOff,
+                             sTile.nWinYOff, nWinXSize, nWinYSize,
+                             abyTMask.data(), nWinXSize, nWinYSize, GDT_Byte,
+                             0, 0) != CE_None ||
+                GDALRasterIO(hFiltMaskBand, GF_Read, sTile.nWinXOff,
+                             sTile.nWinYOff, nWinXSize, nWinYSize,
+                             abyFMask.data(), nWinXSize, nWinYSize, GDT_Byte,
+                             0, 0) != CE_None ||
+                GDALRasterIO(hTargetBand, GF_Read, sTile.nWinXOff,
+                             sTile.nWinYOff, nWinXSize, nWinYSize,
+                             afThisPass.data(), nWinXSize, nWinYSize,
+                             GDT_Float32, 0, 0) != CE_None)
+            {
+                return false;
+            }
+        }
+
+        if (bUserMaskBand)
+        {
+            for (size_t i = 0; i < nWinPixels; i++)
+            {
+                if (abyFMask[i] == 255)
+                    abyTMask[i] = 255;
+            }
+        }
+
+        // Lines on the border of the window are never filtered. Their
+        // neighbours are thus wrong (unless the border is the one of the
+        // raster), but this only propagates by one pixel per iteration,
+        // which the halo absorbs.
+        std::vector<float> afLastPass(afThisPass);
+        for (int iIter = 0; iIter < nSmoothingIterations; iIter++)
+        {
+            std::swap(afThisPass, afLastPass);
+            for (int iLine = 1; iLine < nWinYSize - 1; iLine++)
+            {
+                const size_t nOffset =
+                    static_cast<size_t>(iLine) * nWinXSize;
+                GDALFilterLine(afLastPass.data() + nOffset - nWinXSize,
+                               afLastPass.data() + nOffset,
+                               afLastPass.data() + nOffset + nWinXSize,
+                               afThisPass.data() + nOffset,
+                               abyTMask.data() + nOffset - nWinXSize,
+                               abyTMask.data() + nOffset,
+                               abyTMask.data() + nOffset + nWinXSize,
+                               abyFMask.data() + nOffset, nWinXSize);
+            }
+        }
+
+        std::lock_guard<std::mutex> oLock(oIOMutex);
+        const int nTileXOff = sTile.nXOff - sTile.nWinXOff;
+        const int nTileYOff = sTile.nYOff - sTile.nWinYOff;
+        GDALRasterIOExtraArg sExtraArg;
+        INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+        return GDALRasterBand::FromHandle(hValBand)->RasterIO(
+                   GF_Write, sTile.nXOff, sTile.nYOff, sTile.nXSize,
+                   sTile.nYSize,
+                   afThisPass.data() +
+                       static_cast<size_t>(nTileYOff) * nWinXSize + nTileXOff,
+                   sTile.nXSize, sTile.nYSize, GDT_Float32, sizeof(float),
+                   static_cast<GSpacing>(nWinXSize) * sizeof(float),
+                   &sExtraArg) == CE_None;
+    };
+
+    if (!RunTiles(nSmoothingIterations, SmoothTile, "Smoothing Filter...",
+                  dfProgressRatio, 1.0) ||
+        GDALRasterBandCopyWholeRaster(hValBand, hTargetBand, nullptr, nullptr,
+                                      nullptr) != CE_None)
+    {
+        return CE_Failure;
+    }
+
+    return CE_None;
+}
+
 /************************************************************************/
 /*                           GDALFillNodata()                           */
 /************************************************************************/
@@ -385,6 +1026,13 @@ inline void QUAD_CHECK(double &dfQuadDist, float &fQuadValue, int target_x,
  * interpolated using an inverse distance weighting (INV_DIST). It is also
  * possible to choose a nearest neighbour (NEAREST) strategy.</li>
  * </ul>
+ *
+ * Starting with GDAL 3.12, when the GDAL_NUM_THREADS configuration option is
+ * set to a value greater than one, the raster is processed by tiles in
+ * parallel, provided that the maximum search distance and the number of
+ * smoothing iterations do not exceed 1024 pixels. The result is identical to
+ * the single-threaded one.
+ *
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
  *
@@ -464,12 +1112,31 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
 
     const CPLString osTmpFile = CPLGenerateTempFilenameSafe("");
 
+    /* -------------------------------------------------------------------- */
+    /*      Process the raster by tiles on the global thread pool when      */
+    /*      multithreading is requested, and the search distance and        */
+    /*      number of smoothing iterations are small enough.                */
+    /* -------------------------------------------------------------------- */
+    const int nThreads = GDALGetNumThreads();
+    bool bTiled = false;
+    int nTileSize = 0;
+    if (nThreads > 1 && nMaxSearchDist < FILL_NODATA_MAX_TILED_HALO &&
+        nSmoothingIterations <= FILL_NODATA_MAX_TILED_HALO)
+    {
+        const int nHalo = std::max(nMaxSearchDist + 1, nSmoothingIterations);
+        nTileSize =
+            atoi(CPLGetConfigOption("GDAL_FILL_NODATA_TILE_SIZE", "0"));
+        if (nTileSize <= 0)
+            nTileSize = std::max(256, (nHalo + 255) / 256 * 256);
+        bTiled = nXSize > nTileSize || nYSize > nTileSize;
+    }
+
     std::unique_ptr<GDALDataset> poTmpMaskDS;
     if (hMaskBand == nullptr)
     {
         hMaskBand = GDALGetMaskBand(hTargetBand);
     }
-    else if (nSmoothingIterations > 0 &&
+    else if (!bTiled && nSmoothingIterations > 0 &&
              hMaskBand != GDALGetMaskBand(hTargetBand))
     {
         // If doing smoothing operations and the user provided its own
@@ -521,6 +1188,22 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
         return CE_Failure;
     }
 
+    GDALFillNodataParams sParams;
+    sParams.dfMaxSearchDist = dfMaxSearchDist;
+    sParams.nMaxSearchDist = nMaxSearchDist;
+    sParams.bNearest = bNearest;
+    sParams.bHasNoData = bHasNoData;
+    sParams.fNoData = fNoData;
+    sParams.nNoDataVal = nNoDataVal;
+
+    if (bTiled)
+    {
+        return GDALFillNodataTiled(hTargetBand, hMaskBand, sParams,
+                                   nSmoothingIterations, nThreads, nTileSize,
+                                   hDriver, osTmpFile, aosWorkFileOptions,
+                                   dfProgressRatio, pfnProgress, pProgressArg);
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Create a work file to hold the Y "last value" indices.          */
     /* -------------------------------------------------------------------- */
@@ -781,138 +1464,9 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
         /* --------------------------------------------------------------------
          */
         memset(pabyFiltMask, 0, nXSize);
-        for (int iX = 0; iX < nXSize; iX++)
-        {
-            int nThisMaxSearchDist = nMaxSearchDist;
-
-            // If this was a valid target - no change.
-            if (pabyMask[iX])
-                continue;
-
-            enum Quadrants
-            {
-                QUAD_TOP_LEFT = 0,
-                QUAD_BOTTOM_LEFT = 1,
-                QUAD_TOP_RIGHT = 2,
-                QUAD_BOTTOM_RIGHT = 3,
-            };
-
-            constexpr int QUAD_COUNT = 4;
-            double adfQuadDist[QUAD_COUNT] = {};
-            float afQuadValue[QUAD_COUNT] = {};
-
-            for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
-            {
-                adfQuadDist[iQuad] = dfMaxSearchDist + 1.0;
-                afQuadValue[iQuad] = 0.0;
-            }
-
-            // Step left and right by one pixel searching for the closest
-            // target value for each quadrant.
-            for (int iStep = 0; iStep <= nThisMaxSearchDist; iStep++)
-            {
-                const int iLeftX = std::max(0, iX - iStep);
-                const int iRightX = std::min(nXSize - 1, iX + iStep);
-
-                // Top left includes current line.
-                QUAD_CHECK(adfQuadDist[QUAD_TOP_LEFT],
-                           afQuadValue[QUAD_TOP_LEFT], iLeftX,
-                           panTopDownY[iLeftX], iX, iY, pafTopDownValue[iLeftX],
-                           nNoDataVal);
-
-                // Bottom left.
-                QUAD_CHECK(adfQuadDist[QUAD_BOTTOM_LEFT],
-                           afQuadValue[QUAD_BOTTOM_LEFT], iLeftX,
-                           panLastY[iLeftX], iX, iY, pafLastValue[iLeftX],
-                           nNoDataVal);
-
-                // Top right and bottom right do no include center pixel.
-                if (iStep == 0)
-                    continue;
-
-                // Top right includes current line.
-                QUAD_CHECK(adfQuadDist[QUAD_TOP_RIGHT],
-                           afQuadValue[QUAD_TOP_RIGHT], iRightX,
-                           panTopDownY[iRightX], iX, iY,
-                           pafTopDownValue[iRightX], nNoDataVal);
-
-                // Bottom right.
-                QUAD_CHECK(adfQuadDist[QUAD_BOTTOM_RIGHT],
-                           afQuadValue[QUAD_BOTTOM_RIGHT], iRightX,
-                           panLastY[iRightX], iX, iY, pafLastValue[iRightX],
-                           nNoDataVal);
-
-                // Every four steps, recompute maximum distance.
-                if ((iStep & 0x3) == 0)
-                    nThisMaxSearchDist = static_cast<int>(floor(
-                        std::max(std::max(adfQuadDist[0], adfQuadDist[1]),
-                                 std::max(adfQuadDist[2], adfQuadDist[3]))));
-            }
-
-            bool bHasSrcValues = false;
-            if (bNearest)
-            {
-                double dfNearestDist = dfMaxSearchDist + 1;
-                float fNearestValue = 0.0f;
-
-                for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
-                {
-                    if (adfQuadDist[iQuad] < dfNearestDist)
-                    {
-                        bHasSrcValues = true;
-                        if (!bHasNoData || afQuadValue[iQuad] != fNoData)
-                        {
-                            fNearestValue = afQuadValue[iQuad];
-                            dfNearestDist = adfQuadDist[iQuad];
-                        }
-                    }
-                }
-
-                if (bHasSrcValues)
-                {
-                    pabyFiltMask[iX] = 255;
-                    if (dfNearestDist <= dfMaxSearchDist)
-                    {
-                        pabyMask[iX] = 255;
-                        pafScanline[iX] = fNearestValue;
-                    }
-                    else
-                        pafScanline[iX] = fNoData;
-                }
-            }
-            else
-            {
-                double dfWeightSum = 0.0;
-                double dfValueSum = 0.0;
-
-                for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
-                {
-                    if (adfQuadDist[iQuad] <= dfMaxSearchDist)
-                    {
-                        bHasSrcValues = true;
-                        if (!bHasNoData || afQuadValue[iQuad] != fNoData)
-                        {
-                            const double dfWeight = 1.0 / adfQuadDist[iQuad];
-                            dfWeightSum += dfWeight;
-                            dfValueSum += double(afQuadValue[iQuad]) * dfWeight;
-                        }
-                    }
-                }
-
-                if (bHasSrcValues)
-                {
-                    pabyFiltMask[iX] = 255;
-                    if (dfWeightSum > 0.0)
-                    {
-                        pabyMask[iX] = 255;
-                        pafScanline[iX] =
-                            static_cast<float>(dfValueSum / dfWeightSum);
-                    }
-                    else
-                        pafScanline[iX] = fNoData;
-                }
-            }
-        }
+        GDALFillNodataLine(sParams, iY, 0, nXSize, nXSize, panTopDownY,
+                           pafTopDownValue, panLastY, pafLastValue, pabyMask,
+                           pafScanline, pabyFiltMask);
 
         /* --------------------------------------------------------------------
          */
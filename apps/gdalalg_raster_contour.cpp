@@ -83,6 +83,7 @@ GDALRasterContourAlgorithm::GDALRasterContourAlgorithm(bool standaloneStep)
            _("Group n features per transaction (default 100 000)"),
            &m_groupTransactions)
         .SetMinValueIncluded(0);
+    AddNumThreadsArg(&m_numThreads, &m_numThreadsStr);
 }
 
 /************************************************************************/
@@ -252,6 +253,8 @@ bool GDALRasterContourAlgorithm::RunStep(GDALPipelineStepRunContext &ctxt)
 
         if (bRet)
         {
+            papszStringOptions = CSLSetNameValue(
+                papszStringOptions, "NUM_THREADS", m_numThreadsStr.c_str());
             bRet = GDALContourGenerateEx(hBand, hLayer, papszStringOptions,
                                          ctxt.m_pfnProgress,
                                          ctxt.m_pProgressData) == CE_None;
@@ -12,6 +12,7 @@
 
 #include "gdalalg_raster_fill_nodata.h"
 
+#include "cpl_conv.h"
 #include "cpl_progress.h"
 #include "gdal_priv.h"
 #include "gdal_alg.h"
@@ -65,6 +66,8 @@ GDALRasterFillNodataAlgorithm::GDALRasterFillNodataAlgorithm(
            &m_strategy)
         .SetDefault(m_strategy)
         .SetChoices("invdist", "nearest");
+
+    AddNumThreadsArg(&m_numThreads, &m_numThreadsStr);
 }
 
 /************************************************************************/
@@ -112,6 +115,8 @@ bool GDALRasterFillNodataAlgorithm::RunStep(GDALPipelineStepRunContext &ctxt)
 
     pScaledData.reset(
         GDALCreateScaledProgress(0.5, 1.0, pfnProgress, pProgressData));
+    CPLConfigOptionSetter oNumThreadsSetter(
+        "GDAL_NUM_THREADS", m_numThreadsStr.c_str(), false);
     const auto retVal = GDALFillNodata(
         dstBand, maskBand, m_maxDistance, 0, m_smoothingIterations,
         aosFillOptions.List(), pScaledData ? GDALScaledProgress : nullptr,
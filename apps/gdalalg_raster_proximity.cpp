@@ -55,6 +55,20 @@ GDALRasterProximityAlgorithm::GDALRasterProximityAlgorithm(bool standaloneStep)
            _("Specify a nodata value to use for pixels that are beyond the "
              "maximum distance"),
            &m_noDataValue);
+    AddArg("algorithm", 0,
+           _("Algorithm: 'sweep' (low memory) or 'edt' (exact Euclidean "
+             "distance transform, multithreaded)"),
+           &m_algorithm)
+        .SetChoices("sweep", "edt")
+        .SetDefault(m_algorithm);
+    AddArg("output-value", 0,
+           _("What to output: distance to the nearest target pixel, value "
+             "of the nearest target pixel or index of the nearest target "
+             "pixel (the last two imply --algorithm edt)"),
+           &m_outputValue)
+        .SetChoices("distance", "nearest-value", "nearest-index")
+        .SetDefault(m_outputValue);
+    AddNumThreadsArg(&m_numThreads, &m_numThreadsStr);
 }
 
 /************************************************************************/
@@ -69,6 +83,15 @@ bool GDALRasterProximityAlgorithm::RunStep(GDALPipelineStepRunContext &ctxt)
     auto poSrcDS = m_inputDataset[0].GetDatasetRef();
     CPLAssert(poSrcDS);
 
+    if (m_outputValue != "distance" && m_algorithm != "edt" &&
+        GetArg("algorithm")->IsExplicitlySet())
+    {
+        ReportError(CE_Failure, CPLE_IllegalArg,
+                    "--output-value %s requires --algorithm edt",
+                    m_outputValue.c_str());
+        return false;
+    }
+
     GDALDataType outputType = GDT_Float32;
     if (!m_outputDataType.empty())
     {
@@ -130,6 +153,22 @@ bool GDALRasterProximityAlgorithm::RunStep(GDALPipelineStepRunContext &ctxt)
             CPLSPrintf("VALUES=%s", targetPixelValues.c_str()));
     }
 
+    if (m_algorithm == "edt" || m_outputValue != "distance")
+    {
+        proximityOptions.AddString("ALGORITHM=EDT");
+    }
+
+    if (m_outputValue == "nearest-value")
+    {
+        proximityOptions.AddString("OUTPUT=NEAREST_VALUE");
+    }
+    else if (m_outputValue == "nearest-index")
+    {
+        proximityOptions.AddString("OUTPUT=NEAREST_INDEX");
+    }
+
+    CPLConfigOptionSetter oNumThreadsSetter(
+        "GDAL_NUM_THREADS", m_numThreadsStr.c_str(), false);
     const auto error = GDALComputeProximity(srcBand, dstBand, proximityOptions,
                                             pfnProgress, pProgressData);
     if (error == CE_None)
@@ -44,6 +44,13 @@ class GDALRasterProximityAlgorithm /* non final */
     std::string m_distanceUnits = "pixel";  // pixel|geo
     double m_maxDistance = 0.0;
     double m_fixedBufferValue = 0.0;
+    std::string m_algorithm = "sweep";       // sweep|edt
+    std::string m_outputValue =
+        "distance";  // distance|nearest-value|nearest-index
+    int m_numThreads = 0;
+
+    // Work variables
+    std::string m_numThreadsStr{"ALL_CPUS"};
 };
 
 /************************************************************************/
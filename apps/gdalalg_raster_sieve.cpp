@@ -51,6 +51,8 @@ GDALRasterSieveAlgorithm::GDALRasterSieveAlgorithm(bool standaloneStep)
     AddArg("connect-diagonal-pixels", 'c',
            _("Consider diagonal pixels as connected"), &m_connectDiagonalPixels)
         .SetDefault(m_connectDiagonalPixels);
+
+    AddNumThreadsArg(&m_numThreads, &m_numThreadsStr);
 }
 
 /************************************************************************/
@@ -88,6 +90,8 @@ bool GDALRasterSieveAlgorithm::RunStep(GDALPipelineStepRunContext &ctxt)
 
     pScaledData.reset(
         GDALCreateScaledProgress(0.5, 1.0, pfnProgress, pProgressData));
+    CPLConfigOptionSetter oNumThreadsSetter(
+        "GDAL_NUM_THREADS", m_numThreadsStr.c_str(), false);
     const CPLErr err = GDALSieveFilter(
         dstBand, maskBand, dstBand, m_sizeThreshold,
         m_connectDiagonalPixels ? 8 : 4, nullptr,
@@ -169,6 +169,13 @@ class GDALVectorGeomOneToOneAlgorithmLayer /* non final */
         return m_iGeomIdx < 0 || idx == m_iGeomIdx;
     }
 
+    // TranslateFeature() is const and only modifies the passed feature.
+    // OGRGeometry methods using GEOS create their own GEOS context.
+    bool IsTranslateFeatureThreadSafe() const override
+    {
+        return true;
+    }
+
     virtual std::unique_ptr<OGRFeature>
     TranslateFeature(std::unique_ptr<OGRFeature> poSrcFeature) const = 0;
 
@@ -384,6 +384,10 @@ bool GDALVectorLayerAlgebraAlgorithm::RunImpl(GDALProgressFunc pfnProgress,
         aosOptions.SetNameValue("PROMOTE_TO_MULTI", "YES");
     }
 
+    // Avoid a full scan of the method layer for each input feature when the
+    // method layer has no efficient spatial filtering.
+    aosOptions.SetNameValue("METHOD_LAYER_INDEX", "AUTO");
+
     const std::map<std::string, decltype(&OGRLayer::Union)>
         mapOperationToMethod = {
             {"union", &OGRLayer::Union},
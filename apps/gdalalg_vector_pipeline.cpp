@@ -41,7 +41,9 @@
 #include "../frmts/mem/memdataset.h"
 
 #include "cpl_conv.h"
+#include "cpl_error_internal.h"
 #include "cpl_string.h"
+#include "gdal_thread_pool.h"
 
 #include <algorithm>
 #include <cassert>
@@ -324,6 +326,76 @@ void GDALVectorPipelineOutputLayer::ResetReading()
     m_srcLayer.ResetReading();
     m_pendingFeatures.clear();
     m_idxInPendingFeatures = 0;
+    m_nTranslateThreads = 0;
+}
+
+/************************************************************************/
+/*          GDALVectorPipelineOutputLayer::TranslateNextBatch()         */
+/************************************************************************/
+
+/** Read a batch of source features and translate them on the global thread
+ * pool into m_pendingFeatures, in the order of source features.
+ *
+ * Source features are read by the calling thread only.
+ *
+ * @return false when there are no more source features.
+ */
+bool GDALVectorPipelineOutputLayer::TranslateNextBatch()
+{
+    // Large enough to amortize the scheduling of jobs, small enough to
+    // not hold too many features in memory.
+    constexpr int FEATURES_PER_THREAD_IN_BATCH = 64;
+    // Several jobs per thread to balance features of varying complexity
+    constexpr int JOBS_PER_THREAD = 4;
+
+    const size_t nBatchSize =
+        static_cast<size_t>(m_nTranslateThreads) * FEATURES_PER_THREAD_IN_BATCH;
+    std::vector<std::unique_ptr<OGRFeature>> apoSrcFeatures;
+    apoSrcFeatures.reserve(nBatchSize);
+    while (apoSrcFeatures.size() < nBatchSize)
+    {
+        auto poSrcFeature =
+            std::unique_ptr<OGRFeature>(m_srcLayer.GetNextFeature());
+        if (!poSrcFeature)
+            break;
+        apoSrcFeatures.push_back(std::move(poSrcFeature));
+    }
+    if (apoSrcFeatures.empty())
+        return false;
+
+    const size_t nFeatures = apoSrcFeatures.size();
+    const size_t nJobs = std::min(
+        nFeatures, static_cast<size_t>(m_nTranslateThreads) * JOBS_PER_THREAD);
+    std::vector<std::vector<std::unique_ptr<OGRFeature>>> aapoOutFeatures(
+        nJobs);
+    CPLErrorAccumulator oErrorAccumulator;
+    auto poQueue =
+        GDALGetGlobalThreadPool(m_nTranslateThreads)->CreateJobQueue();
+    for (size_t iJob = 0; iJob < nJobs; ++iJob)
+    {
+        const size_t iStart = iJob * nFeatures / nJobs;
+        const size_t iEnd = (iJob + 1) * nFeatures / nJobs;
+        poQueue->SubmitJob(
+            [this, &apoSrcFeatures, &aapoOutFeatures, &oErrorAccumulator, iJob,
+             iStart, iEnd]()
+            {
+                auto oAccumulator = oErrorAccumulator.InstallForCurrentScope();
+                for (size_t i = iStart; i < iEnd; ++i)
+                {
+                    TranslateFeature(std::move(apoSrcFeatures[i]),
+                                     aapoOutFeatures[iJob]);
+                }
+            });
+    }
+    poQueue->WaitCompletion();
+    oErrorAccumulator.ReplayErrors();
+
+    for (auto &apoOutFeatures : aapoOutFeatures)
+    {
+        for (auto &poOutFeature : apoOutFeatures)
+            m_pendingFeatures.push_back(std::move(poOutFeature));
+    }
+    return true;
 }
 
 /************************************************************************/
@@ -341,13 +413,33 @@ OGRFeature *GDALVectorPipelineOutputLayer::GetNextRawFeature()
     }
     m_pendingFeatures.clear();
     m_idxInPendingFeatures = 0;
+
+    if (m_nTranslateThreads == 0)
+    {
+        m_nTranslateThreads =
+            IsTranslateFeatureThreadSafe() ? GDALGetNumThreads() : 1;
+        if (m_nTranslateThreads > 1 &&
+            !GDALGetGlobalThreadPool(m_nTranslateThreads))
+        {
+            m_nTranslateThreads = 1;
+        }
+    }
+
     while (true)
     {
-        auto poSrcFeature =
-            std::unique_ptr<OGRFeature>(m_srcLayer.GetNextFeature());
-        if (!poSrcFeature)
-            return nullptr;
-        TranslateFeature(std::move(poSrcFeature), m_pendingFeatures);
+        if (m_nTranslateThreads > 1)
+        {
+            if (!TranslateNextBatch())
+                return nullptr;
+        }
+        else
+        {
+            auto poSrcFeature =
+                std::unique_ptr<OGRFeature>(m_srcLayer.GetNextFeature());
+            if (!poSrcFeature)
+                return nullptr;
+            TranslateFeature(std::move(poSrcFeature), m_pendingFeatures);
+        }
         if (!m_pendingFeatures.empty())
             break;
     }
@@ -172,6 +172,16 @@ class GDALVectorPipelineOutputLayer /* non final */
 
     OGRLayer &m_srcLayer;
 
+    /** Whether TranslateFeature() may be called concurrently from several
+     * threads on different features. If so, GetNextRawFeature() translates
+     * batches of source features on the global thread pool when
+     * GDAL_NUM_THREADS is greater than one.
+     */
+    virtual bool IsTranslateFeatureThreadSafe() const
+    {
+        return false;
+    }
+
   public:
     void ResetReading() override;
     OGRFeature *GetNextRawFeature();
@@ -179,6 +189,10 @@ class GDALVectorPipelineOutputLayer /* non final */
   private:
     std::vector<std::unique_ptr<OGRFeature>> m_pendingFeatures{};
     size_t m_idxInPendingFeatures = 0;
+    // Number of threads used to translate features. 0 if not determined yet
+    int m_nTranslateThreads = 0;
+
+    bool TranslateNextBatch();
 };
 
 /************************************************************************/
@@ -113,6 +113,7 @@ GDALVectorRasterizeAlgorithm::GDALVectorRasterizeAlgorithm(bool bStandaloneStep)
            &m_optimization)
         .SetChoices("AUTO", "RASTER", "VECTOR")
         .SetDefault("AUTO");
+    AddNumThreadsArg(&m_numThreads, &m_numThreadsStr);
 
     if (bStandaloneStep)
     {
@@ -323,6 +324,8 @@ bool GDALVectorRasterizeAlgorithm::RunStep(GDALPipelineStepRunContext &ctxt)
             GDALDataset::ToHandle(m_outputDataset.GetDatasetRef());
 
         GDALDatasetH hSrcDS = GDALDataset::ToHandle(poSrcDS);
+        CPLConfigOptionSetter oNumThreadsSetter(
+            "GDAL_NUM_THREADS", m_numThreadsStr.c_str(), false);
         auto poRetDS = GDALDataset::FromHandle(GDALRasterize(
             outputFilename.c_str(), hDstDS, hSrcDS, psOptions.get(), nullptr));
         bOK = poRetDS != nullptr;
@@ -93,10 +93,15 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
+#include <condition_variable>
 #include <limits>
+#include <mutex>
+#include <vector>
 
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_float.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
@@ -104,6 +109,7 @@
 #include "cpl_vsi_virtual.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 #if defined(__x86_64__) || defined(_M_X64)
 #define HAVE_16_SSE_REG
@@ -307,6 +313,468 @@ GInt32 INTERPOL(GInt32 a, GInt32 b, int bSrcHasNoData, GInt32 fSrcNoDataValue)
     return nVal;
 }
 
+/************************************************************************/
+/*                  GDALGeneric3x3ProcessingContext                     */
+/************************************************************************/
+
+// Settings of the computation of output lines
+template <class T> struct GDALGeneric3x3ProcessingContext
+{
+    int nXSize = 0;
+    int nYSize = 0;
+    bool bSrcHasNoData = false;
+    T fSrcNoDataValue = 0;
+    bool bIsSrcNoDataNan = false;
+    float fDstNoDataValue = 0;
+    typename GDALGeneric3x3ProcessingAlg<T>::type pfnAlg = nullptr;
+    typename GDALGeneric3x3ProcessingAlg_multisample<T>::type
+        pfnAlg_multisample = nullptr;
+    const AlgorithmParameters *pData = nullptr;
+    bool bComputeAtEdges = false;
+
+    // Whether the first and last lines are computed, or set to nodata
+    bool ComputeFirstAndLastLines() const
+    {
+        return bComputeAtEdges && nXSize >= 2 && nYSize >= 2;
+    }
+};
+
+/************************************************************************/
+/*                 GDALGeneric3x3LineHasNoData()                        */
+/************************************************************************/
+
+template <class T>
+static bool
+GDALGeneric3x3LineHasNoData(const GDALGeneric3x3ProcessingContext<T> &ctxt,
+                            const T *pafLine)
+{
+    if (!ctxt.bSrcHasNoData)
+        return false;
+
+    const int nXSize = ctxt.nXSize;
+    const T fSrcNoDataValue = ctxt.fSrcNoDataValue;
+    if constexpr (std::numeric_limits<T>::is_integer)
+    {
+        int iX = 0;
+        for (; iX + 3 < nXSize; iX += 4)
+        {
+            if (pafLine[iX] == fSrcNoDataValue ||
+                pafLine[iX + 1] == fSrcNoDataValue ||
+                pafLine[iX + 2] == fSrcNoDataValue ||
+                pafLine[iX + 3] == fSrcNoDataValue)
+            {
+                return true;
+            }
+        }
+        for (; iX < nXSize; iX++)
+        {
+            if (pafLine[iX] == fSrcNoDataValue)
+                return true;
+        }
+    }
+    else
+    {
+        int iX = 0;
+        for (; iX + 3 < nXSize; iX += 4)
+        {
+            if (pafLine[iX] == fSrcNoDataValue || std::isnan(pafLine[iX]) ||
+                pafLine[iX + 1] == fSrcNoDataValue ||
+                std::isnan(pafLine[iX + 1]) ||
+                pafLine[iX + 2] == fSrcNoDataValue ||
+                std::isnan(pafLine[iX + 2]) ||
+                pafLine[iX + 3] == fSrcNoDataValue ||
+                std::isnan(pafLine[iX + 3]))
+            {
+                return true;
+            }
+        }
+        for (; iX < nXSize; iX++)
+        {
+            if (pafLine[iX] == fSrcNoDataValue || std::isnan(pafLine[iX]))
+                return true;
+        }
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                 GDALGeneric3x3ProcessFirstLine()                     */
+/************************************************************************/
+
+// Compute the first output line from the first two source lines, when
+// ctxt.ComputeFirstAndLastLines() is true.
+template <class T>
+static void
+GDALGeneric3x3ProcessFirstLine(const GDALGeneric3x3ProcessingContext<T> &ctxt,
+                               const T *pafLine1, const T *pafLine2,
+                               float *pafOutputBuf)
+{
+    const int nXSize = ctxt.nXSize;
+    const bool bSrcHasNoData = ctxt.bSrcHasNoData;
+    const T fSrcNoDataValue = ctxt.fSrcNoDataValue;
+    for (int j = 0; j < nXSize; j++)
+    {
+        int jmin = (j == 0) ? j : j - 1;
+        int jmax = (j == nXSize - 1) ? j : j + 1;
+
+        T afWin[9] = {INTERPOL(pafLine1[jmin], pafLine2[jmin], bSrcHasNoData,
+                               fSrcNoDataValue),
+                      INTERPOL(pafLine1[j], pafLine2[j], bSrcHasNoData,
+                               fSrcNoDataValue),
+                      INTERPOL(pafLine1[jmax], pafLine2[jmax], bSrcHasNoData,
+                               fSrcNoDataValue),
+                      pafLine1[jmin],
+                      pafLine1[j],
+                      pafLine1[jmax],
+                      pafLine2[jmin],
+                      pafLine2[j],
+                      pafLine2[jmax]};
+        pafOutputBuf[j] =
+            ComputeVal(bSrcHasNoData, fSrcNoDataValue, ctxt.bIsSrcNoDataNan,
+                       afWin, ctxt.fDstNoDataValue, ctxt.pfnAlg, ctxt.pData,
+                       ctxt.bComputeAtEdges);
+    }
+}
+
+/************************************************************************/
+/*                   GDALGeneric3x3ProcessLine()                        */
+/************************************************************************/
+
+// Compute an output line, that is neither the first nor the last one, from
+// the source lines above it, at it and below it.
+template <class T>
+static void
+GDALGeneric3x3ProcessLine(const GDALGeneric3x3ProcessingContext<T> &ctxt,
+                          const T *pafLine1, const T *pafLine2,
+                          const T *pafLine3, bool bOneOfThreeLinesHasNoData,
+                          float *pafOutputBuf)
+{
+    const int nXSize = ctxt.nXSize;
+    const bool bSrcHasNoData = ctxt.bSrcHasNoData;
+    const T fSrcNoDataValue = ctxt.fSrcNoDataValue;
+
+    // Move a 3x3 pafWindow over each cell
+    // (where the cell in question is #4)
+    //
+    //      0 1 2
+    //      3 4 5
+    //      6 7 8
+
+    if (ctxt.bComputeAtEdges && nXSize >= 2)
+    {
+        int j = 0;
+        T afWin[9] = {
+            INTERPOL(pafLine1[j], pafLine1[j + 1], bSrcHasNoData,
+                     fSrcNoDataValue),
+            pafLine1[j],
+            pafLine1[j + 1],
+            INTERPOL(pafLine2[j], pafLine2[j + 1], bSrcHasNoData,
+                     fSrcNoDataValue),
+            pafLine2[j],
+            pafLine2[j + 1],
+            INTERPOL(pafLine3[j], pafLine3[j + 1], bSrcHasNoData,
+                     fSrcNoDataValue),
+            pafLine3[j],
+            pafLine3[j + 1]};
+
+        pafOutputBuf[j] = ComputeVal(
+            bOneOfThreeLinesHasNoData, fSrcNoDataValue, ctxt.bIsSrcNoDataNan,
+            afWin, ctxt.fDstNoDataValue, ctxt.pfnAlg, ctxt.pData,
+            ctxt.bComputeAtEdges);
+    }
+    else
+    {
+        // Exclude the edges
+        pafOutputBuf[0] = ctxt.fDstNoDataValue;
+    }
+
+    int j = 1;
+    if (ctxt.pfnAlg_multisample && !bOneOfThreeLinesHasNoData)
+    {
+        j = ctxt.pfnAlg_multisample(pafLine1, pafLine2, pafLine3, nXSize,
+                                    ctxt.pData, pafOutputBuf);
+    }
+
+    for (; j < nXSize - 1; j++)
+    {
+        T afWin[9] = {pafLine1[j - 1], pafLine1[j], pafLine1[j + 1],
+                      pafLine2[j - 1], pafLine2[j], pafLine2[j + 1],
+                      pafLine3[j - 1], pafLine3[j], pafLine3[j + 1]};
+
+        pafOutputBuf[j] = ComputeVal(
+            bOneOfThreeLinesHasNoData, fSrcNoDataValue, ctxt.bIsSrcNoDataNan,
+            afWin, ctxt.fDstNoDataValue, ctxt.pfnAlg, ctxt.pData,
+            ctxt.bComputeAtEdges);
+    }
+
+    if (ctxt.bComputeAtEdges && nXSize >= 2)
+    {
+        j = nXSize - 1;
+
+        T afWin[9] = {pafLine1[j - 1],
+                      pafLine1[j],
+                      INTERPOL(pafLine1[j], pafLine1[j - 1], bSrcHasNoData,
+                               fSrcNoDataValue),
+                      pafLine2[j - 1],
+                      pafLine2[j],
+                      INTERPOL(pafLine2[j], pafLine2[j - 1], bSrcHasNoData,
+                               fSrcNoDataValue),
+                      pafLine3[j - 1],
+                      pafLine3[j],
+                      INTERPOL(pafLine3[j], pafLine3[j - 1], bSrcHasNoData,
+                               fSrcNoDataValue)};
+
+        pafOutputBuf[j] = ComputeVal(
+            bOneOfThreeLinesHasNoData, fSrcNoDataValue, ctxt.bIsSrcNoDataNan,
+            afWin, ctxt.fDstNoDataValue, ctxt.pfnAlg, ctxt.pData,
+            ctxt.bComputeAtEdges);
+    }
+    else
+    {
+        // Exclude the edges
+        if (nXSize > 1)
+            pafOutputBuf[nXSize - 1] = ctxt.fDstNoDataValue;
+    }
+}
+
+/************************************************************************/
+/*                  GDALGeneric3x3ProcessLastLine()                     */
+/************************************************************************/
+
+// Compute the last output line from the last two source lines, when
+// ctxt.ComputeFirstAndLastLines() is true.
+template <class T>
+static void
+GDALGeneric3x3ProcessLastLine(const GDALGeneric3x3ProcessingContext<T> &ctxt,
+                              const T *pafLine1, const T *pafLine2,
+                              float *pafOutputBuf)
+{
+    const int nXSize = ctxt.nXSize;
+    const bool bSrcHasNoData = ctxt.bSrcHasNoData;
+    const T fSrcNoDataValue = ctxt.fSrcNoDataValue;
+    for (int j = 0; j < nXSize; j++)
+    {
+        int jmin = (j == 0) ? j : j - 1;
+        int jmax = (j == nXSize - 1) ? j : j + 1;
+
+        T afWin[9] = {
+            pafLine1[jmin],
+            pafLine1[j],
+            pafLine1[jmax],
+            pafLine2[jmin],
+            pafLine2[j],
+            pafLine2[jmax],
+            INTERPOL(pafLine2[jmin], pafLine1[jmin], bSrcHasNoData,
+                     fSrcNoDataValue),
+            INTERPOL(pafLine2[j], pafLine1[j], bSrcHasNoData, fSrcNoDataValue),
+            INTERPOL(pafLine2[jmax], pafLine1[jmax], bSrcHasNoData,
+                     fSrcNoDataValue),
+        };
+
+        pafOutputBuf[j] =
+            ComputeVal(bSrcHasNoData, fSrcNoDataValue, ctxt.bIsSrcNoDataNan,
+                       afWin, ctxt.fDstNoDataValue, ctxt.pfnAlg, ctxt.pData,
+                       ctxt.bComputeAtEdges);
+    }
+}
+
+/************************************************************************/
+/*              GDALGeneric3x3ProcessingMultiThreaded()                 */
+/************************************************************************/
+
+// Minimum height of the strips processed concurrently
+constexpr int GDALDEM_MIN_STRIP_HEIGHT = 64;
+// Maximum size of the source buffer of a strip
+constexpr size_t GDALDEM_MAX_STRIP_BUFFER_SIZE = 64 * 1024 * 1024;
+
+// Process the raster by horizontal strips, computed concurrently by the
+// threads of poPool. Each strip reads the source lines just above and below
+// it, so that its output is identical to the one of the line by line
+// processing.
+template <class T>
+static CPLErr GDALGeneric3x3ProcessingMultiThreaded(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hDstBand,
+    const GDALGeneric3x3ProcessingContext<T> &ctxt, GDALDataType eReadDT,
+    CPLWorkerThreadPool *poPool, int nThreads, GDALProgressFunc pfnProgress,
+    void *pProgressData)
+{
+    const int nXSize = ctxt.nXSize;
+    const int nYSize = ctxt.nYSize;
+
+    // Align strips on the destination blocks, so that they are written
+    // only once
+    int nBlockYSize = 1;
+    GDALGetBlockSize(hDstBand, nullptr, &nBlockYSize);
+    nBlockYSize = std::max(1, nBlockYSize);
+    int nStripHeight = std::max(GDALDEM_MIN_STRIP_HEIGHT,
+                                (nYSize + 4 * nThreads - 1) / (4 * nThreads));
+    nStripHeight = static_cast<int>(std::max<size_t>(
+        1, std::min<size_t>(nStripHeight, GDALDEM_MAX_STRIP_BUFFER_SIZE /
+                                                  (sizeof(T) * nXSize) -
+                                              2)));
+    // Round up to a multiple of the block height
+    const GIntBig nAlignedStripHeight =
+        (static_cast<GIntBig>(nStripHeight) + nBlockYSize - 1) / nBlockYSize *
+        nBlockYSize;
+    nStripHeight =
+        static_cast<int>(std::min<GIntBig>(nAlignedStripHeight, nYSize));
+    const int nStrips = (nYSize + nStripHeight - 1) / nStripHeight;
+
+    std::mutex oMutex;
+    std::condition_variable oCV;
+    std::mutex oIOMutex;
+    std::atomic<bool> bStop{false};
+    int nFinishedStrips = 0;
+    CPLErr eErr = CE_None;
+    CPLErrorAccumulator oErrorAccumulator;
+
+    auto poJobQueue = poPool->CreateJobQueue();
+    for (int iStrip = 0; iStrip < nStrips; ++iStrip)
+    {
+        poJobQueue->SubmitJob(
+            [&, iStrip]()
+            {
+                auto oAccumulator = oErrorAccumulator.InstallForCurrentScope();
+                CPL_IGNORE_RET_VAL(oAccumulator);
+
+                CPLErr eJobErr = bStop ? CE_Failure : CE_None;
+
+                const int nFirstLine = iStrip * nStripHeight;
+                const int nLines = std::min(nStripHeight, nYSize - nFirstLine);
+                const int nFirstReadLine = std::max(0, nFirstLine - 1);
+                const int nReadLines =
+                    std::min(nYSize, nFirstLine + nLines + 1) - nFirstReadLine;
+
+                std::vector<T> aSrcBuffer;
+                std::vector<float> afOutputBuf;
+                std::vector<bool> abLineHasNoData;
+                if (eJobErr == CE_None)
+                {
+                    try
+                    {
+                        aSrcBuffer.resize(static_cast<size_t>(nXSize) *
+                                          nReadLines);
+                        afOutputBuf.resize(static_cast<size_t>(nXSize) *
+                                           nLines);
+                        abLineHasNoData.resize(nReadLines);
+                    }
+                    catch (const std::exception &)
+                    {
+                        CPLError(CE_Failure, CPLE_OutOfMemory,
+                                 "Out of memory allocating strip buffers");
+                        eJobErr = CE_Failure;
+                    }
+                }
+
+                if (eJobErr == CE_None)
+                {
+                    std::lock_guard<std::mutex> oLock(oIOMutex);
+                    eJobErr = GDALRasterIO(hSrcBand, GF_Read, 0,
+                                           nFirstReadLine, nXSize, nReadLines,
+                                           aSrcBuffer.data(), nXSize,
+                                           nReadLines, eReadDT, 0, 0);
+                }
+
+                if (eJobErr == CE_None)
+                {
+                    for (int i = 0; i < nReadLines; ++i)
+                    {
+                        abLineHasNoData[i] = GDALGeneric3x3LineHasNoData(
+                            ctxt, aSrcBuffer.data() +
+                                      static_cast<size_t>(i) * nXSize);
+                    }
+
+                    const auto GetLine = [&](int iLine)
+                    {
+                        return aSrcBuffer.data() +
+                               static_cast<size_t>(iLine - nFirstReadLine) *
+                                   nXSize;
+                    };
+
+                    for (int i = nFirstLine;
+                         i < nFirstLine + nLines && !bStop; ++i)
+                    {
+                        float *pafOutputBuf =
+                            afOutputBuf.data() +
+                            static_cast<size_t>(i - nFirstLine) * nXSize;
+                        if (i == 0 || i == nYSize - 1)
+                        {
+                            if (!ctxt.ComputeFirstAndLastLines())
+                            {
+                                std::fill(pafOutputBuf, pafOutputBuf + nXSize,
+                                          ctxt.fDstNoDataValue);
+                            }
+                            else if (i == 0)
+                            {
+                                GDALGeneric3x3ProcessFirstLine(
+                                    ctxt, GetLine(0), GetLine(1),
+                                    pafOutputBuf);
+                            }
+                            else
+                            {
+                                GDALGeneric3x3ProcessLastLine(
+                                    ctxt, GetLine(i - 1), GetLine(i),
+                                    pafOutputBuf);
+                            }
+                        }
+                        else
+                        {
+                            const int iBuf = i - nFirstReadLine;
+                            GDALGeneric3x3ProcessLine(
+                                ctxt, GetLine(i - 1), GetLine(i),
+                                GetLine(i + 1),
+                                abLineHasNoData[iBuf - 1] ||
+                                    abLineHasNoData[iBuf] ||
+                                    abLineHasNoData[iBuf + 1],
+                                pafOutputBuf);
+                        }
+                    }
+                    if (bStop)
+                        eJobErr = CE_Failure;
+                }
+
+                if (eJobErr == CE_None)
+                {
+                    std::lock_guard<std::mutex> oLock(oIOMutex);
+                    eJobErr = GDALRasterIO(hDstBand, GF_Write, 0, nFirstLine,
+                                           nXSize, nLines, afOutputBuf.data(),
+                                           nXSize, nLines, GDT_Float32, 0, 0);
+                }
+
+                std::lock_guard<std::mutex> oLock(oMutex);
+                if (eJobErr != CE_None)
+                {
+                    eErr = eJobErr;
+                    bStop = true;
+                }
+                ++nFinishedStrips;
+                oCV.notify_one();
+            });
+    }
+
+    // Report progress from the calling thread
+    {
+        std::unique_lock<std::mutex> oLock(oMutex);
+        while (nFinishedStrips < nStrips)
+        {
+            oCV.wait(oLock);
+            if (!bStop &&
+                !pfnProgress(double(nFinishedStrips) / nStrips, nullptr,
+                             pProgressData))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                eErr = CE_Failure;
+                bStop = true;
+            }
+        }
+    }
+
+    poJobQueue->WaitCompletion();
+    oErrorAccumulator.ReplayErrors();
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                  GDALGeneric3x3Processing()                          */
 /************************************************************************/
@@ -335,19 +803,6 @@ static CPLErr GDALGeneric3x3Processing(
     const int nXSize = GDALGetRasterBandXSize(hSrcBand);
     const int nYSize = GDALGetRasterBandYSize(hSrcBand);
 
-    // 1 line destination buffer.
-    float *pafOutputBuf =
-        static_cast<float *>(VSI_MALLOC2_VERBOSE(sizeof(float), nXSize));
-    // 3 line rotating source buffer.
-    T *pafThreeLineWin =
-        static_cast<T *>(VSI_MALLOC2_VERBOSE(3 * sizeof(T), nXSize));
-    if (pafOutputBuf == nullptr || pafThreeLineWin == nullptr)
-    {
-        VSIFree(pafOutputBuf);
-        VSIFree(pafThreeLineWin);
-        return CE_Failure;
-    }
-
     GDALDataType eReadDT;
     int bSrcHasNoData = FALSE;
     const double dfNoDataValue =
@@ -394,17 +849,53 @@ static CPLErr GDALGeneric3x3Processing(
     if (!bDstHasNoData)
         fDstNoDataValue = 0.0;
 
+    GDALGeneric3x3ProcessingContext<T> ctxt;
+    ctxt.nXSize = nXSize;
+    ctxt.nYSize = nYSize;
+    ctxt.bSrcHasNoData = CPL_TO_BOOL(bSrcHasNoData);
+    ctxt.fSrcNoDataValue = fSrcNoDataValue;
+    ctxt.bIsSrcNoDataNan = bIsSrcNoDataNan;
+    ctxt.fDstNoDataValue = fDstNoDataValue;
+    ctxt.pfnAlg = pfnAlg;
+    ctxt.pfnAlg_multisample = pfnAlg_multisample;
+    ctxt.pData = pData.get();
+    ctxt.bComputeAtEdges = bComputeAtEdges;
+
+    /* -------------------------------------------------------------------- */
+    /*      Process the raster by strips when several threads can be used.  */
+    /* -------------------------------------------------------------------- */
+    const int nThreads = GDALGetNumThreads();
+    CPLWorkerThreadPool *poPool =
+        nThreads > 1 && nYSize >= 2 * GDALDEM_MIN_STRIP_HEIGHT
+            ? GDALGetGlobalThreadPool(nThreads)
+            : nullptr;
+    if (poPool)
+    {
+        const CPLErr eErr = GDALGeneric3x3ProcessingMultiThreaded(
+            hSrcBand, hDstBand, ctxt, eReadDT, poPool, nThreads, pfnProgress,
+            pProgressData);
+        if (eErr == CE_None)
+            pfnProgress(1.0, nullptr, pProgressData);
+        return eErr;
+    }
+
+    // 1 line destination buffer.
+    float *pafOutputBuf =
+        static_cast<float *>(VSI_MALLOC2_VERBOSE(sizeof(float), nXSize));
+    // 3 line rotating source buffer.
+    T *pafThreeLineWin =
+        static_cast<T *>(VSI_MALLOC2_VERBOSE(3 * sizeof(T), nXSize));
+    if (pafOutputBuf == nullptr || pafThreeLineWin == nullptr)
+    {
+        VSIFree(pafOutputBuf);
+        VSIFree(pafThreeLineWin);
+        return CE_Failure;
+    }
+
     int nLine1Off = 0;
     int nLine2Off = nXSize;
     int nLine3Off = 2 * nXSize;
 
-    // Move a 3x3 pafWindow over each cell
-    // (where the cell in question is #4)
-    //
-    //      0 1 2
-    //      3 4 5
-    //      6 7 8
-
     /* Preload the first 2 lines */
 
     bool abLineHasNoDataValue[3] = {CPL_TO_BOOL(bSrcHasNoData),
@@ -422,60 +913,15 @@ static CPLErr GDALGeneric3x3Processing(
 
             return CE_Failure;
         }
-        if (bSrcHasNoData)
-        {
-            abLineHasNoDataValue[i] = false;
-            if constexpr (std::numeric_limits<T>::is_integer)
-            {
-                for (int iX = 0; iX < nXSize; iX++)
-                {
-                    if (pafThreeLineWin[i * nXSize + iX] == fSrcNoDataValue)
-                    {
-                        abLineHasNoDataValue[i] = true;
-                        break;
-                    }
-                }
-            }
-            else
-            {
-                for (int iX = 0; iX < nXSize; iX++)
-                {
-                    if (pafThreeLineWin[i * nXSize + iX] == fSrcNoDataValue ||
-                        std::isnan(pafThreeLineWin[i * nXSize + iX]))
-                    {
-                        abLineHasNoDataValue[i] = true;
-                        break;
-                    }
-                }
-            }
-        }
+        abLineHasNoDataValue[i] =
+            GDALGeneric3x3LineHasNoData(ctxt, pafThreeLineWin + i * nXSize);
     }
 
     CPLErr eErr = CE_None;
-    if (bComputeAtEdges && nXSize >= 2 && nYSize >= 2)
+    if (ctxt.ComputeFirstAndLastLines())
     {
-        for (int j = 0; j < nXSize; j++)
-        {
-            int jmin = (j == 0) ? j : j - 1;
-            int jmax = (j == nXSize - 1) ? j : j + 1;
-
-            T afWin[9] = {
-                INTERPOL(pafThreeLineWin[jmin], pafThreeLineWin[nXSize + jmin],
-                         bSrcHasNoData, fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[j], pafThreeLineWin[nXSize + j],
-                         bSrcHasNoData, fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[jmax], pafThreeLineWin[nXSize + jmax],
-                         bSrcHasNoData, fSrcNoDataValue),
-                pafThreeLineWin[jmin],
-                pafThreeLineWin[j],
-                pafThreeLineWin[jmax],
-                pafThreeLineWin[nXSize + jmin],
-                pafThreeLineWin[nXSize + j],
-                pafThreeLineWin[nXSize + jmax]};
-            pafOutputBuf[j] = ComputeVal(
-                CPL_TO_BOOL(bSrcHasNoData), fSrcNoDataValue, bIsSrcNoDataNan,
-                afWin, fDstNoDataValue, pfnAlg, pData.get(), bComputeAtEdges);
-        }
+        GDALGeneric3x3ProcessFirstLine(ctxt, pafThreeLineWin,
+                                       pafThreeLineWin + nXSize, pafOutputBuf);
         eErr = GDALRasterIO(hDstBand, GF_Write, 0, 0, nXSize, 1, pafOutputBuf,
                             nXSize, 1, GDT_Float32, 0, 0);
     }
@@ -520,170 +966,16 @@ static CPLErr GDALGeneric3x3Processing(
 
         // In case none of the 3 lines have nodata values, then no need to
         // check it in ComputeVal()
-        bool bOneOfThreeLinesHasNoData = CPL_TO_BOOL(bSrcHasNoData);
-        if (bSrcHasNoData)
-        {
-            if constexpr (std::numeric_limits<T>::is_integer)
-            {
-                bool bLastLineHasNoDataValue = false;
-                int iX = 0;
-                for (; iX + 3 < nXSize; iX += 4)
-                {
-                    if (pafThreeLineWin[nLine3Off + iX] == fSrcNoDataValue ||
-                        pafThreeLineWin[nLine3Off + iX + 1] ==
-                            fSrcNoDataValue ||
-                        pafThreeLineWin[nLine3Off + iX + 2] ==
-                            fSrcNoDataValue ||
-                        pafThreeLineWin[nLine3Off + iX + 3] == fSrcNoDataValue)
-                    {
-                        bLastLineHasNoDataValue = true;
-                        break;
-                    }
-                }
-                if (!bLastLineHasNoDataValue)
-                {
-                    for (; iX < nXSize; iX++)
-                    {
-                        if (pafThreeLineWin[nLine3Off + iX] == fSrcNoDataValue)
-                        {
-                            bLastLineHasNoDataValue = true;
-                        }
-                    }
-                }
-                abLineHasNoDataValue[nLine3Off / nXSize] =
-                    bLastLineHasNoDataValue;
-
-                bOneOfThreeLinesHasNoData = abLineHasNoDataValue[0] ||
-                                            abLineHasNoDataValue[1] ||
-                                            abLineHasNoDataValue[2];
-            }
-            else
-            {
-                bool bLastLineHasNoDataValue = false;
-                int iX = 0;
-                for (; iX + 3 < nXSize; iX += 4)
-                {
-                    if (pafThreeLineWin[nLine3Off + iX] == fSrcNoDataValue ||
-                        std::isnan(pafThreeLineWin[nLine3Off + iX]) ||
-                        pafThreeLineWin[nLine3Off + iX + 1] ==
-                            fSrcNoDataValue ||
-                        std::isnan(pafThreeLineWin[nLine3Off + iX + 1]) ||
-                        pafThreeLineWin[nLine3Off + iX + 2] ==
-                            fSrcNoDataValue ||
-                        std::isnan(pafThreeLineWin[nLine3Off + iX + 2]) ||
-                        pafThreeLineWin[nLine3Off + iX + 3] ==
-                            fSrcNoDataValue ||
-                        std::isnan(pafThreeLineWin[nLine3Off + iX + 3]))
-                    {
-                        bLastLineHasNoDataValue = true;
-                        break;
-                    }
-                }
-                if (!bLastLineHasNoDataValue)
-                {
-                    for (; iX < nXSize; iX++)
-                    {
-                        if (pafThreeLineWin[nLine3Off + iX] ==
-                                fSrcNoDataValue ||
-                            std::isnan(pafThreeLineWin[nLine3Off + iX]))
-                        {
-                            bLastLineHasNoDataValue = true;
-                        }
-                    }
-                }
-                abLineHasNoDataValue[nLine3Off / nXSize] =
-                    bLastLineHasNoDataValue;
+        abLineHasNoDataValue[nLine3Off / nXSize] =
+            GDALGeneric3x3LineHasNoData(ctxt, pafThreeLineWin + nLine3Off);
+        const bool bOneOfThreeLinesHasNoData = abLineHasNoDataValue[0] ||
+                                               abLineHasNoDataValue[1] ||
+                                               abLineHasNoDataValue[2];
 
-                bOneOfThreeLinesHasNoData = abLineHasNoDataValue[0] ||
-                                            abLineHasNoDataValue[1] ||
-                                            abLineHasNoDataValue[2];
-            }
-        }
-
-        if (bComputeAtEdges && nXSize >= 2)
-        {
-            int j = 0;
-            T afWin[9] = {INTERPOL(pafThreeLineWin[nLine1Off + j],
-                                   pafThreeLineWin[nLine1Off + j + 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine1Off + j],
-                          pafThreeLineWin[nLine1Off + j + 1],
-                          INTERPOL(pafThreeLineWin[nLine2Off + j],
-                                   pafThreeLineWin[nLine2Off + j + 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine2Off + j],
-                          pafThreeLineWin[nLine2Off + j + 1],
-                          INTERPOL(pafThreeLineWin[nLine3Off + j],
-                                   pafThreeLineWin[nLine3Off + j + 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine3Off + j],
-                          pafThreeLineWin[nLine3Off + j + 1]};
-
-            pafOutputBuf[j] = ComputeVal(
-                bOneOfThreeLinesHasNoData, fSrcNoDataValue, bIsSrcNoDataNan,
-                afWin, fDstNoDataValue, pfnAlg, pData.get(), bComputeAtEdges);
-        }
-        else
-        {
-            // Exclude the edges
-            pafOutputBuf[0] = fDstNoDataValue;
-        }
-
-        int j = 1;
-        if (pfnAlg_multisample && !bOneOfThreeLinesHasNoData)
-        {
-            j = pfnAlg_multisample(
-                pafThreeLineWin + nLine1Off, pafThreeLineWin + nLine2Off,
-                pafThreeLineWin + nLine3Off, nXSize, pData.get(), pafOutputBuf);
-        }
-
-        for (; j < nXSize - 1; j++)
-        {
-            T afWin[9] = {pafThreeLineWin[nLine1Off + j - 1],
-                          pafThreeLineWin[nLine1Off + j],
-                          pafThreeLineWin[nLine1Off + j + 1],
-                          pafThreeLineWin[nLine2Off + j - 1],
-                          pafThreeLineWin[nLine2Off + j],
-                          pafThreeLineWin[nLine2Off + j + 1],
-                          pafThreeLineWin[nLine3Off + j - 1],
-                          pafThreeLineWin[nLine3Off + j],
-                          pafThreeLineWin[nLine3Off + j + 1]};
-
-            pafOutputBuf[j] = ComputeVal(
-                bOneOfThreeLinesHasNoData, fSrcNoDataValue, bIsSrcNoDataNan,
-                afWin, fDstNoDataValue, pfnAlg, pData.get(), bComputeAtEdges);
-        }
-
-        if (bComputeAtEdges && nXSize >= 2)
-        {
-            j = nXSize - 1;
-
-            T afWin[9] = {pafThreeLineWin[nLine1Off + j - 1],
-                          pafThreeLineWin[nLine1Off + j],
-                          INTERPOL(pafThreeLineWin[nLine1Off + j],
-                                   pafThreeLineWin[nLine1Off + j - 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine2Off + j - 1],
-                          pafThreeLineWin[nLine2Off + j],
-                          INTERPOL(pafThreeLineWin[nLine2Off + j],
-                                   pafThreeLineWin[nLine2Off + j - 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine3Off + j - 1],
-                          pafThreeLineWin[nLine3Off + j],
-                          INTERPOL(pafThreeLineWin[nLine3Off + j],
-                                   pafThreeLineWin[nLine3Off + j - 1],
-                                   bSrcHasNoData, fSrcNoDataValue)};
-
-            pafOutputBuf[j] = ComputeVal(
-                bOneOfThreeLinesHasNoData, fSrcNoDataValue, bIsSrcNoDataNan,
-                afWin, fDstNoDataValue, pfnAlg, pData.get(), bComputeAtEdges);
-        }
-        else
-        {
-            // Exclude the edges
-            if (nXSize > 1)
-                pafOutputBuf[nXSize - 1] = fDstNoDataValue;
-        }
+        GDALGeneric3x3ProcessLine(ctxt, pafThreeLineWin + nLine1Off,
+                                  pafThreeLineWin + nLine2Off,
+                                  pafThreeLineWin + nLine3Off,
+                                  bOneOfThreeLinesHasNoData, pafOutputBuf);
 
         /* -----------------------------------------
          * Write Line to Raster
@@ -715,35 +1007,11 @@ static CPLErr GDALGeneric3x3Processing(
         nLine3Off = nTemp;
     }
 
-    if (bComputeAtEdges && nXSize >= 2 && nYSize >= 2)
+    if (ctxt.ComputeFirstAndLastLines())
     {
-        for (int j = 0; j < nXSize; j++)
-        {
-            int jmin = (j == 0) ? j : j - 1;
-            int jmax = (j == nXSize - 1) ? j : j + 1;
-
-            T afWin[9] = {
-                pafThreeLineWin[nLine1Off + jmin],
-                pafThreeLineWin[nLine1Off + j],
-                pafThreeLineWin[nLine1Off + jmax],
-                pafThreeLineWin[nLine2Off + jmin],
-                pafThreeLineWin[nLine2Off + j],
-                pafThreeLineWin[nLine2Off + jmax],
-                INTERPOL(pafThreeLineWin[nLine2Off + jmin],
-                         pafThreeLineWin[nLine1Off + jmin], bSrcHasNoData,
-                         fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[nLine2Off + j],
-                         pafThreeLineWin[nLine1Off + j], bSrcHasNoData,
-                         fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[nLine2Off + jmax],
-                         pafThreeLineWin[nLine1Off + jmax], bSrcHasNoData,
-                         fSrcNoDataValue),
-            };
-
-            pafOutputBuf[j] = ComputeVal(
-                CPL_TO_BOOL(bSrcHasNoData), fSrcNoDataValue, bIsSrcNoDataNan,
-                afWin, fDstNoDataValue, pfnAlg, pData.get(), bComputeAtEdges);
-        }
+        GDALGeneric3x3ProcessLastLine(ctxt, pafThreeLineWin + nLine1Off,
+                                      pafThreeLineWin + nLine2Off,
+                                      pafOutputBuf);
         eErr = GDALRasterIO(hDstBand, GF_Write, 0, i, nXSize, 1, pafOutputBuf,
                             nXSize, 1, GDT_Float32, 0, 0);
         if (eErr != CE_None)
@@ -1294,6 +1562,114 @@ static float GDALHillshadeMultiDirectionalAlg(const T *afWin,
     return static_cast<float>(cang);
 }
 
+#ifdef HAVE_16_SSE_REG
+
+// Same computation as GDALHillshadeMultiDirectionalAlg<T, GradientAlg::HORN>,
+// done in the same order, so that results are identical.
+template <class T, class REG_T>
+static int GDALHillshadeMultiDirectionalAlg_multisample(
+    const T *pafFirstLine, const T *pafSecondLine, const T *pafThirdLine,
+    int nXSize, const AlgorithmParameters *pData, float *pafOutputBuf)
+{
+    const GDALHillshadeMultiDirectionalAlgData *psData =
+        static_cast<const GDALHillshadeMultiDirectionalAlgData *>(pData);
+    const auto reg_inv_ewres = XMMReg4Double::Set1(psData->inv_ewres_xscale);
+    const auto reg_inv_nsres = XMMReg4Double::Set1(psData->inv_nsres_yscale);
+    const auto reg_square_z = XMMReg4Double::Set1(psData->square_z);
+    const auto reg_sin_alt_mul_127 =
+        XMMReg4Double::Set1(psData->sin_altRadians_mul_127);
+    const auto reg_cos_alt_mul_z_mul_127 =
+        XMMReg4Double::Set1(psData->cos_alt_mul_z_mul_127);
+    const auto reg_cos225_az_mul_cos_alt_mul_z_mul_127 =
+        XMMReg4Double::Set1(psData->cos225_az_mul_cos_alt_mul_z_mul_127);
+    const auto reg_flat =
+        XMMReg4Double::Set1(1.0 + psData->sin_altRadians_mul_254);
+    const auto reg_zero = XMMReg4Double::Zero();
+    const auto reg_half = XMMReg4Double::Set1(0.5);
+    const auto reg_one = reg_half + reg_half;
+
+    int j = 1;  // Used after for.
+    for (; j < nXSize - 4; j += 4)
+    {
+        const T *firstLine = pafFirstLine + j - 1;
+        const T *secondLine = pafSecondLine + j - 1;
+        const T *thirdLine = pafThirdLine + j - 1;
+
+        const auto firstLine0 = REG_T::Load4Val(firstLine);
+        const auto firstLine1 = REG_T::Load4Val(firstLine + 1);
+        const auto firstLine2 = REG_T::Load4Val(firstLine + 2);
+        const auto secondLine0 = REG_T::Load4Val(secondLine);
+        const auto secondLine2 = REG_T::Load4Val(secondLine + 2);
+        const auto thirdLine0 = REG_T::Load4Val(thirdLine);
+        const auto thirdLine1 = REG_T::Load4Val(thirdLine + 1);
+        const auto thirdLine2 = REG_T::Load4Val(thirdLine + 2);
+
+        // First Slope ...
+        const auto reg_x =
+            (((firstLine0 + secondLine0) + secondLine0) + thirdLine0 -
+             (((firstLine2 + secondLine2) + secondLine2) + thirdLine2))
+                .cast_to_double() *
+            reg_inv_ewres;
+        const auto reg_y =
+            (((thirdLine0 + thirdLine1) + thirdLine1) + thirdLine2 -
+             (((firstLine0 + firstLine1) + firstLine1) + firstLine2))
+                .cast_to_double() *
+            reg_inv_nsres;
+
+        const auto reg_xx = reg_x * reg_x;
+        const auto reg_yy = reg_y * reg_y;
+        const auto reg_xx_plus_yy = reg_xx + reg_yy;
+
+        // ... then the shade value from different azimuth. Negative values
+        // are clamped to zero, while NaN is propagated as in the scalar code.
+        const auto ClampNegative = [&reg_zero](const XMMReg4Double &v)
+        {
+            return XMMReg4Double::Ternary(XMMReg4Double::Greater(reg_zero, v),
+                                          reg_zero, v);
+        };
+        const auto val225_mul_127 = ClampNegative(
+            reg_sin_alt_mul_127 +
+            (reg_x - reg_y) * reg_cos225_az_mul_cos_alt_mul_z_mul_127);
+        const auto val270_mul_127 = ClampNegative(
+            reg_sin_alt_mul_127 - reg_x * reg_cos_alt_mul_z_mul_127);
+        const auto val315_mul_127 = ClampNegative(
+            reg_sin_alt_mul_127 +
+            (reg_x + reg_y) * reg_cos225_az_mul_cos_alt_mul_z_mul_127);
+        const auto val360_mul_127 = ClampNegative(
+            reg_sin_alt_mul_127 - reg_y * reg_cos_alt_mul_z_mul_127);
+
+        // ... then the weighted shading
+        const auto weight_225 = reg_half * reg_xx_plus_yy - reg_x * reg_y;
+        const auto weight_270 = reg_xx;
+        const auto weight_315 = reg_xx_plus_yy - weight_225;
+        const auto weight_360 = reg_yy;
+        const auto reg_numerator =
+            (weight_225 * val225_mul_127 + weight_270 * val270_mul_127 +
+             weight_315 * val315_mul_127 + weight_360 * val360_mul_127) /
+            reg_xx_plus_yy;
+        const auto reg_denominator = reg_one + reg_square_z * reg_xx_plus_yy;
+#ifdef HAVE_SSE2
+        const auto cang_mul_127 =
+            reg_numerator * reg_denominator.approx_inv_sqrt(reg_one, reg_half);
+#else
+        // ApproxADivByInvSqrtB() is then a / sqrt(b)
+        double adfSqrtDenominator[4];
+        reg_denominator.Store4Val(adfSqrtDenominator);
+        for (double &dfVal : adfSqrtDenominator)
+            dfVal = sqrt(dfVal);
+        const auto cang_mul_127 =
+            reg_numerator / XMMReg4Double::Load4Val(adfSqrtDenominator);
+#endif
+
+        const auto cang = XMMReg4Double::Ternary(
+            XMMReg4Double::Equals(reg_xx_plus_yy, reg_zero), reg_flat,
+            reg_one + cang_mul_127);
+        cang.cast_to_float().Store4Val(pafOutputBuf + j);
+    }
+    return j;
+}
+#endif
+
 static std::unique_ptr<AlgorithmParameters>
 GDALCreateHillshadeMultiDirectionalData(const double *adfGeoTransform, double z,
                                         double xscale, double yscale,
@@ -3819,6 +4195,14 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
                 GDALHillshadeMultiDirectionalAlg<float, GradientAlg::HORN>;
             pfnAlgInt32 =
                 GDALHillshadeMultiDirectionalAlg<GInt32, GradientAlg::HORN>;
+#ifdef HAVE_16_SSE_REG
+            pfnAlgFloat_multisample =
+                GDALHillshadeMultiDirectionalAlg_multisample<float,
+                                                             XMMReg4Float>;
+            pfnAlgInt32_multisample =
+                GDALHillshadeMultiDirectionalAlg_multisample<GInt32,
+                                                             XMMReg4Int>;
+#endif
         }
     }
     else if (eUtilityMode == HILL_SHADE)
@@ -11,6 +11,7 @@
 # SPDX-License-Identifier: MIT
 ###############################################################################
 
+import math
 import struct
 
 import gdaltest
@@ -607,3 +608,67 @@ cellsize     1
             elev_values.append((f["ELEV_MIN"], f["ELEV_MAX"]))
 
         assert elev_values == expected_elev_values, (elev_values, expected_elev_values)
+
+
+###############################################################################
+# Test that the multi-threaded generation gives the same contours as the
+# single-threaded one
+
+
+@pytest.mark.parametrize("polygonize", [False, True])
+def test_contour_multi_threaded(polygonize):
+
+    width = 150
+    height = 700
+    src_ds = gdal.GetDriverByName("MEM").Create(
+        "", width, height, 1, gdal.GDT_Float64
+    )
+    values = []
+    for y in range(height):
+        for x in range(width):
+            if (x * 7 + y * 13) % 97 == 0:
+                values.append(-1)
+            else:
+                values.append(50 + 40 * math.sin(x * 0.1) * math.cos(y * 0.05))
+    src_ds.GetRasterBand(1).WriteRaster(
+        0, 0, width, height, struct.pack("d" * width * height, *values)
+    )
+
+    def get_contours(num_threads):
+        ogr_ds = ogr.GetDriverByName("MEM").CreateDataSource("")
+        lyr = ogr_ds.CreateLayer("contour")
+        lyr.CreateField(ogr.FieldDefn("ID", ogr.OFTInteger))
+        lyr.CreateField(ogr.FieldDefn("ELEV", ogr.OFTReal))
+        assert (
+            gdal.ContourGenerateEx(
+                src_ds.GetRasterBand(1),
+                lyr,
+                options=[
+                    "LEVEL_INTERVAL=10",
+                    "NODATA=-1",
+                    "ID_FIELD=0",
+                    "ELEV_FIELD=1",
+                    "ELEV_FIELD_MIN=1",
+                    f"POLYGONIZE={polygonize}",
+                    f"NUM_THREADS={num_threads}",
+                ],
+            )
+            == gdal.CE_None
+        )
+        ret = {}
+        for f in lyr:
+            g = f.GetGeometryRef()
+            count, length, area = ret.get(f["ELEV"], (0, 0, 0))
+            if polygonize:
+                ret[f["ELEV"]] = (count + g.GetGeometryCount(), 0, area + g.GetArea())
+            else:
+                ret[f["ELEV"]] = (count + 1, length + g.Length(), 0)
+        return ret
+
+    expected = get_contours(1)
+    got = get_contours(4)
+    assert got.keys() == expected.keys()
+    for elev in expected:
+        assert got[elev][0] == expected[elev][0], elev
+        assert got[elev][1] == pytest.approx(expected[elev][1], rel=1e-12), elev
+        assert got[elev][2] == pytest.approx(expected[elev][2], rel=1e-12), elev
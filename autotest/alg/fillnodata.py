@@ -386,3 +386,65 @@ def test_fillnodata_nearest(
         for i in range(height)
     ]
     assert got == expected
+
+
+###############################################################################
+# Check that the tiled multithreaded implementation gives the same result as
+# the line by line one
+
+
+@pytest.mark.parametrize("interpolation", ["INV_DIST", "NEAREST"])
+@pytest.mark.parametrize("smoothing_iterations", [0, 3])
+@pytest.mark.parametrize("user_mask", [False, True])
+@pytest.mark.parametrize("datatype", [gdal.GDT_Byte, gdal.GDT_Float32])
+def test_fillnodata_multithreaded(
+    interpolation, smoothing_iterations, user_mask, datatype
+):
+
+    width = 150
+    height = 130
+    values = []
+    for j in range(height):
+        for i in range(width):
+            # Holes of various sizes, and some isolated nodata pixels
+            if (
+                (i // 20 + j // 15) % 3 == 0
+                or (i * 7 + j * 13) % 11 == 0
+                or (40 <= i < 100 and 50 <= j < 90)
+            ):
+                values.append(0)
+            else:
+                values.append(1 + (i * 3 + j * 5) % 200)
+    ar = struct.pack("B" * (width * height), *values)
+
+    def run(num_threads):
+        ds = gdal.GetDriverByName("MEM").Create("", width, height, 1, datatype)
+        ds.GetRasterBand(1).WriteRaster(
+            0, 0, width, height, ar, buf_type=gdal.GDT_Byte
+        )
+        mask_band = None
+        if user_mask:
+            mask_ds = gdal.GetDriverByName("MEM").Create("", width, height)
+            mask_ds.WriteRaster(
+                0,
+                0,
+                width,
+                height,
+                bytes(255 if v else 0 for v in values),
+            )
+            mask_band = mask_ds.GetRasterBand(1)
+        else:
+            ds.GetRasterBand(1).SetNoDataValue(0)
+        with gdal.config_options(
+            {"GDAL_NUM_THREADS": num_threads, "GDAL_FILL_NODATA_TILE_SIZE": "32"}
+        ):
+            gdal.FillNodata(
+                targetBand=ds.GetRasterBand(1),
+                maskBand=mask_band,
+                maxSearchDist=12,
+                smoothingIterations=smoothing_iterations,
+                options=["INTERPOLATION=" + interpolation],
+            )
+        return ds.GetRasterBand(1).ReadRaster()
+
+    assert run("4") == run("1")
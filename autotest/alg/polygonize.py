@@ -427,3 +427,40 @@ def test_polygonize_8():
         wkt
         == "POLYGON ((1 4,1 3,0 3,0 1,1 1,1 0,3 0,3 1,4 1,4 3,3 3,3 4,1 4),(1 3,3 3,3 1,1 1,1 3))"
     )
+
+
+###############################################################################
+# Test that the multi-threaded implementation produces the same polygons as
+# the single-threaded one.
+
+
+@pytest.mark.parametrize("is_int_polygonize", [True, False])
+@pytest.mark.parametrize("options", [[], ["8CONNECTED=8"]])
+def test_polygonize_multithreaded(is_int_polygonize, options):
+
+    src_ds = gdal.Open("data/polygonize_check_area.tif")
+    src_band = src_ds.GetRasterBand(1)
+
+    def polygonize(num_threads):
+        mem_ds = ogr.GetDriverByName("MEM").CreateDataSource("out")
+        mem_layer = mem_ds.CreateLayer("poly", None, ogr.wkbPolygon)
+        mem_layer.CreateField(ogr.FieldDefn("DN", ogr.OFTInteger))
+
+        with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+            if is_int_polygonize:
+                result = gdal.Polygonize(
+                    src_band, src_band.GetMaskBand(), mem_layer, 0, options
+                )
+            else:
+                result = gdal.FPolygonize(
+                    src_band, src_band.GetMaskBand(), mem_layer, 0, options
+                )
+        assert result == 0, "Polygonize failed"
+
+        return sorted(
+            (f.GetField("DN"), f.GetGeometryRef().ExportToWkt()) for f in mem_layer
+        )
+
+    expected = polygonize("1")
+    assert polygonize("4") == expected
+    assert polygonize("ALL_CPUS") == expected
@@ -109,3 +109,68 @@ def test_proximity_3():
     if cs != cs_expected:
         print("Got: ", cs)
         pytest.fail("got wrong checksum")
+
+
+###############################################################################
+# Test the exact Euclidean distance transform algorithm
+
+
+@pytest.mark.parametrize("num_threads", ["1", "ALL_CPUS"])
+@pytest.mark.parametrize(
+    "options,datatype,cs_expected",
+    [
+        ([], gdal.GDT_Byte, 1941),
+        (
+            ["VALUES=65,64", "MAXDIST=12", "NODATA=-1", "FIXED_BUF_VAL=255"],
+            gdal.GDT_Float32,
+            3256,
+        ),
+        (
+            ["VALUES=65,64", "MAXDIST=12", "USE_INPUT_NODATA=YES", "NODATA=0"],
+            gdal.GDT_Byte,
+            1465,
+        ),
+        (["VALUES=65,64", "OUTPUT=NEAREST_VALUE"], gdal.GDT_Byte, 7879),
+        (
+            ["VALUES=65,64", "MAXDIST=5", "NODATA=-1", "OUTPUT=NEAREST_INDEX"],
+            gdal.GDT_Int16,
+            695,
+        ),
+    ],
+)
+def test_proximity_edt(options, datatype, cs_expected, num_threads):
+
+    src_ds = gdal.Open("data/pat.tif")
+    src_band = src_ds.GetRasterBand(1)
+
+    dst_ds = gdal.GetDriverByName("MEM").Create("", 25, 25, 1, datatype)
+    dst_band = dst_ds.GetRasterBand(1)
+
+    with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+        gdal.ComputeProximity(src_band, dst_band, options=options + ["ALGORITHM=EDT"])
+
+    assert dst_band.Checksum() == cs_expected
+
+
+###############################################################################
+# Test invalid ALGORITHM / OUTPUT combinations
+
+
+def test_proximity_edt_errors():
+
+    src_ds = gdal.Open("data/pat.tif")
+    src_band = src_ds.GetRasterBand(1)
+
+    dst_ds = gdal.GetDriverByName("MEM").Create("", 25, 25, 1, gdal.GDT_Float32)
+    dst_band = dst_ds.GetRasterBand(1)
+
+    with pytest.raises(Exception, match="Unrecognized ALGORITHM"):
+        gdal.ComputeProximity(src_band, dst_band, options=["ALGORITHM=FOO"])
+
+    with pytest.raises(Exception, match="Unrecognized OUTPUT"):
+        gdal.ComputeProximity(src_band, dst_band, options=["OUTPUT=FOO"])
+
+    with pytest.raises(Exception, match="requires ALGORITHM=EDT"):
+        gdal.ComputeProximity(
+            src_band, dst_band, options=["ALGORITHM=SWEEP", "OUTPUT=NEAREST_VALUE"]
+        )
@@ -1039,3 +1039,46 @@ def test_rasterize_bugfix_gh12129():
 
     # 121 on s390x
     assert target_ds.GetRasterBand(1).Checksum() in (120, 121)
+
+
+###############################################################################
+# Test multi-threaded tiled rasterization of geometries
+
+
+@pytest.mark.parametrize("merge_alg", ["REPLACE", "ADD"])
+@pytest.mark.parametrize("all_touched", [False, True])
+def test_rasterize_geometries_multi_threaded(merge_alg, all_touched):
+
+    src_ds = gdal.GetDriverByName("MEM").CreateVector("")
+    lyr = src_ds.CreateLayer("test")
+    lyr.CreateField(ogr.FieldDefn("val", ogr.OFTReal))
+    for i in range(200):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["val"] = i
+        x = (i * 37) % 1400
+        y = (i * 53) % 1400
+        if i % 3 == 0:
+            wkt = f"POLYGON(({x} {y},{x + 150} {y + 20},{x + 80} {y + 200},{x} {y}))"
+        elif i % 3 == 1:
+            wkt = f"LINESTRING({x} {y},{x + 300} {y + 250},{x + 10} {y + 500})"
+        else:
+            wkt = f"MULTIPOINT(({x} {y}),({x + 0.5} {y + 700}))"
+        f.SetGeometry(ogr.CreateGeometryFromWkt(wkt))
+        lyr.CreateFeature(f)
+
+    def rasterize(num_threads):
+        ds = gdal.GetDriverByName("MEM").Create("", 1500, 1500, 2, gdal.GDT_Float32)
+        ds.SetGeoTransform([0, 1, 0, 0, 0, 1])
+        with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+            assert gdal.Rasterize(
+                ds,
+                src_ds,
+                attribute="val",
+                allTouched=all_touched,
+                add=merge_alg == "ADD",
+            )
+        return [ds.GetRasterBand(i + 1).ReadRaster() for i in range(2)]
+
+    expected = rasterize("1")
+    assert rasterize("4") == expected
+    assert rasterize("ALL_CPUS") == expected
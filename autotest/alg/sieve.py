@@ -341,3 +341,57 @@ def test_sieve_all_masked():
     gdal.SieveFilter(src_band, mask_band, src_band, 4, 4)
 
     assert src_band.Checksum() == expected_cs
+
+
+###############################################################################
+# Check that the multithreaded implementation gives the same result as the
+# single-threaded one
+
+
+@pytest.mark.parametrize("connectedness", [4, 8])
+@pytest.mark.parametrize("use_mask", [False, True])
+def test_sieve_multithreaded(connectedness, use_mask):
+
+    width = 97
+    height = 211
+    values = bytearray(width * height)
+    seed = 1
+    for j in range(height):
+        for i in range(width):
+            seed = (seed * 1103515245 + 12345) % (1 << 31)
+            r = seed % 10
+            if r < 4 and i > 0:
+                values[j * width + i] = values[j * width + i - 1]
+            elif r < 8 and j > 0:
+                values[j * width + i] = values[(j - 1) * width + i]
+            else:
+                values[j * width + i] = seed % 4
+
+    drv = gdal.GetDriverByName("MEM")
+    src_ds = drv.Create("", width, height, 1, gdal.GDT_Byte)
+    src_band = src_ds.GetRasterBand(1)
+    src_band.WriteRaster(0, 0, width, height, bytes(values))
+
+    mask_band = None
+    if use_mask:
+        mask_ds = drv.Create("", width, height, 1, gdal.GDT_Byte)
+        mask_ds.WriteRaster(
+            0,
+            0,
+            width,
+            height,
+            bytes(0 if (i * 7) % 23 == 0 else 255 for i in range(width * height)),
+        )
+        mask_band = mask_ds.GetRasterBand(1)
+
+    def run(num_threads):
+        dst_ds = drv.Create("", width, height, 1, gdal.GDT_Byte)
+        with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+            gdal.SieveFilter(
+                src_band, mask_band, dst_ds.GetRasterBand(1), 12, connectedness
+            )
+        return dst_ds.GetRasterBand(1).ReadRaster()
+
+    expected = run("1")
+    assert expected != bytes(values)
+    assert run("4") == expected
@@ -2197,3 +2197,57 @@ def test_warp_mode_nan(dt):
 
     out_ds = gdal.Warp("", ds, options="-f MEM -r mode -ts 1 1")
     assert out_ds.ReadRaster(0, 0, 1, 1) == b"\xFF" * dtsize, gdal.GetDataTypeName(dt)
+
+
+###############################################################################
+# Test WARP_PLAN warping option
+
+
+@pytest.mark.parametrize("num_threads", ["1", "2"])
+@gdaltest.enable_exceptions()
+def test_warp_plan(tmp_vsimem, num_threads):
+
+    src_ds = gdal.Open("../gcore/data/byte.tif")
+    src_ds2 = gdal.Translate("", src_ds, options="-of MEM -scale 0 255 255 0")
+    plan_filename = str(tmp_vsimem / "plan.tif")
+
+    options = f"-of MEM -t_srs EPSG:4326 -ts 30 25 -r bilinear -et 0 -wo NUM_THREADS={num_threads}"
+    ref_ds = gdal.Warp("", src_ds, options=options)
+    ref_ds2 = gdal.Warp("", src_ds2, options=options)
+
+    # Creates the plan
+    out_ds = gdal.Warp("", src_ds, options=options + f" -wo WARP_PLAN={plan_filename}")
+    assert gdal.VSIStatL(plan_filename) is not None
+    assert out_ds.ReadRaster() == ref_ds.ReadRaster()
+
+    with gdal.Open(plan_filename) as plan_ds:
+        assert plan_ds.RasterXSize == 30
+        assert plan_ds.RasterYSize == 25
+        assert plan_ds.GetGeoTransform() == ref_ds.GetGeoTransform()
+        assert plan_ds.GetMetadataItem("WARP_PLAN_VERSION") == "1"
+
+    # Uses the plan, on a dataset with the same grid
+    out_ds = gdal.Warp(
+        "", src_ds2, options=options + f" -wo WARP_PLAN={plan_filename}"
+    )
+    assert out_ds.ReadRaster() == ref_ds2.ReadRaster()
+
+    # Source dataset with a different grid
+    src_ds3 = gdal.Translate("", src_ds, options="-of MEM -srcwin 1 1 18 18")
+    with pytest.raises(Exception, match="does not match the source dataset"):
+        gdal.Warp("", src_ds3, options=options + f" -wo WARP_PLAN={plan_filename}")
+
+    # Destination dataset with a different grid
+    with pytest.raises(Exception, match="does not match the destination dataset"):
+        gdal.Warp(
+            "",
+            src_ds,
+            options=f"-of MEM -t_srs EPSG:4326 -ts 31 25 -wo WARP_PLAN={plan_filename}",
+        )
+
+    with pytest.raises(Exception, match="is not a warp plan"):
+        gdal.Warp(
+            "",
+            src_ds,
+            options=options + " -wo WARP_PLAN=../gcore/data/byte.tif",
+        )
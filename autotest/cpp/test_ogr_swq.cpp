@@ -210,6 +210,22 @@ TEST_F(test_ogr_swq, select_unparse)
         EXPECT_STREQ(ret, pszSQL);
         CPLFree(ret);
     }
+    {
+        swq_select select;
+        const char *pszSQL = "SELECT a, \"group\", COUNT(b) FROM FOO "
+                             "WHERE 1 GROUP BY a, \"group\" ORDER BY a";
+        EXPECT_EQ(select.preparse(pszSQL), CE_None);
+        EXPECT_EQ(select.group_by_count, 2);
+        char *ret = select.Unparse();
+        EXPECT_STREQ(ret, pszSQL);
+        CPLFree(ret);
+    }
+    {
+        // GROUP is only a keyword when followed by BY
+        swq_select select;
+        EXPECT_EQ(select.preparse("SELECT group FROM FOO"), CE_None);
+        EXPECT_EQ(select.group_by_count, 0);
+    }
 }
 
 }  // namespace
@@ -1942,6 +1942,55 @@ def test_cog_mask_band_overviews(tmp_vsimem):
     assert ds.GetRasterBand(1).GetOverview(1).IsMaskBand()
 
 
+###############################################################################
+# Test that generating temporary overviews in memory or on disk gives the
+# same result
+
+
+# Overviews of the imagery and the mask are about 1.3 MB
+@pytest.mark.parametrize("max_memory", ["0", "1MB", "10%"])
+def test_cog_tmp_overviews_in_memory(tmp_vsimem, tmp_path, max_memory):
+
+    src_ds = gdal.Translate(
+        "",
+        "data/stefan_full_rgba.tif",
+        options="-of MEM -outsize 1024 0 -b 1 -b 2 -b 3 -mask 4",
+    )
+
+    def create(filename, max_memory):
+        with gdal.config_options(
+            {"COG_TMP_MAX_MEMORY": max_memory, "CPL_TMPDIR": str(tmp_path)}
+        ):
+            ds = gdal.GetDriverByName("COG").CreateCopy(
+                filename,
+                src_ds,
+                options=["BLOCKSIZE=128", "COMPRESS=LZW", "OVERVIEW_COUNT=3"],
+            )
+        assert ds
+        ds = None
+        # No temporary file left behind
+        assert os.listdir(tmp_path) == []
+
+    ref_filename = str(tmp_vsimem / "ref.tif")
+    create(ref_filename, "0")
+
+    filename = str(tmp_vsimem / "out.tif")
+    create(filename, max_memory)
+
+    ds = gdal.Open(filename)
+    assert ds.GetRasterBand(1).GetOverviewCount() == 3
+    assert ds.GetRasterBand(1).GetMaskFlags() == gdal.GMF_PER_DATASET
+    ds = None
+
+    f = gdal.VSIFile(ref_filename, "rb")
+    ref_data = f.read()
+    f.close()
+    f = gdal.VSIFile(filename, "rb")
+    data = f.read()
+    f.close()
+    assert data == ref_data
+
+
 ###############################################################################
 # Verify that we can generate an output that is byte-identical to the expected golden file.
 
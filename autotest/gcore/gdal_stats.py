@@ -981,3 +981,61 @@ def test_stats_uint64():
         1 << 50,
         0,
     ]
+
+
+###############################################################################
+# Test multi-threaded computation of statistics and min/max
+
+
+@pytest.mark.parametrize(
+    "datatype,struct_frmt",
+    [(gdal.GDT_Byte, "B"), (gdal.GDT_UInt16, "H"), (gdal.GDT_Float32, "f")],
+)
+@pytest.mark.parametrize("with_mask", [False, True])
+def test_stats_multithreaded(tmp_vsimem, datatype, struct_frmt, with_mask):
+
+    width = 100
+    height = 250
+    src_ds = gdal.GetDriverByName("MEM").Create("", width, height, 1, datatype)
+    values = [(i * 37 + (i // width) * 11) % 251 for i in range(width * height)]
+    if datatype == gdal.GDT_Float32:
+        values = [v + 0.25 for v in values]
+    src_ds.WriteRaster(
+        0, 0, width, height, struct.pack(struct_frmt * (width * height), *values)
+    )
+    if with_mask:
+        src_ds.CreateMaskBand(gdal.GMF_PER_DATASET)
+        mask_values = [(i % 3) * 127 for i in range(width * height)]
+        src_ds.GetRasterBand(1).GetMaskBand().WriteRaster(
+            0, 0, width, height, struct.pack("B" * (width * height), *mask_values)
+        )
+
+    # Small tiles so that there are many jobs
+    filename = str(tmp_vsimem / "test_stats_multithreaded.tif")
+    gdal.Translate(
+        filename,
+        src_ds,
+        creationOptions=["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16"],
+    )
+
+    def compute(num_threads, approx_ok=False):
+        with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+            ds = gdal.Open(filename)
+            band = ds.GetRasterBand(1)
+            return (
+                band.ComputeRasterMinMax(approx_ok),
+                band.ComputeStatistics(approx_ok),
+                band.GetMetadataItem("STATISTICS_VALID_PERCENT"),
+            )
+
+    ref = compute("1")
+    mt2 = compute("2")
+    mt8 = compute("8")
+    # Results do not depend on the number of threads, since per-block
+    # results are merged in the same order
+    assert mt2 == mt8
+    assert mt2 == ref
+
+    ref = compute("1", True)
+    mt = compute("4", True)
+    assert mt == ref
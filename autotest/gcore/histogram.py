@@ -767,3 +767,85 @@ def test_histogram_min_equal_max():
 
     ds = gdal.GetDriverByName("MEM").Create("", 1, 1, 1, gdal.GDT_Int16)
     assert ds.GetRasterBand(1).GetDefaultHistogram() == (-0.5, 0.5, 1, [1])
+
+
+###############################################################################
+# Test that the multi-threaded code path gives the same result as the
+# single-threaded one
+
+
+@pytest.mark.parametrize(
+    "datatype,struct_frmt",
+    [
+        (gdal.GDT_Byte, "B"),
+        (gdal.GDT_Int8, "b"),
+        (gdal.GDT_UInt16, "H"),
+        (gdal.GDT_Int16, "h"),
+        (gdal.GDT_Float32, "f"),
+        (gdal.GDT_Float64, "d"),
+    ],
+)
+@pytest.mark.parametrize("with_nodata", [False, True])
+@pytest.mark.parametrize("with_mask", [False, True])
+def test_histogram_multithreaded(
+    tmp_vsimem, datatype, struct_frmt, with_nodata, with_mask
+):
+
+    width = 100
+    height = 250
+    filename = str(tmp_vsimem / "test.tif")
+    ds = gdal.GetDriverByName("GTiff").Create(
+        filename,
+        width,
+        height,
+        1,
+        datatype,
+        options=["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16"],
+    )
+    values = [((i * 37) % 300) - 40 for i in range(width * height)]
+    if struct_frmt in ("B", "H"):
+        values = [abs(v) for v in values]
+    if struct_frmt == "B":
+        values = [min(v, 255) for v in values]
+    elif struct_frmt == "b":
+        values = [min(v, 127) for v in values]
+    if struct_frmt in ("f", "d"):
+        values = [v + 0.25 for v in values]
+        values[5] = float("nan")
+    ds.GetRasterBand(1).WriteRaster(
+        0, 0, width, height, struct.pack(struct_frmt * (width * height), *values)
+    )
+    if with_nodata:
+        ds.GetRasterBand(1).SetNoDataValue(values[1])
+    if with_mask:
+        ds.GetRasterBand(1).CreateMaskBand(0)
+        ds.GetRasterBand(1).GetMaskBand().WriteRaster(
+            0,
+            0,
+            width,
+            height,
+            b"".join(b"\xff" if (i % 7) else b"\x00" for i in range(width * height)),
+        )
+    ds = None
+
+    def get_histograms():
+        ds = gdal.Open(filename)
+        band = ds.GetRasterBand(1)
+        return [
+            band.GetHistogram(
+                min=-10.5,
+                max=200.5,
+                buckets=50,
+                include_out_of_range=include_out_of_range,
+                approx_ok=approx_ok,
+            )
+            for include_out_of_range in (0, 1)
+            for approx_ok in (0, 1)
+        ]
+
+    with gdal.config_option("GDAL_NUM_THREADS", "1"):
+        ref = get_histograms()
+    assert sum(ref[0]) > 0
+    for num_threads in ("2", "8"):
+        with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+            assert get_histograms() == ref
@@ -3898,3 +3898,41 @@ def test_rasterio_gdt_unknown():
         # Caught at the SWIG level
         with pytest.raises(Exception, match="Illegal value for data type"):
             ds.GetRasterBand(1).ReadRaster(buf_type=gdal.GDT_Unknown)
+
+
+###############################################################################
+# Test pipelined GDALDatasetCopyWholeRaster()
+
+
+@pytest.mark.parametrize("interleave", ["PIXEL", "BAND"])
+@pytest.mark.parametrize("num_threads", ["2", "4"])
+def test_rasterio_copy_whole_raster_pipelined(tmp_vsimem, interleave, num_threads):
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", 1000, 1000, 3)
+    for i in range(3):
+        src_ds.GetRasterBand(i + 1).WriteRaster(
+            0, 0, 1000, 1000, bytes((x * (i + 3)) % 251 for x in range(1000 * 1000))
+        )
+
+    out_filename = tmp_vsimem / "out.tif"
+    with gdaltest.config_options(
+        {"GDAL_NUM_THREADS": num_threads, "GDAL_SWATH_SIZE": "1000000"}
+    ):
+        out_ds = gdal.GetDriverByName("GTiff").CreateCopy(
+            out_filename, src_ds, options=["INTERLEAVE=" + interleave]
+        )
+    assert [out_ds.GetRasterBand(i + 1).Checksum() for i in range(3)] == [
+        src_ds.GetRasterBand(i + 1).Checksum() for i in range(3)
+    ]
+
+    # Test interruption
+    with gdaltest.config_options(
+        {"GDAL_NUM_THREADS": num_threads, "GDAL_SWATH_SIZE": "1000000"}
+    ):
+        with pytest.raises(Exception, match="User terminated"):
+            gdal.GetDriverByName("GTiff").CreateCopy(
+                tmp_vsimem / "out2.tif",
+                src_ds,
+                options=["INTERLEAVE=" + interleave],
+                callback=lambda pct, msg, user_data: pct < 0.5,
+            )
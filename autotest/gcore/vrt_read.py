@@ -2816,6 +2816,117 @@ def test_vrt_read_multi_threaded_disabled_since_overlapping_sources():
     )
 
 
+###############################################################################
+# Test source selection through the spatial index of sources, and its
+# invalidation when sources are added
+
+
+def test_vrt_read_many_sources_spatial_index(tmp_vsimem):
+
+    src_ds = gdal.Translate(
+        "", "../gdrivers/data/small_world.tif", width=400, height=200, format="MEM"
+    )
+    tile_size = 20
+    tiles = []
+    for j in range(200 // tile_size):
+        for i in range(400 // tile_size):
+            tiles.append(
+                gdal.Translate(
+                    "",
+                    src_ds,
+                    format="MEM",
+                    srcWin=[i * tile_size, j * tile_size, tile_size, tile_size],
+                )
+            )
+    vrt_ds = gdal.BuildVRT("", tiles)
+
+    for win in [
+        (0, 0, 400, 200),
+        (5, 7, 1, 1),
+        (19, 19, 2, 2),
+        (33, 41, 100, 50),
+        (380, 180, 20, 20),
+    ]:
+        assert vrt_ds.ReadRaster(*win) == src_ds.ReadRaster(*win), win
+        assert vrt_ds.GetRasterBand(1).ReadRaster(*win) == src_ds.GetRasterBand(
+            1
+        ).ReadRaster(*win), win
+
+    assert vrt_ds.GetRasterBand(1).GetDataCoverageStatus(21, 21, 10, 10) == (
+        gdal.GDAL_DATA_COVERAGE_STATUS_DATA,
+        100.0,
+    )
+
+    # Add a source after the index has been built
+    constant_filename = str(tmp_vsimem / "constant.tif")
+    constant_ds = gdal.GetDriverByName("GTiff").Create(constant_filename, 4, 4)
+    constant_ds.GetRasterBand(1).Fill(255)
+    constant_ds.Close()
+
+    vrt_ds.GetRasterBand(1).SetMetadataItem(
+        "source_0",
+        f"""<SimpleSource>
+              <SourceFilename>{constant_filename}</SourceFilename>
+              <SourceBand>1</SourceBand>
+              <SrcRect xOff="0" yOff="0" xSize="4" ySize="4"/>
+              <DstRect xOff="102" yOff="52" xSize="4" ySize="4"/>
+            </SimpleSource>""",
+        "new_vrt_sources",
+    )
+    assert vrt_ds.GetRasterBand(1).ReadRaster(100, 50, 8, 8) != src_ds.GetRasterBand(
+        1
+    ).ReadRaster(100, 50, 8, 8)
+    assert vrt_ds.GetRasterBand(1).ReadRaster(102, 52, 4, 4) == b"\xff" * 16
+
+
+###############################################################################
+# Test source selection through the spatial index of sources, when reading
+# a multi-band mosaic at the dataset level
+
+
+@pytest.mark.parametrize("use_threads", [True, False])
+def test_vrt_read_many_sources_spatial_index_dataset_level(tmp_vsimem, use_threads):
+
+    src_ds = gdal.Translate(
+        "", "../gdrivers/data/small_world.tif", width=2048, height=1024, format="MEM"
+    )
+    assert src_ds.RasterCount == 3
+    tile_size = 128
+    tile_filenames = []
+    for j in range(1024 // tile_size):
+        for i in range(2048 // tile_size):
+            tile_filename = str(tmp_vsimem / f"{i}_{j}.tif")
+            gdal.Translate(
+                tile_filename,
+                src_ds,
+                srcWin=[i * tile_size, j * tile_size, tile_size, tile_size],
+            )
+            tile_filenames.append(tile_filename)
+    vrt_ds = gdal.BuildVRT("", tile_filenames)
+    assert vrt_ds.GetMetadataItem("CheckCompatibleForDatasetIO()", "__DEBUG__") == "1"
+
+    with gdal.config_options({} if use_threads else {"VRT_NUM_THREADS": "0"}):
+        for win in [
+            (1, 2, 1030, 1020),
+            (5, 7, 1, 1),
+            (127, 127, 2, 2),
+            (300, 400, 200, 100),
+            (1920, 896, 128, 128),
+        ]:
+            assert vrt_ds.ReadRaster(*win) == src_ds.ReadRaster(*win), win
+            assert vrt_ds.ReadRaster(*win, band_list=[3, 1]) == src_ds.ReadRaster(
+                *win, band_list=[3, 1]
+            ), win
+
+        # Large enough for the multi-threaded code path
+        assert vrt_ds.ReadRaster(1, 2, 1030, 1020) == src_ds.ReadRaster(
+            1, 2, 1030, 1020
+        )
+        assert vrt_ds.GetMetadataItem(
+            "MULTI_THREADED_RASTERIO_LAST_USED", "__DEBUG__"
+        ) == ("1" if gdal.GetNumCPUs() >= 2 and use_threads else "0")
+
+
 ###############################################################################
 # Test propagation of errors from threads to main thread in multi-threaded reading
 
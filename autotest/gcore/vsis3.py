@@ -3170,6 +3170,88 @@ def test_vsis3_write_multipart_retry(aws_test_config, webserver_port):
                 gdal.VSIFCloseL(f)
 
 
+###############################################################################
+# Test multipart upload with parts uploaded by several threads
+
+
+@pytest.mark.parametrize("failed_last_part", [False, True])
+def test_vsis3_write_multipart_multithreaded(
+    aws_test_config, webserver_port, failed_last_part
+):
+
+    gdal.VSICurlClearCache()
+
+    with gdaltest.config_options(
+        {
+            "VSIS3_CHUNK_SIZE_BYTES": "3",
+            "VSIS3_UPLOAD_NUM_THREADS": "2",
+        },
+        thread_local=False,
+    ):
+        f = gdal.VSIFOpenL("/vsis3/s3_fake_bucket4/mt_file.bin", "wb")
+    assert f is not None
+
+    # Use a non sequential HTTP handler as the PUT could be emitted in
+    # any order
+    handler = webserver.NonSequentialMockedHttpHandler()
+    handler.add(
+        "POST",
+        "/s3_fake_bucket4/mt_file.bin?uploads",
+        200,
+        {"Content-type": "application:/xml"},
+        b"""<?xml version="1.0" encoding="UTF-8"?>
+        <InitiateMultipartUploadResult>
+        <UploadId>my_id</UploadId>
+        </InitiateMultipartUploadResult>""",
+    )
+    for i, content in enumerate([b"abc", b"def", b"g"]):
+        if i == 2 and failed_last_part:
+            handler.add(
+                "PUT",
+                "/s3_fake_bucket4/mt_file.bin?partNumber=3&uploadId=my_id",
+                403,
+            )
+        else:
+            handler.add(
+                "PUT",
+                "/s3_fake_bucket4/mt_file.bin?partNumber=%d&uploadId=my_id"
+                % (i + 1),
+                200,
+                {"ETag": '"etag%d"' % (i + 1)},
+                expected_headers={"Content-Length": str(len(content))},
+                expected_body=content,
+            )
+    if failed_last_part:
+        handler.add("DELETE", "/s3_fake_bucket4/mt_file.bin?uploadId=my_id", 204)
+    else:
+        handler.add(
+            "POST",
+            "/s3_fake_bucket4/mt_file.bin?uploadId=my_id",
+            200,
+            expected_body=b"""<CompleteMultipartUpload>
+<Part>
+<PartNumber>1</PartNumber><ETag>"etag1"</ETag></Part>
+<Part>
+<PartNumber>2</PartNumber><ETag>"etag2"</ETag></Part>
+<Part>
+<PartNumber>3</PartNumber><ETag>"etag3"</ETag></Part>
+</CompleteMultipartUpload>
+""",
+        )
+
+    with webserver.install_http_handler(handler):
+        assert gdal.VSIFWriteL(b"abcd", 1, 4, f) == 4
+        assert gdal.VSIFWriteL(b"efg", 1, 3, f) == 3
+        if failed_last_part:
+            with gdal.quiet_errors():
+                assert gdal.VSIFCloseL(f) != 0
+            assert "UploadPart(3)" in gdal.GetLastErrorMsg()
+        else:
+            gdal.ErrorReset()
+            assert gdal.VSIFCloseL(f) == 0
+            assert gdal.GetLastErrorMsg() == ""
+
+
 ###############################################################################
 # Test abort pending multipart uploads
 
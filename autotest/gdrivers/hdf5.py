@@ -1612,6 +1612,34 @@ END
     )
 
 
+###############################################################################
+# Test reading chunks directly, without going through H5Dread()
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_hdf5_direct_chunk_read(num_threads):
+
+    filename = 'HDF5:"data/hdf5/dummy_HDFEOS_swath_chunked.h5"://HDFEOS/SWATHS/MySwath/Data_Fields/MyDataField'
+
+    with gdal.config_option("GDAL_HDF5_DIRECT_CHUNK_READ", "NO"):
+        ds = gdal.Open(filename)
+        expected_data = ds.ReadRaster()
+        expected_window = ds.ReadRaster(1, 2, 7, 9, band_list=[2, 3])
+        expected_cs = [
+            ds.GetRasterBand(i + 1).Checksum() for i in range(ds.RasterCount)
+        ]
+
+    with gdal.config_options(
+        {"GDAL_HDF5_DIRECT_CHUNK_READ": "YES", "GDAL_NUM_THREADS": num_threads}
+    ):
+        ds = gdal.Open(filename)
+        assert ds.ReadRaster() == expected_data
+        assert ds.ReadRaster(1, 2, 7, 9, band_list=[2, 3]) == expected_window
+        assert [
+            ds.GetRasterBand(i + 1).Checksum() for i in range(ds.RasterCount)
+        ] == expected_cs
+
+
 ###############################################################################
 # Test GetNoDataValue(), GetOffset(), GetScale()
 
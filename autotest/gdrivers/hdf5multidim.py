@@ -932,3 +932,30 @@ def test_hdf5_multimdim_eos_grid_VIIRS_Grid_IMG_2D_issue_12941():
     assert struct.unpack("d" * 4, xdim_var.Read())[0:2] == pytest.approx(
         (-972956.7047086251, -694969.0747918751)
     )
+
+
+###############################################################################
+# Test reading chunks directly, without going through H5Dread()
+
+
+def test_hdf5_multidim_direct_chunk_read():
+
+    def read(direct):
+        with gdal.config_option("GDAL_HDF5_DIRECT_CHUNK_READ", direct):
+            ds = gdal.OpenEx(
+                "data/hdf5/dummy_HDFEOS_swath_chunked.h5", gdal.OF_MULTIDIM_RASTER
+            )
+            ar = ds.GetRootGroup().OpenMDArrayFromFullname(
+                "/HDFEOS/SWATHS/MySwath/Data Fields/MyDataField"
+            )
+            assert ar
+            return (
+                ar.Read(),
+                ar.Read(array_start_idx=[1, 2, 3], count=[4, 5, 6]),
+                ar.Read(
+                    buffer_datatype=gdal.ExtendedDataType.Create(gdal.GDT_Float64)
+                ),
+            )
+
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        assert read("YES") == read("NO")
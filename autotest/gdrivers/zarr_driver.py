@@ -4070,6 +4070,186 @@ def test_zarr_advise_read(tmp_path, compression, format):
     read()
 
 
+@pytest.mark.parametrize("compression", ["NONE", "GZIP"])
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_zarr_v3_sharding(tmp_vsimem, compression, num_threads):
+
+    filename = tmp_vsimem / "test.zarr"
+
+    dim0_size = 100
+    dim1_size = 130
+    data = array.array("H", [(i % 1000) for i in range(dim0_size * dim1_size)])
+
+    def create():
+        ds = gdal.GetDriverByName("ZARR").CreateMultiDimensional(
+            filename, options=["FORMAT=ZARR_V3"]
+        )
+        assert ds is not None
+        rg = ds.GetRootGroup()
+        dim0 = rg.CreateDimension("dim0", None, None, dim0_size)
+        dim1 = rg.CreateDimension("dim1", None, None, dim1_size)
+        ar = rg.CreateMDArray(
+            "test",
+            [dim0, dim1],
+            gdal.ExtendedDataType.Create(gdal.GDT_UInt16),
+            [
+                "COMPRESS=" + compression,
+                "BLOCKSIZE=40,60",
+                "SHARD_INNER_BLOCKSIZE=20,30",
+            ],
+        )
+        assert ar
+        assert ar.Write(data) == gdal.CE_None
+
+    with gdaltest.config_option("GDAL_NUM_THREADS", num_threads):
+        create()
+
+    j = json.loads(gdal.VSIFile(filename / "test/zarr.json", "rb").read())
+    assert j["chunk_grid"]["configuration"]["chunk_shape"] == [40, 60]
+    assert len(j["codecs"]) == 1
+    assert j["codecs"][0]["name"] == "sharding_indexed"
+    assert j["codecs"][0]["configuration"]["chunk_shape"] == [20, 30]
+    assert j["codecs"][0]["configuration"]["index_codecs"][-1]["name"] == "crc32c"
+    # One file per shard
+    assert gdal.VSIStatL(filename / "test/c/2/2") is not None
+    assert gdal.VSIStatL(filename / "test/c/3/0") is None
+
+    # Read-only mode: blocks are the inner chunks
+    ds = gdal.OpenEx(filename, gdal.OF_MULTIDIM_RASTER)
+    ar = ds.GetRootGroup().OpenMDArray("test")
+    assert ar.GetBlockSize() == [20, 30]
+    assert ar.Read() == data
+    got = ar.Read(array_start_idx=[35, 50], count=[10, 20])
+    assert got == array.array(
+        "H",
+        [data[y * dim1_size + x] for y in range(35, 45) for x in range(50, 70)],
+    )
+    assert ar.AdviseRead(options=["NUM_THREADS=2"]) == gdal.CE_None
+    assert ar.Read() == data
+    ds = None
+
+    # Update mode: blocks are the shards
+    ds = gdal.OpenEx(filename, gdal.OF_MULTIDIM_RASTER | gdal.OF_UPDATE)
+    ar = ds.GetRootGroup().OpenMDArray("test")
+    assert ar.GetBlockSize() == [40, 60]
+    assert ar.Read() == data
+
+
+@pytest.mark.parametrize("update", [False, True])
+def test_zarr_v3_sharding_missing_inner_chunk(tmp_vsimem, update):
+
+    filename = tmp_vsimem / "test.zarr"
+
+    j = {
+        "zarr_format": 3,
+        "node_type": "array",
+        "shape": [6],
+        "data_type": "uint8",
+        "chunk_grid": {"name": "regular", "configuration": {"chunk_shape": [6]}},
+        "chunk_key_encoding": {"name": "default"},
+        "fill_value": 7,
+        "codecs": [
+            {
+                "name": "sharding_indexed",
+                "configuration": {
+                    "chunk_shape": [2],
+                    "codecs": [{"name": "bytes"}],
+                    "index_codecs": [
+                        {"name": "bytes", "configuration": {"endian": "little"}}
+                    ],
+                    "index_location": "start",
+                },
+            }
+        ],
+    }
+    gdal.FileFromMemBuffer(
+        filename / "zarr.json", json.dumps({"zarr_format": 3, "node_type": "group"})
+    )
+    gdal.FileFromMemBuffer(filename / "test/zarr.json", json.dumps(j))
+
+    # Index of 3 inner chunks, the second one being missing, and the third one
+    # stored before the first one.
+    missing = 0xFFFFFFFFFFFFFFFF
+    index = struct.pack("<6Q", 50, 2, missing, missing, 48, 2)
+    gdal.FileFromMemBuffer(filename / "test/c/0", index + b"\x05\x06\x01\x02")
+
+    flags = gdal.OF_MULTIDIM_RASTER
+    if update:
+        flags |= gdal.OF_UPDATE
+    ds = gdal.OpenEx(filename, flags)
+    ar = ds.GetRootGroup().OpenMDArray("test")
+    assert ar.Read() == array.array("B", [1, 2, 7, 7, 5, 6])
+
+
+@pytest.mark.parametrize(
+    "format,order", [("ZARR_V2", "C"), ("ZARR_V2", "F"), ("ZARR_V3", "C")]
+)
+def test_zarr_write_multithreaded(tmp_vsimem, format, order):
+
+    filename = tmp_vsimem / "test.zarr"
+
+    dim0_size = 100
+    dim1_size = 130
+    data = array.array("H", [(i % 1000) + 1 for i in range(dim0_size * dim1_size)])
+
+    with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+        ds = gdal.GetDriverByName("ZARR").CreateMultiDimensional(
+            filename, options=["FORMAT=" + format]
+        )
+        rg = ds.GetRootGroup()
+        dim0 = rg.CreateDimension("dim0", None, None, dim0_size)
+        dim1 = rg.CreateDimension("dim1", None, None, dim1_size)
+        options = ["COMPRESS=GZIP", "BLOCKSIZE=20,30"]
+        if format == "ZARR_V2":
+            options.append("CHUNK_MEMORY_LAYOUT=" + order)
+        ar = rg.CreateMDArray(
+            "test",
+            [dim0, dim1],
+            gdal.ExtendedDataType.Create(gdal.GDT_UInt16),
+            options,
+        )
+
+        # Write by strips that do not match tile boundaries, so that each
+        # tile is written, flushed and read back several times.
+        for y in range(0, dim0_size, 7):
+            count = min(7, dim0_size - y)
+            assert (
+                ar.Write(
+                    data[y * dim1_size : (y + count) * dim1_size],
+                    array_start_idx=[y, 0],
+                    count=[count, dim1_size],
+                )
+                == gdal.CE_None
+            )
+
+        # Make the first tile empty
+        assert (
+            ar.Write(
+                array.array("H", [0] * (20 * 30)),
+                array_start_idx=[0, 0],
+                count=[20, 30],
+            )
+            == gdal.CE_None
+        )
+        for y in range(20):
+            for x in range(30):
+                data[y * dim1_size + x] = 0
+
+        assert ar.Read() == data
+        ds = None
+
+    if format == "ZARR_V2":
+        assert gdal.VSIStatL(filename / "test/0.0") is None
+        assert gdal.VSIStatL(filename / "test/4.4") is not None
+    else:
+        assert gdal.VSIStatL(filename / "test/c/0/0") is None
+        assert gdal.VSIStatL(filename / "test/c/4/4") is not None
+
+    ds = gdal.OpenEx(filename, gdal.OF_MULTIDIM_RASTER)
+    ar = ds.GetRootGroup().OpenMDArray("test")
+    assert ar.Read() == data
+
+
 def test_zarr_read_invalid_nczarr_dim(tmp_vsimem):
 
     gdal.Mkdir(tmp_vsimem / "test.zarr", 0)
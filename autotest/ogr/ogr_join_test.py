@@ -27,6 +27,7 @@
 ###############################################################################
 
 
+import gdaltest
 import ogrtest
 import pytest
 
@@ -546,3 +547,119 @@ def test_ogr_join_on_special_field():
         assert f["a"] == "a2"
         assert f["b"] is None
         assert sql_lyr.GetNextFeature() is None
+
+
+###############################################################################
+# Test the hash join strategy, and that it gives the same results as the
+# nested loop one
+
+
+@pytest.mark.parametrize(
+    "field_type,primary_values,secondary_values",
+    [
+        (
+            ogr.OFTInteger,
+            [1, 2, None, 3, 2, 5],
+            [2, 1, None, 2, 4, 3],
+        ),
+        (
+            ogr.OFTReal,
+            [1.5, 0.0, None, 3.5, -2.5],
+            [-0.0, 1.5, None, 3.5, 1.5],
+        ),
+        (
+            ogr.OFTString,
+            ["a", "B", None, "c", "x", "2024-01-01T00:00:00+00"],
+            ["b", "A", None, "a", "C", "2024-01-01"],
+        ),
+    ],
+)
+def test_ogr_join_hash_strategy(field_type, primary_values, secondary_values):
+
+    ds = ogr.GetDriverByName("MEM").CreateDataSource("")
+    lyr = ds.CreateLayer("first")
+    lyr.CreateField(ogr.FieldDefn("key", field_type))
+    for v in primary_values:
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["key"] = v
+        lyr.CreateFeature(f)
+
+    lyr = ds.CreateLayer("second")
+    lyr.CreateField(ogr.FieldDefn("key", field_type))
+    lyr.CreateField(ogr.FieldDefn("idx", ogr.OFTInteger))
+    for i, v in enumerate(secondary_values):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["key"] = v
+        f["idx"] = i
+        lyr.CreateFeature(f)
+
+    def get_result(sql):
+        got_msg = []
+
+        def my_handler(errorClass, errno, msg):
+            if errorClass == gdal.CE_Debug and msg.startswith("GenSQL: JOIN"):
+                got_msg.append(msg)
+
+        with gdaltest.error_handler(my_handler), gdaltest.config_option(
+            "CPL_DEBUG", "ON"
+        ):
+            with ds.ExecuteSQL(sql) as sql_lyr:
+                res = [(f["key"], f["second.idx"]) for f in sql_lyr]
+        return res, got_msg
+
+    sql = "SELECT * FROM first LEFT JOIN second ON first.key = second.key"
+    with gdaltest.config_option("OGR_GENSQL_JOIN_STRATEGY", "NESTED_LOOP"):
+        ref, msgs = get_result(sql)
+    assert len(msgs) == 1 and "nested loop" in msgs[0]
+    assert len(ref) == len(primary_values)
+
+    res, msgs = get_result(sql)
+    assert len(msgs) == 1 and "hash join" in msgs[0]
+    assert res == ref
+
+    res, msgs = get_result(
+        "SELECT * FROM first LEFT JOIN second ON second.key = first.key"
+    )
+    assert len(msgs) == 1 and "hash join" in msgs[0]
+    assert res == ref
+
+    with gdaltest.config_option("OGR_GENSQL_JOIN_HASH_MAX_MEMORY", "100"):
+        res, msgs = get_result(sql)
+    assert len(msgs) == 1 and "nested loop" in msgs[0]
+    assert res == ref
+
+
+###############################################################################
+# Test that the hash join strategy is not used when it cannot be
+
+
+def test_ogr_join_hash_strategy_not_used():
+
+    ds = ogr.GetDriverByName("MEM").CreateDataSource("")
+    lyr = ds.CreateLayer("first")
+    lyr.CreateField(ogr.FieldDefn("key", ogr.OFTInteger))
+    f = ogr.Feature(lyr.GetLayerDefn())
+    f["key"] = 1
+    lyr.CreateFeature(f)
+
+    lyr = ds.CreateLayer("second")
+    lyr.CreateField(ogr.FieldDefn("key", ogr.OFTString))
+    f = ogr.Feature(lyr.GetLayerDefn())
+    f["key"] = "1"
+    lyr.CreateFeature(f)
+
+    got_msg = []
+
+    def my_handler(errorClass, errno, msg):
+        if errorClass == gdal.CE_Debug and msg.startswith("GenSQL: JOIN"):
+            got_msg.append(msg)
+
+    with gdaltest.error_handler(my_handler), gdaltest.config_option(
+        "CPL_DEBUG", "ON"
+    ):
+        with ds.ExecuteSQL(
+            "SELECT * FROM first LEFT JOIN second ON first.key = second.key"
+        ) as sql_lyr:
+            assert sql_lyr.GetNextFeature() is not None
+
+    assert len(got_msg) == 1 and "nested loop" in got_msg[0]
@@ -593,3 +593,57 @@ def test_algebra_erase_5(A, empty, C):
     assert C.GetFeatureCount() == A.GetFeatureCount(), (
         "Layer.Erase returned " + str(C.GetFeatureCount()) + " features"
     )
+
+
+@pytest.mark.parametrize(
+    "operation",
+    ["Intersection", "Union", "SymDifference", "Identity", "Update", "Clip", "Erase"],
+)
+@pytest.mark.parametrize("method_filter", [False, True])
+def test_algebra_METHOD_LAYER_INDEX(mem_ds, operation, method_filter):
+
+    input_lyr = mem_ds.CreateLayer("input")
+    input_lyr.CreateField(ogr.FieldDefn("input_id", ogr.OFTInteger))
+    for i in range(10):
+        f = ogr.Feature(input_lyr.GetLayerDefn())
+        f["input_id"] = i
+        x = i * 1.5
+        f.SetGeometry(
+            ogr.CreateGeometryFromWkt(
+                f"POLYGON(({x} 0,{x} 2,{x + 2} 2,{x + 2} 0,{x} 0))"
+            )
+        )
+        input_lyr.CreateFeature(f)
+
+    method_lyr = mem_ds.CreateLayer("method")
+    method_lyr.CreateField(ogr.FieldDefn("method_id", ogr.OFTInteger))
+    for i in range(20):
+        f = ogr.Feature(method_lyr.GetLayerDefn())
+        f["method_id"] = i
+        if i != 5:
+            x = i * 0.8
+            f.SetGeometry(
+                ogr.CreateGeometryFromWkt(
+                    f"POLYGON(({x} 1,{x} 3,{x + 1} 3,{x + 1} 1,{x} 1))"
+                )
+            )
+        method_lyr.CreateFeature(f)
+
+    if method_filter:
+        method_lyr.SetSpatialFilterRect(3, 0, 9, 4)
+
+    ref_lyr = mem_ds.CreateLayer("ref")
+    getattr(input_lyr, operation)(method_lyr, ref_lyr)
+    assert ref_lyr.GetFeatureCount() > 0
+
+    out_lyr = mem_ds.CreateLayer("out")
+    getattr(input_lyr, operation)(
+        method_lyr, out_lyr, options=["METHOD_LAYER_INDEX=YES"]
+    )
+    assert is_same(ref_lyr, out_lyr)
+
+    # The spatial filter of the method layer must be left untouched
+    if method_filter:
+        assert method_lyr.GetSpatialFilter().GetEnvelope() == (3, 9, 0, 4)
+    else:
+        assert method_lyr.GetSpatialFilter() is None
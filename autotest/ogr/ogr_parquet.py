@@ -3737,33 +3737,24 @@ def test_ogr_parquet_get_extent_3d(tmp_vsimem):
 
 
 @gdaltest.enable_exceptions()
-@pytest.mark.require_driver("GPKG")
-def test_ogr_parquet_sort_by_bbox(tmp_vsimem):
+@pytest.mark.parametrize("max_memory", [None, "10KB", "1KB"])
+def test_ogr_parquet_sort_by_bbox(tmp_vsimem, max_memory):
 
     outfilename = str(tmp_vsimem / "test_ogr_parquet_sort_by_bbox.parquet")
     ds = ogr.GetDriverByName("Parquet").CreateDataSource(outfilename)
 
-    gpkg_drv = gdal.GetDriverByName("GPKG")
-    gpkg_drv.Deregister()
     ROW_GROUP_SIZE = 100
-    try:
-        with pytest.raises(
-            Exception,
-            match="Driver GPKG required for SORT_BY_BBOX layer creation option",
-        ):
-            ds.CreateLayer(
-                "test",
-                geom_type=ogr.wkbPoint,
-                options=["SORT_BY_BBOX=YES", f"ROW_GROUP_SIZE={ROW_GROUP_SIZE}"],
-            )
-    finally:
-        gpkg_drv.Register()
-
-    lyr = ds.CreateLayer(
-        "test",
-        geom_type=ogr.wkbPoint,
-        options=["SORT_BY_BBOX=YES", f"ROW_GROUP_SIZE={ROW_GROUP_SIZE}", "FID=fid"],
-    )
+    # A small value forces sorted runs to be spilled to a temporary file
+    with gdaltest.config_option("OGR_PARQUET_SORT_BY_BBOX_MAX_MEMORY", max_memory):
+        lyr = ds.CreateLayer(
+            "test",
+            geom_type=ogr.wkbPoint,
+            options=[
+                "SORT_BY_BBOX=YES",
+                f"ROW_GROUP_SIZE={ROW_GROUP_SIZE}",
+                "FID=fid",
+            ],
+        )
     assert lyr.TestCapability(ogr.OLCFastWriteArrowBatch) == 0
     lyr.CreateField(ogr.FieldDefn("i", ogr.OFTInteger))
     COUNT_NON_SPATIAL = 501
@@ -3778,6 +3769,7 @@ def test_ogr_parquet_sort_by_bbox(tmp_vsimem):
         f.SetGeometryDirectly(ogr.CreateGeometryFromWkt(f"POINT({i} {i})"))
         lyr.CreateFeature(f)
     ds = None
+    assert gdal.VSIStatL(outfilename + ".sort.tmp") is None
 
     with gdaltest.config_option("OGR_PARQUET_SHOW_ROW_GROUP_EXTENT", "YES"):
         ds = ogr.Open(outfilename)
@@ -3825,11 +3817,12 @@ def test_ogr_parquet_sort_by_bbox(tmp_vsimem):
 
     # Check that this works also when using the Arrow interface for creation
     outfilename2 = str(tmp_vsimem / "test_ogr_parquet_sort_by_bbox2.parquet")
-    gdal.VectorTranslate(
-        outfilename2,
-        outfilename,
-        layerCreationOptions=["SORT_BY_BBOX=YES", "ROW_GROUP_SIZE=100"],
-    )
+    with gdaltest.config_option("OGR_PARQUET_SORT_BY_BBOX_MAX_MEMORY", max_memory):
+        gdal.VectorTranslate(
+            outfilename2,
+            outfilename,
+            layerCreationOptions=["SORT_BY_BBOX=YES", "ROW_GROUP_SIZE=100"],
+        )
     check_file(outfilename2)
 
 
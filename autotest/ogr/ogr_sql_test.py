@@ -2234,3 +2234,232 @@ def test_ogr_sql_union_layer_feature_count_add_overflow():
             "select * from test union all select * from test2", dialect="OGRSQL"
         ) as sql_lyr:
             assert sql_lyr.GetFeatureCount() == 0
+
+
+###############################################################################
+# Test GROUP BY
+
+
+@pytest.fixture()
+def ds_for_group_by():
+
+    ds = ogr.GetDriverByName("MEM").CreateDataSource("")
+    lyr = ds.CreateLayer("test")
+    lyr.CreateField(ogr.FieldDefn("cat", ogr.OFTString))
+    lyr.CreateField(ogr.FieldDefn("sub", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("val", ogr.OFTReal))
+    for cat, sub, val in [
+        ("a", 1, 1.0),
+        ("b", 1, 2.0),
+        ("a", 2, 3.0),
+        ("a", 1, 4.0),
+        (None, 1, 5.0),
+        ("b", None, None),
+    ]:
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["cat"] = cat
+        f["sub"] = sub
+        f["val"] = val
+        lyr.CreateFeature(f)
+    return ds
+
+
+def test_ogr_sql_group_by(ds_for_group_by):
+
+    with ds_for_group_by.ExecuteSQL(
+        "SELECT cat, COUNT(*), COUNT(val), SUM(val), AVG(val), MIN(val), MAX(val) FROM test GROUP BY cat"
+    ) as sql_lyr:
+        assert sql_lyr.GetGeomType() == ogr.wkbNone
+        assert sql_lyr.GetFeatureCount() == 3
+        res = [
+            (
+                f["cat"],
+                f["COUNT_*"],
+                f["COUNT_val"],
+                f["SUM_val"],
+                f["AVG_val"],
+                f["MIN_val"],
+                f["MAX_val"],
+            )
+            for f in sql_lyr
+        ]
+        assert res == [
+            ("a", 3, 3, 8.0, pytest.approx(8.0 / 3), 1.0, 4.0),
+            ("b", 2, 1, 2.0, 2.0, 2.0, 2.0),
+            (None, 1, 1, 5.0, 5.0, 5.0, 5.0),
+        ]
+
+        f = sql_lyr.GetFeature(1)
+        assert f.GetFID() == 1
+        assert f["cat"] == "b"
+        assert sql_lyr.GetFeature(3) is None
+
+
+def test_ogr_sql_group_by_multiple_keys_order_by(ds_for_group_by):
+
+    with ds_for_group_by.ExecuteSQL(
+        "SELECT cat, sub, COUNT(*) AS n FROM test GROUP BY cat, sub ORDER BY cat DESC, sub"
+    ) as sql_lyr:
+        res = [(f["cat"], f["sub"], f["n"]) for f in sql_lyr]
+        assert res == [
+            ("b", None, 1),
+            ("b", 1, 1),
+            ("a", 1, 2),
+            ("a", 2, 1),
+            (None, 1, 1),
+        ]
+
+    with ds_for_group_by.ExecuteSQL(
+        "SELECT cat, sub, COUNT(*) AS n FROM test GROUP BY cat, sub ORDER BY cat DESC, sub LIMIT 2 OFFSET 1"
+    ) as sql_lyr:
+        assert sql_lyr.GetFeatureCount() == 2
+        res = [(f["cat"], f["sub"], f["n"]) for f in sql_lyr]
+        assert res == [("b", 1, 1), ("a", 1, 2)]
+
+
+def test_ogr_sql_group_by_where_and_count_distinct(ds_for_group_by):
+
+    with ds_for_group_by.ExecuteSQL(
+        "SELECT cat, COUNT(DISTINCT sub) FROM test GROUP BY cat ORDER BY cat"
+    ) as sql_lyr:
+        res = [(f["cat"], f["COUNT_sub"]) for f in sql_lyr]
+        assert res == [(None, 1), ("a", 2), ("b", 1)]
+
+    # Key not in the select list
+    with ds_for_group_by.ExecuteSQL(
+        "SELECT COUNT(*) AS n FROM test WHERE val > 1 GROUP BY cat"
+    ) as sql_lyr:
+        assert [f["n"] for f in sql_lyr] == [1, 2, 1]
+
+
+@pytest.mark.parametrize(
+    "sql,error_msg",
+    [
+        (
+            "SELECT cat, sub FROM test GROUP BY cat",
+            "must appear in the GROUP BY clause",
+        ),
+        ("SELECT * FROM test GROUP BY cat", "must appear in the GROUP BY clause"),
+        ("SELECT cat FROM test GROUP BY foo", "Unrecognized field name foo"),
+        (
+            "SELECT COUNT(*) FROM test GROUP BY cat ORDER BY sub",
+            "must appear in the GROUP BY clause",
+        ),
+        ("SELECT DISTINCT cat FROM test GROUP BY cat", "not supported"),
+        ("SELECT cat FROM test GROUP BY", None),
+    ],
+)
+def test_ogr_sql_group_by_errors(ds_for_group_by, sql, error_msg):
+
+    with pytest.raises(Exception, match=error_msg):
+        ds_for_group_by.ExecuteSQL(sql)
+
+
+def test_ogr_sql_group_as_column_name():
+
+    ds = ogr.GetDriverByName("MEM").CreateDataSource("")
+    lyr = ds.CreateLayer("test")
+    lyr.CreateField(ogr.FieldDefn("group", ogr.OFTString))
+    for v in ("x", "y", "x"):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["group"] = v
+        lyr.CreateFeature(f)
+
+    with ds.ExecuteSQL("SELECT group FROM test WHERE group = 'y'") as sql_lyr:
+        assert sql_lyr.GetFeatureCount() == 1
+
+    with ds.ExecuteSQL(
+        'SELECT "group", COUNT(*) FROM test GROUP BY "group"'
+    ) as sql_lyr:
+        assert [(f["group"], f["COUNT_*"]) for f in sql_lyr] == [
+            ("x", 2),
+            ("y", 1),
+        ]
+
+
+###############################################################################
+# Test ORDER BY with an external merge sort, and that it gives the same results
+# as the in-memory sort
+
+
+@pytest.mark.parametrize("carry_features", ["YES", "NO"])
+def test_ogr_sql_order_by_external_sort(tmp_path, carry_features):
+
+    ds = ogr.GetDriverByName("MEM").CreateDataSource("")
+    lyr = ds.CreateLayer("test")
+    lyr.CreateField(ogr.FieldDefn("int", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+    lyr.CreateField(ogr.FieldDefn("real", ogr.OFTReal))
+    for i in range(1000):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["int"] = (i * 37) % 11
+        if i % 7 != 0:
+            f["str"] = "val%d" % ((i * 13) % 101)
+        f["real"] = ((i * 17) % 23) / 3.0
+        f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (%d 0)" % i))
+        lyr.CreateFeature(f)
+
+    def get_result(sql):
+        got_msg = []
+
+        def my_handler(errorClass, errno, msg):
+            if errorClass == gdal.CE_Debug and "external sort" in msg:
+                got_msg.append(msg)
+
+        with gdaltest.error_handler(my_handler), gdaltest.config_option(
+            "CPL_DEBUG", "ON"
+        ):
+            with ds.ExecuteSQL(sql) as sql_lyr:
+                res = [
+                    (f.GetFID(), f["int"], f["str"], f.GetGeometryRef().GetX())
+                    for f in sql_lyr
+                ]
+        return res, len(got_msg) != 0
+
+    for sql in [
+        "SELECT * FROM test ORDER BY int",
+        "SELECT * FROM test ORDER BY str DESC, real",
+        "SELECT * FROM test WHERE int > 3 ORDER BY real, str LIMIT 500 OFFSET 20",
+    ]:
+        ref, external_sort = get_result(sql)
+        assert not external_sort
+
+        # Small enough to get more runs than the merge width
+        with gdaltest.config_options(
+            {
+                "OGR_GENSQL_ORDER_BY_MAX_MEMORY": "1000",
+                "OGR_GENSQL_ORDER_BY_CARRY_FEATURES": carry_features,
+                "CPL_TMPDIR": str(tmp_path),
+            }
+        ):
+            res, external_sort = get_result(sql)
+        assert external_sort
+        assert res == ref
+
+    # Temporary files must have been cleaned up
+    assert os.listdir(tmp_path) == []
+
+
+###############################################################################
+# Test SetNextByIndex() and rewinding on an externally sorted result
+
+
+def test_ogr_sql_order_by_external_sort_set_next_by_index():
+
+    ds = ogr.GetDriverByName("MEM").CreateDataSource("")
+    lyr = ds.CreateLayer("test")
+    lyr.CreateField(ogr.FieldDefn("int", ogr.OFTInteger))
+    for i in range(100):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["int"] = 99 - i
+        lyr.CreateFeature(f)
+
+    with gdaltest.config_option("OGR_GENSQL_ORDER_BY_MAX_MEMORY", "500"):
+        with ds.ExecuteSQL("SELECT * FROM test ORDER BY int OFFSET 10") as sql_lyr:
+            assert sql_lyr.GetNextFeature()["int"] == 10
+            assert sql_lyr.SetNextByIndex(50) == ogr.OGRERR_NONE
+            assert sql_lyr.GetNextFeature()["int"] == 60
+            assert sql_lyr.SetNextByIndex(5) == ogr.OGRERR_NONE
+            assert sql_lyr.GetNextFeature()["int"] == 15
+            sql_lyr.ResetReading()
+            assert [f["int"] for f in sql_lyr] == list(range(10, 100))
@@ -957,3 +957,28 @@ UNIT["Foot_US",0.30480060960121924],AUTHORITY["EPSG","102641"]]"""
     x, y, _ = ct.TransformPoint(-122, 39.3333333333333, 0)
     assert x == pytest.approx(6561666.667)
     assert y == pytest.approx(1640416.667)
+
+
+###############################################################################
+# Test the multi-threaded code path of OGRProjCT::TransformWithErrorCodes()
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4", "ALL_CPUS"])
+def test_osr_ct_transform_points_multi_threaded(num_threads):
+
+    s = osr.SpatialReference()
+    s.ImportFromEPSG(4326)
+    s.SetAxisMappingStrategy(osr.OAMS_TRADITIONAL_GIS_ORDER)
+    t = osr.SpatialReference()
+    t.ImportFromEPSG(32631)
+    ct = osr.CoordinateTransformation(s, t)
+
+    N = 100000
+    points = [(3 + (i % 1000) * 1e-3, 45 + (i // 1000) * 1e-2) for i in range(N)]
+    with gdaltest.config_option("OGR_CT_NUM_THREADS", "1"):
+        expected = ct.TransformPoints(points)
+    with gdaltest.config_option("OGR_CT_NUM_THREADS", num_threads):
+        got = ct.TransformPoints(points)
+    assert len(got) == N
+    assert got == expected
+    assert got[0] == pytest.approx((500000, 4982950.4, 0), abs=1e-1)
@@ -348,3 +348,45 @@ def test_gdalalg_raster_proximity_cannot_create_temp_file(tmp_path, tmp_vsimem):
     ):
         with pytest.raises(Exception):
             alg.Run()
+
+
+@pytest.mark.require_driver("GTiff")
+@pytest.mark.parametrize(
+    "output_value,expected_output_data",
+    [
+        ("distance", [[0, 1, 2], [1, 1, 1.4142135], [1, 0, 1]]),
+        ("nearest-value", [[3, 3, 3], [3, 1, 1], [1, 1, 1]]),
+        ("nearest-index", [[0, 0, 0], [0, 7, 7], [7, 7, 7]]),
+    ],
+)
+def test_gdalalg_raster_proximity_edt(tmp_vsimem, output_value, expected_output_data):
+
+    input_data = np.array([[3, 0, 0], [0, 0, 0], [0, 1, 0]], dtype=np.uint8)
+    src_filename = tmp_vsimem / "prox_in.tif"
+    dst_filename = tmp_vsimem / "prox_out.tif"
+    create_gtiff_from_array(src_filename, input_data)
+
+    alg = get_alg()
+    alg["input"] = str(src_filename)
+    alg["output"] = str(dst_filename)
+    alg["algorithm"] = "edt"
+    alg["output-value"] = output_value
+    alg["num-threads"] = 2
+    assert alg.Run()
+    assert alg.Finalize()
+
+    out_ds = gdal.Open(str(dst_filename))
+    output_data = out_ds.GetRasterBand(1).ReadAsArray()
+    assert np.allclose(output_data, np.array(expected_output_data), atol=1e-6)
+    out_ds = None
+
+
+def test_gdalalg_raster_proximity_nearest_value_requires_edt(tmp_vsimem):
+
+    alg = get_alg()
+    alg["input"] = "../gcore/data/byte.tif"
+    alg["output"] = str(tmp_vsimem / "prox_out.tif")
+    alg["algorithm"] = "sweep"
+    alg["output-value"] = "nearest-value"
+    with pytest.raises(Exception, match="requires --algorithm edt"):
+        alg.Run()
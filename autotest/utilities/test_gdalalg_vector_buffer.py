@@ -106,3 +106,56 @@ def test_gdalalg_vector_buffer(input_wkt, options, output_wkt):
     )
     out_f = out_lyr.GetNextFeature()
     assert out_f.GetGeometryRef() is None
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_gdalalg_vector_buffer_multi_threaded(num_threads):
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", 0, 0, 0, gdal.GDT_Unknown)
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(32631)
+    src_lyr = src_ds.CreateLayer("the_layer", srs=srs)
+    src_lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+
+    N = 1000
+    for i in range(N):
+        f = ogr.Feature(src_lyr.GetLayerDefn())
+        f["id"] = i
+        if i % 10 != 0:
+            f.SetGeometry(ogr.CreateGeometryFromWkt(f"POINT ({i} {i})"))
+        src_lyr.CreateFeature(f)
+
+    alg = get_alg()
+    alg["input"] = src_ds
+    alg["output"] = ""
+    alg["output-format"] = "stream"
+    alg["distance"] = 1
+    alg["quadrant-segments"] = 2
+
+    with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+        assert alg.Run()
+
+        out_ds = alg["output"].GetDataset()
+        out_lyr = out_ds.GetLayer(0)
+        for iter in range(2):
+            count = 0
+            for i, out_f in enumerate(out_lyr):
+                assert out_f["id"] == i
+                if i % 10 == 0:
+                    assert out_f.GetGeometryRef() is None
+                else:
+                    assert out_f.GetGeometryRef().GetEnvelope() == (
+                        i - 1,
+                        i + 1,
+                        i - 1,
+                        i + 1,
+                    )
+                    assert (
+                        out_f.GetGeometryRef()
+                        .GetSpatialReference()
+                        .GetAuthorityCode(None)
+                        == "32631"
+                    )
+                count += 1
+            assert count == N
+            out_lyr.ResetReading()
@@ -910,3 +910,80 @@ def test_gdaldem_lib_dict_arguments():
     ind = opt.index("-co")
 
     assert opt[ind : ind + 4] == ["-co", "COMPRESS=DEFLATE", "-co", "LEVEL=4"]
+
+
+###############################################################################
+# Test that the multi-threaded processing gives the same result as the
+# single-threaded one
+
+
+@pytest.mark.parametrize("datatype", [gdal.GDT_Int16, gdal.GDT_Float32])
+@pytest.mark.parametrize(
+    "processing,options",
+    [
+        ("hillshade", {}),
+        ("hillshade", {"computeEdges": True}),
+        ("hillshade", {"multiDirectional": True}),
+        ("slope", {"computeEdges": True}),
+        ("aspect", {"alg": "ZevenbergenThorne"}),
+        ("TRI", {}),
+    ],
+)
+def test_gdaldem_lib_multi_threaded(datatype, processing, options):
+
+    width = 100
+    height = 600
+    src_ds = gdal.GetDriverByName("MEM").Create("", width, height, 1, datatype)
+    src_ds.SetGeoTransform([0, 10, 0, 0, 0, -10])
+    src_ds.GetRasterBand(1).SetNoDataValue(-1)
+    values = [
+        -1 if (x * 7 + y * 13) % 101 == 0 else (x * 3 + y * y // 50) % 1000
+        for y in range(height)
+        for x in range(width)
+    ]
+    src_ds.GetRasterBand(1).WriteRaster(
+        0,
+        0,
+        width,
+        height,
+        struct.pack("h" * width * height, *values),
+        buf_type=gdal.GDT_Int16,
+    )
+
+    with gdal.config_option("GDAL_NUM_THREADS", "1"):
+        expected = gdal.DEMProcessing(
+            "", src_ds, processing, format="MEM", **options
+        ).ReadRaster()
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        got = gdal.DEMProcessing(
+            "", src_ds, processing, format="MEM", **options
+        ).ReadRaster()
+    assert got == expected
+
+
+###############################################################################
+# Test multi-threaded processing with destination blocks taller than strips
+
+
+def test_gdaldem_lib_multi_threaded_tiled_output(tmp_vsimem):
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", 100, 600, 1, gdal.GDT_Int16)
+    src_ds.SetGeoTransform([0, 10, 0, 0, 0, -10])
+    values = [(x * 3 + y * y // 50) % 1000 for y in range(600) for x in range(100)]
+    src_ds.GetRasterBand(1).WriteRaster(
+        0, 0, 100, 600, struct.pack("h" * 100 * 600, *values)
+    )
+
+    with gdal.config_option("GDAL_NUM_THREADS", "1"):
+        expected = gdal.DEMProcessing(
+            "", src_ds, "hillshade", format="MEM"
+        ).ReadRaster()
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        out_ds = gdal.DEMProcessing(
+            tmp_vsimem / "out.tif",
+            src_ds,
+            "hillshade",
+            creationOptions=["TILED=YES", "BLOCKYSIZE=256", "COMPRESS=DEFLATE"],
+        )
+        assert out_ds.GetRasterBand(1).GetBlockSize() == [256, 256]
+        assert out_ds.ReadRaster() == expected
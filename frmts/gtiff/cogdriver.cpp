@@ -55,13 +55,19 @@ static bool HasZSTDCompression()
 /*                           GetTmpFilename()                           */
 /************************************************************************/
 
-static CPLString GetTmpFilename(const char *pszFilename, const char *pszExt)
+static CPLString GetTmpFilename(const char *pszFilename, const char *pszExt,
+                                bool bInMemory = false)
 {
     const bool bSupportsRandomWrite =
         VSISupportsRandomWrite(pszFilename, false);
     CPLString osTmpFilename;
-    if (!bSupportsRandomWrite ||
-        CPLGetConfigOption("CPL_TMPDIR", nullptr) != nullptr)
+    if (bInMemory)
+    {
+        osTmpFilename =
+            VSIMemGenerateHiddenFilename(CPLGetFilename(pszFilename));
+    }
+    else if (!bSupportsRandomWrite ||
+             CPLGetConfigOption("CPL_TMPDIR", nullptr) != nullptr)
     {
         osTmpFilename = CPLGenerateTempFilenameSafe(
             CPLGetBasenameSafe(pszFilename).c_str());
@@ -74,6 +80,50 @@ static CPLString GetTmpFilename(const char *pszFilename, const char *pszExt)
     return osTmpFilename;
 }
 
+/************************************************************************/
+/*                    CanGenerateOverviewsInMemory()                    */
+/************************************************************************/
+
+/** Return whether the temporary overview files can be generated in memory,
+ * that is if their uncompressed size does not exceed COG_TMP_MAX_MEMORY.
+ * Otherwise they are spilled to disk.
+ */
+static bool CanGenerateOverviewsInMemory(
+    GDALDataset *poSrcDS, bool bGenerateOvr, bool bGenerateMskOvr,
+    const std::vector<std::pair<int, int>> &asOverviewDims)
+{
+    // Temporary files are kept for inspection only on disk
+    if (!CPLTestBool(CPLGetConfigOption("COG_DELETE_TEMP_FILES", "YES")))
+        return false;
+
+    const char *pszMaxMemory = CPLGetConfigOption("COG_TMP_MAX_MEMORY", "10%");
+    GIntBig nMaxMemory = 0;
+    bool bUnitSpecified = false;
+    if (CPLParseMemorySize(pszMaxMemory, &nMaxMemory, &bUnitSpecified) !=
+        CE_None)
+    {
+        return false;
+    }
+
+    double dfPixelSize = 0;
+    if (bGenerateOvr)
+    {
+        dfPixelSize +=
+            double(poSrcDS->GetRasterCount()) *
+            GDALGetDataTypeSizeBytes(
+                poSrcDS->GetRasterBand(1)->GetRasterDataType());
+    }
+    if (bGenerateMskOvr)
+        dfPixelSize += 1;
+
+    double dfSize = 0;
+    for (const auto &oDims : asOverviewDims)
+        dfSize += double(oDims.first) * oDims.second * dfPixelSize;
+
+    CPLDebug("COG", "Uncompressed size of overviews: %.0f bytes", dfSize);
+    return dfSize <= static_cast<double>(nMaxMemory);
+}
+
 /************************************************************************/
 /*                             GetResampling()                          */
 /************************************************************************/
@@ -1110,6 +1160,14 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
             double(nXSize) * nYSize * (nBands + (bHasMask ? 1 : 0)) * 4. / 3;
     }
 
+    // Generating the temporary overview files in memory saves a round-trip
+    // through the disk, and the need for local scratch space when the output
+    // file system does not support random writes.
+    const bool bTmpOverviewsInMemory =
+        (bGenerateMskOvr || bGenerateOvr) &&
+        CanGenerateOverviewsInMemory(poCurDS, bGenerateOvr, bGenerateMskOvr,
+                                     asOverviewDims);
+
     CPLStringList aosOverviewOptions;
     aosOverviewOptions.SetNameValue(
         "COMPRESS",
@@ -1123,7 +1181,8 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
     if (bGenerateMskOvr)
     {
         CPLDebug("COG", "Generating overviews of the mask: start");
-        m_osTmpMskOverviewFilename = GetTmpFilename(pszFilename, "msk.ovr.tmp");
+        m_osTmpMskOverviewFilename = GetTmpFilename(
+            pszFilename, "msk.ovr.tmp", bTmpOverviewsInMemory);
         GDALRasterBand *poSrcMask = poFirstBand->GetMaskBand();
         const char *pszResampling = CSLFetchNameValueDef(
             papszOptions, "OVERVIEW_RESAMPLING",
@@ -1154,7 +1213,8 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
     if (bGenerateOvr)
     {
         CPLDebug("COG", "Generating overviews of the imagery: start");
-        m_osTmpOverviewFilename = GetTmpFilename(pszFilename, "ovr.tmp");
+        m_osTmpOverviewFilename =
+            GetTmpFilename(pszFilename, "ovr.tmp", bTmpOverviewsInMemory);
         std::vector<GDALRasterBand *> apoSrcBands;
         for (int i = 0; i < nBands; i++)
             apoSrcBands.push_back(poCurDS->GetRasterBand(i + 1));
@@ -0,0 +1,602 @@
+/******************************************************************************
+ *
+ * Project:  Hierarchical Data Format Release 5 (HDF5)
+ * Purpose:  Read chunked datasets by decoding raw chunks outside of libhdf5
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "hdf5directchunkreader.h"
+#include "hdf5dataset.h"
+
+#include "cpl_conv.h"
+#include "cpl_error.h"
+#include "gdal_thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+// Filter id registered by https://github.com/aparamon/HDF5Plugin-Zstandard
+constexpr H5Z_filter_t HDF5_FILTER_ZSTD = 32015;
+
+// Maximum cumulated size of raw chunks read at once
+constexpr size_t MAX_RAW_BATCH_SIZE = 64 * 1024 * 1024;
+
+/************************************************************************/
+/*                              Create()                                */
+/************************************************************************/
+
+std::unique_ptr<HDF5DirectChunkReader>
+HDF5DirectChunkReader::Create(hid_t hDataset, hid_t hNativeType)
+{
+#if H5_VERSION_GE(1, 10, 5)
+    if (!CPLTestBool(
+            CPLGetConfigOption("GDAL_HDF5_DIRECT_CHUNK_READ", "YES")))
+        return nullptr;
+
+    // Only numeric types (or compounds of them, such as complex types),
+    // whose in-file representation is the native one.
+    const auto IsNumericClass = [](H5T_class_t eClass)
+    { return eClass == H5T_INTEGER || eClass == H5T_FLOAT; };
+    const H5T_class_t eClass = H5Tget_class(hNativeType);
+    if (eClass == H5T_COMPOUND)
+    {
+        const int nMembers = H5Tget_nmembers(hNativeType);
+        for (int i = 0; i < nMembers; ++i)
+        {
+            const hid_t hMemberType = H5Tget_member_type(hNativeType, i);
+            const bool bOK = IsNumericClass(H5Tget_class(hMemberType));
+            H5Tclose(hMemberType);
+            if (!bOK)
+                return nullptr;
+        }
+    }
+    else if (!IsNumericClass(eClass))
+    {
+        return nullptr;
+    }
+    const hid_t hFileType = H5Dget_type(hDataset);
+    const bool bSameType = H5Tequal(hFileType, hNativeType) > 0;
+    H5Tclose(hFileType);
+    if (!bSameType)
+        return nullptr;
+
+    std::unique_ptr<HDF5DirectChunkReader> poReader(
+        new HDF5DirectChunkReader(hDataset));
+    poReader->m_nDTSize = H5Tget_size(hNativeType);
+    if (poReader->m_nDTSize == 0)
+        return nullptr;
+
+    // Raw chunks are read through the VSI API, so only accept files opened
+    // with GDAL's VSI file driver or the default (sec2) one, and without a
+    // user block (H5Dget_chunk_info() addresses are relative to it).
+    const hid_t hFile = H5Iget_file_id(hDataset);
+    if (hFile < 0)
+        return nullptr;
+    bool bFileOK = false;
+    const hid_t hFAPL = H5Fget_access_plist(hFile);
+    if (hFAPL >= 0)
+    {
+        const hid_t hDriver = H5Pget_driver(hFAPL);
+        bFileOK = hDriver == HDF5GetFileDriver() || hDriver == H5FD_SEC2;
+        H5Pclose(hFAPL);
+    }
+    const hid_t hFCPL = bFileOK ? H5Fget_create_plist(hFile) : -1;
+    if (hFCPL >= 0)
+    {
+        hsize_t nUserBlockSize = 0;
+        bFileOK = H5Pget_userblock(hFCPL, &nUserBlockSize) >= 0 &&
+                  nUserBlockSize == 0;
+        H5Pclose(hFCPL);
+    }
+    if (bFileOK)
+    {
+        const ssize_t nNameLen = H5Fget_name(hFile, nullptr, 0);
+        if (nNameLen > 0)
+        {
+            poReader->m_osFilename.resize(static_cast<size_t>(nNameLen));
+            bFileOK = H5Fget_name(hFile, &poReader->m_osFilename[0],
+                                  static_cast<size_t>(nNameLen) + 1) > 0;
+        }
+        else
+        {
+            bFileOK = false;
+        }
+    }
+    H5Fclose(hFile);
+    if (!bFileOK)
+        return nullptr;
+
+    // Dimensions and chunking
+    const hid_t hDataSpace = H5Dget_space(hDataset);
+    const int nDims = H5Sget_simple_extent_ndims(hDataSpace);
+    if (nDims > 0)
+    {
+        poReader->m_anDims.resize(nDims);
+        H5Sget_simple_extent_dims(hDataSpace, poReader->m_anDims.data(),
+                                  nullptr);
+    }
+    H5Sclose(hDataSpace);
+    if (nDims <= 0)
+        return nullptr;
+
+    const hid_t hPlist = H5Dget_create_plist(hDataset);
+    if (hPlist < 0)
+        return nullptr;
+    const bool bOK = [&poReader, hPlist, hNativeType, nDims]()
+    {
+        if (H5Pget_layout(hPlist) != H5D_CHUNKED)
+            return false;
+        poReader->m_anChunkDims.resize(nDims);
+        if (H5Pget_chunk(hPlist, nDims, poReader->m_anChunkDims.data()) !=
+            nDims)
+            return false;
+        uint64_t nChunkByteSize = poReader->m_nDTSize;
+        for (int i = 0; i < nDims; ++i)
+        {
+            const hsize_t nChunkDim = poReader->m_anChunkDims[i];
+            if (nChunkDim == 0 ||
+                nChunkDim > static_cast<uint64_t>(
+                                std::numeric_limits<int>::max()) /
+                                nChunkByteSize)
+                return false;
+            nChunkByteSize *= nChunkDim;
+            poReader->m_anChunkCount.push_back(
+                (poReader->m_anDims[i] + nChunkDim - 1) / nChunkDim);
+        }
+        poReader->m_nChunkByteSize = static_cast<size_t>(nChunkByteSize);
+
+        // Fill value for chunks that are not allocated
+        H5D_fill_time_t eFillTime = H5D_FILL_TIME_IFSET;
+        if (H5Pget_fill_time(hPlist, &eFillTime) < 0 ||
+            eFillTime == H5D_FILL_TIME_NEVER)
+            return false;
+        poReader->m_abyFillValue.resize(poReader->m_nDTSize);
+        H5D_fill_value_t eFillValueStatus = H5D_FILL_VALUE_UNDEFINED;
+        if (H5Pfill_value_defined(hPlist, &eFillValueStatus) >= 0 &&
+            eFillValueStatus != H5D_FILL_VALUE_UNDEFINED &&
+            H5Pget_fill_value(hPlist, hNativeType,
+                              poReader->m_abyFillValue.data()) < 0)
+            return false;
+
+        bool bHasCompressor = false;
+        const int nFilters = H5Pget_nfilters(hPlist);
+        for (int i = 0; i < nFilters; ++i)
+        {
+            unsigned int nFlags = 0;
+            unsigned int anCDValues[8] = {0};
+            size_t nCDValues = CPL_ARRAYSIZE(anCDValues);
+            char szName[64 + 1] = {0};
+            Filter oFilter;
+            oFilter.nId = H5Pget_filter(hPlist, i, &nFlags, &nCDValues,
+                                        anCDValues, 64, szName);
+            if (oFilter.nId == H5Z_FILTER_SHUFFLE)
+            {
+                oFilter.nEltSize = nCDValues >= 1 ? anCDValues[0]
+                                                  : poReader->m_nDTSize;
+            }
+            else if (oFilter.nId == H5Z_FILTER_DEFLATE ||
+                     oFilter.nId == HDF5_FILTER_ZSTD)
+            {
+                // Chained compressors would require knowing the size of
+                // intermediate buffers.
+                if (bHasCompressor)
+                    return false;
+                bHasCompressor = true;
+                oFilter.psDecompressor = CPLGetDecompressor(
+                    oFilter.nId == H5Z_FILTER_DEFLATE ? "zlib" : "zstd");
+                if (!oFilter.psDecompressor)
+                    return false;
+            }
+            else
+            {
+                return false;
+            }
+            poReader->m_aoFilters.push_back(oFilter);
+        }
+        // H5Dget_chunk_info() filter masks have 32 bits
+        return poReader->m_aoFilters.size() <= 32;
+    }();
+    H5Pclose(hPlist);
+    if (!bOK)
+        return nullptr;
+
+    return poReader;
+#else
+    CPL_IGNORE_RET_VAL(hDataset);
+    CPL_IGNORE_RET_VAL(hNativeType);
+    return nullptr;
+#endif
+}
+
+/************************************************************************/
+/*                            DecodeChunk()                             */
+/************************************************************************/
+
+/** Apply, in reverse order, the filters that have not been skipped according
+ * to nFilterMask. abyData is replaced by the decoded chunk.
+ */
+bool HDF5DirectChunkReader::DecodeChunk(std::vector<GByte> &abyData,
+                                        unsigned nFilterMask,
+                                        std::vector<GByte> &abyTmp) const
+{
+    for (size_t i = m_aoFilters.size(); i > 0;)
+    {
+        --i;
+        if ((nFilterMask & (1U << i)) != 0)
+            continue;
+        const Filter &oFilter = m_aoFilters[i];
+        if (oFilter.psDecompressor)
+        {
+            abyTmp.resize(m_nChunkByteSize);
+            void *pOutData = abyTmp.data();
+            size_t nOutSize = abyTmp.size();
+            if (!oFilter.psDecompressor->pfnFunc(
+                    abyData.data(), abyData.size(), &pOutData, &nOutSize,
+                    nullptr, oFilter.psDecompressor->user_data))
+            {
+                return false;
+            }
+            abyTmp.resize(nOutSize);
+            std::swap(abyData, abyTmp);
+        }
+        else if (oFilter.nEltSize > 1)
+        {
+            // Unshuffle: byte j of element k is at j * nElts + k.
+            // Trailing bytes that do not form a whole element are not
+            // shuffled.
+            const size_t nEltSize = oFilter.nEltSize;
+            const size_t nElts = abyData.size() / nEltSize;
+            abyTmp.resize(abyData.size());
+            for (size_t j = 0; j < nEltSize; ++j)
+            {
+                const GByte *pabySrc = abyData.data() + j * nElts;
+                GByte *pabyDst = abyTmp.data() + j;
+                for (size_t k = 0; k < nElts; ++k)
+                    pabyDst[k * nEltSize] = pabySrc[k];
+            }
+            memcpy(abyTmp.data() + nElts * nEltSize,
+                   abyData.data() + nElts * nEltSize,
+                   abyData.size() - nElts * nEltSize);
+            std::swap(abyData, abyTmp);
+        }
+    }
+    return abyData.size() == m_nChunkByteSize;
+}
+
+/************************************************************************/
+/*                          CopyChunkRegion()                           */
+/************************************************************************/
+
+/** Copy the region of a decoded chunk starting at anSrcOffset and of size
+ * anRegionCount into pabyDst, or fill it with pabyFillValue if pabyChunk is
+ * null.
+ */
+static void CopyChunkRegion(const GByte *pabyChunk, const GByte *pabyFillValue,
+                            size_t nDTSize, size_t nDims,
+                            const hsize_t *anChunkDims,
+                            const size_t *anSrcOffset,
+                            const size_t *anRegionCount, GByte *pabyDst,
+                            const GPtrDiff_t *anDstStride)
+{
+    std::vector<size_t> anSrcStride(nDims);
+    anSrcStride[nDims - 1] = 1;
+    for (size_t i = nDims - 1; i > 0; --i)
+        anSrcStride[i - 1] =
+            anSrcStride[i] * static_cast<size_t>(anChunkDims[i]);
+
+    const size_t iLastDim = nDims - 1;
+    const size_t nRowCount = anRegionCount[iLastDim];
+    const GPtrDiff_t nDstEltStride =
+        anDstStride[iLastDim] * static_cast<GPtrDiff_t>(nDTSize);
+    std::vector<size_t> anIdx(nDims);
+    while (true)
+    {
+        size_t nSrcOffset = anSrcOffset[iLastDim];
+        GPtrDiff_t nDstOffset = 0;
+        for (size_t i = 0; i < iLastDim; ++i)
+        {
+            nSrcOffset += (anSrcOffset[i] + anIdx[i]) * anSrcStride[i];
+            nDstOffset += static_cast<GPtrDiff_t>(anIdx[i]) * anDstStride[i] *
+                          static_cast<GPtrDiff_t>(nDTSize);
+        }
+        GByte *pabyDstRow = pabyDst + nDstOffset;
+        if (pabyChunk &&
+            nDstEltStride == static_cast<GPtrDiff_t>(nDTSize))
+        {
+            memcpy(pabyDstRow, pabyChunk + nSrcOffset * nDTSize,
+                   nRowCount * nDTSize);
+        }
+        else
+        {
+            for (size_t k = 0; k < nRowCount; ++k)
+            {
+                memcpy(pabyDstRow + static_cast<GPtrDiff_t>(k) * nDstEltStride,
+                       pabyChunk ? pabyChunk + (nSrcOffset + k) * nDTSize
+                                 : pabyFillValue,
+                       nDTSize);
+            }
+        }
+
+        size_t iDim = iLastDim;
+        while (true)
+        {
+            if (iDim == 0)
+                return;
+            --iDim;
+            if (++anIdx[iDim] < anRegionCount[iDim])
+                break;
+            anIdx[iDim] = 0;
+        }
+    }
+}
+
+/************************************************************************/
+/*                                Read()                                */
+/************************************************************************/
+
+bool HDF5DirectChunkReader::Read(const hsize_t *anStart, const size_t *anCount,
+                                 const GPtrDiff_t *anDstStride,
+                                 void *pDstBuffer)
+{
+#if H5_VERSION_GE(1, 10, 5)
+    const size_t nDims = m_anDims.size();
+    for (size_t i = 0; i < nDims; ++i)
+    {
+        if (anCount[i] == 0)
+            return true;
+        if (anStart[i] >= m_anDims[i] || anCount[i] > m_anDims[i] - anStart[i])
+            return false;
+    }
+
+    {
+        std::lock_guard oMutexLock(m_oMutex);
+        if (!m_bFileOpenAttempted)
+        {
+            m_bFileOpenAttempted = true;
+            m_fp.reset(VSIFOpenL(m_osFilename.c_str(), "rb"));
+            if (!m_fp)
+                CPLDebug("HDF5", "Cannot open %s", m_osFilename.c_str());
+        }
+        if (!m_fp)
+            return false;
+    }
+
+    // Collect the chunks intersecting the request
+    std::vector<hsize_t> anFirstChunk(nDims);
+    std::vector<hsize_t> anLastChunk(nDims);
+    for (size_t i = 0; i < nDims; ++i)
+    {
+        anFirstChunk[i] = anStart[i] / m_anChunkDims[i];
+        anLastChunk[i] = (anStart[i] + anCount[i] - 1) / m_anChunkDims[i];
+    }
+    std::vector<hsize_t> anChunkCoords;
+    std::vector<uint64_t> anChunkIndices;
+    {
+        std::vector<hsize_t> anCur(anFirstChunk);
+        while (true)
+        {
+            uint64_t nIdx = 0;
+            for (size_t i = 0; i < nDims; ++i)
+                nIdx = nIdx * m_anChunkCount[i] + anCur[i];
+            anChunkIndices.push_back(nIdx);
+            anChunkCoords.insert(anChunkCoords.end(), anCur.begin(),
+                                 anCur.end());
+
+            bool bDone = true;
+            for (size_t iDim = nDims; iDim > 0;)
+            {
+                --iDim;
+                if (++anCur[iDim] <= anLastChunk[iDim])
+                {
+                    bDone = false;
+                    break;
+                }
+                anCur[iDim] = anFirstChunk[iDim];
+            }
+            if (bDone)
+                break;
+        }
+    }
+    const size_t nChunks = anChunkIndices.size();
+
+    // Fetch the locations of the chunks from the cache, and query the ones
+    // not yet known. The HDF5 lock is not taken while holding m_oMutex.
+    std::vector<ChunkInfo> aoChunkInfo(nChunks);
+    std::vector<size_t> anUnknownChunks;
+    {
+        std::lock_guard oMutexLock(m_oMutex);
+        for (size_t iChunk = 0; iChunk < nChunks; ++iChunk)
+        {
+            const auto oIter = m_oMapChunkInfo.find(anChunkIndices[iChunk]);
+            if (oIter != m_oMapChunkInfo.end())
+                aoChunkInfo[iChunk] = oIter->second;
+            else
+                anUnknownChunks.push_back(iChunk);
+        }
+    }
+    if (!anUnknownChunks.empty())
+    {
+        {
+            HDF5_GLOBAL_LOCK();
+
+            std::vector<hsize_t> anChunkOffset(nDims);
+            for (const size_t iChunk : anUnknownChunks)
+            {
+                for (size_t i = 0; i < nDims; ++i)
+                    anChunkOffset[i] =
+                        anChunkCoords[iChunk * nDims + i] * m_anChunkDims[i];
+                ChunkInfo &oInfo = aoChunkInfo[iChunk];
+                if (H5Dget_chunk_info_by_coord(
+                        m_hDataset, anChunkOffset.data(), &oInfo.nFilterMask,
+                        &oInfo.nAddr, &oInfo.nSize) < 0)
+                {
+                    return false;
+                }
+                if (oInfo.nSize == 0)
+                    oInfo.nAddr = HADDR_UNDEF;
+            }
+        }
+
+        std::lock_guard oMutexLock(m_oMutex);
+        for (const size_t iChunk : anUnknownChunks)
+            m_oMapChunkInfo[anChunkIndices[iChunk]] = aoChunkInfo[iChunk];
+    }
+
+    // Copy the part of chunk iChunk that intersects the request
+    const auto CopyChunk = [this, nDims, anStart, anCount, anDstStride,
+                            pDstBuffer,
+                            &anChunkCoords](size_t iChunk,
+                                            const GByte *pabyChunk)
+    {
+        std::vector<size_t> anSrcOffset(nDims);
+        std::vector<size_t> anRegionCount(nDims);
+        GByte *pabyDst = static_cast<GByte *>(pDstBuffer);
+        for (size_t i = 0; i < nDims; ++i)
+        {
+            const hsize_t nChunkStart =
+                anChunkCoords[iChunk * nDims + i] * m_anChunkDims[i];
+            const hsize_t nRegionStart = std::max(nChunkStart, anStart[i]);
+            const hsize_t nRegionEnd =
+                std::min(nChunkStart + m_anChunkDims[i],
+                         static_cast<hsize_t>(anStart[i] + anCount[i]));
+            anSrcOffset[i] = static_cast<size_t>(nRegionStart - nChunkStart);
+            anRegionCount[i] = static_cast<size_t>(nRegionEnd - nRegionStart);
+            pabyDst += static_cast<GPtrDiff_t>(nRegionStart - anStart[i]) *
+                       anDstStride[i] * static_cast<GPtrDiff_t>(m_nDTSize);
+        }
+        CopyChunkRegion(pabyChunk, m_abyFillValue.data(), m_nDTSize, nDims,
+                        m_anChunkDims.data(), anSrcOffset.data(),
+                        anRegionCount.data(), pabyDst, anDstStride);
+    };
+
+    // Fill missing chunks, and sort allocated ones by file offset
+    std::vector<size_t> anAllocatedChunks;
+    for (size_t iChunk = 0; iChunk < nChunks; ++iChunk)
+    {
+        const ChunkInfo &oInfo = aoChunkInfo[iChunk];
+        if (oInfo.nAddr == HADDR_UNDEF)
+            CopyChunk(iChunk, nullptr);
+        else if (oInfo.nSize > 2 * static_cast<hsize_t>(m_nChunkByteSize) +
+                                   1024 * 1024)
+            return false;
+        else
+            anAllocatedChunks.push_back(iChunk);
+    }
+    std::sort(anAllocatedChunks.begin(), anAllocatedChunks.end(),
+              [&aoChunkInfo](size_t a, size_t b)
+              { return aoChunkInfo[a].nAddr < aoChunkInfo[b].nAddr; });
+
+    const int nThreads = GDALGetNumThreads();
+    CPLWorkerThreadPool *poPool =
+        nThreads > 1 && anAllocatedChunks.size() > 1
+            ? GDALGetGlobalThreadPool(nThreads)
+            : nullptr;
+    auto poQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+
+    std::atomic<bool> bSuccess{true};
+    const auto DecodeAndCopyChunk =
+        [this, &bSuccess, &CopyChunk](size_t iChunk, unsigned nFilterMask,
+                                      std::vector<GByte> &abyData)
+    {
+        // Errors are not reported, as the caller falls back to H5Dread()
+        CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+        std::vector<GByte> abyTmp;
+        if (DecodeChunk(abyData, nFilterMask, abyTmp))
+            CopyChunk(iChunk, abyData.data());
+        else
+            bSuccess = false;
+    };
+
+    // Read raw chunks by batches, and decode them
+    size_t iNextChunk = 0;
+    while (iNextChunk < anAllocatedChunks.size() && bSuccess)
+    {
+        std::vector<size_t> anBatch;
+        size_t nBatchSize = 0;
+        while (iNextChunk < anAllocatedChunks.size() &&
+               (anBatch.empty() || nBatchSize < MAX_RAW_BATCH_SIZE))
+        {
+            const size_t iChunk = anAllocatedChunks[iNextChunk++];
+            anBatch.push_back(iChunk);
+            nBatchSize += static_cast<size_t>(aoChunkInfo[iChunk].nSize);
+        }
+
+        std::vector<std::vector<GByte>> aabyRaw(anBatch.size());
+        std::vector<void *> apData(anBatch.size());
+        std::vector<vsi_l_offset> anOffsets(anBatch.size());
+        std::vector<size_t> anSizes(anBatch.size());
+        std::vector<unsigned> anFilterMasks(anBatch.size());
+        try
+        {
+            for (size_t i = 0; i < anBatch.size(); ++i)
+            {
+                const ChunkInfo &oInfo = aoChunkInfo[anBatch[i]];
+                aabyRaw[i].resize(static_cast<size_t>(oInfo.nSize));
+                apData[i] = aabyRaw[i].data();
+                anOffsets[i] = static_cast<vsi_l_offset>(oInfo.nAddr);
+                anSizes[i] = static_cast<size_t>(oInfo.nSize);
+                anFilterMasks[i] = oInfo.nFilterMask;
+            }
+        }
+        catch (const std::exception &)
+        {
+            bSuccess = false;
+            break;
+        }
+        bool bReadOK;
+        {
+            std::lock_guard oMutexLock(m_oMutex);
+            bReadOK = m_fp->ReadMultiRange(static_cast<int>(anBatch.size()),
+                                           apData.data(), anOffsets.data(),
+                                           anSizes.data()) == 0;
+        }
+        if (!bReadOK)
+        {
+            CPLDebug("HDF5", "Cannot read raw chunks of %s",
+                     m_osFilename.c_str());
+            bSuccess = false;
+            break;
+        }
+
+        for (size_t i = 0; i < anBatch.size(); ++i)
+        {
+            const size_t iChunk = anBatch[i];
+            const unsigned nFilterMask = anFilterMasks[i];
+            if (poQueue)
+            {
+                poQueue->SubmitJob(
+                    [&DecodeAndCopyChunk, &aabyRaw, i, iChunk, nFilterMask]()
+                    { DecodeAndCopyChunk(iChunk, nFilterMask, aabyRaw[i]); });
+            }
+            else
+            {
+                DecodeAndCopyChunk(iChunk, nFilterMask, aabyRaw[i]);
+            }
+        }
+        if (poQueue)
+            poQueue->WaitCompletion();
+    }
+
+    if (!bSuccess)
+    {
+        CPLDebug("HDF5",
+                 "Direct chunk reading failed. Using H5Dread() instead");
+        return false;
+    }
+    return true;
+#else
+    CPL_IGNORE_RET_VAL(anStart);
+    CPL_IGNORE_RET_VAL(anCount);
+    CPL_IGNORE_RET_VAL(anDstStride);
+    CPL_IGNORE_RET_VAL(pDstBuffer);
+    return false;
+#endif
+}
@@ -0,0 +1,115 @@
+/******************************************************************************
+ *
+ * Project:  Hierarchical Data Format Release 5 (HDF5)
+ * Purpose:  Read chunked datasets by decoding raw chunks outside of libhdf5
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#ifndef HDF5DIRECTCHUNKREADER_H_INCLUDED
+#define HDF5DIRECTCHUNKREADER_H_INCLUDED
+
+#include "hdf5_api.h"
+
+#include "cpl_compressor.h"
+#include "cpl_vsi_virtual.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/************************************************************************/
+/*                        HDF5DirectChunkReader                         */
+/************************************************************************/
+
+/** Reader of chunked HDF5 datasets that bypasses H5Dread().
+ *
+ * Raw chunks are located with H5Dget_chunk_info_by_coord(), each chunk being
+ * queried only once, read through the VSI API, and decoded (shuffle, deflate,
+ * zstd filters) on GDAL's global thread pool when GDAL_NUM_THREADS is greater
+ * than 1. As decoding happens outside of libhdf5, it does not need to hold the
+ * global HDF5 lock.
+ *
+ * Only datasets whose file and native data types are identical, and whose
+ * filters are all handled, are supported. Create() returns nullptr otherwise,
+ * in which case the caller should keep using H5Dread().
+ */
+class HDF5DirectChunkReader
+{
+  public:
+    /** Must be called with the global HDF5 lock held.
+     * hDataset must remain valid during the lifetime of the reader.
+     */
+    static std::unique_ptr<HDF5DirectChunkReader> Create(hid_t hDataset,
+                                                         hid_t hNativeType);
+
+    /** Read the hyperslab starting at anStart and of size anCount.
+     *
+     * Values are written in the native data type of the dataset, at
+     * pDstBuffer + sum(i, idx[i] * anDstStride[i]) * GetDataTypeSize().
+     * Must be called without the global HDF5 lock held.
+     *
+     * @return false in case of failure, in which case the caller may retry
+     * with H5Dread().
+     */
+    bool Read(const hsize_t *anStart, const size_t *anCount,
+              const GPtrDiff_t *anDstStride, void *pDstBuffer);
+
+    /** Size in bytes of the native data type */
+    size_t GetDataTypeSize() const
+    {
+        return m_nDTSize;
+    }
+
+  private:
+    struct Filter
+    {
+        H5Z_filter_t nId = 0;
+        //! Element size, for the shuffle filter
+        size_t nEltSize = 0;
+        //! Decompressor, for the deflate and zstd filters
+        const CPLCompressor *psDecompressor = nullptr;
+    };
+
+    struct ChunkInfo
+    {
+        haddr_t nAddr = HADDR_UNDEF;
+        hsize_t nSize = 0;
+        unsigned nFilterMask = 0;
+    };
+
+    hid_t m_hDataset;
+    std::string m_osFilename{};
+    std::vector<hsize_t> m_anDims{};
+    std::vector<hsize_t> m_anChunkDims{};
+    std::vector<uint64_t> m_anChunkCount{};
+    size_t m_nDTSize = 0;
+    size_t m_nChunkByteSize = 0;
+    std::vector<GByte> m_abyFillValue{};
+    //! Filters, in the order they are applied when writing
+    std::vector<Filter> m_aoFilters{};
+
+    //! Protects m_oMapChunkInfo, m_fp and m_bFileOpenAttempted
+    std::mutex m_oMutex{};
+    //! Cache of chunk locations, indexed by linear chunk index
+    std::map<uint64_t, ChunkInfo> m_oMapChunkInfo{};
+    VSIVirtualHandleUniquePtr m_fp{};
+    bool m_bFileOpenAttempted = false;
+
+    explicit HDF5DirectChunkReader(hid_t hDataset) : m_hDataset(hDataset)
+    {
+    }
+
+    bool DecodeChunk(std::vector<GByte> &abyRaw, unsigned nFilterMask,
+                     std::vector<GByte> &abyTmp) const;
+
+    CPL_DISALLOW_COPY_ASSIGN(HDF5DirectChunkReader)
+};
+
+#endif /* HDF5DIRECTCHUNKREADER_H_INCLUDED */
@@ -20,6 +20,7 @@
 #include "gdal_priv.h"
 #include "gh5_convenience.h"
 #include "hdf5dataset.h"
+#include "hdf5directchunkreader.h"
 #include "hdf5drivercore.h"
 #include "ogr_spatialref.h"
 #include "memdataset.h"
@@ -102,8 +103,15 @@ class HDF5ImageDataset final : public HDF5Dataset
     // [m_iCurrentBandChunk * m_nBandChunkSize, (m_iCurrentBandChunk+1) * m_nBandChunkSize[
     std::vector<GByte> m_abyBandChunk{};
 
+    //! Reader decoding chunks outside of libhdf5, when possible
+    std::unique_ptr<HDF5DirectChunkReader> m_poDirectChunkReader{};
+
     CPLErr CreateODIMH5Projection();
 
+    bool ReadDirect(int nRank, const H5OFFSET_TYPE *offset,
+                    const hsize_t *count, const hsize_t *anBufferDims,
+                    void *pBuffer);
+
     CPL_DISALLOW_COPY_ASSIGN(HDF5ImageDataset)
 
   public:
@@ -389,8 +397,6 @@ CPLErr HDF5ImageRasterBand::IReadBlock(int nBlockXOff, int nBlockYOff,
         }
     }
 
-    HDF5_GLOBAL_LOCK();
-
     hsize_t count[3] = {0, 0, 0};
     H5OFFSET_TYPE offset[3] = {0, 0, 0};
     hsize_t col_dims[3] = {0, 0, 0};
@@ -414,6 +420,18 @@ CPLErr HDF5ImageRasterBand::IReadBlock(int nBlockXOff, int nBlockYOff,
     offset[poGDS->GetXIndex()] = nXOff;
     count[poGDS->GetXIndex()] = nXSize;
 
+    if (nYIndex >= 0)
+        col_dims[nYIndex] = nBlockYSize;
+    col_dims[poGDS->GetXIndex()] = nBlockXSize;
+
+    if (poGDS->ReadDirect(static_cast<int>(rank), offset, count, col_dims,
+                          pImage))
+    {
+        return CE_None;
+    }
+
+    HDF5_GLOBAL_LOCK();
+
     // Select block from file space.
     herr_t status = H5Sselect_hyperslab(poGDS->dataspace_id, H5S_SELECT_SET,
                                         offset, nullptr, count, nullptr);
@@ -421,9 +439,6 @@ CPLErr HDF5ImageRasterBand::IReadBlock(int nBlockXOff, int nBlockYOff,
         return CE_Failure;
 
     // Create memory space to receive the data.
-    if (nYIndex >= 0)
-        col_dims[nYIndex] = nBlockYSize;
-    col_dims[poGDS->GetXIndex()] = nBlockXSize;
 
     const hid_t memspace =
         H5Screate_simple(static_cast<int>(rank), col_dims, nullptr);
@@ -619,8 +634,6 @@ CPLErr HDF5ImageRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                     static_cast<size_t>(poGDS->m_nBandChunkSize) *
                     nRasterXSize * nRasterYSize * nDTSize);
 
-                HDF5_GLOBAL_LOCK();
-
                 hsize_t count[3] = {
                     std::min(static_cast<hsize_t>(poGDS->nBands),
                              static_cast<hsize_t>(iBandChunk + 1) *
@@ -634,36 +647,42 @@ CPLErr HDF5ImageRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                         poGDS->m_nBandChunkSize,
                     static_cast<H5OFFSET_TYPE>(0),
                     static_cast<H5OFFSET_TYPE>(0)};
-                herr_t status =
-                    H5Sselect_hyperslab(poGDS->dataspace_id, H5S_SELECT_SET,
-                                        offset, nullptr, count, nullptr);
-                if (status < 0)
-                    return CE_Failure;
-
-                const hid_t memspace =
-                    H5Screate_simple(poGDS->ndims, count, nullptr);
-                H5OFFSET_TYPE mem_offset[3] = {0, 0, 0};
-                status =
-                    H5Sselect_hyperslab(memspace, H5S_SELECT_SET, mem_offset,
-                                        nullptr, count, nullptr);
-                if (status < 0)
+                if (!poGDS->ReadDirect(poGDS->ndims, offset, count, count,
+                                       poGDS->m_abyBandChunk.data()))
                 {
-                    H5Sclose(memspace);
-                    return CE_Failure;
-                }
+                    HDF5_GLOBAL_LOCK();
+
+                    herr_t status = H5Sselect_hyperslab(
+                        poGDS->dataspace_id, H5S_SELECT_SET, offset, nullptr,
+                        count, nullptr);
+                    if (status < 0)
+                        return CE_Failure;
+
+                    const hid_t memspace =
+                        H5Screate_simple(poGDS->ndims, count, nullptr);
+                    H5OFFSET_TYPE mem_offset[3] = {0, 0, 0};
+                    status = H5Sselect_hyperslab(memspace, H5S_SELECT_SET,
+                                                 mem_offset, nullptr, count,
+                                                 nullptr);
+                    if (status < 0)
+                    {
+                        H5Sclose(memspace);
+                        return CE_Failure;
+                    }
 
-                status = H5Dread(poGDS->dataset_id, poGDS->native, memspace,
-                                 poGDS->dataspace_id, H5P_DEFAULT,
-                                 poGDS->m_abyBandChunk.data());
+                    status = H5Dread(poGDS->dataset_id, poGDS->native,
+                                     memspace, poGDS->dataspace_id,
+                                     H5P_DEFAULT, poGDS->m_abyBandChunk.data());
 
-                H5Sclose(memspace);
+                    H5Sclose(memspace);
 
-                if (status < 0)
-                {
-                    CPLError(
-                        CE_Failure, CPLE_AppDefined,
-                        "HDF5ImageRasterBand::IRasterIO(): H5Dread() failed");
-                    return CE_Failure;
+                    if (status < 0)
+                    {
+                        CPLError(CE_Failure, CPLE_AppDefined,
+                                 "HDF5ImageRasterBand::IRasterIO(): H5Dread() "
+                                 "failed");
+                        return CE_Failure;
+                    }
                 }
 
                 poGDS->m_iCurrentBandChunk = iBandChunk;
@@ -695,8 +714,6 @@ CPLErr HDF5ImageRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
         nYSize == nBufYSize && eBufType == eDataType &&
         nPixelSpace == nDTSize && nLineSpace == nXSize * nPixelSpace)
     {
-        HDF5_GLOBAL_LOCK();
-
         hsize_t count[3] = {1, static_cast<hsize_t>(nYSize),
                             static_cast<hsize_t>(nXSize)};
         H5OFFSET_TYPE offset[3] = {static_cast<H5OFFSET_TYPE>(nBand - 1),
@@ -710,6 +727,12 @@ CPLErr HDF5ImageRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
             offset[0] = offset[1];
             offset[1] = offset[2];
         }
+
+        if (poGDS->ReadDirect(poGDS->ndims, offset, count, count, pData))
+            return CE_None;
+
+        HDF5_GLOBAL_LOCK();
+
         herr_t status = H5Sselect_hyperslab(poGDS->dataspace_id, H5S_SELECT_SET,
                                             offset, nullptr, count, nullptr);
         if (status < 0)
@@ -777,6 +800,37 @@ CPLErr HDF5ImageRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                                         nPixelSpace, nLineSpace, psExtraArg);
 }
 
+/************************************************************************/
+/*                             ReadDirect()                             */
+/************************************************************************/
+
+/** Read the hyperslab (offset, count) into pBuffer, whose dimensions are
+ * anBufferDims, with m_poDirectChunkReader. Must be called without the global
+ * HDF5 lock held.
+ *
+ * @return false if the direct chunk reader is not available or failed, in
+ * which case H5Dread() should be used.
+ */
+bool HDF5ImageDataset::ReadDirect(int nRank, const H5OFFSET_TYPE *offset,
+                                  const hsize_t *count,
+                                  const hsize_t *anBufferDims, void *pBuffer)
+{
+    if (!m_poDirectChunkReader || nRank > 3)
+        return false;
+
+    size_t anCount[3] = {0, 0, 0};
+    GPtrDiff_t anBufferStride[3] = {0, 0, 0};
+    GPtrDiff_t nStride = 1;
+    for (int i = nRank - 1; i >= 0; --i)
+    {
+        anCount[i] = static_cast<size_t>(count[i]);
+        anBufferStride[i] = nStride;
+        nStride *= static_cast<GPtrDiff_t>(anBufferDims[i]);
+    }
+    return m_poDirectChunkReader->Read(offset, anCount, anBufferStride,
+                                       pBuffer);
+}
+
 /************************************************************************/
 /*                             IRasterIO()                              */
 /************************************************************************/
@@ -819,8 +873,6 @@ CPLErr HDF5ImageDataset::IRasterIO(
         eBufType == eDT && nPixelSpace == nDTSize &&
         nLineSpace == nXSize * nPixelSpace && nBandSpace == nYSize * nLineSpace)
     {
-        HDF5_GLOBAL_LOCK();
-
         hsize_t count[3] = {static_cast<hsize_t>(nBandCount),
                             static_cast<hsize_t>(nYSize),
                             static_cast<hsize_t>(nXSize)};
@@ -828,6 +880,12 @@ CPLErr HDF5ImageDataset::IRasterIO(
             static_cast<H5OFFSET_TYPE>(panBandMap[0] - 1),
             static_cast<H5OFFSET_TYPE>(nYOff),
             static_cast<H5OFFSET_TYPE>(nXOff)};
+
+        if (ReadDirect(ndims, offset, count, count, pData))
+            return CE_None;
+
+        HDF5_GLOBAL_LOCK();
+
         herr_t status = H5Sselect_hyperslab(dataspace_id, H5S_SELECT_SET,
                                             offset, nullptr, count, nullptr);
         if (status < 0)
@@ -868,8 +926,6 @@ CPLErr HDF5ImageDataset::IRasterIO(
         nPixelSpace == nBandCount * nBandSpace &&
         nLineSpace == nXSize * nPixelSpace)
     {
-        HDF5_GLOBAL_LOCK();
-
         hsize_t count[3] = {static_cast<hsize_t>(nYSize),
                             static_cast<hsize_t>(nXSize),
                             static_cast<hsize_t>(nBandCount)};
@@ -877,6 +933,12 @@ CPLErr HDF5ImageDataset::IRasterIO(
             static_cast<H5OFFSET_TYPE>(nYOff),
             static_cast<H5OFFSET_TYPE>(nXOff),
             static_cast<H5OFFSET_TYPE>(panBandMap[0] - 1)};
+
+        if (ReadDirect(ndims, offset, count, count, pData))
+            return CE_None;
+
+        HDF5_GLOBAL_LOCK();
+
         herr_t status = H5Sselect_hyperslab(dataspace_id, H5S_SELECT_SET,
                                             offset, nullptr, count, nullptr);
         if (status < 0)
@@ -1274,6 +1336,17 @@ GDALDataset *HDF5ImageDataset::Open(GDALOpenInfo *poOpenInfo)
     {
         if (H5Pget_layout(listid) == H5D_CHUNKED)
         {
+            // Float16 values need to be converted after H5Dread()
+            bool bCanUseDirectChunkReader = true;
+#ifdef HDF5_HAVE_FLOAT16
+            bCanUseDirectChunkReader = !poDS->m_bConvertFromFloat16;
+#endif
+            if (bCanUseDirectChunkReader)
+            {
+                poDS->m_poDirectChunkReader = HDF5DirectChunkReader::Create(
+                    poDS->dataset_id, poDS->native);
+            }
+
             hsize_t panChunkDims[3] = {0, 0, 0};
             const int nDimSize = H5Pget_chunk(listid, 3, panChunkDims);
             CPL_IGNORE_RET_VAL(nDimSize);
@@ -10,6 +10,7 @@
  ****************************************************************************/
 
 #include "hdf5dataset.h"
+#include "hdf5directchunkreader.h"
 #include "hdf5eosparser.h"
 #include "s100.h"
 
@@ -289,6 +290,8 @@ class HDF5Array final : public GDALMDArray
     std::shared_ptr<OGRSpatialReference> m_poSRS{};
     haddr_t m_nOffset;
     mutable CPLStringList m_aosStructuralInfo{};
+    //! Reader decoding chunks outside of libhdf5, when possible
+    std::unique_ptr<HDF5DirectChunkReader> m_poDirectChunkReader{};
 
     HDF5Array(const std::string &osParentName, const std::string &osName,
               const std::shared_ptr<HDF5SharedResources> &poShared,
@@ -303,6 +306,11 @@ class HDF5Array final : public GDALMDArray
                   const GDALExtendedDataType &bufferDataType,
                   void *pDstBuffer) const;
 
+    bool ReadDirect(const GUInt64 *arrayStartIdx, const size_t *count,
+                    const GInt64 *arrayStep, const GPtrDiff_t *bufferStride,
+                    const GDALExtendedDataType &bufferDataType,
+                    void *pDstBuffer) const;
+
     static herr_t GetAttributesCallback(hid_t hArray, const char *pszObjName,
                                         void *);
 
@@ -1094,6 +1102,12 @@ HDF5Array::HDF5Array(const std::string &osParentName, const std::string &osName,
         return;
     }
 
+    if (m_dt.GetClass() == GEDTC_NUMERIC && !m_bHasNonNativeDataType)
+    {
+        m_poDirectChunkReader =
+            HDF5DirectChunkReader::Create(hArray, m_hNativeDT);
+    }
+
     HDF5Array::GetAttributes();
 
     // Special case for S102 nodata value that is typically at 1e6
@@ -2638,6 +2652,97 @@ lbl_next_depth:
         goto lbl_return_to_caller_in_loop;
 }
 
+/************************************************************************/
+/*                             ReadDirect()                             */
+/************************************************************************/
+
+/** Read with m_poDirectChunkReader, which decodes chunks outside of libhdf5.
+ * Must be called without the global HDF5 lock held.
+ *
+ * @return false if the request cannot be handled, or in case of failure, in
+ * which case H5Dread() should be used.
+ */
+bool HDF5Array::ReadDirect(const GUInt64 *arrayStartIdx, const size_t *count,
+                           const GInt64 *arrayStep,
+                           const GPtrDiff_t *bufferStride,
+                           const GDALExtendedDataType &bufferDataType,
+                           void *pDstBuffer) const
+{
+    if (bufferDataType.GetClass() != GEDTC_NUMERIC)
+        return false;
+
+    const size_t nDims(m_dims.size());
+    std::vector<hsize_t> anStart(nDims);
+    size_t nEltCount = 1;
+    for (size_t i = 0; i < nDims; ++i)
+    {
+        if (count[i] != 1 && (arrayStep[i] != 1 || bufferStride[i] < 0))
+            return false;
+        anStart[i] = static_cast<hsize_t>(arrayStartIdx[i]);
+        nEltCount *= count[i];
+    }
+
+    if (bufferDataType == m_dt)
+    {
+        return m_poDirectChunkReader->Read(anStart.data(), count, bufferStride,
+                                           pDstBuffer);
+    }
+
+    // Read into a temporary buffer with the data type of the array, and
+    // convert it into the requested one.
+    std::vector<GByte> abyTemp;
+    try
+    {
+        abyTemp.resize(nEltCount * m_dt.GetSize());
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+    std::vector<GPtrDiff_t> anTempStride(nDims);
+    GPtrDiff_t nStride = 1;
+    for (size_t i = nDims; i > 0;)
+    {
+        --i;
+        anTempStride[i] = nStride;
+        nStride *= static_cast<GPtrDiff_t>(count[i]);
+    }
+    if (!m_poDirectChunkReader->Read(anStart.data(), count, anTempStride.data(),
+                                     abyTemp.data()))
+    {
+        return false;
+    }
+
+    const size_t nSrcDTSize = m_dt.GetSize();
+    const size_t nDstDTSize = bufferDataType.GetSize();
+    const size_t iLastDim = nDims - 1;
+    const GByte *pabySrc = abyTemp.data();
+    std::vector<size_t> anIdx(nDims);
+    while (true)
+    {
+        GPtrDiff_t nDstOffset = 0;
+        for (size_t i = 0; i < iLastDim; ++i)
+            nDstOffset += static_cast<GPtrDiff_t>(anIdx[i]) * bufferStride[i];
+        GDALExtendedDataType::CopyValues(
+            pabySrc, m_dt, 1,
+            static_cast<GByte *>(pDstBuffer) +
+                nDstOffset * static_cast<GPtrDiff_t>(nDstDTSize),
+            bufferDataType, bufferStride[iLastDim], count[iLastDim]);
+        pabySrc += count[iLastDim] * nSrcDTSize;
+
+        size_t iDim = iLastDim;
+        while (true)
+        {
+            if (iDim == 0)
+                return true;
+            --iDim;
+            if (++anIdx[iDim] < count[iDim])
+                break;
+            anIdx[iDim] = 0;
+        }
+    }
+}
+
 /************************************************************************/
 /*                               IRead()                                */
 /************************************************************************/
@@ -2647,6 +2752,13 @@ bool HDF5Array::IRead(const GUInt64 *arrayStartIdx, const size_t *count,
                       const GDALExtendedDataType &bufferDataType,
                       void *pDstBuffer) const
 {
+    if (m_poDirectChunkReader &&
+        ReadDirect(arrayStartIdx, count, arrayStep, bufferStride,
+                   bufferDataType, pDstBuffer))
+    {
+        return true;
+    }
+
     HDF5_GLOBAL_LOCK();
 
     const size_t nDims(m_dims.size());
@@ -943,8 +943,16 @@ class CPL_DLL VRTSourcedRasterBand CPL_NON_FINAL : public VRTRasterBand
     CPLStringList m_aosSourceList{};
     int m_nSkipBufferInitialization = -1;
 
+    struct SourceIndex;
+
+    //! Spatial index over the destination windows of sources, lazily built.
+    mutable std::unique_ptr<SourceIndex> m_poSourceIndex{};
+    mutable std::mutex m_oSourceIndexMutex{};
+
     bool CanUseSourcesMinMaxImplementations();
 
+    const SourceIndex *GetSourceIndex() const;
+
     bool IsMosaicOfNonOverlappingSimpleSourcesOfFullRasterNoResAndTypeChange(
         bool bAllowMaxValAdjustment) const;
 
@@ -1057,6 +1065,8 @@ class CPL_DLL VRTSourcedRasterBand CPL_NON_FINAL : public VRTRasterBand
 
     void RemoveCoveredSources(CSLConstList papszOptions = nullptr);
 
+    void InvalidateSourceIndex();
+
     bool CanIRasterIOBeForwardedToEachSource(
         GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize, int nYSize,
         int nBufXSize, int nBufYSize, GDALRasterIOExtraArg *psExtraArg) const;
@@ -1065,6 +1075,9 @@ class CPL_DLL VRTSourcedRasterBand CPL_NON_FINAL : public VRTRasterBand
                                 double dfYSize,
                                 int &nContributingSources) const;
 
+    std::vector<int> GetCandidateSources(double dfXOff, double dfYOff,
+                                         double dfXSize, double dfYSize) const;
+
     CPLErr IReadBlock(int, int, void *) override;
 
     virtual void GetFileList(char ***ppapszFileList, int *pnSize,
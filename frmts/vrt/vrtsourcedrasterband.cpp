@@ -26,6 +26,8 @@
 #include <mutex>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -49,6 +51,37 @@
 /* ==================================================================== */
 /************************************************************************/
 
+/************************************************************************/
+/*                 VRTSourcedRasterBand::SourceIndex                    */
+/************************************************************************/
+
+/** Spatial index over the destination windows of the sources of a band. */
+struct VRTSourcedRasterBand::SourceIndex
+{
+    // Content of m_papoSources when the index was built, to detect
+    // modifications done directly on that public member.
+    const std::unique_ptr<VRTSource> *pSources = nullptr;
+    size_t nSources = 0;
+
+    // Indices of simple sources with a finite and non-negative destination
+    // window.
+    CPLQuadTree *hQuadTree = nullptr;
+
+    // Indices of sources not in hQuadTree, that must be considered by
+    // any request.
+    std::vector<int> anUnindexedSources{};
+
+    SourceIndex() = default;
+
+    ~SourceIndex()
+    {
+        if (hQuadTree)
+            CPLQuadTreeDestroy(hQuadTree);
+    }
+
+    CPL_DISALLOW_COPY_ASSIGN(SourceIndex)
+};
+
 /************************************************************************/
 /*                        VRTSourcedRasterBand()                        */
 /************************************************************************/
@@ -116,6 +149,145 @@ VRTSourcedRasterBand::~VRTSourcedRasterBand()
     VRTSourcedRasterBand::CloseDependentDatasets();
 }
 
+/************************************************************************/
+/*                        InvalidateSourceIndex()                       */
+/************************************************************************/
+
+/** Must be called when the sources or their destination window are modified
+ * in place. Adding or removing sources through m_papoSources is detected.
+ */
+void VRTSourcedRasterBand::InvalidateSourceIndex()
+{
+    std::lock_guard oLock(m_oSourceIndexMutex);
+    m_poSourceIndex.reset();
+}
+
+/************************************************************************/
+/*                           GetSourceIndex()                           */
+/************************************************************************/
+
+const VRTSourcedRasterBand::SourceIndex *
+VRTSourcedRasterBand::GetSourceIndex() const
+{
+    std::lock_guard oLock(m_oSourceIndexMutex);
+    if (m_poSourceIndex && m_poSourceIndex->pSources == m_papoSources.data() &&
+        m_poSourceIndex->nSources == m_papoSources.size())
+    {
+        return m_poSourceIndex.get();
+    }
+
+    auto poIndex = std::make_unique<SourceIndex>();
+    poIndex->pSources = m_papoSources.data();
+    poIndex->nSources = m_papoSources.size();
+
+    std::vector<std::pair<int, CPLRectObj>> aoIndexed;
+    CPLRectObj sGlobalBounds;
+    sGlobalBounds.minx = std::numeric_limits<double>::infinity();
+    sGlobalBounds.miny = std::numeric_limits<double>::infinity();
+    sGlobalBounds.maxx = -std::numeric_limits<double>::infinity();
+    sGlobalBounds.maxy = -std::numeric_limits<double>::infinity();
+    for (int iSource = 0; iSource < static_cast<int>(m_papoSources.size());
+         iSource++)
+    {
+        const auto &poSource = m_papoSources[iSource];
+        const auto poSimpleSource =
+            poSource->IsSimpleSource()
+                ? cpl::down_cast<VRTSimpleSource *>(poSource.get())
+                : nullptr;
+        double dfDstXOff = 0;
+        double dfDstYOff = 0;
+        double dfDstXSize = 0;
+        double dfDstYSize = 0;
+        if (poSimpleSource && poSimpleSource->IsDstWinSet())
+        {
+            poSimpleSource->GetDstWindow(dfDstXOff, dfDstYOff, dfDstXSize,
+                                         dfDstYSize);
+        }
+        if (!poSimpleSource || !poSimpleSource->IsDstWinSet() ||
+            !std::isfinite(dfDstXOff) || !std::isfinite(dfDstYOff) ||
+            !std::isfinite(dfDstXSize) || !std::isfinite(dfDstYSize) ||
+            dfDstXSize < 0 || dfDstYSize < 0)
+        {
+            poIndex->anUnindexedSources.push_back(iSource);
+            continue;
+        }
+
+        CPLRectObj sBounds;
+        sBounds.minx = dfDstXOff;
+        sBounds.miny = dfDstYOff;
+        sBounds.maxx = dfDstXOff + dfDstXSize;
+        sBounds.maxy = dfDstYOff + dfDstYSize;
+        sGlobalBounds.minx = std::min(sGlobalBounds.minx, sBounds.minx);
+        sGlobalBounds.miny = std::min(sGlobalBounds.miny, sBounds.miny);
+        sGlobalBounds.maxx = std::max(sGlobalBounds.maxx, sBounds.maxx);
+        sGlobalBounds.maxy = std::max(sGlobalBounds.maxy, sBounds.maxy);
+        aoIndexed.emplace_back(iSource, sBounds);
+    }
+
+    if (!aoIndexed.empty())
+    {
+        poIndex->hQuadTree = CPLQuadTreeCreate(&sGlobalBounds, nullptr);
+        for (const auto &oIndexed : aoIndexed)
+        {
+            CPLQuadTreeInsertWithBounds(
+                poIndex->hQuadTree,
+                reinterpret_cast<void *>(
+                    static_cast<uintptr_t>(oIndexed.first)),
+                &oIndexed.second);
+        }
+    }
+
+    m_poSourceIndex = std::move(poIndex);
+    return m_poSourceIndex.get();
+}
+
+/************************************************************************/
+/*                        GetCandidateSources()                         */
+/************************************************************************/
+
+/** Returns, in increasing order, the indices of the sources that may
+ * contribute to the specified window of the band.
+ *
+ * This is a superset of the sources whose destination window intersects
+ * the requested one: non-simple sources, or simple sources without a
+ * destination window, are always returned.
+ */
+std::vector<int> VRTSourcedRasterBand::GetCandidateSources(double dfXOff,
+                                                           double dfYOff,
+                                                           double dfXSize,
+                                                           double dfYSize) const
+{
+    std::vector<int> anSources;
+    if (m_papoSources.size() <= 1)
+    {
+        if (!m_papoSources.empty())
+            anSources.push_back(0);
+        return anSources;
+    }
+
+    const SourceIndex *poIndex = GetSourceIndex();
+    anSources = poIndex->anUnindexedSources;
+    if (poIndex->hQuadTree)
+    {
+        CPLRectObj sAoi;
+        sAoi.minx = dfXOff;
+        sAoi.miny = dfYOff;
+        sAoi.maxx = dfXOff + dfXSize;
+        sAoi.maxy = dfYOff + dfYSize;
+        int nFeatureCount = 0;
+        void **pahFeatures =
+            CPLQuadTreeSearch(poIndex->hQuadTree, &sAoi, &nFeatureCount);
+        for (int i = 0; i < nFeatureCount; ++i)
+        {
+            anSources.push_back(
+                static_cast<int>(reinterpret_cast<uintptr_t>(pahFeatures[i])));
+        }
+        CPLFree(pahFeatures);
+        std::sort(anSources.begin(), anSources.end());
+    }
+    return anSources;
+}
+
 /************************************************************************/
 /*                  CanIRasterIOBeForwardedToEachSource()               */
 /************************************************************************/
@@ -272,99 +444,102 @@ bool VRTSourcedRasterBand::CanMultiThreadRasterIO(
     double dfXOff, double dfYOff, double dfXSize, double dfYSize,
     int &nContributingSources) const
 {
-    int iLastSource = 0;
-    CPLRectObj sSourceBounds;
-    CPLQuadTree *hQuadTree = nullptr;
-    bool bRet = true;
     std::set<std::string> oSetDSName;
+    std::vector<int> anContributingSources;
 
     nContributingSources = 0;
-    for (int iSource = 0; iSource < static_cast<int>(m_papoSources.size());
-         iSource++)
+    // Non-simple sources are never filtered out by GetCandidateSources()
+    for (const int iSource :
+         GetCandidateSources(dfXOff, dfYOff, dfXSize, dfYSize))
     {
         const auto &poSource = m_papoSources[iSource];
         if (!poSource->IsSimpleSource())
         {
-            bRet = false;
-            break;
+            return false;
         }
         const auto poSimpleSource =
             cpl::down_cast<VRTSimpleSource *>(poSource.get());
         if (poSimpleSource->DstWindowIntersects(dfXOff, dfYOff, dfXSize,
                                                 dfYSize))
         {
-            // Only build hQuadTree if there are 2 or more sources
-            if (nContributingSources == 1)
-            {
-                std::string &oFirstSrcDSName =
-                    cpl::down_cast<VRTSimpleSource *>(
-                        m_papoSources[iLastSource].get())
-                        ->m_osSrcDSName;
-                oSetDSName.insert(oFirstSrcDSName);
-
-                CPLRectObj sGlobalBounds;
-                sGlobalBounds.minx = dfXOff;
-                sGlobalBounds.miny = dfYOff;
-                sGlobalBounds.maxx = dfXOff + dfXSize;
-                sGlobalBounds.maxy = dfYOff + dfYSize;
-                hQuadTree = CPLQuadTreeCreate(&sGlobalBounds, nullptr);
-
-                CPLQuadTreeInsertWithBounds(
-                    hQuadTree,
-                    reinterpret_cast<void *>(
-                        static_cast<uintptr_t>(iLastSource)),
-                    &sSourceBounds);
-            }
-
             // Check there are not several sources with the same name, to avoid
             // the same GDALDataset* to be used from multiple threads. We may
             // be a bit too pessimistic, for example if working with unnamed
             // Memory datasets, but that would involve comparing
             // poSource->GetRasterBandNoOpen()->GetDataset()
-            if (oSetDSName.find(poSimpleSource->m_osSrcDSName) !=
-                oSetDSName.end())
+            if (!oSetDSName.insert(poSimpleSource->m_osSrcDSName).second)
             {
-                bRet = false;
-                break;
+                return false;
             }
-            oSetDSName.insert(poSimpleSource->m_osSrcDSName);
-
-            double dfSourceXOff;
-            double dfSourceYOff;
-            double dfSourceXSize;
-            double dfSourceYSize;
-            poSimpleSource->GetDstWindow(dfSourceXOff, dfSourceYOff,
-                                         dfSourceXSize, dfSourceYSize);
-            constexpr double EPSILON = 1e-1;
-            sSourceBounds.minx = dfSourceXOff + EPSILON;
-            sSourceBounds.miny = dfSourceYOff + EPSILON;
-            sSourceBounds.maxx = dfSourceXOff + dfSourceXSize - EPSILON;
-            sSourceBounds.maxy = dfSourceYOff + dfSourceYSize - EPSILON;
-            iLastSource = iSource;
-
-            if (hQuadTree)
-            {
-                // Check that the new source doesn't overlap an existing one.
-                if (CPLQuadTreeHasMatch(hQuadTree, &sSourceBounds))
-                {
-                    bRet = false;
-                    break;
-                }
+            anContributingSources.push_back(iSource);
+        }
+    }
 
-                CPLQuadTreeInsertWithBounds(
-                    hQuadTree,
-                    reinterpret_cast<void *>(static_cast<uintptr_t>(iSource)),
-                    &sSourceBounds);
-            }
+    nContributingSources = static_cast<int>(anContributingSources.size());
+    if (nContributingSources <= 1)
+        return true;
 
-            ++nContributingSources;
+    // Check that contributing sources do not overlap each other, using
+    // the spatial index of sources to only compare nearby ones.
+    const SourceIndex *poIndex = GetSourceIndex();
+    const auto GetBounds = [this](int iSource, double dfEpsilon)
+    {
+        double dfSourceXOff;
+        double dfSourceYOff;
+        double dfSourceXSize;
+        double dfSourceYSize;
+        cpl::down_cast<VRTSimpleSource *>(m_papoSources[iSource].get())
+            ->GetDstWindow(dfSourceXOff, dfSourceYOff, dfSourceXSize,
+                           dfSourceYSize);
+        CPLRectObj sBounds;
+        sBounds.minx = dfSourceXOff + dfEpsilon;
+        sBounds.miny = dfSourceYOff + dfEpsilon;
+        sBounds.maxx = dfSourceXOff + dfSourceXSize - dfEpsilon;
+        sBounds.maxy = dfSourceYOff + dfSourceYSize - dfEpsilon;
+        return sBounds;
+    };
+    constexpr double EPSILON = 1e-1;
+
+    for (const int iSource : anContributingSources)
+    {
+        // Contributing sources not in the index are unusual enough (e.g
+        // negative or infinite destination window) to not bother.
+        if (!poIndex->hQuadTree ||
+            std::binary_search(poIndex->anUnindexedSources.begin(),
+                               poIndex->anUnindexedSources.end(), iSource))
+        {
+            return false;
         }
-    }
 
-    if (hQuadTree)
-        CPLQuadTreeDestroy(hQuadTree);
+        const CPLRectObj sSourceBounds = GetBounds(iSource, EPSILON);
+        const CPLRectObj sAoi = GetBounds(iSource, 0);
+        int nFeatureCount = 0;
+        void **pahFeatures =
+            CPLQuadTreeSearch(poIndex->hQuadTree, &sAoi, &nFeatureCount);
+        bool bOverlap = false;
+        for (int i = 0; !bOverlap && i < nFeatureCount; ++i)
+        {
+            const int iOtherSource =
+                static_cast<int>(reinterpret_cast<uintptr_t>(pahFeatures[i]));
+            if (iOtherSource != iSource &&
+                std::binary_search(anContributingSources.begin(),
+                                   anContributingSources.end(),
+                                   iOtherSource))
+            {
+                const CPLRectObj sOtherBounds =
+                    GetBounds(iOtherSource, EPSILON);
+                bOverlap = !(sSourceBounds.minx > sOtherBounds.maxx ||
+                             sSourceBounds.maxx < sOtherBounds.minx ||
+                             sSourceBounds.miny > sOtherBounds.maxy ||
+                             sSourceBounds.maxy < sOtherBounds.miny);
+            }
+        }
+        CPLFree(pahFeatures);
+        if (bOverlap)
+            return false;
+    }
 
-    return bRet;
+    return true;
 }
 
 /************************************************************************/
@@ -673,8 +848,10 @@ CPLErr VRTSourcedRasterBand::IRasterIO(
 
         auto oQueue = psThreadPool->CreateJobQueue();
         std::atomic<int> nCompletedJobs = 0;
-        for (auto &poSource : m_papoSources)
+        for (const int iSource :
+             GetCandidateSources(dfXOff, dfYOff, dfXSize, dfYSize))
         {
+            auto &poSource = m_papoSources[iSource];
             if (!poSource->IsSimpleSource())
                 continue;
             auto poSimpleSource =
@@ -732,17 +909,20 @@ CPLErr VRTSourcedRasterBand::IRasterIO(
         void *const pProgressDataGlobal = psExtraArg->pProgressData;
 
         VRTSource::WorkingState oWorkingState;
-        const int nSources = static_cast<int>(m_papoSources.size());
-        for (int iSource = 0; eErr == CE_None && iSource < nSources; iSource++)
+        // Sources not intersecting the request would be no-op
+        const auto anSources =
+            GetCandidateSources(dfXOff, dfYOff, dfXSize, dfYSize);
+        const int nSources = static_cast<int>(anSources.size());
+        for (int i = 0; eErr == CE_None && i < nSources; i++)
         {
             psExtraArg->pfnProgress = GDALScaledProgress;
             psExtraArg->pProgressData = GDALCreateScaledProgress(
-                1.0 * iSource / nSources, 1.0 * (iSource + 1) / nSources,
+                1.0 * i / nSources, 1.0 * (i + 1) / nSources,
                 pfnProgressGlobal, pProgressDataGlobal);
             if (psExtraArg->pProgressData == nullptr)
                 psExtraArg->pfnProgress = nullptr;
 
-            eErr = m_papoSources[iSource]->RasterIO(
+            eErr = m_papoSources[anSources[i]]->RasterIO(
                 eDataType, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize,
                 nBufYSize, eBufType, nPixelSpace, nLineSpace, psExtraArg,
                 l_poDS ? l_poDS->m_oWorkingState : oWorkingState);
@@ -836,8 +1016,10 @@ int VRTSourcedRasterBand::IGetDataCoverageStatus(int nXOff, int nYOff,
         poPolyNonCoveredBySources->addRingDirectly(poLR.release());
     }
 
-    for (auto &poSource : m_papoSources)
+    for (const int iSource :
+         GetCandidateSources(nXOff, nYOff, nXSize, nYSize))
     {
+        const auto &poSource = m_papoSources[iSource];
         if (!poSource->IsSimpleSource())
         {
             return GDAL_DATA_COVERAGE_STATUS_UNIMPLEMENTED |
@@ -2229,6 +2411,7 @@ CPLErr VRTSourcedRasterBand::AddSource(std::unique_ptr<VRTSource> poNewSource)
     }
 
     m_papoSources.push_back(std::move(poNewSource));
+    InvalidateSourceIndex();
 
     return CE_None;
 }
@@ -3053,6 +3236,7 @@ CPLErr VRTSourcedRasterBand::SetMetadata(char **papszNewMD,
         if (EQUAL(pszDomain, "vrt_sources"))
         {
             m_papoSources.clear();
+            InvalidateSourceIndex();
         }
 
         for (const char *const pszMDItem :
@@ -3112,6 +3296,7 @@ int VRTSourcedRasterBand::CloseDependentDatasets()
         return ret;
 
     m_papoSources.clear();
+    InvalidateSourceIndex();
 
     return TRUE;
 }
@@ -3303,6 +3488,7 @@ void VRTSourcedRasterBand::RemoveCoveredSources(CSLConstList papszOptions)
                                        [](const std::unique_ptr<VRTSource> &src)
                                        { return src.get() == nullptr; }),
                         m_papoSources.end());
+    InvalidateSourceIndex();
 
     CPLQuadTreeDestroy(hTree);
 #endif
@@ -14,12 +14,17 @@
 #define ZARR_H
 
 #include "cpl_compressor.h"
+#include "cpl_error_internal.h"
 #include "cpl_json.h"
+#include "cpl_mem_cache.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal_priv.h"
 #include "gdal_pam.h"
 #include "memmultidim.h"
 
 #include <array>
+#include <functional>
+#include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -246,6 +251,8 @@ class ZarrSharedResource
     CPLStringList m_aosOpenOptions{};
     std::weak_ptr<ZarrGroupBase> m_poWeakRootGroup{};
     std::set<std::string> m_oSetArrayInLoading{};
+    // Shared by the arrays writing tiles asynchronously
+    std::unique_ptr<CPLWorkerThreadPool> m_poTileWriterPool{};
 
     explicit ZarrSharedResource(const std::string &osRootDirectoryName,
                                 bool bUpdatable);
@@ -312,6 +319,8 @@ class ZarrSharedResource
     bool AddArrayInLoading(const std::string &osZarrayFilename);
     void RemoveArrayInLoading(const std::string &osZarrayFilename);
 
+    CPLWorkerThreadPool *GetTileWriterPool(int nThreads);
+
     struct SetFilenameAdder
     {
         std::shared_ptr<ZarrSharedResource> m_poSharedResource;
@@ -806,6 +815,17 @@ class ZarrArray CPL_NON_FINAL : public GDALPamMDArray
 
     mutable std::map<uint64_t, CachedTile> m_oMapTileIndexToCachedTile{};
 
+    // Write-behind of dirty tiles, when GDAL_NUM_THREADS > 1
+    mutable bool m_bTileWriterInitDone = false;
+    mutable std::unique_ptr<CPLJobQueue> m_poTileWriterQueue{};
+    mutable int m_nTileWriterMaxPendingJobs = 0;
+    mutable std::mutex m_oTileWriterMutex{};
+    // Members below protected by m_oTileWriterMutex
+    mutable std::set<std::vector<uint64_t>> m_oSetTilesBeingWritten{};
+    mutable bool m_bTileWriterError = false;
+    mutable std::unique_ptr<CPLErrorAccumulator>
+        m_poTileWriterErrorAccumulator{};
+
     static uint64_t
     ComputeTileCount(const std::string &osName,
                      const std::vector<std::shared_ptr<GDALDimension>> &aoDims,
@@ -837,6 +857,15 @@ class ZarrArray CPL_NON_FINAL : public GDALPamMDArray
 
     virtual bool FlushDirtyTile() const = 0;
 
+    bool IsTileWriterAsync() const;
+
+    bool SubmitTileWrite(std::function<bool()> &&fnWrite) const;
+
+    bool
+    WaitTileWriteIfPending(const std::vector<uint64_t> &anTileIndices) const;
+
+    bool WaitTileWrites() const;
+
     std::shared_ptr<GDALMDArray> OpenTilePresenceCache(bool bCanCreate) const;
 
     void NotifyChildrenOfRenaming() override;
@@ -1107,6 +1136,23 @@ class ZarrV2Array final : public ZarrArray
                            ZarrByteVectorQuickResize &abyTmpRawTileData,
                            ZarrByteVectorQuickResize &abyDecodedTileData) const;
 
+    // Filter or compressor, with its options, applied when writing a tile
+    struct TileEncoder
+    {
+        std::string osId{};
+        const CPLCompressor *psCompressor = nullptr;
+        CPLStringList aosOptions{};
+    };
+
+    bool GetTileEncoders(std::vector<TileEncoder> &aoFilters,
+                         TileEncoder &oCompressor) const;
+
+    bool WriteTileData(const std::string &osFilename,
+                       ZarrByteVectorQuickResize &abyRawTileData,
+                       ZarrByteVectorQuickResize &abyTmpRawTileData,
+                       const std::vector<TileEncoder> &aoFilters,
+                       const TileEncoder &oCompressor) const;
+
     // Disable copy constructor and assignment operator
     ZarrV2Array(const ZarrV2Array &) = delete;
     ZarrV2Array &operator=(const ZarrV2Array &) = delete;
@@ -1164,6 +1210,8 @@ struct ZarrArrayMetadata
 {
     DtypeElt oElt{};
     std::vector<size_t> anBlockSizes{};
+    // Fill value in the native representation of oElt. Empty means zero.
+    std::vector<GByte> abyFillValue{};
 
     size_t GetEltCount() const
     {
@@ -1434,6 +1482,41 @@ class ZarrV3CodecTranspose final : public ZarrV3Codec
                 ZarrByteVectorQuickResize &abyDst) const override;
 };
 
+/************************************************************************/
+/*                          ZarrV3CodecCRC32C                           */
+/************************************************************************/
+
+// Implements https://zarr-specs.readthedocs.io/en/latest/v3/codecs/crc32c/v1.0.html
+class ZarrV3CodecCRC32C final : public ZarrV3Codec
+{
+  public:
+    static constexpr const char *NAME = "crc32c";
+
+    ZarrV3CodecCRC32C();
+
+    IOType GetInputType() const override
+    {
+        return IOType::BYTES;
+    }
+
+    IOType GetOutputType() const override
+    {
+        return IOType::BYTES;
+    }
+
+    bool
+    InitFromConfiguration(const CPLJSONObject &configuration,
+                          const ZarrArrayMetadata &oInputArrayMetadata,
+                          ZarrArrayMetadata &oOutputArrayMetadata) override;
+
+    std::unique_ptr<ZarrV3Codec> Clone() const override;
+
+    bool Encode(const ZarrByteVectorQuickResize &abySrc,
+                ZarrByteVectorQuickResize &abyDst) const override;
+    bool Decode(const ZarrByteVectorQuickResize &abySrc,
+                ZarrByteVectorQuickResize &abyDst) const override;
+};
+
 /************************************************************************/
 /*                          ZarrV3CodecSequence                         */
 /************************************************************************/
@@ -1463,10 +1546,100 @@ class ZarrV3CodecSequence
         return m_oCodecArray;
     }
 
+    const std::vector<std::unique_ptr<ZarrV3Codec>> &GetCodecs() const
+    {
+        return m_apoCodecs;
+    }
+
     bool Encode(ZarrByteVectorQuickResize &abyBuffer);
     bool Decode(ZarrByteVectorQuickResize &abyBuffer);
 };
 
+/************************************************************************/
+/*                      ZarrV3CodecShardingIndexed                      */
+/************************************************************************/
+
+// Implements https://zarr-specs.readthedocs.io/en/latest/v3/codecs/sharding-indexed/v1.0.html
+class ZarrV3CodecShardingIndexed final : public ZarrV3Codec
+{
+    // Shape of the inner chunks
+    std::vector<size_t> m_anInnerBlockSize{};
+    // Number of inner chunks along each dimension of a shard
+    std::vector<size_t> m_anChunksPerShard{};
+    size_t m_nChunkCount = 0;
+    std::unique_ptr<ZarrV3CodecSequence> m_poCodecs{};
+    std::unique_ptr<ZarrV3CodecSequence> m_poIndexCodecs{};
+    bool m_bIndexAtEnd = true;
+    size_t m_nIndexEncodedSize = 0;
+
+    void CopyInnerChunk(size_t iChunk, const GByte *pabySrc, GByte *pabyDst,
+                        bool bChunkToShard) const;
+
+  public:
+    static constexpr const char *NAME = "sharding_indexed";
+
+    // Value of the offset and nbytes fields of the index of a missing chunk
+    static constexpr uint64_t MISSING_CHUNK =
+        std::numeric_limits<uint64_t>::max();
+
+    ZarrV3CodecShardingIndexed();
+
+    IOType GetInputType() const override
+    {
+        return IOType::ARRAY;
+    }
+
+    IOType GetOutputType() const override
+    {
+        return IOType::BYTES;
+    }
+
+    static CPLJSONObject
+    GetConfiguration(const std::vector<GUInt64> &anInnerBlockSize,
+                     const CPLJSONArray &oCodecs);
+
+    bool
+    InitFromConfiguration(const CPLJSONObject &configuration,
+                          const ZarrArrayMetadata &oInputArrayMetadata,
+                          ZarrArrayMetadata &oOutputArrayMetadata) override;
+
+    std::unique_ptr<ZarrV3Codec> Clone() const override;
+
+    bool Encode(const ZarrByteVectorQuickResize &abySrc,
+                ZarrByteVectorQuickResize &abyDst) const override;
+    bool Decode(const ZarrByteVectorQuickResize &abySrc,
+                ZarrByteVectorQuickResize &abyDst) const override;
+
+    const std::vector<size_t> &GetInnerBlockSize() const
+    {
+        return m_anInnerBlockSize;
+    }
+
+    const std::vector<size_t> &GetChunksPerShard() const
+    {
+        return m_anChunksPerShard;
+    }
+
+    const ZarrV3CodecSequence *GetInnerCodecs() const
+    {
+        return m_poCodecs.get();
+    }
+
+    bool IsIndexAtEnd() const
+    {
+        return m_bIndexAtEnd;
+    }
+
+    size_t GetIndexEncodedSize() const
+    {
+        return m_nIndexEncodedSize;
+    }
+
+    // This method is not thread safe
+    bool DecodeIndex(const GByte *pabyEncodedIndex,
+                     std::vector<uint64_t> &anIndex) const;
+};
+
 /************************************************************************/
 /*                           ZarrV3Array                                */
 /************************************************************************/
@@ -1476,6 +1649,13 @@ class ZarrV3Array final : public ZarrArray
     bool m_bV2ChunkKeyEncoding = false;
     std::unique_ptr<ZarrV3CodecSequence> m_poCodecs{};
 
+    // Set in read-only mode when the blocks of the array are the inner chunks
+    // of a sharding_indexed codec. m_poCodecs are then the inner codecs.
+    std::unique_ptr<ZarrV3CodecShardingIndexed> m_poShardingCodec{};
+    // Decoded shard indices, indexed by shard filename
+    mutable lru11::Cache<std::string, std::shared_ptr<std::vector<uint64_t>>>
+        m_oShardIndexCache{256};
+
     ZarrV3Array(const std::shared_ptr<ZarrSharedResource> &poSharedResource,
                 const std::string &osParentName, const std::string &osName,
                 const std::vector<std::shared_ptr<GDALDimension>> &aoDims,
@@ -1497,6 +1677,29 @@ class ZarrV3Array final : public ZarrArray
                       ZarrByteVectorQuickResize &abyDecodedTileData,
                       bool &bMissingTileOut) const;
 
+    void DecodeSourceElts(const ZarrByteVectorQuickResize &abyRawTileData,
+                          ZarrByteVectorQuickResize &abyDecodedTileData) const;
+
+    size_t GetShardIndices(const uint64_t *tileIndices,
+                           std::vector<uint64_t> &anShardIndices) const;
+
+    std::shared_ptr<std::vector<uint64_t>>
+    GetShardIndex(const std::string &osFilename, VSILFILE *fp,
+                  bool bUseMutex) const;
+
+    bool LoadShardedTileData(const uint64_t *tileIndices, bool bUseMutex,
+                             ZarrV3CodecSequence *poCodecs,
+                             ZarrByteVectorQuickResize &abyRawTileData,
+                             ZarrByteVectorQuickResize &abyDecodedTileData,
+                             bool &bMissingTileOut) const;
+
+    bool AdviseReadSharded(const std::vector<uint64_t> &anReqTilesIndices,
+                           size_t nReqTiles, int nThreadsMax) const;
+
+    bool WriteTileData(const std::string &osFilename,
+                       ZarrByteVectorQuickResize &abyRawTileData,
+                       ZarrV3CodecSequence *poCodecs) const;
+
   public:
     ~ZarrV3Array() override;
 
@@ -1518,6 +1721,12 @@ class ZarrV3Array final : public ZarrArray
         m_poCodecs = std::move(poCodecs);
     }
 
+    void SetShardingCodec(
+        std::unique_ptr<ZarrV3CodecShardingIndexed> &&poShardingCodec)
+    {
+        m_poShardingCodec = std::move(poShardingCodec);
+    }
+
     bool Flush() override;
 
   protected:
@@ -14,6 +14,7 @@
 #include "ucs4_utf8.hpp"
 
 #include "cpl_float.h"
+#include "gdal_thread_pool.h"
 
 #include "netcdf_cf_constants.h"  // for CF_UNITS, etc
 
@@ -862,6 +863,10 @@ bool ZarrArray::IAdviseReadCommon(const GUInt64 *arrayStartIdx,
     if (!CheckValidAndErrorOutIfNot())
         return false;
 
+    // Tiles are read back from storage
+    if (!WaitTileWrites())
+        return false;
+
     const size_t nDims = m_aoDims.size();
     anIndicesCur.resize(nDims);
     std::vector<uint64_t> anIndicesMin(nDims);
@@ -1160,7 +1165,7 @@ lbl_next_depth:
             }
             else
             {
-                if (!FlushDirtyTile())
+                if (!FlushDirtyTile() || !WaitTileWriteIfPending(tileIndices))
                     return false;
 
                 m_anCachedTiledIndices = tileIndices;
@@ -1660,7 +1665,9 @@ lbl_next_depth:
         }
         else
         {
-            if (!FlushDirtyTile())
+            // Also wait for a pending write of the new tile, so that it is
+            // not overwritten by an older version, or read before written.
+            if (!FlushDirtyTile() || !WaitTileWriteIfPending(tileIndices))
                 return false;
 
             m_anCachedTiledIndices = tileIndices;
@@ -1975,6 +1982,125 @@ lbl_next_depth:
     return true;
 }
 
+/************************************************************************/
+/*                   ZarrArray::IsTileWriterAsync()                     */
+/************************************************************************/
+
+/** Return whether dirty tiles are encoded and written by worker threads.
+ *
+ * This is the case when GDAL_NUM_THREADS is set to a value greater than 1.
+ * Jobs are queued to the tile writer thread pool of the shared resource.
+ */
+bool ZarrArray::IsTileWriterAsync() const
+{
+    if (!m_bTileWriterInitDone)
+    {
+        m_bTileWriterInitDone = true;
+        const int nThreads = GDALGetNumThreads();
+        if (nThreads > 1)
+        {
+            auto poPool = m_poSharedResource->GetTileWriterPool(nThreads);
+            if (poPool)
+            {
+                m_poTileWriterQueue = poPool->CreateJobQueue();
+                // Bound the number of tile copies waiting to be written
+                m_nTileWriterMaxPendingJobs = 2 * nThreads;
+                m_poTileWriterErrorAccumulator =
+                    std::make_unique<CPLErrorAccumulator>();
+            }
+        }
+    }
+    return m_poTileWriterQueue != nullptr;
+}
+
+/************************************************************************/
+/*                   ZarrArray::SubmitTileWrite()                       */
+/************************************************************************/
+
+/** Submit to the tile writer thread pool the encoding and writing of the
+ * tile at m_anCachedTiledIndices.
+ *
+ * fnWrite must only use data it owns, or members that are not modified
+ * while tiles are being written.
+ *
+ * This waits for previous tile writes to complete if too many of them are
+ * pending. Errors of previous tile writes are reported by this method or
+ * by WaitTileWrites().
+ */
+bool ZarrArray::SubmitTileWrite(std::function<bool()> &&fnWrite) const
+{
+    m_poTileWriterQueue->WaitCompletion(m_nTileWriterMaxPendingJobs - 1);
+    bool bError;
+    {
+        std::lock_guard oLock(m_oTileWriterMutex);
+        bError = m_bTileWriterError;
+        if (!bError)
+            m_oSetTilesBeingWritten.insert(m_anCachedTiledIndices);
+    }
+    if (bError)
+        return WaitTileWrites();
+
+    const auto anTileIndices = m_anCachedTiledIndices;
+    m_poTileWriterQueue->SubmitJob(
+        [this, anTileIndices, fnWrite = std::move(fnWrite)]()
+        {
+            bool bRet;
+            {
+                auto oAccumulator =
+                    m_poTileWriterErrorAccumulator->InstallForCurrentScope();
+                CPL_IGNORE_RET_VAL(oAccumulator);
+                bRet = fnWrite();
+            }
+            std::lock_guard oLock(m_oTileWriterMutex);
+            if (!bRet)
+                m_bTileWriterError = true;
+            m_oSetTilesBeingWritten.erase(anTileIndices);
+        });
+    return true;
+}
+
+/************************************************************************/
+/*                 ZarrArray::WaitTileWriteIfPending()                  */
+/************************************************************************/
+
+/** Wait for pending tile writes to complete if one of them concerns the
+ * specified tile, typically before reading it back.
+ */
+bool ZarrArray::WaitTileWriteIfPending(
+    const std::vector<uint64_t> &anTileIndices) const
+{
+    if (!m_poTileWriterQueue)
+        return true;
+    {
+        std::lock_guard oLock(m_oTileWriterMutex);
+        if (!cpl::contains(m_oSetTilesBeingWritten, anTileIndices))
+            return true;
+    }
+    return WaitTileWrites();
+}
+
+/************************************************************************/
+/*                     ZarrArray::WaitTileWrites()                      */
+/************************************************************************/
+
+/** Wait for pending tile writes to complete, and replay in the calling
+ * thread errors emitted by them.
+ *
+ * @return true if all tiles have been successfully written.
+ */
+bool ZarrArray::WaitTileWrites() const
+{
+    if (!m_poTileWriterQueue)
+        return true;
+    m_poTileWriterQueue->WaitCompletion();
+    m_poTileWriterErrorAccumulator->ReplayErrors();
+    m_poTileWriterErrorAccumulator = std::make_unique<CPLErrorAccumulator>();
+    std::lock_guard oLock(m_oTileWriterMutex);
+    const bool bRet = !m_bTileWriterError;
+    m_bTileWriterError = false;
+    return bRet;
+}
+
 /************************************************************************/
 /*                   ZarrArray::IsEmptyTile()                           */
 /************************************************************************/
@@ -2146,6 +2272,9 @@ bool ZarrArray::CacheTilePresence()
     if (m_nTotalTileCount == 1)
         return true;
 
+    if (!WaitTileWrites())
+        return false;
+
     const std::string osDirectoryName = GetDataDirectory();
 
     struct DirCloser
@@ -2668,6 +2797,9 @@ bool ZarrArray::Rename(const std::string &osNewName)
             return false;
     }
 
+    if (!WaitTileWrites())
+        return false;
+
     const std::string osRootDirectoryName(
         CPLGetDirnameSafe(CPLGetDirnameSafe(m_osFilename.c_str()).c_str()));
     const std::string osOldDirectoryName = CPLFormFilenameSafe(
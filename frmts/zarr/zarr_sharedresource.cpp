@@ -362,3 +362,25 @@ void ZarrSharedResource::RemoveArrayInLoading(
 {
     m_oSetArrayInLoading.erase(osZarrayFilename);
 }
+
+/************************************************************************/
+/*             ZarrSharedResource::GetTileWriterPool()                  */
+/************************************************************************/
+
+/** Return the thread pool used to encode and write dirty tiles.
+ *
+ * It is shared by all arrays of the dataset, so that the number of threads
+ * does not grow with the number of arrays being written. It is distinct
+ * from the global thread pool, as codecs may themselves use the latter.
+ */
+CPLWorkerThreadPool *ZarrSharedResource::GetTileWriterPool(int nThreads)
+{
+    if (!m_poTileWriterPool)
+    {
+        auto poPool = std::make_unique<CPLWorkerThreadPool>();
+        if (!poPool->Setup(nThreads, nullptr, nullptr, false))
+            return nullptr;
+        m_poTileWriterPool = std::move(poPool);
+    }
+    return m_poTileWriterPool.get();
+}
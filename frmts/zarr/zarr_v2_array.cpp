@@ -80,9 +80,15 @@ ZarrV2Array::~ZarrV2Array()
 bool ZarrV2Array::Flush()
 {
     if (!m_bValid)
+    {
+        // Pending tile writes must not outlive this object
+        CPL_IGNORE_RET_VAL(WaitTileWrites());
         return true;
+    }
 
     bool ret = ZarrV2Array::FlushDirtyTile();
+    if (!WaitTileWrites())
+        ret = false;
 
     if (m_bDefinitionModified)
     {
@@ -845,6 +851,9 @@ bool ZarrV2Array::FlushDirtyTile() const
     {
         m_bCachedTiledEmpty = true;
 
+        if (!WaitTileWriteIfPending(m_anCachedTiledIndices))
+            return false;
+
         VSIStatBufL sStat;
         if (VSIStatL(osFilename.c_str(), &sStat) == 0)
         {
@@ -869,48 +878,163 @@ bool ZarrV2Array::FlushDirtyTile() const
         }
     }
 
-    if (m_bFortranOrder && !m_aoDims.empty())
+    std::vector<TileEncoder> aoFilters;
+    TileEncoder oCompressor;
+    if (!GetTileEncoders(aoFilters, oCompressor))
+        return false;
+
+    if (!IsTileWriterAsync())
     {
-        BlockTranspose(m_abyRawTileData, m_abyTmpRawTileData, false);
-        std::swap(m_abyRawTileData, m_abyTmpRawTileData);
+        return WriteTileData(osFilename, m_abyRawTileData, m_abyTmpRawTileData,
+                             aoFilters, oCompressor);
     }
 
-    size_t nRawDataSize = m_abyRawTileData.size();
+    // Hand over a copy of the tile to a worker thread
+    auto poTileData = std::make_shared<ZarrByteVectorQuickResize>();
+    try
+    {
+        poTileData->resize(m_abyRawTileData.size());
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate memory for tile %s", osFilename.c_str());
+        return false;
+    }
+    memcpy(poTileData->data(), m_abyRawTileData.data(),
+           m_abyRawTileData.size());
+
+    return SubmitTileWrite(
+        [this, osFilename, poTileData, aoFilters = std::move(aoFilters),
+         oCompressor = std::move(oCompressor)]()
+        {
+            ZarrByteVectorQuickResize abyTmpRawTileData;
+            return WriteTileData(osFilename, *poTileData, abyTmpRawTileData,
+                                 aoFilters, oCompressor);
+        });
+}
+
+/************************************************************************/
+/*                    ZarrV2Array::GetTileEncoders()                    */
+/************************************************************************/
+
+/** Collect the filters and the compressor to apply when writing a tile, so
+ * that JSON objects are not accessed from worker threads.
+ */
+bool ZarrV2Array::GetTileEncoders(std::vector<TileEncoder> &aoFilters,
+                                  TileEncoder &oCompressor) const
+{
     for (const auto &oFilter : m_oFiltersArray)
     {
-        const auto osFilterId = oFilter["id"].ToString();
-        if (osFilterId == "quantize" || osFilterId == "fixedscaleoffset")
+        TileEncoder oEncoder;
+        oEncoder.osId = oFilter["id"].ToString();
+        if (oEncoder.osId == "quantize" || oEncoder.osId == "fixedscaleoffset")
         {
             CPLError(CE_Failure, CPLE_NotSupported,
-                     "%s filter not supported for writing", osFilterId.c_str());
+                     "%s filter not supported for writing",
+                     oEncoder.osId.c_str());
             return false;
         }
-        const auto psFilterCompressor =
-            EQUAL(osFilterId.c_str(), "shuffle")
-                ? ZarrGetShuffleCompressor()
-                : CPLGetCompressor(osFilterId.c_str());
-        CPLAssert(psFilterCompressor);
+        oEncoder.psCompressor = EQUAL(oEncoder.osId.c_str(), "shuffle")
+                                    ? ZarrGetShuffleCompressor()
+                                    : CPLGetCompressor(oEncoder.osId.c_str());
+        CPLAssert(oEncoder.psCompressor);
 
-        CPLStringList aosOptions;
         for (const auto &obj : oFilter.GetChildren())
         {
-            aosOptions.SetNameValue(obj.GetName().c_str(),
-                                    obj.ToString().c_str());
+            oEncoder.aosOptions.SetNameValue(obj.GetName().c_str(),
+                                             obj.ToString().c_str());
         }
-        void *out_buffer = &m_abyTmpRawTileData[0];
-        size_t nOutSize = m_abyTmpRawTileData.size();
-        if (!psFilterCompressor->pfnFunc(
-                m_abyRawTileData.data(), nRawDataSize, &out_buffer, &nOutSize,
-                aosOptions.List(), psFilterCompressor->user_data))
+        aoFilters.push_back(std::move(oEncoder));
+    }
+
+    if (m_psCompressor == nullptr && m_psDecompressor != nullptr)
+    {
+        // Case of imagecodecs_tiff
+
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Only decompression supported for '%s' compression method",
+                 m_osDecompressorId.c_str());
+        return false;
+    }
+
+    if (m_psCompressor)
+    {
+        oCompressor.osId = m_psCompressor->pszId;
+        oCompressor.psCompressor = m_psCompressor;
+        const auto &compressorConfig = m_oCompressorJSon;
+        for (const auto &obj : compressorConfig.GetChildren())
+        {
+            oCompressor.aosOptions.SetNameValue(obj.GetName().c_str(),
+                                                obj.ToString().c_str());
+        }
+        if (EQUAL(m_psCompressor->pszId, "blosc") &&
+            m_oType.GetClass() == GEDTC_NUMERIC)
+        {
+            oCompressor.aosOptions.SetNameValue(
+                "TYPESIZE",
+                CPLSPrintf("%d", GDALGetDataTypeSizeBytes(
+                                     GDALGetNonComplexDataType(
+                                         m_oType.GetNumericDataType()))));
+        }
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                    ZarrV2Array::WriteTileData()                      */
+/************************************************************************/
+
+/** Apply filters and compressor to abyRawTileData (in native
+ * representation), and write the result to osFilename.
+ *
+ * This may be called from a worker thread, hence must not modify object
+ * members. abyRawTileData and abyTmpRawTileData are used as working buffers.
+ */
+bool ZarrV2Array::WriteTileData(const std::string &osFilename,
+                                ZarrByteVectorQuickResize &abyRawTileData,
+                                ZarrByteVectorQuickResize &abyTmpRawTileData,
+                                const std::vector<TileEncoder> &aoFilters,
+                                const TileEncoder &oCompressor) const
+{
+    if ((m_bFortranOrder && !m_aoDims.empty()) || !aoFilters.empty())
+    {
+        try
+        {
+            abyTmpRawTileData.resize(abyRawTileData.size());
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate memory for tile %s", osFilename.c_str());
+            return false;
+        }
+    }
+
+    if (m_bFortranOrder && !m_aoDims.empty())
+    {
+        BlockTranspose(abyRawTileData, abyTmpRawTileData, false);
+        std::swap(abyRawTileData, abyTmpRawTileData);
+    }
+
+    size_t nRawDataSize = abyRawTileData.size();
+    for (const auto &oFilter : aoFilters)
+    {
+        void *out_buffer = &abyTmpRawTileData[0];
+        size_t nOutSize = abyTmpRawTileData.size();
+        if (!oFilter.psCompressor->pfnFunc(
+                abyRawTileData.data(), nRawDataSize, &out_buffer, &nOutSize,
+                oFilter.aosOptions.List(), oFilter.psCompressor->user_data))
         {
             CPLError(CE_Failure, CPLE_AppDefined,
-                     "Filter %s for tile %s failed", osFilterId.c_str(),
+                     "Filter %s for tile %s failed", oFilter.osId.c_str(),
                      osFilename.c_str());
             return false;
         }
 
         nRawDataSize = nOutSize;
-        std::swap(m_abyRawTileData, m_abyTmpRawTileData);
+        std::swap(abyRawTileData, abyTmpRawTileData);
     }
 
     if (m_osDimSeparator == "/")
@@ -919,7 +1043,10 @@ bool ZarrV2Array::FlushDirtyTile() const
         VSIStatBufL sStat;
         if (VSIStatL(osDir.c_str(), &sStat) != 0)
         {
-            if (VSIMkdirRecursive(osDir.c_str(), 0755) != 0)
+            // The directory might have been created meanwhile by another
+            // thread
+            if (VSIMkdirRecursive(osDir.c_str(), 0755) != 0 &&
+                VSIStatL(osDir.c_str(), &sStat) != 0)
             {
                 CPLError(CE_Failure, CPLE_AppDefined,
                          "Cannot create directory %s", osDir.c_str());
@@ -928,16 +1055,6 @@ bool ZarrV2Array::FlushDirtyTile() const
         }
     }
 
-    if (m_psCompressor == nullptr && m_psDecompressor != nullptr)
-    {
-        // Case of imagecodecs_tiff
-
-        CPLError(CE_Failure, CPLE_NotSupported,
-                 "Only decompression supported for '%s' compression method",
-                 m_osDecompressorId.c_str());
-        return false;
-    }
-
     VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "wb");
     if (fp == nullptr)
     {
@@ -947,9 +1064,9 @@ bool ZarrV2Array::FlushDirtyTile() const
     }
 
     bool bRet = true;
-    if (m_psCompressor == nullptr)
+    if (oCompressor.psCompressor == nullptr)
     {
-        if (VSIFWriteL(m_abyRawTileData.data(), 1, nRawDataSize, fp) !=
+        if (VSIFWriteL(abyRawTileData.data(), 1, nRawDataSize, fp) !=
             nRawDataSize)
         {
             CPLError(CE_Failure, CPLE_AppDefined,
@@ -977,26 +1094,10 @@ bool ZarrV2Array::FlushDirtyTile() const
         {
             void *out_buffer = &abyCompressedData[0];
             size_t out_size = abyCompressedData.size();
-            CPLStringList aosOptions;
-            const auto &compressorConfig = m_oCompressorJSon;
-            for (const auto &obj : compressorConfig.GetChildren())
-            {
-                aosOptions.SetNameValue(obj.GetName().c_str(),
-                                        obj.ToString().c_str());
-            }
-            if (EQUAL(m_psCompressor->pszId, "blosc") &&
-                m_oType.GetClass() == GEDTC_NUMERIC)
-            {
-                aosOptions.SetNameValue(
-                    "TYPESIZE",
-                    CPLSPrintf("%d", GDALGetDataTypeSizeBytes(
-                                         GDALGetNonComplexDataType(
-                                             m_oType.GetNumericDataType()))));
-            }
-
-            if (!m_psCompressor->pfnFunc(
-                    m_abyRawTileData.data(), nRawDataSize, &out_buffer,
-                    &out_size, aosOptions.List(), m_psCompressor->user_data))
+            if (!oCompressor.psCompressor->pfnFunc(
+                    abyRawTileData.data(), nRawDataSize, &out_buffer,
+                    &out_size, oCompressor.aosOptions.List(),
+                    oCompressor.psCompressor->user_data))
             {
                 CPLError(CE_Failure, CPLE_AppDefined,
                          "Compression of tile %s failed", osFilename.c_str());
@@ -10,12 +10,15 @@
  * SPDX-License-Identifier: MIT
  ****************************************************************************/
 
+#include "cpl_error_internal.h"
 #include "cpl_float.h"
 #include "cpl_vsi_virtual.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal_thread_pool.h"
 #include "zarr.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <cstdlib>
@@ -77,9 +80,15 @@ ZarrV3Array::~ZarrV3Array()
 bool ZarrV3Array::Flush()
 {
     if (!m_bValid)
+    {
+        // Pending tile writes must not outlive this object
+        CPL_IGNORE_RET_VAL(WaitTileWrites());
         return true;
+    }
 
     bool ret = ZarrV3Array::FlushDirtyTile();
+    if (!WaitTileWrites())
+        ret = false;
 
     if (!m_aoDims.empty())
     {
@@ -383,6 +392,13 @@ bool ZarrV3Array::LoadTileData(const uint64_t *tileIndices, bool bUseMutex,
 #define m_abyDecodedTileData cannot_use_here
 #define m_poCodecs cannot_use_here
 
+    if (m_poShardingCodec)
+    {
+        return LoadShardedTileData(tileIndices, bUseMutex, poCodecs,
+                                   abyRawTileData, abyDecodedTileData,
+                                   bMissingTileOut);
+    }
+
     bMissingTileOut = false;
 
     std::string osFilename = BuildTileFilename(tileIndices);
@@ -546,6 +562,23 @@ bool ZarrV3Array::LoadTileData(const uint64_t *tileIndices, bool bUseMutex,
         return false;
     }
 
+    DecodeSourceElts(abyRawTileData, abyDecodedTileData);
+
+    return true;
+
+#undef m_abyRawTileData
+#undef m_abyDecodedTileData
+#undef m_poCodecs
+}
+
+/************************************************************************/
+/*                    ZarrV3Array::DecodeSourceElts()                   */
+/************************************************************************/
+
+void ZarrV3Array::DecodeSourceElts(
+    const ZarrByteVectorQuickResize &abyRawTileData,
+    ZarrByteVectorQuickResize &abyDecodedTileData) const
+{
     if (!abyDecodedTileData.empty())
     {
         const size_t nSourceSize =
@@ -561,12 +594,187 @@ bool ZarrV3Array::LoadTileData(const uint64_t *tileIndices, bool bUseMutex,
             DecodeSourceElt(m_aoDtypeElts, pSrc, pDst);
         }
     }
+}
 
-    return true;
+/************************************************************************/
+/*                    ZarrV3Array::GetShardIndices()                    */
+/************************************************************************/
 
-#undef m_abyRawTileData
-#undef m_abyDecodedTileData
-#undef m_poCodecs
+// Compute the indices of the shard containing the inner chunk of indices
+// tileIndices, and return the index of the inner chunk in the shard.
+size_t ZarrV3Array::GetShardIndices(const uint64_t *tileIndices,
+                                    std::vector<uint64_t> &anShardIndices) const
+{
+    const auto &anChunksPerShard = m_poShardingCodec->GetChunksPerShard();
+    const size_t nDims = m_aoDims.size();
+    anShardIndices.resize(nDims);
+    size_t nInnerChunkIdx = 0;
+    for (size_t i = 0; i < nDims; ++i)
+    {
+        anShardIndices[i] = tileIndices[i] / anChunksPerShard[i];
+        nInnerChunkIdx = nInnerChunkIdx * anChunksPerShard[i] +
+                         static_cast<size_t>(tileIndices[i] %
+                                             anChunksPerShard[i]);
+    }
+    return nInnerChunkIdx;
+}
+
+/************************************************************************/
+/*                     ZarrV3Array::GetShardIndex()                     */
+/************************************************************************/
+
+// Return the decoded index of a shard, reading it from fp if it is not
+// in the cache.
+std::shared_ptr<std::vector<uint64_t>>
+ZarrV3Array::GetShardIndex(const std::string &osFilename, VSILFILE *fp,
+                           bool bUseMutex) const
+{
+    std::unique_lock<std::mutex> oLock(m_oMutex, std::defer_lock);
+    if (bUseMutex)
+        oLock.lock();
+    std::shared_ptr<std::vector<uint64_t>> panIndex;
+    if (m_oShardIndexCache.tryGet(osFilename, panIndex))
+        return panIndex;
+    if (bUseMutex)
+        oLock.unlock();
+
+    const size_t nIndexSize = m_poShardingCodec->GetIndexEncodedSize();
+    vsi_l_offset nIndexOffset = 0;
+    if (m_poShardingCodec->IsIndexAtEnd())
+    {
+        VSIFSeekL(fp, 0, SEEK_END);
+        const auto nFileSize = VSIFTellL(fp);
+        if (nFileSize < nIndexSize)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "Shard %s is too small",
+                     osFilename.c_str());
+            return nullptr;
+        }
+        nIndexOffset = nFileSize - nIndexSize;
+    }
+    std::vector<GByte> abyIndex(nIndexSize);
+    if (VSIFSeekL(fp, nIndexOffset, SEEK_SET) != 0 ||
+        VSIFReadL(abyIndex.data(), 1, nIndexSize, fp) != nIndexSize)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Could not read index of shard %s", osFilename.c_str());
+        return nullptr;
+    }
+
+    panIndex = std::make_shared<std::vector<uint64_t>>();
+    if (bUseMutex)
+        oLock.lock();
+    if (!m_poShardingCodec->DecodeIndex(abyIndex.data(), *panIndex))
+        return nullptr;
+    m_oShardIndexCache.insert(osFilename, panIndex);
+    return panIndex;
+}
+
+/************************************************************************/
+/*                  ZarrV3Array::LoadShardedTileData()                  */
+/************************************************************************/
+
+// Load an inner chunk of a shard, using the shard index to only read the
+// bytes of that chunk.
+bool ZarrV3Array::LoadShardedTileData(
+    const uint64_t *tileIndices, bool bUseMutex, ZarrV3CodecSequence *poCodecs,
+    ZarrByteVectorQuickResize &abyRawTileData,
+    ZarrByteVectorQuickResize &abyDecodedTileData, bool &bMissingTileOut) const
+{
+    // This method should NOT modify any ZarrArray member, except the shard
+    // index cache under the mutex, as it is going to be called concurrently
+    // from several threads.
+
+    bMissingTileOut = false;
+
+    std::vector<uint64_t> anShardIndices;
+    const size_t nInnerChunkIdx = GetShardIndices(tileIndices, anShardIndices);
+    const std::string osFilename = BuildTileFilename(anShardIndices.data());
+
+    const char *const apszOpenOptions[] = {"IGNORE_FILENAME_RESTRICTIONS=YES",
+                                           nullptr};
+    const auto nErrorBefore = CPLGetErrorCounter();
+    VSILFILE *fp = VSIFOpenEx2L(osFilename.c_str(), "rb", 0, apszOpenOptions);
+    if (fp == nullptr)
+    {
+        if (nErrorBefore != CPLGetErrorCounter())
+            return false;
+        // Missing shards are OK and indicate nodata_value
+        CPLDebugOnly(ZARR_DEBUG_KEY, "Shard %s missing (=nodata)",
+                     osFilename.c_str());
+        bMissingTileOut = true;
+        return true;
+    }
+
+    const auto panIndex = GetShardIndex(osFilename, fp, bUseMutex);
+    if (!panIndex)
+    {
+        VSIFCloseL(fp);
+        return false;
+    }
+    const uint64_t nOffset = (*panIndex)[2 * nInnerChunkIdx];
+    const uint64_t nSize = (*panIndex)[2 * nInnerChunkIdx + 1];
+    if (nOffset == ZarrV3CodecShardingIndexed::MISSING_CHUNK &&
+        nSize == ZarrV3CodecShardingIndexed::MISSING_CHUNK)
+    {
+        VSIFCloseL(fp);
+        bMissingTileOut = true;
+        return true;
+    }
+    if (nSize > static_cast<uint64_t>(std::numeric_limits<int>::max()))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Too large inner chunk in %s",
+                 osFilename.c_str());
+        VSIFCloseL(fp);
+        return false;
+    }
+
+    bool bRet = true;
+    try
+    {
+        abyRawTileData.resize(static_cast<size_t>(nSize));
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate memory for inner chunk of %s",
+                 osFilename.c_str());
+        bRet = false;
+    }
+    if (bRet && (VSIFSeekL(fp, nOffset, SEEK_SET) != 0 ||
+                 VSIFReadL(abyRawTileData.data(), 1, abyRawTileData.size(),
+                           fp) != abyRawTileData.size()))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Could not read inner chunk of %s correctly",
+                 osFilename.c_str());
+        bRet = false;
+    }
+    VSIFCloseL(fp);
+    if (!bRet)
+        return false;
+
+    if (!poCodecs->Decode(abyRawTileData))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Decompression of inner chunk of %s failed",
+                 osFilename.c_str());
+        return false;
+    }
+    if (abyRawTileData.size() != m_nTileSize)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Decompressed inner chunk of %s has not expected size. "
+                 "Got %u instead of %u",
+                 osFilename.c_str(),
+                 static_cast<unsigned>(abyRawTileData.size()),
+                 static_cast<unsigned>(m_nTileSize));
+        return false;
+    }
+
+    DecodeSourceElts(abyRawTileData, abyDecodedTileData);
+
+    return true;
 }
 
 /************************************************************************/
@@ -590,6 +798,9 @@ bool ZarrV3Array::IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
         return true;
     }
 
+    if (m_poShardingCodec)
+        return AdviseReadSharded(anReqTilesIndices, nReqTiles, nThreadsMax);
+
     const int nThreads =
         static_cast<int>(std::min(static_cast<size_t>(nThreadsMax), nReqTiles));
 
@@ -738,6 +949,216 @@ bool ZarrV3Array::IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
     return bGlobalStatus;
 }
 
+/************************************************************************/
+/*                   ZarrV3Array::AdviseReadSharded()                   */
+/************************************************************************/
+
+// Load the requested inner chunks, shard by shard, so that the inner chunks
+// of a same shard are fetched with a single VSIFReadMultiRangeL() call.
+bool ZarrV3Array::AdviseReadSharded(
+    const std::vector<uint64_t> &anReqTilesIndices, size_t nReqTiles,
+    int nThreadsMax) const
+{
+    const size_t nDims = m_aoDims.size();
+
+    std::map<std::vector<uint64_t>, std::vector<size_t>> oMapShardToReqTiles;
+    {
+        std::vector<uint64_t> anShardIndices;
+        for (size_t iReq = 0; iReq < nReqTiles; ++iReq)
+        {
+            GetShardIndices(anReqTilesIndices.data() + iReq * nDims,
+                            anShardIndices);
+            oMapShardToReqTiles[anShardIndices].push_back(iReq);
+        }
+    }
+
+    CPLWorkerThreadPool *wtp = GDALGetGlobalThreadPool(nThreadsMax);
+    if (wtp == nullptr)
+        return false;
+
+    const auto StoreTile =
+        [this, nDims, &anReqTilesIndices](size_t iReq,
+                                          ZarrByteVectorQuickResize *pabyTile)
+    {
+        const uint64_t *tileIndices = anReqTilesIndices.data() + iReq * nDims;
+        uint64_t nTileIdx = 0;
+        for (size_t j = 0; j < nDims; ++j)
+        {
+            if (j > 0)
+                nTileIdx *= m_aoDims[j - 1]->GetSize();
+            nTileIdx += tileIndices[j];
+        }
+        CachedTile cachedTile;
+        if (pabyTile)
+            std::swap(cachedTile.abyDecoded, *pabyTile);
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_oMapTileIndexToCachedTile[nTileIdx] = std::move(cachedTile);
+    };
+
+    const auto ProcessShard =
+        [this, nDims, &anReqTilesIndices,
+         &StoreTile](const std::vector<uint64_t> &anShardIndices,
+                     const std::vector<size_t> &anReqTiles)
+    {
+        const std::string osFilename = BuildTileFilename(anShardIndices.data());
+        const char *const apszOpenOptions[] = {
+            "IGNORE_FILENAME_RESTRICTIONS=YES", nullptr};
+        const auto nErrorBefore = CPLGetErrorCounter();
+        VSILFILE *fp =
+            VSIFOpenEx2L(osFilename.c_str(), "rb", 0, apszOpenOptions);
+        if (fp == nullptr)
+        {
+            if (nErrorBefore != CPLGetErrorCounter())
+                return false;
+            for (const size_t iReq : anReqTiles)
+                StoreTile(iReq, nullptr);
+            return true;
+        }
+
+        const auto panIndex = GetShardIndex(osFilename, fp, true);
+        if (!panIndex)
+        {
+            VSIFCloseL(fp);
+            return false;
+        }
+
+        // Collect the byte ranges of the present inner chunks
+        struct ByteRange
+        {
+            size_t iReq;
+            vsi_l_offset nOffset;
+            size_t nSize;
+        };
+
+        std::vector<ByteRange> asRanges;
+        std::vector<uint64_t> anShardIndicesUnused;
+        for (const size_t iReq : anReqTiles)
+        {
+            const size_t nInnerChunkIdx =
+                GetShardIndices(anReqTilesIndices.data() + iReq * nDims,
+                                anShardIndicesUnused);
+            const uint64_t nOffset = (*panIndex)[2 * nInnerChunkIdx];
+            const uint64_t nSize = (*panIndex)[2 * nInnerChunkIdx + 1];
+            if (nOffset == ZarrV3CodecShardingIndexed::MISSING_CHUNK &&
+                nSize == ZarrV3CodecShardingIndexed::MISSING_CHUNK)
+            {
+                StoreTile(iReq, nullptr);
+            }
+            else if (nSize >
+                     static_cast<uint64_t>(std::numeric_limits<int>::max()))
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Too large inner chunk in %s", osFilename.c_str());
+                VSIFCloseL(fp);
+                return false;
+            }
+            else
+            {
+                asRanges.push_back(
+                    ByteRange{iReq, nOffset, static_cast<size_t>(nSize)});
+            }
+        }
+        std::sort(asRanges.begin(), asRanges.end(),
+                  [](const ByteRange &a, const ByteRange &b)
+                  { return a.nOffset < b.nOffset; });
+
+        std::vector<ZarrByteVectorQuickResize> aabyRawTileData(
+            asRanges.size());
+        std::vector<void *> apData;
+        std::vector<vsi_l_offset> anOffsets;
+        std::vector<size_t> anSizes;
+        try
+        {
+            for (size_t i = 0; i < asRanges.size(); ++i)
+            {
+                aabyRawTileData[i].resize(asRanges[i].nSize);
+                apData.push_back(aabyRawTileData[i].data());
+                anOffsets.push_back(asRanges[i].nOffset);
+                anSizes.push_back(asRanges[i].nSize);
+            }
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate memory for inner chunks of %s",
+                     osFilename.c_str());
+            VSIFCloseL(fp);
+            return false;
+        }
+        const bool bReadOK =
+            apData.empty() ||
+            VSIFReadMultiRangeL(static_cast<int>(apData.size()), apData.data(),
+                                anOffsets.data(), anSizes.data(), fp) == 0;
+        VSIFCloseL(fp);
+        if (!bReadOK)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Could not read inner chunks of %s correctly",
+                     osFilename.c_str());
+            return false;
+        }
+
+        std::unique_ptr<ZarrV3CodecSequence> poCodecs;
+        {
+            std::lock_guard<std::mutex> oLock(m_oMutex);
+            poCodecs = m_poCodecs->Clone();
+        }
+        const bool bNeedDecodedBuffer = NeedDecodedBuffer();
+        for (size_t i = 0; i < asRanges.size(); ++i)
+        {
+            auto &abyRawTileData = aabyRawTileData[i];
+            if (!poCodecs->Decode(abyRawTileData) ||
+                abyRawTileData.size() != m_nTileSize)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Decompression of inner chunk of %s failed",
+                         osFilename.c_str());
+                return false;
+            }
+            if (bNeedDecodedBuffer)
+            {
+                ZarrByteVectorQuickResize abyDecodedTileData;
+                const size_t nSourceSize = m_aoDtypeElts.back().nativeOffset +
+                                           m_aoDtypeElts.back().nativeSize;
+                abyDecodedTileData.resize(m_nTileSize / nSourceSize *
+                                          m_oType.GetSize());
+                DecodeSourceElts(abyRawTileData, abyDecodedTileData);
+                StoreTile(asRanges[i].iReq, &abyDecodedTileData);
+            }
+            else
+            {
+                StoreTile(asRanges[i].iReq, &abyRawTileData);
+            }
+        }
+        return true;
+    };
+
+    std::atomic<bool> bGlobalStatus{true};
+    CPLErrorAccumulator oErrorAccumulator;
+    auto poQueue = wtp->CreateJobQueue();
+    for (const auto &oIter : oMapShardToReqTiles)
+    {
+        const auto *panShardIndices = &oIter.first;
+        const auto *panReqTiles = &oIter.second;
+        poQueue->SubmitJob(
+            [&ProcessShard, &bGlobalStatus, &oErrorAccumulator,
+             panShardIndices, panReqTiles]()
+            {
+                auto oAccumulator = oErrorAccumulator.InstallForCurrentScope();
+                CPL_IGNORE_RET_VAL(oAccumulator);
+                if (bGlobalStatus && !ProcessShard(*panShardIndices,
+                                                   *panReqTiles))
+                {
+                    bGlobalStatus = false;
+                }
+            });
+    }
+    poQueue->WaitCompletion();
+    oErrorAccumulator.ReplayErrors();
+
+    return bGlobalStatus;
+}
+
 /************************************************************************/
 /*                    ZarrV3Array::FlushDirtyTile()                     */
 /************************************************************************/
@@ -759,6 +1180,9 @@ bool ZarrV3Array::FlushDirtyTile() const
     {
         m_bCachedTiledEmpty = true;
 
+        if (!WaitTileWriteIfPending(m_anCachedTiledIndices))
+            return false;
+
         VSIStatBufL sStat;
         if (VSIStatL(osFilename.c_str(), &sStat) == 0)
         {
@@ -783,14 +1207,57 @@ bool ZarrV3Array::FlushDirtyTile() const
         }
     }
 
-    const size_t nSizeBefore = m_abyRawTileData.size();
+    if (!IsTileWriterAsync())
+    {
+        const size_t nSizeBefore = m_abyRawTileData.size();
+        const bool bRet =
+            WriteTileData(osFilename, m_abyRawTileData, m_poCodecs.get());
+        m_abyRawTileData.resize(nSizeBefore);
+        return bRet;
+    }
+
+    // Hand over a copy of the tile, and of the codec chain which is not
+    // thread-safe, to a worker thread.
+    auto poTileData = std::make_shared<ZarrByteVectorQuickResize>();
+    try
+    {
+        poTileData->resize(m_abyRawTileData.size());
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate memory for tile %s", osFilename.c_str());
+        return false;
+    }
+    memcpy(poTileData->data(), m_abyRawTileData.data(),
+           m_abyRawTileData.size());
+    std::shared_ptr<ZarrV3CodecSequence> poCodecs;
     if (m_poCodecs)
+        poCodecs = m_poCodecs->Clone();
+
+    return SubmitTileWrite(
+        [this, osFilename, poTileData, poCodecs]()
+        { return WriteTileData(osFilename, *poTileData, poCodecs.get()); });
+}
+
+/************************************************************************/
+/*                    ZarrV3Array::WriteTileData()                      */
+/************************************************************************/
+
+/** Encode abyRawTileData (in native representation) with poCodecs and
+ * write it to osFilename.
+ *
+ * This may be called from a worker thread, hence must not modify object
+ * members. abyRawTileData is modified.
+ */
+bool ZarrV3Array::WriteTileData(const std::string &osFilename,
+                                ZarrByteVectorQuickResize &abyRawTileData,
+                                ZarrV3CodecSequence *poCodecs) const
+{
+    if (poCodecs)
     {
-        if (!m_poCodecs->Encode(m_abyRawTileData))
-        {
-            m_abyRawTileData.resize(nSizeBefore);
+        if (!poCodecs->Encode(abyRawTileData))
             return false;
-        }
     }
 
     if (m_osDimSeparator == "/")
@@ -799,11 +1266,13 @@ bool ZarrV3Array::FlushDirtyTile() const
         VSIStatBufL sStat;
         if (VSIStatL(osDir.c_str(), &sStat) != 0)
         {
-            if (VSIMkdirRecursive(osDir.c_str(), 0755) != 0)
+            // The directory might have been created meanwhile by another
+            // thread
+            if (VSIMkdirRecursive(osDir.c_str(), 0755) != 0 &&
+                VSIStatL(osDir.c_str(), &sStat) != 0)
             {
                 CPLError(CE_Failure, CPLE_AppDefined,
                          "Cannot create directory %s", osDir.c_str());
-                m_abyRawTileData.resize(nSizeBefore);
                 return false;
             }
         }
@@ -814,13 +1283,12 @@ bool ZarrV3Array::FlushDirtyTile() const
     {
         CPLError(CE_Failure, CPLE_AppDefined, "Cannot create tile %s",
                  osFilename.c_str());
-        m_abyRawTileData.resize(nSizeBefore);
         return false;
     }
 
     bool bRet = true;
-    const size_t nRawDataSize = m_abyRawTileData.size();
-    if (VSIFWriteL(m_abyRawTileData.data(), 1, nRawDataSize, fp) !=
+    const size_t nRawDataSize = abyRawTileData.size();
+    if (VSIFWriteL(abyRawTileData.data(), 1, nRawDataSize, fp) !=
         nRawDataSize)
     {
         CPLError(CE_Failure, CPLE_AppDefined,
@@ -829,8 +1297,6 @@ bool ZarrV3Array::FlushDirtyTile() const
     }
     VSIFCloseL(fp);
 
-    m_abyRawTileData.resize(nSizeBefore);
-
     return bRet;
 }
 
@@ -1589,11 +2055,28 @@ ZarrV3Group::LoadArray(const std::string &osArrayName,
             oInputArrayMetadata.anBlockSizes.push_back(
                 static_cast<size_t>(nSize));
         oInputArrayMetadata.oElt = aoDtypeElts.back();
+        if (abyNoData.size() == oInputArrayMetadata.oElt.nativeSize)
+            oInputArrayMetadata.abyFillValue = abyNoData;
         poCodecs = std::make_unique<ZarrV3CodecSequence>(oInputArrayMetadata);
         if (!poCodecs->InitFromJson(oCodecs))
             return nullptr;
     }
 
+    // In read-only mode, when sharding_indexed is the only codec, use the
+    // inner chunks as the blocks of the array, so that only the needed inner
+    // chunks are read from the shards.
+    std::unique_ptr<ZarrV3CodecShardingIndexed> poShardingCodec;
+    if (poCodecs && !m_bUpdatable && poCodecs->GetCodecs().size() == 1 &&
+        poCodecs->GetCodecs()[0]->GetName() ==
+            ZarrV3CodecShardingIndexed::NAME)
+    {
+        poShardingCodec.reset(cpl::down_cast<ZarrV3CodecShardingIndexed *>(
+            poCodecs->GetCodecs()[0]->Clone().release()));
+        const auto &anInnerBlockSize = poShardingCodec->GetInnerBlockSize();
+        anBlockSize.assign(anInnerBlockSize.begin(), anInnerBlockSize.end());
+        poCodecs = poShardingCodec->GetInnerCodecs()->Clone();
+    }
+
     auto poArray =
         ZarrV3Array::Create(m_poSharedResource, GetFullName(), osArrayName,
                             aoDims, oType, aoDtypeElts, anBlockSize);
@@ -1618,6 +2101,9 @@ ZarrV3Group::LoadArray(const std::string &osArrayName,
     }
     if (poCodecs)
         poArray->SetCodecs(std::move(poCodecs));
+    const bool bSharded = poShardingCodec != nullptr;
+    if (poShardingCodec)
+        poArray->SetShardingCodec(std::move(poShardingCodec));
     RegisterArray(poArray);
 
     // If this is an indexing variable, attach it to the dimension.
@@ -1630,7 +2116,9 @@ ZarrV3Group::LoadArray(const std::string &osArrayName,
         }
     }
 
-    if (CPLTestBool(m_poSharedResource->GetOpenOptions().FetchNameValueDef(
+    // The presence of inner chunks is given by the shard indices
+    if (!bSharded &&
+        CPLTestBool(m_poSharedResource->GetOpenOptions().FetchNameValueDef(
             "CACHE_TILE_PRESENCE", "NO")))
     {
         poArray->CacheTilePresence();
@@ -13,6 +13,13 @@
 #include "zarr.h"
 
 #include "cpl_compressor.h"
+#include "cpl_error_internal.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 
 /************************************************************************/
 /*                          ZarrV3Codec()                               */
@@ -958,6 +965,124 @@ bool ZarrV3CodecTranspose::Decode(const ZarrByteVectorQuickResize &abySrc,
     return Transpose(abySrc, abyDst, false);
 }
 
+/************************************************************************/
+/*                         ZarrV3CodecCRC32C()                          */
+/************************************************************************/
+
+ZarrV3CodecCRC32C::ZarrV3CodecCRC32C() : ZarrV3Codec(NAME)
+{
+}
+
+/************************************************************************/
+/*                ZarrV3CodecCRC32C::InitFromConfiguration()            */
+/************************************************************************/
+
+bool ZarrV3CodecCRC32C::InitFromConfiguration(
+    const CPLJSONObject &configuration,
+    const ZarrArrayMetadata &oInputArrayMetadata,
+    ZarrArrayMetadata &oOutputArrayMetadata)
+{
+    m_oConfiguration = configuration.Clone();
+    m_oInputArrayMetadata = oInputArrayMetadata;
+    oOutputArrayMetadata = oInputArrayMetadata;
+
+    if (configuration.IsValid())
+    {
+        if (configuration.GetType() != CPLJSONObject::Type::Object)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Codec crc32c: configuration is not an object");
+            return false;
+        }
+
+        for (const auto &oChild : configuration.GetChildren())
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Codec crc32c: configuration contains a unhandled "
+                     "member: %s",
+                     oChild.GetName().c_str());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                      ZarrV3CodecCRC32C::Clone()                      */
+/************************************************************************/
+
+std::unique_ptr<ZarrV3Codec> ZarrV3CodecCRC32C::Clone() const
+{
+    auto psClone = std::make_unique<ZarrV3CodecCRC32C>();
+    ZarrArrayMetadata oOutputArrayMetadata;
+    psClone->InitFromConfiguration(m_oConfiguration, m_oInputArrayMetadata,
+                                   oOutputArrayMetadata);
+    return psClone;
+}
+
+/************************************************************************/
+/*                          ComputeCRC32C()                             */
+/************************************************************************/
+
+// CRC-32C (Castagnoli polynomial), as used by the crc32c codec
+static uint32_t ComputeCRC32C(const GByte *pabyData, size_t nSize)
+{
+    uint32_t nCRC = 0xFFFFFFFFU;
+    for (size_t i = 0; i < nSize; ++i)
+    {
+        nCRC ^= pabyData[i];
+        for (int j = 0; j < 8; ++j)
+            nCRC = (nCRC >> 1) ^ (0x82F63B78U & (0U - (nCRC & 1U)));
+    }
+    return ~nCRC;
+}
+
+/************************************************************************/
+/*                      ZarrV3CodecCRC32C::Encode()                     */
+/************************************************************************/
+
+bool ZarrV3CodecCRC32C::Encode(const ZarrByteVectorQuickResize &abySrc,
+                               ZarrByteVectorQuickResize &abyDst) const
+{
+    const size_t nSize = abySrc.size();
+    abyDst.resize(nSize + sizeof(uint32_t));
+    if (nSize)
+        memcpy(abyDst.data(), abySrc.data(), nSize);
+    uint32_t nCRC = ComputeCRC32C(abySrc.data(), nSize);
+    CPL_LSBPTR32(&nCRC);
+    memcpy(abyDst.data() + nSize, &nCRC, sizeof(nCRC));
+    return true;
+}
+
+/************************************************************************/
+/*                      ZarrV3CodecCRC32C::Decode()                     */
+/************************************************************************/
+
+bool ZarrV3CodecCRC32C::Decode(const ZarrByteVectorQuickResize &abySrc,
+                               ZarrByteVectorQuickResize &abyDst) const
+{
+    if (abySrc.size() < sizeof(uint32_t))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Codec crc32c: input buffer too small");
+        return false;
+    }
+    const size_t nSize = abySrc.size() - sizeof(uint32_t);
+    uint32_t nExpectedCRC;
+    memcpy(&nExpectedCRC, abySrc.data() + nSize, sizeof(nExpectedCRC));
+    CPL_LSBPTR32(&nExpectedCRC);
+    if (ComputeCRC32C(abySrc.data(), nSize) != nExpectedCRC)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Codec crc32c: invalid checksum");
+        return false;
+    }
+    abyDst.resize(nSize);
+    if (nSize)
+        memcpy(abyDst.data(), abySrc.data(), nSize);
+    return true;
+}
+
 /************************************************************************/
 /*                    ZarrV3CodecSequence::Clone()                      */
 /************************************************************************/
@@ -1036,6 +1161,10 @@ bool ZarrV3CodecSequence::InitFromJson(const CPLJSONObject &oCodecs)
             poCodec = std::make_unique<ZarrV3CodecBytes>();
         else if (osName == "transpose")
             poCodec = std::make_unique<ZarrV3CodecTranspose>();
+        else if (osName == "crc32c")
+            poCodec = std::make_unique<ZarrV3CodecCRC32C>();
+        else if (osName == "sharding_indexed")
+            poCodec = std::make_unique<ZarrV3CodecShardingIndexed>();
         else
         {
             CPLError(CE_Failure, CPLE_NotSupported, "Unsupported codec: %s",
@@ -1155,3 +1284,533 @@ bool ZarrV3CodecSequence::Decode(ZarrByteVectorQuickResize &abyBuffer)
     }
     return true;
 }
+
+/************************************************************************/
+/*                    ZarrV3CodecShardingIndexed()                      */
+/************************************************************************/
+
+ZarrV3CodecShardingIndexed::ZarrV3CodecShardingIndexed() : ZarrV3Codec(NAME)
+{
+}
+
+/************************************************************************/
+/*                           GetConfiguration()                         */
+/************************************************************************/
+
+/* static */ CPLJSONObject ZarrV3CodecShardingIndexed::GetConfiguration(
+    const std::vector<GUInt64> &anInnerBlockSize, const CPLJSONArray &oCodecs)
+{
+    CPLJSONObject oConfig;
+    CPLJSONArray oChunkShape;
+    for (const auto nSize : anInnerBlockSize)
+        oChunkShape.Add(static_cast<GInt64>(nSize));
+    oConfig.Add("chunk_shape", oChunkShape);
+    oConfig.Add("codecs", oCodecs);
+
+    CPLJSONArray oIndexCodecs;
+    {
+        CPLJSONObject oCodec;
+        oCodec.Add("name", ZarrV3CodecBytes::NAME);
+        oCodec.Add("configuration", ZarrV3CodecBytes::GetConfiguration(true));
+        oIndexCodecs.Add(oCodec);
+    }
+    {
+        CPLJSONObject oCodec;
+        oCodec.Add("name", ZarrV3CodecCRC32C::NAME);
+        oIndexCodecs.Add(oCodec);
+    }
+    oConfig.Add("index_codecs", oIndexCodecs);
+    oConfig.Add("index_location", "end");
+    return oConfig;
+}
+
+/************************************************************************/
+/*           ZarrV3CodecShardingIndexed::InitFromConfiguration()        */
+/************************************************************************/
+
+bool ZarrV3CodecShardingIndexed::InitFromConfiguration(
+    const CPLJSONObject &configuration,
+    const ZarrArrayMetadata &oInputArrayMetadata,
+    ZarrArrayMetadata &oOutputArrayMetadata)
+{
+    m_oConfiguration = configuration.Clone();
+    m_oInputArrayMetadata = oInputArrayMetadata;
+    oOutputArrayMetadata = oInputArrayMetadata;
+
+    if (!configuration.IsValid() ||
+        configuration.GetType() != CPLJSONObject::Type::Object)
+    {
+        CPLError(
+            CE_Failure, CPLE_AppDefined,
+            "Codec sharding_indexed: configuration missing or not an object");
+        return false;
+    }
+
+    for (const auto &oChild : configuration.GetChildren())
+    {
+        const auto osName = oChild.GetName();
+        if (osName != "chunk_shape" && osName != "codecs" &&
+            osName != "index_codecs" && osName != "index_location")
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Codec sharding_indexed: configuration contains a "
+                     "unhandled member: %s",
+                     osName.c_str());
+            return false;
+        }
+    }
+
+    const auto oChunkShape = configuration["chunk_shape"].ToArray();
+    const size_t nDims = oInputArrayMetadata.anBlockSizes.size();
+    if (!oChunkShape.IsValid() ||
+        static_cast<size_t>(oChunkShape.Size()) != nDims)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Codec sharding_indexed: chunk_shape missing or not an "
+                 "array of the expected size");
+        return false;
+    }
+
+    m_anInnerBlockSize.clear();
+    m_anChunksPerShard.clear();
+    m_nChunkCount = 1;
+    for (size_t i = 0; i < nDims; ++i)
+    {
+        const auto nSize = oChunkShape[static_cast<int>(i)].ToLong();
+        const size_t nShardSize = oInputArrayMetadata.anBlockSizes[i];
+        if (nSize <= 0 || static_cast<uint64_t>(nSize) > nShardSize ||
+            (nShardSize % static_cast<size_t>(nSize)) != 0)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Codec sharding_indexed: chunk_shape[%d] is not a "
+                     "divisor of the shard shape",
+                     static_cast<int>(i));
+            return false;
+        }
+        m_anInnerBlockSize.push_back(static_cast<size_t>(nSize));
+        m_anChunksPerShard.push_back(nShardSize / static_cast<size_t>(nSize));
+        m_nChunkCount *= m_anChunksPerShard.back();
+    }
+    // The shard is already held in memory, so this cannot overflow
+    if (m_nChunkCount >
+        std::numeric_limits<size_t>::max() / (2 * sizeof(uint64_t)))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Codec sharding_indexed: too many inner chunks");
+        return false;
+    }
+
+    const auto oIndexLocation = configuration.GetObj("index_location");
+    m_bIndexAtEnd = true;
+    if (oIndexLocation.IsValid())
+    {
+        const auto osIndexLocation = oIndexLocation.ToString();
+        if (osIndexLocation == "start")
+            m_bIndexAtEnd = false;
+        else if (osIndexLocation != "end")
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Codec sharding_indexed: invalid value for "
+                     "index_location");
+            return false;
+        }
+    }
+
+    ZarrArrayMetadata oInnerArrayMetadata;
+    oInnerArrayMetadata.oElt = oInputArrayMetadata.oElt;
+    oInnerArrayMetadata.anBlockSizes = m_anInnerBlockSize;
+    oInnerArrayMetadata.abyFillValue = oInputArrayMetadata.abyFillValue;
+    m_poCodecs = std::make_unique<ZarrV3CodecSequence>(oInnerArrayMetadata);
+    if (!m_poCodecs->InitFromJson(configuration["codecs"]))
+        return false;
+
+    // The index is an array of (offset, nbytes) uint64 pairs, one per inner
+    // chunk.
+    const auto oIndexCodecs = configuration["index_codecs"];
+    if (oIndexCodecs.GetType() != CPLJSONObject::Type::Array)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Codec sharding_indexed: index_codecs missing or not an "
+                 "array");
+        return false;
+    }
+    for (const auto &oCodec : oIndexCodecs.ToArray())
+    {
+        // Only fixed-size codecs are allowed by the specification
+        const auto osName = oCodec["name"].ToString();
+        if (osName != ZarrV3CodecBytes::NAME &&
+            osName != ZarrV3CodecCRC32C::NAME)
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "Codec sharding_indexed: unsupported index codec: %s",
+                     osName.c_str());
+            return false;
+        }
+    }
+
+    ZarrArrayMetadata oIndexArrayMetadata;
+    oIndexArrayMetadata.oElt.nativeType = DtypeElt::NativeType::UNSIGNED_INT;
+    oIndexArrayMetadata.oElt.nativeSize = sizeof(uint64_t);
+    oIndexArrayMetadata.oElt.gdalType =
+        GDALExtendedDataType::Create(GDT_UInt64);
+    oIndexArrayMetadata.oElt.gdalSize = sizeof(uint64_t);
+    oIndexArrayMetadata.anBlockSizes = m_anChunksPerShard;
+    oIndexArrayMetadata.anBlockSizes.push_back(2);
+    m_poIndexCodecs =
+        std::make_unique<ZarrV3CodecSequence>(oIndexArrayMetadata);
+    if (!m_poIndexCodecs->InitFromJson(oIndexCodecs))
+        return false;
+
+    // Compute the size of the encoded index
+    ZarrByteVectorQuickResize abyIndex;
+    try
+    {
+        abyIndex.resize(m_nChunkCount * 2 * sizeof(uint64_t));
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+        return false;
+    }
+    memset(abyIndex.data(), 0xFF, abyIndex.size());
+    if (!m_poIndexCodecs->Encode(abyIndex))
+        return false;
+    m_nIndexEncodedSize = abyIndex.size();
+
+    return true;
+}
+
+/************************************************************************/
+/*                 ZarrV3CodecShardingIndexed::Clone()                  */
+/************************************************************************/
+
+std::unique_ptr<ZarrV3Codec> ZarrV3CodecShardingIndexed::Clone() const
+{
+    // Do not re-run InitFromConfiguration(), to avoid emitting again
+    // warnings of the inner codec sequences.
+    auto psClone = std::make_unique<ZarrV3CodecShardingIndexed>();
+    psClone->m_oConfiguration = m_oConfiguration.Clone();
+    psClone->m_oInputArrayMetadata = m_oInputArrayMetadata;
+    psClone->m_anInnerBlockSize = m_anInnerBlockSize;
+    psClone->m_anChunksPerShard = m_anChunksPerShard;
+    psClone->m_nChunkCount = m_nChunkCount;
+    if (m_poCodecs)
+        psClone->m_poCodecs = m_poCodecs->Clone();
+    if (m_poIndexCodecs)
+        psClone->m_poIndexCodecs = m_poIndexCodecs->Clone();
+    psClone->m_bIndexAtEnd = m_bIndexAtEnd;
+    psClone->m_nIndexEncodedSize = m_nIndexEncodedSize;
+    return psClone;
+}
+
+/************************************************************************/
+/*             ZarrV3CodecShardingIndexed::CopyInnerChunk()             */
+/************************************************************************/
+
+// Copy the inner chunk of index iChunk (in C order) from a contiguous buffer
+// to its location in the shard if bChunkToShard, or the reverse.
+void ZarrV3CodecShardingIndexed::CopyInnerChunk(size_t iChunk,
+                                                const GByte *pabySrc,
+                                                GByte *pabyDst,
+                                                bool bChunkToShard) const
+{
+    const size_t nDims = m_anInnerBlockSize.size();
+    const size_t nEltSize = m_oInputArrayMetadata.oElt.nativeSize;
+    if (nDims == 0)
+    {
+        memcpy(pabyDst, pabySrc, nEltSize);
+        return;
+    }
+
+    // Origin of the inner chunk in the shard, and strides of the shard
+    std::vector<size_t> anOrigin(nDims);
+    std::vector<size_t> anShardStride(nDims);
+    size_t nStride = nEltSize;
+    for (size_t i = nDims; i > 0;)
+    {
+        --i;
+        anOrigin[i] = (iChunk % m_anChunksPerShard[i]) * m_anInnerBlockSize[i];
+        iChunk /= m_anChunksPerShard[i];
+        anShardStride[i] = nStride;
+        nStride *= m_oInputArrayMetadata.anBlockSizes[i];
+    }
+
+    // Iterate over the rows (along the last dimension) of the inner chunk
+    const size_t nRowSize = m_anInnerBlockSize[nDims - 1] * nEltSize;
+    std::vector<size_t> anIdx(nDims, 0);
+    size_t nChunkOffset = 0;
+    while (true)
+    {
+        size_t nShardOffset = 0;
+        for (size_t i = 0; i < nDims; ++i)
+            nShardOffset += (anOrigin[i] + anIdx[i]) * anShardStride[i];
+        if (bChunkToShard)
+            memcpy(pabyDst + nShardOffset, pabySrc + nChunkOffset, nRowSize);
+        else
+            memcpy(pabyDst + nChunkOffset, pabySrc + nShardOffset, nRowSize);
+        nChunkOffset += nRowSize;
+
+        bool bDone = true;
+        for (size_t i = nDims - 1; i > 0;)
+        {
+            --i;
+            if (++anIdx[i] < m_anInnerBlockSize[i])
+            {
+                bDone = false;
+                break;
+            }
+            anIdx[i] = 0;
+        }
+        if (bDone)
+            break;
+    }
+}
+
+/************************************************************************/
+/*               ZarrV3CodecShardingIndexed::DecodeIndex()              */
+/************************************************************************/
+
+bool ZarrV3CodecShardingIndexed::DecodeIndex(
+    const GByte *pabyEncodedIndex, std::vector<uint64_t> &anIndex) const
+{
+    ZarrByteVectorQuickResize abyIndex;
+    abyIndex.resize(m_nIndexEncodedSize);
+    memcpy(abyIndex.data(), pabyEncodedIndex, m_nIndexEncodedSize);
+    if (!m_poIndexCodecs->Decode(abyIndex))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Codec sharding_indexed: cannot decode shard index");
+        return false;
+    }
+    if (abyIndex.size() != m_nChunkCount * 2 * sizeof(uint64_t))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Codec sharding_indexed: shard index has not expected size");
+        return false;
+    }
+    anIndex.resize(m_nChunkCount * 2);
+    memcpy(anIndex.data(), abyIndex.data(), abyIndex.size());
+    return true;
+}
+
+/************************************************************************/
+/*                 ZarrV3CodecShardingIndexed::Encode()                 */
+/************************************************************************/
+
+bool ZarrV3CodecShardingIndexed::Encode(const ZarrByteVectorQuickResize &abySrc,
+                                        ZarrByteVectorQuickResize &abyDst) const
+{
+    const size_t nEltSize = m_oInputArrayMetadata.oElt.nativeSize;
+    if (abySrc.size() < m_oInputArrayMetadata.GetEltCount() * nEltSize)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "ZarrV3CodecShardingIndexed::Encode(): input buffer too "
+                 "small");
+        return false;
+    }
+    size_t nInnerSize = nEltSize;
+    for (const auto nSize : m_anInnerBlockSize)
+        nInnerSize *= nSize;
+
+    std::vector<ZarrByteVectorQuickResize> aabyChunks(m_nChunkCount);
+    const auto EncodeChunks = [this, &abySrc, &aabyChunks,
+                               nInnerSize](ZarrV3CodecSequence *poCodecs,
+                                           size_t iStart, size_t iEnd)
+    {
+        for (size_t iChunk = iStart; iChunk < iEnd; ++iChunk)
+        {
+            auto &abyChunk = aabyChunks[iChunk];
+            try
+            {
+                abyChunk.resize(nInnerSize);
+            }
+            catch (const std::exception &e)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+                return false;
+            }
+            CopyInnerChunk(iChunk, abySrc.data(), abyChunk.data(),
+                           /* bChunkToShard = */ false);
+            if (!poCodecs->Encode(abyChunk))
+                return false;
+        }
+        return true;
+    };
+
+    // Inner chunks are independent: encode them in parallel if possible,
+    // each job using its own copy of the inner codecs.
+    const int nThreads = static_cast<int>(
+        std::min<size_t>(GDALGetNumThreads(), m_nChunkCount));
+    CPLWorkerThreadPool *poPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    if (poPool)
+    {
+        std::vector<std::unique_ptr<ZarrV3CodecSequence>> apoCodecs;
+        for (int i = 0; i < nThreads; ++i)
+            apoCodecs.push_back(m_poCodecs->Clone());
+
+        std::atomic<bool> bOK{true};
+        CPLErrorAccumulator oErrorAccumulator;
+        auto poQueue = poPool->CreateJobQueue();
+        for (int i = 0; i < nThreads; ++i)
+        {
+            const size_t iStart = i * m_nChunkCount / nThreads;
+            const size_t iEnd = (i + 1) * m_nChunkCount / nThreads;
+            ZarrV3CodecSequence *poCodecs = apoCodecs[i].get();
+            poQueue->SubmitJob(
+                [&EncodeChunks, &bOK, &oErrorAccumulator, poCodecs, iStart,
+                 iEnd]()
+                {
+                    auto oAccumulator =
+                        oErrorAccumulator.InstallForCurrentScope();
+                    CPL_IGNORE_RET_VAL(oAccumulator);
+                    if (!EncodeChunks(poCodecs, iStart, iEnd))
+                        bOK = false;
+                });
+        }
+        poQueue->WaitCompletion();
+        oErrorAccumulator.ReplayErrors();
+        if (!bOK)
+            return false;
+    }
+    else if (!EncodeChunks(m_poCodecs.get(), 0, m_nChunkCount))
+    {
+        return false;
+    }
+
+    // Build the index, and assemble the shard
+    std::vector<uint64_t> anIndex(m_nChunkCount * 2);
+    size_t nOffset = m_bIndexAtEnd ? 0 : m_nIndexEncodedSize;
+    for (size_t iChunk = 0; iChunk < m_nChunkCount; ++iChunk)
+    {
+        anIndex[2 * iChunk] = nOffset;
+        anIndex[2 * iChunk + 1] = aabyChunks[iChunk].size();
+        nOffset += aabyChunks[iChunk].size();
+    }
+
+    ZarrByteVectorQuickResize abyIndex;
+    abyIndex.resize(anIndex.size() * sizeof(uint64_t));
+    memcpy(abyIndex.data(), anIndex.data(), abyIndex.size());
+    if (!m_poIndexCodecs->Encode(abyIndex))
+        return false;
+    CPLAssert(abyIndex.size() == m_nIndexEncodedSize);
+
+    try
+    {
+        abyDst.resize(nOffset + (m_bIndexAtEnd ? m_nIndexEncodedSize : 0));
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+        return false;
+    }
+    GByte *pabyDst = abyDst.data();
+    if (!m_bIndexAtEnd)
+    {
+        memcpy(pabyDst, abyIndex.data(), m_nIndexEncodedSize);
+        pabyDst += m_nIndexEncodedSize;
+    }
+    for (const auto &abyChunk : aabyChunks)
+    {
+        memcpy(pabyDst, abyChunk.data(), abyChunk.size());
+        pabyDst += abyChunk.size();
+    }
+    if (m_bIndexAtEnd)
+        memcpy(pabyDst, abyIndex.data(), m_nIndexEncodedSize);
+
+    return true;
+}
+
+/************************************************************************/
+/*                 ZarrV3CodecShardingIndexed::Decode()                 */
+/************************************************************************/
+
+bool ZarrV3CodecShardingIndexed::Decode(const ZarrByteVectorQuickResize &abySrc,
+                                        ZarrByteVectorQuickResize &abyDst) const
+{
+    if (abySrc.size() < m_nIndexEncodedSize)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Codec sharding_indexed: shard is too small");
+        return false;
+    }
+    std::vector<uint64_t> anIndex;
+    if (!DecodeIndex(abySrc.data() + (m_bIndexAtEnd ? abySrc.size() -
+                                                          m_nIndexEncodedSize
+                                                    : 0),
+                     anIndex))
+    {
+        return false;
+    }
+
+    const size_t nEltSize = m_oInputArrayMetadata.oElt.nativeSize;
+    size_t nInnerSize = nEltSize;
+    for (const auto nSize : m_anInnerBlockSize)
+        nInnerSize *= nSize;
+    try
+    {
+        abyDst.resize(m_oInputArrayMetadata.GetEltCount() * nEltSize);
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+        return false;
+    }
+
+    ZarrByteVectorQuickResize abyChunk;
+    ZarrByteVectorQuickResize abyFillChunk;
+    for (size_t iChunk = 0; iChunk < m_nChunkCount; ++iChunk)
+    {
+        const uint64_t nOffset = anIndex[2 * iChunk];
+        const uint64_t nSize = anIndex[2 * iChunk + 1];
+        if (nOffset == MISSING_CHUNK && nSize == MISSING_CHUNK)
+        {
+            // Missing inner chunks are filled with the fill value
+            if (abyFillChunk.empty())
+            {
+                abyFillChunk.resize(nInnerSize);
+                const auto &abyFillValue = m_oInputArrayMetadata.abyFillValue;
+                if (abyFillValue.size() == nEltSize)
+                {
+                    for (size_t i = 0; i < nInnerSize; i += nEltSize)
+                        memcpy(abyFillChunk.data() + i, abyFillValue.data(),
+                               nEltSize);
+                }
+                else
+                {
+                    memset(abyFillChunk.data(), 0, nInnerSize);
+                }
+            }
+            CopyInnerChunk(iChunk, abyFillChunk.data(), abyDst.data(),
+                           /* bChunkToShard = */ true);
+            continue;
+        }
+
+        if (nOffset > abySrc.size() || nSize > abySrc.size() - nOffset)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Codec sharding_indexed: invalid index entry for inner "
+                     "chunk %u",
+                     static_cast<unsigned>(iChunk));
+            return false;
+        }
+        abyChunk.resize(static_cast<size_t>(nSize));
+        if (nSize)
+            memcpy(abyChunk.data(), abySrc.data() + nOffset,
+                   static_cast<size_t>(nSize));
+        if (!m_poCodecs->Decode(abyChunk))
+            return false;
+        if (abyChunk.size() != nInnerSize)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Codec sharding_indexed: decoded inner chunk %u has not "
+                     "expected size",
+                     static_cast<unsigned>(iChunk));
+            return false;
+        }
+        CopyInnerChunk(iChunk, abyChunk.data(), abyDst.data(),
+                       /* bChunkToShard = */ true);
+    }
+
+    return true;
+}
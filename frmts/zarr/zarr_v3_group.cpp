@@ -692,6 +692,44 @@ std::shared_ptr<GDALMDArray> ZarrV3Group::CreateMDArray(
         return nullptr;
     }
 
+    const char *pszShardInnerBlockSize =
+        CSLFetchNameValue(papszOptions, "SHARD_INNER_BLOCKSIZE");
+    if (pszShardInnerBlockSize)
+    {
+        // Blocks of the array are shards made of inner chunks, that are
+        // encoded with the above codecs.
+        const CPLStringList aosTokens(
+            CSLTokenizeString2(pszShardInnerBlockSize, ",", 0));
+        if (static_cast<size_t>(aosTokens.size()) != anBlockSize.size())
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Invalid number of values in SHARD_INNER_BLOCKSIZE");
+            return nullptr;
+        }
+        std::vector<GUInt64> anInnerBlockSize;
+        for (int i = 0; i < aosTokens.size(); ++i)
+        {
+            const auto nSize = CPLAtoGIntBig(aosTokens[i]);
+            if (nSize <= 0 || (anBlockSize[i] % nSize) != 0)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Values in SHARD_INNER_BLOCKSIZE should be divisors "
+                         "of the ones of BLOCKSIZE");
+                return nullptr;
+            }
+            anInnerBlockSize.push_back(static_cast<GUInt64>(nSize));
+        }
+
+        CPLJSONObject oCodec;
+        oCodec.Add("name", "sharding_indexed");
+        oCodec.Add("configuration",
+                   ZarrV3CodecShardingIndexed::GetConfiguration(
+                       anInnerBlockSize, oCodecs));
+        CPLJSONArray oShardingCodecs;
+        oShardingCodecs.Add(oCodec);
+        oCodecs = oShardingCodecs;
+    }
+
     if (oCodecs.Size() > 0)
     {
         // Byte swapping will be done by the codec chain
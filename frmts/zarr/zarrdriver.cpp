@@ -861,6 +861,16 @@ void ZarrDriver::InitMetadata()
             psBlockSizeNode, "description",
             "Comma separated list of chunk size along each dimension");
 
+        auto psShardInnerBlockSizeNode =
+            CPLCreateXMLNode(oTree.get(), CXT_Element, "Option");
+        CPLAddXMLAttributeAndValue(psShardInnerBlockSizeNode, "name",
+                                   "SHARD_INNER_BLOCKSIZE");
+        CPLAddXMLAttributeAndValue(psShardInnerBlockSizeNode, "type", "string");
+        CPLAddXMLAttributeAndValue(
+            psShardInnerBlockSizeNode, "description",
+            "Comma separated list of inner chunk size along each dimension, "
+            "to store chunks as shards (only for ZARR_V3)");
+
         auto psChunkMemoryLayout =
             CPLCreateXMLNode(oTree.get(), CXT_Element, "Option");
         CPLAddXMLAttributeAndValue(psChunkMemoryLayout, "name",
@@ -1592,11 +1592,19 @@ class CPL_DLL GDALRasterBlock final
     GDALRasterBlock *poNext = nullptr;
     GDALRasterBlock *poPrevious = nullptr;
 
+    // Value of a global counter when the block was last touched.
+    GUIntBig nTouchStamp = 0;
+
     bool bMustDetach = false;
 
     CPL_INTERNAL void Detach_unlocked(void);
     CPL_INTERNAL void Touch_unlocked(void);
 
+    template <class IsCandidateFunc>
+    CPL_INTERNAL static GDALRasterBlock *
+    DetachOldestEvictable(IsCandidateFunc IsCandidate,
+                          const char *pszSleepConfigOption);
+
     CPL_INTERNAL void RecycleFor(int nXOffIn, int nYOffIn);
 
   public:
@@ -12,6 +12,11 @@
 
 #include "gdal_thread_pool.h"
 
+#include "cpl_conv.h"
+#include "cpl_multiproc.h"
+#include "cpl_string.h"
+
+#include <algorithm>
 #include <mutex>
 
 // For unclear reasons, attempts at making this a std::unique_ptr<>, even
@@ -52,3 +57,19 @@ void GDALDestroyGlobalThreadPool()
     delete gpoCompressThreadPool;
     gpoCompressThreadPool = nullptr;
 }
+
+/************************************************************************/
+/*                         GDALGetNumThreads()                          */
+/************************************************************************/
+
+/** Return the number of threads to use, as determined by the
+ * GDAL_NUM_THREADS configuration option (an integer or ALL_CPUS),
+ * clamped to [1, nMaxVal]. Defaults to 1 when the option is not set.
+ */
+int GDALGetNumThreads(int nMaxVal)
+{
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads =
+        EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszThreads);
+    return std::max(1, std::min(nMaxVal, nThreads));
+}
@@ -19,4 +19,6 @@ CPLWorkerThreadPool CPL_DLL *GDALGetGlobalThreadPool(int nThreads);
 
 void GDALDestroyGlobalThreadPool();
 
+int CPL_DLL GDALGetNumThreads(int nMaxVal = 128);
+
 #endif  // GDAL_THREAD_POOL_H
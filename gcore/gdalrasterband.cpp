@@ -25,8 +25,11 @@
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <new>
 #include <type_traits>
 
@@ -42,8 +45,14 @@
 #include "gdal_priv_templates.hpp"
 #include "gdal_interpolateatpoint.h"
 #include "gdal_minmax_element.hpp"
+#include "gdal_thread_pool.h"
 #include "gdalmultidim_priv.h"
 
+#if defined(__x86_64) || defined(_M_X64)
+#define USE_SSE2
+#include "gdalsse_priv.h"
+#endif
+
 /************************************************************************/
 /*                           GDALRasterBand()                           */
 /************************************************************************/
@@ -4132,183 +4141,847 @@ inline bool ARE_REAL_EQUAL(GFloat16 dfVal1, GFloat16 dfVal2, int ulp = 2)
 }
 
 /************************************************************************/
-/*                            GetHistogram()                            */
+/*                   GDALGetStatisticsThreadPool()                      */
 /************************************************************************/
 
-/**
- * \brief Compute raster histogram.
- *
- * Note that the bucket size is (dfMax-dfMin) / nBuckets.
- *
- * For example to compute a simple 256 entry histogram of eight bit data,
- * the following would be suitable.  The unusual bounds are to ensure that
- * bucket boundaries don't fall right on integer values causing possible errors
- * due to rounding after scaling.
-\code{.cpp}
-    GUIntBig anHistogram[256];
-
-    poBand->GetHistogram( -0.5, 255.5, 256, anHistogram, FALSE, FALSE,
-                          GDALDummyProgress, nullptr );
-\endcode
- *
- * Note that setting bApproxOK will generally result in a subsampling of the
- * file, and will utilize overviews if available.  It should generally
- * produce a representative histogram for the data that is suitable for use
- * in generating histogram based luts for instance.  Generally bApproxOK is
- * much faster than an exactly computed histogram.
- *
- * This method is the same as the C functions GDALGetRasterHistogram() and
- * GDALGetRasterHistogramEx().
- *
- * @param dfMin the lower bound of the histogram.
- * @param dfMax the upper bound of the histogram.
- * @param nBuckets the number of buckets in panHistogram.
- * @param panHistogram array into which the histogram totals are placed.
- * @param bIncludeOutOfRange if TRUE values below the histogram range will
- * mapped into panHistogram[0], and values above will be mapped into
- * panHistogram[nBuckets-1] otherwise out of range values are discarded.
- * @param bApproxOK TRUE if an approximate, or incomplete histogram OK.
- * @param pfnProgress function to report progress to completion.
- * @param pProgressData application data to pass to pfnProgress.
- *
- * @return CE_None on success, or CE_Failure if something goes wrong.
- */
+// Return the global thread pool if GDAL_NUM_THREADS allows to use more than
+// one thread and that there is more than one block to process.
+static CPLWorkerThreadPool *GDALGetStatisticsThreadPool(GIntBig nTotalBlocks,
+                                                        int nSampleRate,
+                                                        int &nThreads)
+{
+    const GIntBig nSampledBlocks =
+        (nTotalBlocks + nSampleRate - 1) / nSampleRate;
+    nThreads = 1;
+    if (nSampledBlocks <= 1)
+        return nullptr;
+    nThreads = GDALGetNumThreads(
+        static_cast<int>(std::min<GIntBig>(128, nSampledBlocks)));
+    return nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+}
 
-CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
-                                    GUIntBig *panHistogram,
-                                    int bIncludeOutOfRange, int bApproxOK,
-                                    GDALProgressFunc pfnProgress,
-                                    void *pProgressData)
+/************************************************************************/
+/*                      GDALComputeOverBlocksMT()                       */
+/************************************************************************/
 
+// Process the sampled blocks of poBand with a thread pool.
+// Blocks and the corresponding mask values are read on the calling thread,
+// since drivers are generally not thread-safe, and are handed to worker
+// threads that compute a partial accumulator per block with computeFunc().
+// Partial accumulators are merged into oAcc in block order, so that the
+// result does not depend on job scheduling, nor on the number of threads.
+template <class Accumulator, class ComputeFunc>
+static bool GDALComputeOverBlocksMT(
+    GDALRasterBand *poBand, GDALRasterBand *poMaskBand,
+    CPLWorkerThreadPool *poThreadPool, int nThreads, GIntBig nTotalBlocks,
+    int nSampleRate, const ComputeFunc &computeFunc, Accumulator &oAcc,
+    GDALProgressFunc pfnProgress, void *pProgressData,
+    const char *pszProgressMsg)
 {
-    CPLAssert(nullptr != panHistogram);
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    const int nBlocksPerRow = DIV_ROUND_UP(poBand->GetXSize(), nBlockXSize);
 
-    if (pfnProgress == nullptr)
-        pfnProgress = GDALDummyProgress;
+    // Blocks stay locked until their job is finalized: bound their number
+    // so that they use at most a quarter of the block cache.
+    const GIntBig nBlockBytes = std::max<GIntBig>(
+        1, static_cast<GIntBig>(nBlockXSize) * nBlockYSize *
+               GDALGetDataTypeSizeBytes(poBand->GetRasterDataType()));
+    const size_t nMaxJobs = static_cast<size_t>(
+        std::max<GIntBig>(nThreads, std::min<GIntBig>(4 * nThreads,
+                                                      GDALGetCacheMax64() /
+                                                          4 / nBlockBytes)));
 
-    /* -------------------------------------------------------------------- */
-    /*      If we have overviews, use them for the histogram.               */
-    /* -------------------------------------------------------------------- */
-    if (bApproxOK && GetOverviewCount() > 0 && !HasArbitraryOverviews())
+    struct Job
     {
-        // FIXME: should we use the most reduced overview here or use some
-        // minimum number of samples like GDALRasterBand::ComputeStatistics()
-        // does?
-        GDALRasterBand *poBestOverview = GetRasterSampleOverview(0);
+        CPL_DISALLOW_COPY_ASSIGN(Job)
 
-        if (poBestOverview != this)
+        GDALRasterBlock *poBlock = nullptr;
+        std::vector<GByte> abyMask{};
+        int nXCheck = 0;
+        int nYCheck = 0;
+        Accumulator oAcc;
+
+        explicit Job(const Accumulator &oInitAcc) : oAcc(oInitAcc)
         {
-            return poBestOverview->GetHistogram(
-                dfMin, dfMax, nBuckets, panHistogram, bIncludeOutOfRange,
-                bApproxOK, pfnProgress, pProgressData);
+        }
+
+        void NotifyFinished()
+        {
+            std::lock_guard guard(mutex);
+            bFinished = true;
+            cv.notify_one();
+        }
+
+        void WaitFinished()
+        {
+            std::unique_lock oGuard(mutex);
+            while (!bFinished)
+            {
+                cv.wait(oGuard);
+            }
+        }
+
+      private:
+        bool bFinished = false;
+        std::mutex mutex{};
+        std::condition_variable cv{};
+    };
+
+    const Accumulator oInitAcc(oAcc);
+    std::deque<std::unique_ptr<Job>> jobList;
+    auto poJobQueue = poThreadPool->CreateJobQueue();
+
+    const auto FinalizeOldestJob = [&jobList, &oAcc]()
+    {
+        Job *poJob = jobList.front().get();
+        poJob->WaitFinished();
+        oAcc.Merge(poJob->oAcc);
+        poJob->poBlock->DropLock();
+        jobList.pop_front();
+    };
+
+    bool bRet = true;
+    for (GIntBig iSampleBlock = 0; iSampleBlock < nTotalBlocks;
+         iSampleBlock += nSampleRate)
+    {
+        while (jobList.size() >= nMaxJobs)
+            FinalizeOldestJob();
+
+        const int iYBlock = static_cast<int>(iSampleBlock / nBlocksPerRow);
+        const int iXBlock = static_cast<int>(iSampleBlock % nBlocksPerRow);
+
+        auto poJob = std::make_unique<Job>(oInitAcc);
+        poBand->GetActualBlockSize(iXBlock, iYBlock, &poJob->nXCheck,
+                                   &poJob->nYCheck);
+
+        if (poMaskBand)
+        {
+            try
+            {
+                poJob->abyMask.resize(static_cast<size_t>(nBlockXSize) *
+                                      poJob->nYCheck);
+            }
+            catch (const std::bad_alloc &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Out of memory allocating mask buffer");
+                bRet = false;
+                break;
+            }
+            if (poMaskBand->RasterIO(
+                    GF_Read, iXBlock * nBlockXSize, iYBlock * nBlockYSize,
+                    poJob->nXCheck, poJob->nYCheck, poJob->abyMask.data(),
+                    poJob->nXCheck, poJob->nYCheck, GDT_Byte, 0, nBlockXSize,
+                    nullptr) != CE_None)
+            {
+                bRet = false;
+                break;
+            }
+        }
+
+        poJob->poBlock = poBand->GetLockedBlockRef(iXBlock, iYBlock);
+        if (poJob->poBlock == nullptr)
+        {
+            bRet = false;
+            break;
+        }
+
+        Job *poJobRaw = poJob.get();
+        jobList.push_back(std::move(poJob));
+        const auto task = [poJobRaw, &computeFunc, nBlockXSize]()
+        {
+            computeFunc(poJobRaw->poBlock->GetDataRef(),
+                        poJobRaw->abyMask.empty() ? nullptr
+                                                  : poJobRaw->abyMask.data(),
+                        poJobRaw->nXCheck, poJobRaw->nYCheck, nBlockXSize,
+                        poJobRaw->oAcc);
+            poJobRaw->NotifyFinished();
+        };
+        if (!poJobQueue->SubmitJob(task))
+            task();
+
+        if (!pfnProgress(static_cast<double>(iSampleBlock) /
+                             static_cast<double>(nTotalBlocks),
+                         pszProgressMsg, pProgressData))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            bRet = false;
+            break;
         }
     }
 
-    /* -------------------------------------------------------------------- */
-    /*      Read actual data and build histogram.                           */
-    /* -------------------------------------------------------------------- */
-    if (!pfnProgress(0.0, "Compute Histogram", pProgressData))
+    while (!jobList.empty())
+        FinalizeOldestJob();
+
+    return bRet;
+}
+
+/************************************************************************/
+/*                       GDALHistogramParams                            */
+/************************************************************************/
+
+namespace
+{
+// Parameters of the block-based computation of GetHistogram()
+struct GDALHistogramParams
+{
+    GDALDataType eDataType = GDT_Unknown;
+    bool bSignedByte = false;
+    const GDALNoDataValues *psNoDataValues = nullptr;
+    double dfMin = 0;
+    double dfScale = 0;
+    int nBuckets = 0;
+    bool bIncludeOutOfRange = false;
+
+    // For Byte, Int8, UInt16 and Int16: bucket index for each possible
+    // value (indexed by its unsigned representation), or -1 if the value
+    // must be ignored.
+    std::vector<int> anLUT{};
+
+    // Return the bucket index of dfValue, or -1 if it must be ignored.
+    // dfValue is assumed not to be NaN.
+    inline int GetBucket(double dfValue) const
     {
-        ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-        return CE_Failure;
+        // Given that dfValue and dfMin are not NaN, and dfScale > 0
+        // and finite, the result of the multiplication cannot be NaN
+        const double dfIndex = floor((dfValue - dfMin) * dfScale);
+
+        if (dfIndex < 0)
+        {
+            return bIncludeOutOfRange ? 0 : -1;
+        }
+        else if (dfIndex >= nBuckets)
+        {
+            return bIncludeOutOfRange ? nBuckets - 1 : -1;
+        }
+        return static_cast<int>(dfIndex);
     }
 
-    // Written this way to deal with NaN
-    if (!(dfMax > dfMin))
+    void BuildLUT();
+};
+
+/************************************************************************/
+/*                     GDALHistogramParams::BuildLUT()                  */
+/************************************************************************/
+
+void GDALHistogramParams::BuildLUT()
+{
+    const int nValues =
+        (eDataType == GDT_Byte || eDataType == GDT_Int8) ? 256 : 65536;
+    anLUT.resize(nValues);
+    for (int i = 0; i < nValues; ++i)
     {
-        ReportError(CE_Failure, CPLE_IllegalArg,
-                    "dfMax should be strictly greater than dfMin");
-        return CE_Failure;
+        double dfValue = 0;
+        switch (eDataType)
+        {
+            case GDT_Byte:
+                dfValue = bSignedByte ? static_cast<signed char>(i) : i;
+                break;
+            case GDT_Int8:
+                dfValue = static_cast<GInt8>(i);
+                break;
+            case GDT_Int16:
+                dfValue = static_cast<GInt16>(i);
+                break;
+            default:
+                dfValue = i;
+                break;
+        }
+        if (psNoDataValues->bGotNoDataValue &&
+            ARE_REAL_EQUAL(dfValue, psNoDataValues->dfNoDataValue))
+        {
+            anLUT[i] = -1;
+        }
+        else
+        {
+            anLUT[i] = GetBucket(dfValue);
+        }
     }
+}
 
-    GDALRasterIOExtraArg sExtraArg;
-    INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+/************************************************************************/
+/*                    GDALPartialHistogramPool                          */
+/************************************************************************/
 
-    const double dfScale = nBuckets / (dfMax - dfMin);
-    if (dfScale == 0 || !std::isfinite(dfScale))
+// Bucket arrays used by the multi-threaded code path of GetHistogram(). Each
+// running job acquires an array for its exclusive use and releases it when
+// done, so there are at most as many arrays as concurrently running jobs,
+// and not one per block. Bucket counts are integers, so the order in which
+// blocks are accumulated into a given array does not matter.
+class GDALPartialHistogramPool
+{
+    std::mutex m_oMutex{};
+    const int m_nBuckets;
+    std::vector<std::unique_ptr<GUIntBig[]>> m_apanAll{};
+    std::vector<GUIntBig *> m_apanFree{};
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALPartialHistogramPool)
+
+  public:
+    explicit GDALPartialHistogramPool(int nBuckets) : m_nBuckets(nBuckets)
     {
-        ReportError(CE_Failure, CPLE_IllegalArg,
-                    "dfMin and dfMax should be finite values such that "
-                    "nBuckets / (dfMax - dfMin) is non-zero");
-        return CE_Failure;
     }
-    memset(panHistogram, 0, sizeof(GUIntBig) * nBuckets);
 
-    GDALNoDataValues sNoDataValues(this, eDataType);
-    GDALRasterBand *poMaskBand = nullptr;
-    if (!sNoDataValues.bGotNoDataValue)
+    GUIntBig *Acquire()
     {
-        const int l_nMaskFlags = GetMaskFlags();
-        if (l_nMaskFlags != GMF_ALL_VALID &&
-            GetColorInterpretation() != GCI_AlphaBand)
+        std::lock_guard oLock(m_oMutex);
+        if (!m_apanFree.empty())
         {
-            poMaskBand = GetMaskBand();
+            GUIntBig *panRet = m_apanFree.back();
+            m_apanFree.pop_back();
+            return panRet;
         }
+        std::unique_ptr<GUIntBig[]> panNew(new (std::nothrow)
+                                               GUIntBig[m_nBuckets]());
+        if (!panNew)
+            return nullptr;
+        m_apanAll.push_back(std::move(panNew));
+        return m_apanAll.back().get();
     }
 
-    bool bSignedByte = false;
-    if (eDataType == GDT_Byte)
+    void Release(GUIntBig *panHistogram)
     {
-        EnablePixelTypeSignedByteWarning(false);
-        const char *pszPixelType =
-            GetMetadataItem("PIXELTYPE", "IMAGE_STRUCTURE");
-        EnablePixelTypeSignedByteWarning(true);
-        bSignedByte =
-            pszPixelType != nullptr && EQUAL(pszPixelType, "SIGNEDBYTE");
+        std::lock_guard oLock(m_oMutex);
+        m_apanFree.push_back(panHistogram);
     }
 
-    if (bApproxOK && HasArbitraryOverviews())
+    void MergeInto(GUIntBig *panHistogram) const
     {
-        /* --------------------------------------------------------------------
-         */
-        /*      Figure out how much the image should be reduced to get an */
-        /*      approximate value. */
-        /* --------------------------------------------------------------------
-         */
-        const double dfReduction =
-            sqrt(static_cast<double>(nRasterXSize) * nRasterYSize /
-                 GDALSTAT_APPROX_NUMSAMPLES);
-
-        int nXReduced = nRasterXSize;
-        int nYReduced = nRasterYSize;
-        if (dfReduction > 1.0)
+        for (const auto &panPartial : m_apanAll)
         {
-            nXReduced = static_cast<int>(nRasterXSize / dfReduction);
-            nYReduced = static_cast<int>(nRasterYSize / dfReduction);
-
-            // Catch the case of huge resizing ratios here
-            if (nXReduced == 0)
-                nXReduced = 1;
-            if (nYReduced == 0)
-                nYReduced = 1;
+            for (int i = 0; i < m_nBuckets; ++i)
+                panHistogram[i] += panPartial[i];
         }
+    }
+};
 
-        void *pData = VSI_MALLOC3_VERBOSE(GDALGetDataTypeSizeBytes(eDataType),
-                                          nXReduced, nYReduced);
-        if (!pData)
-            return CE_Failure;
+// Accumulator of GDALComputeOverBlocksMT() for GetHistogram(): buckets are
+// accumulated in GDALPartialHistogramPool, so only track allocation failures.
+struct GDALHistogramJobAccumulator
+{
+    bool bOK = true;
 
-        const CPLErr eErr =
-            IRasterIO(GF_Read, 0, 0, nRasterXSize, nRasterYSize, pData,
-                      nXReduced, nYReduced, eDataType, 0, 0, &sExtraArg);
-        if (eErr != CE_None)
+    void Merge(const GDALHistogramJobAccumulator &other)
+    {
+        bOK = bOK && other.bOK;
+    }
+};
+
+}  // namespace
+
+/************************************************************************/
+/*                      GDALHistogramWithLUT()                          */
+/************************************************************************/
+
+// T is the unsigned type with the same size as the band data type.
+template <class T>
+static void GDALHistogramWithLUT(const GDALHistogramParams &sParams,
+                                 const T *pData, const GByte *pabyMaskData,
+                                 int nXCheck, int nYCheck, int nBufferWidth,
+                                 GUIntBig *panHistogram)
+{
+    const int *panLUT = sParams.anLUT.data();
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        const T *pLine = pData + static_cast<size_t>(iY) * nBufferWidth;
+        if (pabyMaskData)
         {
-            CPLFree(pData);
-            return eErr;
+            const GByte *pabyMaskLine =
+                pabyMaskData + static_cast<size_t>(iY) * nBufferWidth;
+            for (int iX = 0; iX < nXCheck; iX++)
+            {
+                if (pabyMaskLine[iX])
+                {
+                    const int nIdx = panLUT[pLine[iX]];
+                    if (nIdx >= 0)
+                        ++panHistogram[nIdx];
+                }
+            }
         }
-
-        GByte *pabyMaskData = nullptr;
-        if (poMaskBand)
+        else
         {
-            pabyMaskData =
-                static_cast<GByte *>(VSI_MALLOC2_VERBOSE(nXReduced, nYReduced));
-            if (!pabyMaskData)
+            for (int iX = 0; iX < nXCheck; iX++)
             {
-                CPLFree(pData);
-                return CE_Failure;
+                const int nIdx = panLUT[pLine[iX]];
+                if (nIdx >= 0)
+                    ++panHistogram[nIdx];
             }
+        }
+    }
+}
 
-            if (poMaskBand->RasterIO(GF_Read, 0, 0, nRasterXSize, nRasterYSize,
+/************************************************************************/
+/*                      GDALHistogramFloat32()                          */
+/************************************************************************/
+
+template <bool HAS_NODATA>
+static void GDALHistogramFloat32(const GDALHistogramParams &sParams,
+                                 const float *pafData,
+                                 const GByte *pabyMaskData, int nXCheck,
+                                 int nYCheck, int nBufferWidth,
+                                 GUIntBig *panHistogram)
+{
+    const double dfMin = sParams.dfMin;
+    const double dfScale = sParams.dfScale;
+    const int nBuckets = sParams.nBuckets;
+    const double dfBuckets = nBuckets;
+    const bool bIncludeOutOfRange = sParams.bIncludeOutOfRange;
+    const float fNoDataValue = sParams.psNoDataValues->fNoDataValue;
+
+    // dfIndex = (fValue - dfMin) * dfScale, computed exactly as in the
+    // generic code path. Since floor(dfIndex) >= 0 <==> dfIndex >= 0, and
+    // floor(dfIndex) >= nBuckets <==> dfIndex >= nBuckets, we can avoid
+    // calling floor(). NaN values fail all comparisons.
+    const auto AddValue =
+        [panHistogram, nBuckets, dfBuckets, bIncludeOutOfRange,
+         fNoDataValue](float fValue, double dfIndex)
+    {
+        if (HAS_NODATA && ARE_REAL_EQUAL(fValue, fNoDataValue))
+            return;
+        if (dfIndex >= 0 && dfIndex < dfBuckets)
+        {
+            ++panHistogram[static_cast<int>(dfIndex)];
+        }
+        else if (bIncludeOutOfRange)
+        {
+            if (dfIndex < 0)
+                ++panHistogram[0];
+            else if (dfIndex >= dfBuckets)
+                ++panHistogram[nBuckets - 1];
+        }
+    };
+
+#ifdef USE_SSE2
+    const auto oMin = XMMReg2Double::Set1(dfMin);
+    const auto oScale = XMMReg2Double::Set1(dfScale);
+#endif
+
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        const float *pafLine =
+            pafData + static_cast<size_t>(iY) * nBufferWidth;
+        const GByte *pabyMaskLine =
+            pabyMaskData ? pabyMaskData + static_cast<size_t>(iY) * nBufferWidth
+                         : nullptr;
+        int iX = 0;
+#ifdef USE_SSE2
+        for (; iX + 3 < nXCheck; iX += 4)
+        {
+            const auto oIdx0 =
+                (XMMReg2Double::Load2Val(pafLine + iX) - oMin) * oScale;
+            const auto oIdx1 =
+                (XMMReg2Double::Load2Val(pafLine + iX + 2) - oMin) * oScale;
+            double adfIndex[4];
+            oIdx0.Store2Val(adfIndex);
+            oIdx1.Store2Val(adfIndex + 2);
+            for (int j = 0; j < 4; ++j)
+            {
+                if (!pabyMaskLine || pabyMaskLine[iX + j])
+                    AddValue(pafLine[iX + j], adfIndex[j]);
+            }
+        }
+#endif
+        for (; iX < nXCheck; iX++)
+        {
+            if (!pabyMaskLine || pabyMaskLine[iX])
+            {
+                const float fValue = pafLine[iX];
+                AddValue(fValue, (double(fValue) - dfMin) * dfScale);
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                      GDALHistogramGeneric()                          */
+/************************************************************************/
+
+static void GDALHistogramGeneric(const GDALHistogramParams &sParams,
+                                 const void *pData, const GByte *pabyMaskData,
+                                 int nXCheck, int nYCheck, int nBufferWidth,
+                                 GUIntBig *panHistogram)
+{
+    const GDALDataType eDataType = sParams.eDataType;
+    const bool bSignedByte = sParams.bSignedByte;
+    const GDALNoDataValues &sNoDataValues = *(sParams.psNoDataValues);
+
+    // This isn't the fastest way to do this, but is easier for now.
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        for (int iX = 0; iX < nXCheck; iX++)
+        {
+            const GPtrDiff_t iOffset =
+                iX + static_cast<GPtrDiff_t>(iY) * nBufferWidth;
+
+            if (pabyMaskData && pabyMaskData[iOffset] == 0)
+                continue;
+
+            double dfValue = 0.0;
+
+            switch (eDataType)
+            {
+                case GDT_Byte:
+                {
+                    if (bSignedByte)
+                        dfValue =
+                            static_cast<const signed char *>(pData)[iOffset];
+                    else
+                        dfValue = static_cast<const GByte *>(pData)[iOffset];
+                    break;
+                }
+                case GDT_Int8:
+                    dfValue = static_cast<const GInt8 *>(pData)[iOffset];
+                    break;
+                case GDT_UInt16:
+                    dfValue = static_cast<const GUInt16 *>(pData)[iOffset];
+                    break;
+                case GDT_Int16:
+                    dfValue = static_cast<const GInt16 *>(pData)[iOffset];
+                    break;
+                case GDT_UInt32:
+                    dfValue = static_cast<const GUInt32 *>(pData)[iOffset];
+                    break;
+                case GDT_Int32:
+                    dfValue = static_cast<const GInt32 *>(pData)[iOffset];
+                    break;
+                case GDT_UInt64:
+                    dfValue = static_cast<double>(
+                        static_cast<const GUInt64 *>(pData)[iOffset]);
+                    break;
+                case GDT_Int64:
+                    dfValue = static_cast<double>(
+                        static_cast<const GInt64 *>(pData)[iOffset]);
+                    break;
+                case GDT_Float16:
+                {
+                    using namespace std;
+                    const GFloat16 hfValue =
+                        static_cast<const GFloat16 *>(pData)[iOffset];
+                    if (isnan(hfValue) ||
+                        (sNoDataValues.bGotFloat16NoDataValue &&
+                         ARE_REAL_EQUAL(hfValue, sNoDataValues.hfNoDataValue)))
+                        continue;
+                    dfValue = hfValue;
+                    break;
+                }
+                case GDT_Float32:
+                {
+                    const float fValue =
+                        static_cast<const float *>(pData)[iOffset];
+                    if (std::isnan(fValue) ||
+                        (sNoDataValues.bGotFloatNoDataValue &&
+                         ARE_REAL_EQUAL(fValue, sNoDataValues.fNoDataValue)))
+                        continue;
+                    dfValue = double(fValue);
+                    break;
+                }
+                case GDT_Float64:
+                    dfValue = static_cast<const double *>(pData)[iOffset];
+                    if (std::isnan(dfValue))
+                        continue;
+                    break;
+                case GDT_CInt16:
+                {
+                    double dfReal =
+                        static_cast<const GInt16 *>(pData)[iOffset * 2];
+                    double dfImag =
+                        static_cast<const GInt16 *>(pData)[iOffset * 2 + 1];
+                    dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
+                    break;
+                }
+                case GDT_CInt32:
+                {
+                    double dfReal =
+                        static_cast<const GInt32 *>(pData)[iOffset * 2];
+                    double dfImag =
+                        static_cast<const GInt32 *>(pData)[iOffset * 2 + 1];
+                    dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
+                    break;
+                }
+                case GDT_CFloat16:
+                {
+                    double dfReal =
+                        static_cast<const GFloat16 *>(pData)[iOffset * 2];
+                    double dfImag =
+                        static_cast<const GFloat16 *>(pData)[iOffset * 2 + 1];
+                    if (std::isnan(dfReal) || std::isnan(dfImag))
+                        continue;
+                    dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
+                    break;
+                }
+                case GDT_CFloat32:
+                {
+                    double dfReal =
+                        double(static_cast<const float *>(pData)[iOffset * 2]);
+                    double dfImag = double(
+                        static_cast<const float *>(pData)[iOffset * 2 + 1]);
+                    if (std::isnan(dfReal) || std::isnan(dfImag))
+                        continue;
+                    dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
+                    break;
+                }
+                case GDT_CFloat64:
+                {
+                    double dfReal =
+                        static_cast<const double *>(pData)[iOffset * 2];
+                    double dfImag =
+                        static_cast<const double *>(pData)[iOffset * 2 + 1];
+                    if (std::isnan(dfReal) || std::isnan(dfImag))
+                        continue;
+                    dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
+                    break;
+                }
+                case GDT_Unknown:
+                case GDT_TypeCount:
+                    CPLAssert(false);
+                    return;
+            }
+
+            if (eDataType != GDT_Float16 && eDataType != GDT_Float32 &&
+                sNoDataValues.bGotNoDataValue &&
+                ARE_REAL_EQUAL(dfValue, sNoDataValues.dfNoDataValue))
+                continue;
+
+            const int nIdx = sParams.GetBucket(dfValue);
+            if (nIdx >= 0)
+                ++panHistogram[nIdx];
+        }
+    }
+}
+
+/************************************************************************/
+/*                     GDALComputeHistogramForBlock()                   */
+/************************************************************************/
+
+static void GDALComputeHistogramForBlock(const GDALHistogramParams &sParams,
+                                         const void *pData,
+                                         const GByte *pabyMaskData,
+                                         int nXCheck, int nYCheck,
+                                         int nBufferWidth,
+                                         GUIntBig *panHistogram)
+{
+    if (!sParams.anLUT.empty())
+    {
+        if (sParams.eDataType == GDT_Byte || sParams.eDataType == GDT_Int8)
+        {
+            GDALHistogramWithLUT(sParams, static_cast<const GByte *>(pData),
+                                 pabyMaskData, nXCheck, nYCheck, nBufferWidth,
+                                 panHistogram);
+        }
+        else
+        {
+            GDALHistogramWithLUT(sParams, static_cast<const GUInt16 *>(pData),
+                                 pabyMaskData, nXCheck, nYCheck, nBufferWidth,
+                                 panHistogram);
+        }
+    }
+    else if (sParams.eDataType == GDT_Float32)
+    {
+        if (sParams.psNoDataValues->bGotFloatNoDataValue)
+        {
+            GDALHistogramFloat32<true>(
+                sParams, static_cast<const float *>(pData), pabyMaskData,
+                nXCheck, nYCheck, nBufferWidth, panHistogram);
+        }
+        else
+        {
+            GDALHistogramFloat32<false>(
+                sParams, static_cast<const float *>(pData), pabyMaskData,
+                nXCheck, nYCheck, nBufferWidth, panHistogram);
+        }
+    }
+    else
+    {
+        GDALHistogramGeneric(sParams, pData, pabyMaskData, nXCheck, nYCheck,
+                             nBufferWidth, panHistogram);
+    }
+}
+
+/************************************************************************/
+/*                            GetHistogram()                            */
+/************************************************************************/
+
+/**
+ * \brief Compute raster histogram.
+ *
+ * Note that the bucket size is (dfMax-dfMin) / nBuckets.
+ *
+ * For example to compute a simple 256 entry histogram of eight bit data,
+ * the following would be suitable.  The unusual bounds are to ensure that
+ * bucket boundaries don't fall right on integer values causing possible errors
+ * due to rounding after scaling.
+\code{.cpp}
+    GUIntBig anHistogram[256];
+
+    poBand->GetHistogram( -0.5, 255.5, 256, anHistogram, FALSE, FALSE,
+                          GDALDummyProgress, nullptr );
+\endcode
+ *
+ * Note that setting bApproxOK will generally result in a subsampling of the
+ * file, and will utilize overviews if available.  It should generally
+ * produce a representative histogram for the data that is suitable for use
+ * in generating histogram based luts for instance.  Generally bApproxOK is
+ * much faster than an exactly computed histogram.
+ *
+ * Starting with GDAL 3.12, the GDAL_NUM_THREADS configuration option can be
+ * set to a number of threads or ALL_CPUS to process blocks with several
+ * threads. Blocks are still read by the calling thread. The result does not
+ * depend on the number of threads.
+ *
+ * This method is the same as the C functions GDALGetRasterHistogram() and
+ * GDALGetRasterHistogramEx().
+ *
+ * @param dfMin the lower bound of the histogram.
+ * @param dfMax the upper bound of the histogram.
+ * @param nBuckets the number of buckets in panHistogram.
+ * @param panHistogram array into which the histogram totals are placed.
+ * @param bIncludeOutOfRange if TRUE values below the histogram range will
+ * mapped into panHistogram[0], and values above will be mapped into
+ * panHistogram[nBuckets-1] otherwise out of range values are discarded.
+ * @param bApproxOK TRUE if an approximate, or incomplete histogram OK.
+ * @param pfnProgress function to report progress to completion.
+ * @param pProgressData application data to pass to pfnProgress.
+ *
+ * @return CE_None on success, or CE_Failure if something goes wrong.
+ */
+
+CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
+                                    GUIntBig *panHistogram,
+                                    int bIncludeOutOfRange, int bApproxOK,
+                                    GDALProgressFunc pfnProgress,
+                                    void *pProgressData)
+
+{
+    CPLAssert(nullptr != panHistogram);
+
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
+
+    /* -------------------------------------------------------------------- */
+    /*      If we have overviews, use them for the histogram.               */
+    /* -------------------------------------------------------------------- */
+    if (bApproxOK && GetOverviewCount() > 0 && !HasArbitraryOverviews())
+    {
+        // FIXME: should we use the most reduced overview here or use some
+        // minimum number of samples like GDALRasterBand::ComputeStatistics()
+        // does?
+        GDALRasterBand *poBestOverview = GetRasterSampleOverview(0);
+
+        if (poBestOverview != this)
+        {
+            return poBestOverview->GetHistogram(
+                dfMin, dfMax, nBuckets, panHistogram, bIncludeOutOfRange,
+                bApproxOK, pfnProgress, pProgressData);
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Read actual data and build histogram.                           */
+    /* -------------------------------------------------------------------- */
+    if (!pfnProgress(0.0, "Compute Histogram", pProgressData))
+    {
+        ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return CE_Failure;
+    }
+
+    // Written this way to deal with NaN
+    if (!(dfMax > dfMin))
+    {
+        ReportError(CE_Failure, CPLE_IllegalArg,
+                    "dfMax should be strictly greater than dfMin");
+        return CE_Failure;
+    }
+
+    GDALRasterIOExtraArg sExtraArg;
+    INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+
+    const double dfScale = nBuckets / (dfMax - dfMin);
+    if (dfScale == 0 || !std::isfinite(dfScale))
+    {
+        ReportError(CE_Failure, CPLE_IllegalArg,
+                    "dfMin and dfMax should be finite values such that "
+                    "nBuckets / (dfMax - dfMin) is non-zero");
+        return CE_Failure;
+    }
+    memset(panHistogram, 0, sizeof(GUIntBig) * nBuckets);
+
+    GDALNoDataValues sNoDataValues(this, eDataType);
+    GDALRasterBand *poMaskBand = nullptr;
+    if (!sNoDataValues.bGotNoDataValue)
+    {
+        const int l_nMaskFlags = GetMaskFlags();
+        if (l_nMaskFlags != GMF_ALL_VALID &&
+            GetColorInterpretation() != GCI_AlphaBand)
+        {
+            poMaskBand = GetMaskBand();
+        }
+    }
+
+    bool bSignedByte = false;
+    if (eDataType == GDT_Byte)
+    {
+        EnablePixelTypeSignedByteWarning(false);
+        const char *pszPixelType =
+            GetMetadataItem("PIXELTYPE", "IMAGE_STRUCTURE");
+        EnablePixelTypeSignedByteWarning(true);
+        bSignedByte =
+            pszPixelType != nullptr && EQUAL(pszPixelType, "SIGNEDBYTE");
+    }
+
+    if (bApproxOK && HasArbitraryOverviews())
+    {
+        /* --------------------------------------------------------------------
+         */
+        /*      Figure out how much the image should be reduced to get an */
+        /*      approximate value. */
+        /* --------------------------------------------------------------------
+         */
+        const double dfReduction =
+            sqrt(static_cast<double>(nRasterXSize) * nRasterYSize /
+                 GDALSTAT_APPROX_NUMSAMPLES);
+
+        int nXReduced = nRasterXSize;
+        int nYReduced = nRasterYSize;
+        if (dfReduction > 1.0)
+        {
+            nXReduced = static_cast<int>(nRasterXSize / dfReduction);
+            nYReduced = static_cast<int>(nRasterYSize / dfReduction);
+
+            // Catch the case of huge resizing ratios here
+            if (nXReduced == 0)
+                nXReduced = 1;
+            if (nYReduced == 0)
+                nYReduced = 1;
+        }
+
+        void *pData = VSI_MALLOC3_VERBOSE(GDALGetDataTypeSizeBytes(eDataType),
+                                          nXReduced, nYReduced);
+        if (!pData)
+            return CE_Failure;
+
+        const CPLErr eErr =
+            IRasterIO(GF_Read, 0, 0, nRasterXSize, nRasterYSize, pData,
+                      nXReduced, nYReduced, eDataType, 0, 0, &sExtraArg);
+        if (eErr != CE_None)
+        {
+            CPLFree(pData);
+            return eErr;
+        }
+
+        GByte *pabyMaskData = nullptr;
+        if (poMaskBand)
+        {
+            pabyMaskData =
+                static_cast<GByte *>(VSI_MALLOC2_VERBOSE(nXReduced, nYReduced));
+            if (!pabyMaskData)
+            {
+                CPLFree(pData);
+                return CE_Failure;
+            }
+
+            if (poMaskBand->RasterIO(GF_Read, 0, 0, nRasterXSize, nRasterYSize,
                                      pabyMaskData, nXReduced, nYReduced,
                                      GDT_Byte, 0, 0, nullptr) != CE_None)
             {
@@ -4507,252 +5180,133 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                 nSampleRate += 1;
         }
 
-        GByte *pabyMaskData = nullptr;
-        if (poMaskBand)
-        {
-            pabyMaskData = static_cast<GByte *>(
-                VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
-            if (!pabyMaskData)
-            {
-                return CE_Failure;
-            }
-        }
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Read the blocks, and add to histogram. */
-        /* --------------------------------------------------------------------
-         */
-        for (GIntBig iSampleBlock = 0;
-             iSampleBlock <
-             static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
-             iSampleBlock += nSampleRate)
-        {
-            if (!pfnProgress(
-                    static_cast<double>(iSampleBlock) /
-                        (static_cast<double>(nBlocksPerRow) * nBlocksPerColumn),
-                    "Compute Histogram", pProgressData))
+        const GIntBig nTotalBlocks =
+            static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
+
+        GDALHistogramParams sParams;
+        sParams.eDataType = eDataType;
+        sParams.bSignedByte = bSignedByte;
+        sParams.psNoDataValues = &sNoDataValues;
+        sParams.dfMin = dfMin;
+        sParams.dfScale = dfScale;
+        sParams.nBuckets = nBuckets;
+        sParams.bIncludeOutOfRange = CPL_TO_BOOL(bIncludeOutOfRange);
+
+        // For 8-bit and 16-bit integer data types, precompute the bucket of
+        // each possible value, when that is cheaper than computing it for
+        // each pixel.
+        if (eDataType == GDT_Byte || eDataType == GDT_Int8 ||
+            ((eDataType == GDT_UInt16 || eDataType == GDT_Int16) &&
+             (nTotalBlocks / nSampleRate) * nBlockXSize * nBlockYSize >=
+                 65536))
+        {
+            sParams.BuildLUT();
+        }
+
+        int nThreads = 1;
+        CPLWorkerThreadPool *const poThreadPool =
+            GDALGetStatisticsThreadPool(nTotalBlocks, nSampleRate, nThreads);
+        if (poThreadPool)
+        {
+            GDALPartialHistogramPool oPool(nBuckets);
+            const auto ComputeForBlock =
+                [&sParams, &oPool](const void *pData,
+                                   const GByte *pabyMaskData, int nXCheck,
+                                   int nYCheck, int nBufferWidth,
+                                   GDALHistogramJobAccumulator &oJobAcc)
             {
-                CPLFree(pabyMaskData);
-                return CE_Failure;
-            }
-
-            const int iYBlock = static_cast<int>(iSampleBlock / nBlocksPerRow);
-            const int iXBlock = static_cast<int>(iSampleBlock % nBlocksPerRow);
-
-            int nXCheck = 0, nYCheck = 0;
-            GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-            if (poMaskBand &&
-                poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
-                                     iYBlock * nBlockYSize, nXCheck, nYCheck,
-                                     pabyMaskData, nXCheck, nYCheck, GDT_Byte,
-                                     0, nBlockXSize, nullptr) != CE_None)
+                GUIntBig *panPartialHistogram = oPool.Acquire();
+                if (!panPartialHistogram)
+                {
+                    oJobAcc.bOK = false;
+                    return;
+                }
+                GDALComputeHistogramForBlock(sParams, pData, pabyMaskData,
+                                             nXCheck, nYCheck, nBufferWidth,
+                                             panPartialHistogram);
+                oPool.Release(panPartialHistogram);
+            };
+
+            GDALHistogramJobAccumulator oAcc;
+            if (!GDALComputeOverBlocksMT(this, poMaskBand, poThreadPool,
+                                         nThreads, nTotalBlocks, nSampleRate,
+                                         ComputeForBlock, oAcc, pfnProgress,
+                                         pProgressData, "Compute Histogram"))
             {
-                CPLFree(pabyMaskData);
                 return CE_Failure;
             }
-
-            GDALRasterBlock *poBlock = GetLockedBlockRef(iXBlock, iYBlock);
-            if (poBlock == nullptr)
+            if (!oAcc.bOK)
             {
-                CPLFree(pabyMaskData);
+                ReportError(CE_Failure, CPLE_OutOfMemory,
+                            "Cannot allocate partial histogram");
                 return CE_Failure;
             }
+            oPool.MergeInto(panHistogram);
+        }
+        else
+        {
+            GByte *pabyMaskData = nullptr;
+            if (poMaskBand)
+            {
+                pabyMaskData = static_cast<GByte *>(
+                    VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
+                if (!pabyMaskData)
+                {
+                    return CE_Failure;
+                }
+            }
 
-            void *pData = poBlock->GetDataRef();
-
-            // this is a special case for a common situation.
-            if (eDataType == GDT_Byte && !bSignedByte && dfScale == 1.0 &&
-                (dfMin >= -0.5 && dfMin <= 0.5) && nYCheck == nBlockYSize &&
-                nXCheck == nBlockXSize && nBuckets == 256)
-            {
-                const GPtrDiff_t nPixels =
-                    static_cast<GPtrDiff_t>(nXCheck) * nYCheck;
-                GByte *pabyData = static_cast<GByte *>(pData);
-
-                for (GPtrDiff_t i = 0; i < nPixels; i++)
-                {
-                    if (pabyMaskData && pabyMaskData[i] == 0)
-                        continue;
-                    if (!(sNoDataValues.bGotNoDataValue &&
-                          (pabyData[i] ==
-                           static_cast<GByte>(sNoDataValues.dfNoDataValue))))
-                    {
-                        panHistogram[pabyData[i]]++;
-                    }
-                }
-
-                poBlock->DropLock();
-                continue;  // To next sample block.
-            }
-
-            // This isn't the fastest way to do this, but is easier for now.
-            for (int iY = 0; iY < nYCheck; iY++)
-            {
-                for (int iX = 0; iX < nXCheck; iX++)
-                {
-                    const GPtrDiff_t iOffset =
-                        iX + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
-
-                    if (pabyMaskData && pabyMaskData[iOffset] == 0)
-                        continue;
-
-                    double dfValue = 0.0;
-
-                    switch (eDataType)
-                    {
-                        case GDT_Byte:
-                        {
-                            if (bSignedByte)
-                                dfValue =
-                                    static_cast<signed char *>(pData)[iOffset];
-                            else
-                                dfValue = static_cast<GByte *>(pData)[iOffset];
-                            break;
-                        }
-                        case GDT_Int8:
-                            dfValue = static_cast<GInt8 *>(pData)[iOffset];
-                            break;
-                        case GDT_UInt16:
-                            dfValue = static_cast<GUInt16 *>(pData)[iOffset];
-                            break;
-                        case GDT_Int16:
-                            dfValue = static_cast<GInt16 *>(pData)[iOffset];
-                            break;
-                        case GDT_UInt32:
-                            dfValue = static_cast<GUInt32 *>(pData)[iOffset];
-                            break;
-                        case GDT_Int32:
-                            dfValue = static_cast<GInt32 *>(pData)[iOffset];
-                            break;
-                        case GDT_UInt64:
-                            dfValue = static_cast<double>(
-                                static_cast<GUInt64 *>(pData)[iOffset]);
-                            break;
-                        case GDT_Int64:
-                            dfValue = static_cast<double>(
-                                static_cast<GInt64 *>(pData)[iOffset]);
-                            break;
-                        case GDT_Float16:
-                        {
-                            using namespace std;
-                            const GFloat16 hfValue =
-                                static_cast<GFloat16 *>(pData)[iOffset];
-                            if (isnan(hfValue) ||
-                                (sNoDataValues.bGotFloat16NoDataValue &&
-                                 ARE_REAL_EQUAL(hfValue,
-                                                sNoDataValues.hfNoDataValue)))
-                                continue;
-                            dfValue = hfValue;
-                            break;
-                        }
-                        case GDT_Float32:
-                        {
-                            const float fValue =
-                                static_cast<float *>(pData)[iOffset];
-                            if (std::isnan(fValue) ||
-                                (sNoDataValues.bGotFloatNoDataValue &&
-                                 ARE_REAL_EQUAL(fValue,
-                                                sNoDataValues.fNoDataValue)))
-                                continue;
-                            dfValue = double(fValue);
-                            break;
-                        }
-                        case GDT_Float64:
-                            dfValue = static_cast<double *>(pData)[iOffset];
-                            if (std::isnan(dfValue))
-                                continue;
-                            break;
-                        case GDT_CInt16:
-                        {
-                            double dfReal =
-                                static_cast<GInt16 *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<GInt16 *>(pData)[iOffset * 2 + 1];
-                            dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                            break;
-                        }
-                        case GDT_CInt32:
-                        {
-                            double dfReal =
-                                static_cast<GInt32 *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<GInt32 *>(pData)[iOffset * 2 + 1];
-                            dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                            break;
-                        }
-                        case GDT_CFloat16:
-                        {
-                            double dfReal =
-                                static_cast<GFloat16 *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<GFloat16 *>(pData)[iOffset * 2 + 1];
-                            if (std::isnan(dfReal) || std::isnan(dfImag))
-                                continue;
-                            dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                            break;
-                        }
-                        case GDT_CFloat32:
-                        {
-                            double dfReal = double(
-                                static_cast<float *>(pData)[iOffset * 2]);
-                            double dfImag = double(
-                                static_cast<float *>(pData)[iOffset * 2 + 1]);
-                            if (std::isnan(dfReal) || std::isnan(dfImag))
-                                continue;
-                            dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                            break;
-                        }
-                        case GDT_CFloat64:
-                        {
-                            double dfReal =
-                                static_cast<double *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<double *>(pData)[iOffset * 2 + 1];
-                            if (std::isnan(dfReal) || std::isnan(dfImag))
-                                continue;
-                            dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                            break;
-                        }
-                        case GDT_Unknown:
-                        case GDT_TypeCount:
-                            CPLAssert(false);
-                            CPLFree(pabyMaskData);
-                            return CE_Failure;
-                    }
-
-                    if (eDataType != GDT_Float16 && eDataType != GDT_Float32 &&
-                        sNoDataValues.bGotNoDataValue &&
-                        ARE_REAL_EQUAL(dfValue, sNoDataValues.dfNoDataValue))
-                        continue;
+            /* ----------------------------------------------------------------
+             */
+            /*      Read the blocks, and add to histogram. */
+            /* ----------------------------------------------------------------
+             */
+            for (GIntBig iSampleBlock = 0; iSampleBlock < nTotalBlocks;
+                 iSampleBlock += nSampleRate)
+            {
+                if (!pfnProgress(static_cast<double>(iSampleBlock) /
+                                     static_cast<double>(nTotalBlocks),
+                                 "Compute Histogram", pProgressData))
+                {
+                    CPLFree(pabyMaskData);
+                    return CE_Failure;
+                }
 
-                    // Given that dfValue and dfMin are not NaN, and dfScale > 0
-                    // and finite, the result of the multiplication cannot be
-                    // NaN
-                    const double dfIndex = floor((dfValue - dfMin) * dfScale);
+                const int iYBlock =
+                    static_cast<int>(iSampleBlock / nBlocksPerRow);
+                const int iXBlock =
+                    static_cast<int>(iSampleBlock % nBlocksPerRow);
 
-                    if (dfIndex < 0)
-                    {
-                        if (bIncludeOutOfRange)
-                            panHistogram[0]++;
-                    }
-                    else if (dfIndex >= nBuckets)
-                    {
-                        if (bIncludeOutOfRange)
-                            ++panHistogram[nBuckets - 1];
-                    }
-                    else
-                    {
-                        ++panHistogram[static_cast<int>(dfIndex)];
-                    }
+                int nXCheck = 0, nYCheck = 0;
+                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+
+                if (poMaskBand &&
+                    poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
+                                         iYBlock * nBlockYSize, nXCheck,
+                                         nYCheck, pabyMaskData, nXCheck,
+                                         nYCheck, GDT_Byte, 0, nBlockXSize,
+                                         nullptr) != CE_None)
+                {
+                    CPLFree(pabyMaskData);
+                    return CE_Failure;
                 }
+
+                GDALRasterBlock *poBlock = GetLockedBlockRef(iXBlock, iYBlock);
+                if (poBlock == nullptr)
+                {
+                    CPLFree(pabyMaskData);
+                    return CE_Failure;
+                }
+
+                GDALComputeHistogramForBlock(sParams, poBlock->GetDataRef(),
+                                             pabyMaskData, nXCheck, nYCheck,
+                                             nBlockXSize, panHistogram);
+
+                poBlock->DropLock();
             }
 
-            poBlock->DropLock();
+            CPLFree(pabyMaskData);
         }
-
-        CPLFree(pabyMaskData);
     }
 
     pfnProgress(1.0, "Compute Histogram", pProgressData);
@@ -5909,6 +6463,24 @@ struct ComputeStatisticsInternal<GByte, COMPUTE_OTHER_STATS>
                   GUIntBig &nValidCount)
     {
         const auto nBlockPixels = static_cast<GPtrDiff_t>(nXCheck) * nYCheck;
+        if (bHasNoData && nXCheck == nBlockXSize && nBlockPixels >= 32 &&
+            nMin > nMax)
+        {
+            // Seed nMin and nMax with the first valid value, so that the
+            // vectorized code path below can be used from the first block
+            // (and by the per-block accumulators of the multi-threaded code
+            // path). This does not change the result since that value is
+            // taken into account again below.
+            for (GPtrDiff_t i = 0; i < nBlockPixels; i++)
+            {
+                if (pData[i] != nNoDataValue)
+                {
+                    nMin = pData[i];
+                    nMax = pData[i];
+                    break;
+                }
+            }
+        }
         if (bHasNoData && nXCheck == nBlockXSize && nBlockPixels >= 32 &&
             nMin <= nMax)
         {
@@ -6493,6 +7065,133 @@ void GDALRasterBand::SetValidPercent(GUIntBig nSampleCount,
 
 //! @endcond
 
+/************************************************************************/
+/*                    GDALIntegerStatsAccumulator                       */
+/************************************************************************/
+
+namespace
+{
+// Partial statistics of the Byte/UInt16 code path of ComputeStatistics().
+// All members are integers, so merging is exact.
+struct GDALIntegerStatsAccumulator
+{
+    GUInt32 nMin;
+    GUInt32 nMax = 0;
+    GUIntBig nSum = 0;
+    GUIntBig nSumSquare = 0;
+    GUIntBig nSampleCount = 0;
+    GUIntBig nValidCount = 0;
+
+    explicit GDALIntegerStatsAccumulator(GUInt32 nMaxValueType)
+        : nMin(nMaxValueType)
+    {
+    }
+
+    void Merge(const GDALIntegerStatsAccumulator &other)
+    {
+        nMin = std::min(nMin, other.nMin);
+        nMax = std::max(nMax, other.nMax);
+        nSum += other.nSum;
+        nSumSquare += other.nSumSquare;
+        nSampleCount += other.nSampleCount;
+        nValidCount += other.nValidCount;
+    }
+};
+
+/************************************************************************/
+/*                    GDALWelfordStatsAccumulator                       */
+/************************************************************************/
+
+// Using Welford algorithm:
+// http://en.wikipedia.org/wiki/Algorithms_for_calculating_variance
+// to compute standard deviation in a more numerically robust way than
+// the difference of the sum of square values with the square of the sum.
+// dfMean and dfM2 are updated at each sample.
+// dfM2 is the sum of square of differences to the current mean.
+// Partial accumulators are combined with the parallel algorithm of Chan et al.
+struct GDALWelfordStatsAccumulator
+{
+    double dfMin = std::numeric_limits<double>::infinity();
+    double dfMax = -std::numeric_limits<double>::infinity();
+    double dfMean = 0.0;
+    double dfM2 = 0.0;
+    GUIntBig nSampleCount = 0;
+    GUIntBig nValidCount = 0;
+
+    inline void Insert(double dfValue)
+    {
+        dfMin = std::min(dfMin, dfValue);
+        dfMax = std::max(dfMax, dfValue);
+
+        nValidCount++;
+        if (dfMin == dfMax)
+        {
+            if (nValidCount == 1)
+                dfMean = dfMin;
+        }
+        else
+        {
+            const double dfDelta = dfValue - dfMean;
+            dfMean += dfDelta / nValidCount;
+            dfM2 += dfDelta * (dfValue - dfMean);
+        }
+    }
+
+    void Merge(const GDALWelfordStatsAccumulator &other)
+    {
+        nSampleCount += other.nSampleCount;
+        if (other.nValidCount == 0)
+            return;
+        if (nValidCount == 0)
+        {
+            const auto nSampleCountBackup = nSampleCount;
+            *this = other;
+            nSampleCount = nSampleCountBackup;
+            return;
+        }
+        dfMin = std::min(dfMin, other.dfMin);
+        dfMax = std::max(dfMax, other.dfMax);
+        const double dfN = static_cast<double>(nValidCount);
+        const double dfNOther = static_cast<double>(other.nValidCount);
+        const double dfNTotal = dfN + dfNOther;
+        const double dfDelta = other.dfMean - dfMean;
+        dfMean += dfDelta * (dfNOther / dfNTotal);
+        dfM2 += other.dfM2 + dfDelta * dfDelta * (dfN * dfNOther / dfNTotal);
+        nValidCount += other.nValidCount;
+    }
+};
+
+/************************************************************************/
+/*                     GDALMinMaxAccumulator                            */
+/************************************************************************/
+
+// Partial result of ComputeRasterMinMax()
+struct GDALMinMaxAccumulator
+{
+    GUInt32 nMin;     // used for GByte & GUInt16 cases
+    GUInt32 nMax = 0; // used for GByte & GUInt16 cases
+    GInt16 nMinInt16 = std::numeric_limits<GInt16>::max();
+    GInt16 nMaxInt16 = std::numeric_limits<GInt16>::lowest();
+    double dfMin = std::numeric_limits<double>::infinity();
+    double dfMax = -std::numeric_limits<double>::infinity();
+
+    explicit GDALMinMaxAccumulator(GUInt32 nMaxValueType) : nMin(nMaxValueType)
+    {
+    }
+
+    void Merge(const GDALMinMaxAccumulator &other)
+    {
+        nMin = std::min(nMin, other.nMin);
+        nMax = std::max(nMax, other.nMax);
+        nMinInt16 = std::min(nMinInt16, other.nMinInt16);
+        nMaxInt16 = std::max(nMaxInt16, other.nMaxInt16);
+        dfMin = std::min(dfMin, other.dfMin);
+        dfMax = std::max(dfMax, other.dfMax);
+    }
+};
+
+}  // namespace
+
 /************************************************************************/
 /*                         ComputeStatistics()                          */
 /************************************************************************/
@@ -6510,6 +7209,14 @@ void GDALRasterBand::SetValidPercent(GUIntBig nSampleCount,
  *
  * Cached statistics can be cleared with GDALDataset::ClearStatistics().
  *
+ * Starting with GDAL 3.12, the GDAL_NUM_THREADS configuration option can be
+ * set to a number of threads or ALL_CPUS to process blocks with several
+ * threads. Blocks are still read by the calling thread.
+ * The result does not depend on the number of threads.
+ * For data types other than Byte and UInt16, statistics are computed per
+ * block and blocks are merged in order, so the mean and standard deviation
+ * may differ in the last bits from GDAL versions before 3.12.
+ *
  * This method is the same as the C function GDALComputeRasterStatistics().
  *
  * @param bApproxOK If TRUE statistics may be computed based on overviews
@@ -6586,16 +7293,7 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
     /* -------------------------------------------------------------------- */
     /*      Read actual data and compute statistics.                        */
     /* -------------------------------------------------------------------- */
-    // Using Welford algorithm:
-    // http://en.wikipedia.org/wiki/Algorithms_for_calculating_variance
-    // to compute standard deviation in a more numerically robust way than
-    // the difference of the sum of square values with the square of the sum.
-    // dfMean and dfM2 are updated at each sample.
-    // dfM2 is the sum of square of differences to the current mean.
-    double dfMin = std::numeric_limits<double>::infinity();
-    double dfMax = -std::numeric_limits<double>::infinity();
-    double dfMean = 0.0;
-    double dfM2 = 0.0;
+    GDALWelfordStatsAccumulator oAcc;
 
     GDALRasterIOExtraArg sExtraArg;
     INIT_RASTERIO_EXTRA_ARG(sExtraArg);
@@ -6623,9 +7321,6 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
             pszPixelType != nullptr && EQUAL(pszPixelType, "SIGNEDBYTE");
     }
 
-    GUIntBig nSampleCount = 0;
-    GUIntBig nValidCount = 0;
-
     if (bApproxOK && HasArbitraryOverviews())
     {
         /* --------------------------------------------------------------------
@@ -6699,25 +7394,11 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                 if (!bValid)
                     continue;
 
-                dfMin = std::min(dfMin, dfValue);
-                dfMax = std::max(dfMax, dfValue);
-
-                nValidCount++;
-                if (dfMin == dfMax)
-                {
-                    if (nValidCount == 1)
-                        dfMean = dfMin;
-                }
-                else
-                {
-                    const double dfDelta = dfValue - dfMean;
-                    dfMean += dfDelta / nValidCount;
-                    dfM2 += dfDelta * (dfValue - dfMean);
-                }
+                oAcc.Insert(dfValue);
             }
         }
 
-        nSampleCount = static_cast<GUIntBig>(nXReduced) * nYReduced;
+        oAcc.nSampleCount = static_cast<GUIntBig>(nXReduced) * nYReduced;
 
         CPLFree(pData);
         CPLFree(pabyMaskData);
@@ -6749,6 +7430,12 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
         if (nSampleRate == 1)
             bApproxOK = false;
 
+        const GIntBig nTotalBlocks =
+            static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
+        int nThreads = 1;
+        CPLWorkerThreadPool *const poThreadPool =
+            GDALGetStatisticsThreadPool(nTotalBlocks, nSampleRate, nThreads);
+
         // Particular case for GDT_Byte that only use integral types for all
         // intermediate computations. Only possible if the number of pixels
         // explored is lower than GUINTBIG_MAX / (255*255), so that nSumSquare
@@ -6768,10 +7455,6 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                       static_cast<GUInt64>(nBlockYSize))))
         {
             const GUInt32 nMaxValueType = (eDataType == GDT_Byte) ? 255 : 65535;
-            GUInt32 nMin = nMaxValueType;
-            GUInt32 nMax = 0;
-            GUIntBig nSum = 0;
-            GUIntBig nSumSquare = 0;
             // If no valid nodata, map to invalid value (256 for Byte)
             const GUInt32 nNoDataValue =
                 (sNoDataValues.bGotNoDataValue &&
@@ -6783,57 +7466,89 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                     ? static_cast<GUInt32>(sNoDataValues.dfNoDataValue + 1e-10)
                     : nMaxValueType + 1;
 
-            for (GIntBig iSampleBlock = 0;
-                 iSampleBlock <
-                 static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
-                 iSampleBlock += nSampleRate)
+            const auto ComputeForBlock =
+                [eDataType = eDataType, nNoDataValue, nMaxValueType](
+                    const void *pData, const GByte * /* pabyMaskData */,
+                    int nXCheck, int nYCheck, int nBufferWidth,
+                    GDALIntegerStatsAccumulator &oIntAcc)
             {
-                const int iYBlock =
-                    static_cast<int>(iSampleBlock / nBlocksPerRow);
-                const int iXBlock =
-                    static_cast<int>(iSampleBlock % nBlocksPerRow);
-
-                GDALRasterBlock *const poBlock =
-                    GetLockedBlockRef(iXBlock, iYBlock);
-                if (poBlock == nullptr)
-                    return CE_Failure;
-
-                void *const pData = poBlock->GetDataRef();
-
-                int nXCheck = 0, nYCheck = 0;
-                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
                 if (eDataType == GDT_Byte)
                 {
                     ComputeStatisticsInternal<
                         GByte, /* COMPUTE_OTHER_STATS = */ true>::
-                        f(nXCheck, nBlockXSize, nYCheck,
+                        f(nXCheck, nBufferWidth, nYCheck,
                           static_cast<const GByte *>(pData),
-                          nNoDataValue <= nMaxValueType, nNoDataValue, nMin,
-                          nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                          nNoDataValue <= nMaxValueType, nNoDataValue,
+                          oIntAcc.nMin, oIntAcc.nMax, oIntAcc.nSum,
+                          oIntAcc.nSumSquare, oIntAcc.nSampleCount,
+                          oIntAcc.nValidCount);
                 }
                 else
                 {
                     ComputeStatisticsInternal<
                         GUInt16, /* COMPUTE_OTHER_STATS = */ true>::
-                        f(nXCheck, nBlockXSize, nYCheck,
+                        f(nXCheck, nBufferWidth, nYCheck,
                           static_cast<const GUInt16 *>(pData),
-                          nNoDataValue <= nMaxValueType, nNoDataValue, nMin,
-                          nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                          nNoDataValue <= nMaxValueType, nNoDataValue,
+                          oIntAcc.nMin, oIntAcc.nMax, oIntAcc.nSum,
+                          oIntAcc.nSumSquare, oIntAcc.nSampleCount,
+                          oIntAcc.nValidCount);
                 }
+            };
 
-                poBlock->DropLock();
-
-                if (!pfnProgress(static_cast<double>(iSampleBlock) /
-                                     (static_cast<double>(nBlocksPerRow) *
-                                      nBlocksPerColumn),
-                                 "Compute Statistics", pProgressData))
+            GDALIntegerStatsAccumulator oIntAcc(nMaxValueType);
+            if (poThreadPool)
+            {
+                if (!GDALComputeOverBlocksMT(
+                        this, nullptr, poThreadPool, nThreads, nTotalBlocks,
+                        nSampleRate, ComputeForBlock, oIntAcc, pfnProgress,
+                        pProgressData, "Compute Statistics"))
                 {
-                    ReportError(CE_Failure, CPLE_UserInterrupt,
-                                "User terminated");
                     return CE_Failure;
                 }
             }
+            else
+            {
+                for (GIntBig iSampleBlock = 0; iSampleBlock < nTotalBlocks;
+                     iSampleBlock += nSampleRate)
+                {
+                    const int iYBlock =
+                        static_cast<int>(iSampleBlock / nBlocksPerRow);
+                    const int iXBlock =
+                        static_cast<int>(iSampleBlock % nBlocksPerRow);
+
+                    GDALRasterBlock *const poBlock =
+                        GetLockedBlockRef(iXBlock, iYBlock);
+                    if (poBlock == nullptr)
+                        return CE_Failure;
+
+                    void *const pData = poBlock->GetDataRef();
+
+                    int nXCheck = 0, nYCheck = 0;
+                    GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+
+                    ComputeForBlock(pData, nullptr, nXCheck, nYCheck,
+                                    nBlockXSize, oIntAcc);
+
+                    poBlock->DropLock();
+
+                    if (!pfnProgress(static_cast<double>(iSampleBlock) /
+                                         static_cast<double>(nTotalBlocks),
+                                     "Compute Statistics", pProgressData))
+                    {
+                        ReportError(CE_Failure, CPLE_UserInterrupt,
+                                    "User terminated");
+                        return CE_Failure;
+                    }
+                }
+            }
+
+            const GUInt32 nMin = oIntAcc.nMin;
+            const GUInt32 nMax = oIntAcc.nMax;
+            const GUIntBig nSum = oIntAcc.nSum;
+            const GUIntBig nSumSquare = oIntAcc.nSumSquare;
+            const GUIntBig nSampleCount = oIntAcc.nSampleCount;
+            const GUIntBig nValidCount = oIntAcc.nValidCount;
 
             if (!pfnProgress(1.0, "Compute Statistics", pProgressData))
             {
@@ -6846,8 +7561,8 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
             /*      Save computed information. */
             /* --------------------------------------------------------------------
              */
-            if (nValidCount)
-                dfMean = static_cast<double>(nSum) / nValidCount;
+            const double dfMean =
+                nValidCount ? static_cast<double>(nSum) / nValidCount : 0.0;
 
             // To avoid potential precision issues when doing the difference,
             // we need to do that computation on 128 bit rather than casting
@@ -6900,55 +7615,19 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
             return CE_Failure;
         }
 
-        GByte *pabyMaskData = nullptr;
-        if (poMaskBand)
-        {
-            pabyMaskData = static_cast<GByte *>(
-                VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
-            if (!pabyMaskData)
-            {
-                return CE_Failure;
-            }
-        }
-
-        for (GIntBig iSampleBlock = 0;
-             iSampleBlock <
-             static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
-             iSampleBlock += nSampleRate)
+        const auto ComputeForBlock =
+            [eDataType = eDataType, bSignedByte, &sNoDataValues](
+                const void *pData, const GByte *pabyMaskData, int nXCheck,
+                int nYCheck, int nBufferWidth,
+                GDALWelfordStatsAccumulator &oBlockAcc)
         {
-            const int iYBlock = static_cast<int>(iSampleBlock / nBlocksPerRow);
-            const int iXBlock = static_cast<int>(iSampleBlock % nBlocksPerRow);
-
-            int nXCheck = 0, nYCheck = 0;
-            GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-            if (poMaskBand &&
-                poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
-                                     iYBlock * nBlockYSize, nXCheck, nYCheck,
-                                     pabyMaskData, nXCheck, nYCheck, GDT_Byte,
-                                     0, nBlockXSize, nullptr) != CE_None)
-            {
-                CPLFree(pabyMaskData);
-                return CE_Failure;
-            }
-
-            GDALRasterBlock *const poBlock =
-                GetLockedBlockRef(iXBlock, iYBlock);
-            if (poBlock == nullptr)
-            {
-                CPLFree(pabyMaskData);
-                return CE_Failure;
-            }
-
-            void *const pData = poBlock->GetDataRef();
-
             // This isn't the fastest way to do this, but is easier for now.
             for (int iY = 0; iY < nYCheck; iY++)
             {
                 for (int iX = 0; iX < nXCheck; iX++)
                 {
                     const GPtrDiff_t iOffset =
-                        iX + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+                        iX + static_cast<GPtrDiff_t>(iY) * nBufferWidth;
                     if (pabyMaskData && pabyMaskData[iOffset] == 0)
                         continue;
 
@@ -6960,40 +7639,89 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                     if (!bValid)
                         continue;
 
-                    dfMin = std::min(dfMin, dfValue);
-                    dfMax = std::max(dfMax, dfValue);
-
-                    nValidCount++;
-                    if (dfMin == dfMax)
-                    {
-                        if (nValidCount == 1)
-                            dfMean = dfMin;
-                    }
-                    else
-                    {
-                        const double dfDelta = dfValue - dfMean;
-                        dfMean += dfDelta / nValidCount;
-                        dfM2 += dfDelta * (dfValue - dfMean);
-                    }
+                    oBlockAcc.Insert(dfValue);
                 }
             }
 
-            nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
+            oBlockAcc.nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
+        };
 
-            poBlock->DropLock();
-
-            if (!pfnProgress(
-                    static_cast<double>(iSampleBlock) /
-                        (static_cast<double>(nBlocksPerRow) * nBlocksPerColumn),
-                    "Compute Statistics", pProgressData))
+        if (poThreadPool)
+        {
+            if (!GDALComputeOverBlocksMT(
+                    this, poMaskBand, poThreadPool, nThreads, nTotalBlocks,
+                    nSampleRate, ComputeForBlock, oAcc, pfnProgress,
+                    pProgressData, "Compute Statistics"))
             {
-                ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-                CPLFree(pabyMaskData);
                 return CE_Failure;
             }
         }
+        else
+        {
+            GByte *pabyMaskData = nullptr;
+            if (poMaskBand)
+            {
+                pabyMaskData = static_cast<GByte *>(
+                    VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
+                if (!pabyMaskData)
+                {
+                    return CE_Failure;
+                }
+            }
 
-        CPLFree(pabyMaskData);
+            for (GIntBig iSampleBlock = 0; iSampleBlock < nTotalBlocks;
+                 iSampleBlock += nSampleRate)
+            {
+                const int iYBlock =
+                    static_cast<int>(iSampleBlock / nBlocksPerRow);
+                const int iXBlock =
+                    static_cast<int>(iSampleBlock % nBlocksPerRow);
+
+                int nXCheck = 0, nYCheck = 0;
+                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+
+                if (poMaskBand &&
+                    poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
+                                         iYBlock * nBlockYSize, nXCheck,
+                                         nYCheck, pabyMaskData, nXCheck,
+                                         nYCheck, GDT_Byte, 0, nBlockXSize,
+                                         nullptr) != CE_None)
+                {
+                    CPLFree(pabyMaskData);
+                    return CE_Failure;
+                }
+
+                GDALRasterBlock *const poBlock =
+                    GetLockedBlockRef(iXBlock, iYBlock);
+                if (poBlock == nullptr)
+                {
+                    CPLFree(pabyMaskData);
+                    return CE_Failure;
+                }
+
+                // Accumulate per block and merge, as
+                // GDALComputeOverBlocksMT() does, so that the result does
+                // not depend on the number of threads.
+                GDALWelfordStatsAccumulator oBlockAcc;
+                ComputeForBlock(poBlock->GetDataRef(), pabyMaskData, nXCheck,
+                                nYCheck, nBlockXSize, oBlockAcc);
+                oAcc.Merge(oBlockAcc);
+
+                poBlock->DropLock();
+
+                if (!pfnProgress(static_cast<double>(iSampleBlock) /
+                                     static_cast<double>(nTotalBlocks),
+                                 "Compute Statistics", pProgressData))
+                {
+                    ReportError(CE_Failure, CPLE_UserInterrupt,
+                                "User terminated");
+                    CPLFree(pabyMaskData);
+                    return CE_Failure;
+                }
+            }
+
+            CPLFree(pabyMaskData);
+        }
     }
 
     if (!pfnProgress(1.0, "Compute Statistics", pProgressData))
@@ -7005,7 +7733,12 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
     /* -------------------------------------------------------------------- */
     /*      Save computed information.                                      */
     /* -------------------------------------------------------------------- */
-    const double dfStdDev = nValidCount > 0 ? sqrt(dfM2 / nValidCount) : 0.0;
+    const GUIntBig nValidCount = oAcc.nValidCount;
+    double dfMin = oAcc.dfMin;
+    double dfMax = oAcc.dfMax;
+    const double dfMean = oAcc.dfMean;
+    const double dfStdDev =
+        nValidCount > 0 ? sqrt(oAcc.dfM2 / nValidCount) : 0.0;
 
     if (nValidCount > 0)
     {
@@ -7025,7 +7758,7 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
         dfMax = 0.0;
     }
 
-    SetValidPercent(nSampleCount, nValidCount);
+    SetValidPercent(oAcc.nSampleCount, nValidCount);
 
     /* -------------------------------------------------------------------- */
     /*      Record results.                                                 */
@@ -7396,6 +8129,10 @@ static bool ComputeMinMaxGenericIterBlocks(
  * If bApprox is FALSE, then all pixels will be read and used to compute
  * an exact range.
  *
+ * Starting with GDAL 3.12, the GDAL_NUM_THREADS configuration option can be
+ * set to a number of threads or ALL_CPUS to process blocks with several
+ * threads.
+ *
  * This method is the same as the C function GDALComputeRasterMinMax().
  *
  * @param bApproxOK TRUE if an approximate (faster) answer is OK, otherwise
@@ -7469,26 +8206,15 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
     GDALRasterIOExtraArg sExtraArg;
     INIT_RASTERIO_EXTRA_ARG(sExtraArg);
 
-    GUInt32 nMin = (eDataType == GDT_Byte)
-                       ? 255
-                       : 65535;  // used for GByte & GUInt16 cases
-    GUInt32 nMax = 0;            // used for GByte & GUInt16 cases
-    GInt16 nMinInt16 =
-        std::numeric_limits<GInt16>::max();  // used for GInt16 case
-    GInt16 nMaxInt16 =
-        std::numeric_limits<GInt16>::lowest();  // used for GInt16 case
-    double dfMin =
-        std::numeric_limits<double>::infinity();  // used for generic code path
-    double dfMax =
-        -std::numeric_limits<double>::infinity();  // used for generic code path
+    GDALMinMaxAccumulator oAcc((eDataType == GDT_Byte) ? 255 : 65535);
     const bool bUseOptimizedPath =
         !poMaskBand && ((eDataType == GDT_Byte && !bSignedByte) ||
                         eDataType == GDT_Int16 || eDataType == GDT_UInt16);
 
     const auto ComputeMinMaxForBlock =
-        [this, bSignedByte, &sNoDataValues, &nMin, &nMax, &nMinInt16,
-         &nMaxInt16](const void *pData, int nXCheck, int nBufferWidth,
-                     int nYCheck)
+        [eDataType = eDataType, bSignedByte,
+         &sNoDataValues](const void *pData, int nXCheck, int nBufferWidth,
+                         int nYCheck, GDALMinMaxAccumulator &oBlockAcc)
     {
         if (eDataType == GDT_Byte && !bSignedByte)
         {
@@ -7505,7 +8231,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                                       /* COMPUTE_OTHER_STATS = */ false>::
                 f(nXCheck, nBufferWidth, nYCheck,
                   static_cast<const GByte *>(pData), bHasNoData, nNoDataValue,
-                  nMin, nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                  oBlockAcc.nMin, oBlockAcc.nMax, nSum, nSumSquare,
+                  nSampleCount, nValidCount);
         }
         else if (eDataType == GDT_UInt16)
         {
@@ -7522,7 +8249,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                                       /* COMPUTE_OTHER_STATS = */ false>::
                 f(nXCheck, nBufferWidth, nYCheck,
                   static_cast<const GUInt16 *>(pData), bHasNoData, nNoDataValue,
-                  nMin, nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                  oBlockAcc.nMin, oBlockAcc.nMax, nSum, nSumSquare,
+                  nSampleCount, nValidCount);
         }
         else if (eDataType == GDT_Int16)
         {
@@ -7540,7 +8268,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                     ComputeMinMax<int16_t, true>(
                         static_cast<const int16_t *>(pData) +
                             static_cast<size_t>(iY) * nBufferWidth,
-                        nXCheck, nNoDataValue, &nMinInt16, &nMaxInt16);
+                        nXCheck, nNoDataValue, &oBlockAcc.nMinInt16,
+                        &oBlockAcc.nMaxInt16);
                 }
             }
             else
@@ -7550,7 +8279,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                     ComputeMinMax<int16_t, false>(
                         static_cast<const int16_t *>(pData) +
                             static_cast<size_t>(iY) * nBufferWidth,
-                        nXCheck, 0, &nMinInt16, &nMaxInt16);
+                        nXCheck, 0, &oBlockAcc.nMinInt16,
+                        &oBlockAcc.nMaxInt16);
                 }
             }
         }
@@ -7616,13 +8346,14 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
 
         if (bUseOptimizedPath)
         {
-            ComputeMinMaxForBlock(pData, nXReduced, nXReduced, nYReduced);
+            ComputeMinMaxForBlock(pData, nXReduced, nXReduced, nYReduced,
+                                  oAcc);
         }
         else
         {
             ComputeMinMaxGeneric(pData, eDataType, bSignedByte, nXReduced,
                                  nYReduced, nXReduced, sNoDataValues,
-                                 pabyMaskData, dfMin, dfMax);
+                                 pabyMaskData, oAcc.dfMin, oAcc.dfMax);
         }
 
         CPLFree(pData);
@@ -7654,11 +8385,47 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                 nSampleRate += 1;
         }
 
-        if (bUseOptimizedPath)
+        const GIntBig nTotalBlocks =
+            static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
+        int nThreads = 1;
+        CPLWorkerThreadPool *const poThreadPool =
+            GDALGetStatisticsThreadPool(nTotalBlocks, nSampleRate, nThreads);
+
+        if (poThreadPool)
+        {
+            const auto ComputeForBlock =
+                [bUseOptimizedPath, &ComputeMinMaxForBlock,
+                 eDataType = eDataType, bSignedByte, &sNoDataValues](
+                    const void *pData, const GByte *pabyMaskData, int nXCheck,
+                    int nYCheck, int nBufferWidth,
+                    GDALMinMaxAccumulator &oBlockAcc)
+            {
+                if (bUseOptimizedPath)
+                {
+                    ComputeMinMaxForBlock(pData, nXCheck, nBufferWidth,
+                                          nYCheck, oBlockAcc);
+                }
+                else
+                {
+                    ComputeMinMaxGeneric(pData, eDataType, bSignedByte,
+                                         nXCheck, nYCheck, nBufferWidth,
+                                         sNoDataValues, pabyMaskData,
+                                         oBlockAcc.dfMin, oBlockAcc.dfMax);
+                }
+            };
+
+            if (!GDALComputeOverBlocksMT(
+                    this, bUseOptimizedPath ? nullptr : poMaskBand,
+                    poThreadPool, nThreads, nTotalBlocks, nSampleRate,
+                    ComputeForBlock, oAcc, GDALDummyProgress, nullptr,
+                    nullptr))
+            {
+                return CE_Failure;
+            }
+        }
+        else if (bUseOptimizedPath)
         {
-            for (GIntBig iSampleBlock = 0;
-                 iSampleBlock <
-                 static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
+            for (GIntBig iSampleBlock = 0; iSampleBlock < nTotalBlocks;
                  iSampleBlock += nSampleRate)
             {
                 const int iYBlock =
@@ -7675,39 +8442,41 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                 int nXCheck = 0, nYCheck = 0;
                 GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
 
-                ComputeMinMaxForBlock(pData, nXCheck, nBlockXSize, nYCheck);
+                ComputeMinMaxForBlock(pData, nXCheck, nBlockXSize, nYCheck,
+                                      oAcc);
 
                 poBlock->DropLock();
 
-                if (eDataType == GDT_Byte && !bSignedByte && nMin == 0 &&
-                    nMax == 255)
+                if (eDataType == GDT_Byte && !bSignedByte && oAcc.nMin == 0 &&
+                    oAcc.nMax == 255)
                     break;
             }
         }
         else
         {
-            const GIntBig nTotalBlocks =
-                static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
             if (!ComputeMinMaxGenericIterBlocks(
                     this, eDataType, bSignedByte, nTotalBlocks, nSampleRate,
-                    nBlocksPerRow, sNoDataValues, poMaskBand, dfMin, dfMax))
+                    nBlocksPerRow, sNoDataValues, poMaskBand, oAcc.dfMin,
+                    oAcc.dfMax))
             {
                 return CE_Failure;
             }
         }
     }
 
+    double dfMin = oAcc.dfMin;
+    double dfMax = oAcc.dfMax;
     if (bUseOptimizedPath)
     {
         if ((eDataType == GDT_Byte && !bSignedByte) || eDataType == GDT_UInt16)
         {
-            dfMin = nMin;
-            dfMax = nMax;
+            dfMin = oAcc.nMin;
+            dfMax = oAcc.nMax;
         }
         else if (eDataType == GDT_Int16)
         {
-            dfMin = nMinInt16;
-            dfMax = nMaxInt16;
+            dfMin = oAcc.nMinInt16;
+            dfMax = oAcc.nMaxInt16;
         }
     }
 
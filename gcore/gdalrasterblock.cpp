@@ -17,9 +17,13 @@
 #include "gdal_priv.h"
 
 #include <algorithm>
+#include <atomic>
 #include <climits>
+#include <cstdint>
 #include <cstring>
+#include <limits>
 #include <mutex>
+#include <utility>
 
 #include "cpl_atomic_ops.h"
 #include "cpl_conv.h"
@@ -30,21 +34,10 @@
 
 // Will later be overridden by the default 5% if GDAL_CACHEMAX not defined.
 static GIntBig nCacheMax = 40 * 1024 * 1024;
-static GIntBig nCacheUsed = 0;
-
-static GDALRasterBlock *poOldest = nullptr;  // Tail.
-static GDALRasterBlock *poNewest = nullptr;  // Head.
+static std::atomic<GIntBig> nCacheUsed{0};
 
 static int nDisableDirtyBlockFlushCounter = 0;
 
-#if 0
-static CPLMutex *hRBLock = nullptr;
-#define INITIALIZE_LOCK CPLMutexHolderD(&hRBLock)
-#define TAKE_LOCK CPLMutexHolderOptionalLockD(hRBLock)
-#define DESTROY_LOCK CPLDestroyMutex(hRBLock)
-#else
-
-static CPLLock *hRBLock = nullptr;
 static bool bDebugContention = false;
 static bool bSleepsForBockCacheDebug = false;
 
@@ -75,14 +68,137 @@ static CPLLockType GetLockType()
     return static_cast<CPLLockType>(nLockType);
 }
 
-#define INITIALIZE_LOCK                                                        \
-    CPLLockHolderD(&hRBLock, GetLockType());                                   \
-    CPLLockSetDebugPerf(hRBLock, bDebugContention)
-#define TAKE_LOCK CPLLockHolderOptionalLockD(hRBLock)
-#define DESTROY_LOCK CPLDestroyLock(hRBLock)
+#define INITIALIZE_LOCK(oShard)                                                \
+    CPLLockHolderD(&((oShard).hLock), GetLockType());                          \
+    CPLLockSetDebugPerf((oShard).hLock, bDebugContention)
+#define TAKE_LOCK(oShard) CPLLockHolderOptionalLockD((oShard).hLock)
+#define DESTROY_LOCK(oShard) CPLDestroyLock((oShard).hLock)
+
+/************************************************************************/
+/*                      GDALRasterBlockCacheShard                       */
+/************************************************************************/
+
+// The list of cached blocks, in least recently used order, is split into
+// shards, selected from a hash of the band and block coordinates, each one
+// protected by its own lock. This avoids all threads contending on a single
+// lock when touching blocks. Evictions start with the shard whose oldest
+// block is the least recently touched one, which closely approximates a
+// global LRU policy. The cache size limit remains global.
+
+constexpr int MAX_SHARD_COUNT = 64;
+
+struct alignas(64) GDALRasterBlockCacheShard
+{
+    CPLLock *hLock = nullptr;
+    GDALRasterBlock *poOldest = nullptr;  // Tail.
+    GDALRasterBlock *poNewest = nullptr;  // Head.
+
+    // Touch stamp of poOldest, that can be read without taking hLock.
+    std::atomic<GUIntBig> nOldestStamp{NO_BLOCK_STAMP};
+
+    static constexpr GUIntBig NO_BLOCK_STAMP =
+        std::numeric_limits<GUIntBig>::max();
+};
+
+static GDALRasterBlockCacheShard asShards[MAX_SHARD_COUNT];
+// Power of two. Only set once, before any block is added to the cache.
+static std::atomic<int> nShardCount{1};
+static std::atomic<GUIntBig> nTouchCounter{0};
+
+static GDALRasterBlockCacheShard &GetShard(GDALRasterBlock *poBlock)
+{
+    const int nShards = nShardCount.load(std::memory_order_relaxed);
+    if (nShards == 1)
+        return asShards[0];
+    GUIntBig nHash =
+        static_cast<GUIntBig>(reinterpret_cast<std::uintptr_t>(
+            poBlock->GetBand())) ^
+        (static_cast<GUIntBig>(static_cast<unsigned>(poBlock->GetXOff()))
+         << 32) ^
+        static_cast<unsigned>(poBlock->GetYOff());
+    // splitmix64 finalizer
+    nHash ^= nHash >> 30;
+    nHash *= 0xbf58476d1ce4e5b9ULL;
+    nHash ^= nHash >> 27;
+    nHash *= 0x94d049bb133111ebULL;
+    nHash ^= nHash >> 31;
+    return asShards[nHash & static_cast<unsigned>(nShards - 1)];
+}
+
+static void InitializeLocks()
+{
+    const int nShards = nShardCount.load(std::memory_order_relaxed);
+    for (int i = 0; i < nShards; ++i)
+    {
+        INITIALIZE_LOCK(asShards[i]);
+    }
+}
+
+// Returns in panShards the indices of the shards, ordered from the one with
+// the least recently touched block to the one with the most recently touched.
+static int GetShardsByAge(int *panShards)
+{
+    const int nShards = nShardCount.load(std::memory_order_relaxed);
+    std::pair<GUIntBig, int> anStamps[MAX_SHARD_COUNT];
+    for (int i = 0; i < nShards; ++i)
+        anStamps[i] = {asShards[i].nOldestStamp.load(), i};
+    std::sort(anStamps, anStamps + nShards);
+    for (int i = 0; i < nShards; ++i)
+        panShards[i] = anStamps[i].second;
+    return nShards;
+}
+
+/************************************************************************/
+/*                       DetachOldestEvictable()                        */
+/************************************************************************/
+
+// Finds the least recently used block, for which IsCandidate() returns true,
+// that is not locked, and removes it from the cache and from its band. The
+// block lock count is set to -1 so that concurrent attempts at reacquiring it
+// fail.
+template <class IsCandidateFunc>
+GDALRasterBlock *GDALRasterBlock::DetachOldestEvictable(
+    IsCandidateFunc IsCandidate, const char *pszSleepConfigOption)
+{
+    int anShards[MAX_SHARD_COUNT];
+    const int nShards = GetShardsByAge(anShards);
+    for (int i = 0; i < nShards; ++i)
+    {
+        GDALRasterBlockCacheShard &oShard = asShards[anShards[i]];
+        INITIALIZE_LOCK(oShard);
+
+        GDALRasterBlock *poTarget = oShard.poOldest;
+        while (poTarget != nullptr)
+        {
+            if (IsCandidate(poTarget) &&
+                CPLAtomicCompareAndExchange(&(poTarget->nLockCount), 0, -1))
+                break;
+            poTarget = poTarget->poPrevious;
+        }
+        if (poTarget == nullptr)
+            continue;
 
+#ifndef __COVERITY__
+        // Disabled to avoid complains about sleeping under locks, that
+        // are only true for debug/testing code
+        if (bSleepsForBockCacheDebug)
+        {
+            const double dfDelay =
+                CPLAtof(CPLGetConfigOption(pszSleepConfigOption, "0"));
+            if (dfDelay > 0)
+                CPLSleep(dfDelay);
+        }
+#else
+        CPL_IGNORE_RET_VAL(pszSleepConfigOption);
 #endif
 
+        poTarget->Detach_unlocked();
+        poTarget->GetBand()->UnreferenceBlock(poTarget);
+        return poTarget;
+    }
+    return nullptr;
+}
+
 // #define ENABLE_DEBUG
 
 /************************************************************************/
@@ -221,9 +337,16 @@ GIntBig CPL_STDCALL GDALGetCacheMax64()
         flagSetupGDALGetCacheMax64,
         []()
         {
-            {
-                INITIALIZE_LOCK;
-            }
+            const char *pszShardCount =
+                CPLGetConfigOption("GDAL_BLOCK_CACHE_SHARDS", nullptr);
+            const int nRequestedShards =
+                pszShardCount ? atoi(pszShardCount) : CPLGetNumCPUs();
+            int nShards = 1;
+            while (nShards < nRequestedShards && nShards < MAX_SHARD_COUNT)
+                nShards *= 2;
+            nShardCount = nShards;
+            InitializeLocks();
+
             bSleepsForBockCacheDebug =
                 CPLTestBool(CPLGetConfigOption("GDAL_DEBUG_BLOCK_CACHE", "NO"));
 
@@ -240,7 +363,8 @@ GIntBig CPL_STDCALL GDALGetCacheMax64()
                 if (CPLParseMemorySize("5%", &nNewCacheMax, &bUnitSpecified) !=
                     CE_None)
                 {
-                    // This means that usable physical RAM could not be determined.
+                    // This means that usable physical RAM could not be
+                    // determined.
                     nNewCacheMax = nCacheMax;
                 }
             }
@@ -336,6 +460,9 @@ int CPL_STDCALL GDALFlushCacheBlock()
  * across zero or more GDALDataset objects in a global raster cache with
  * a least recently used (LRU) list and an upper cache limit (see
  * GDALSetCacheMax()) under which the cache size is normally kept.
+ * Starting with GDAL 3.12, the LRU list is split into several shards
+ * (see the GDAL_BLOCK_CACHE_SHARDS configuration option) to reduce lock
+ * contention between threads.
  *
  * Some blocks in the cache may be modified relative to the state on disk
  * (they are marked "Dirty") and must be flushed to disk before they can
@@ -377,40 +504,15 @@ int CPL_STDCALL GDALFlushCacheBlock()
 int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
 
 {
-    GDALRasterBlock *poTarget;
-
-    {
-        INITIALIZE_LOCK;
-        poTarget = poOldest;
-
-        while (poTarget != nullptr)
+    GDALRasterBlock *poTarget = DetachOldestEvictable(
+        [bDirtyBlocksOnly](GDALRasterBlock *poBlock)
         {
-            if (!bDirtyBlocksOnly ||
-                (poTarget->GetDirty() && nDisableDirtyBlockFlushCounter == 0))
-            {
-                if (CPLAtomicCompareAndExchange(&(poTarget->nLockCount), 0, -1))
-                    break;
-            }
-            poTarget = poTarget->poPrevious;
-        }
-
-        if (poTarget == nullptr)
-            return FALSE;
-#ifndef __COVERITY__
-        // Disabled to avoid complains about sleeping under locks, that
-        // are only true for debug/testing code
-        if (bSleepsForBockCacheDebug)
-        {
-            const double dfDelay = CPLAtof(CPLGetConfigOption(
-                "GDAL_RB_FLUSHBLOCK_SLEEP_AFTER_DROP_LOCK", "0"));
-            if (dfDelay > 0)
-                CPLSleep(dfDelay);
-        }
-#endif
-
-        poTarget->Detach_unlocked();
-        poTarget->GetBand()->UnreferenceBlock(poTarget);
-    }
+            return !bDirtyBlocksOnly ||
+                   (poBlock->GetDirty() && nDisableDirtyBlockFlushCounter == 0);
+        },
+        "GDAL_RB_FLUSHBLOCK_SLEEP_AFTER_DROP_LOCK");
+    if (poTarget == nullptr)
+        return FALSE;
 
 #ifndef __COVERITY__
     // Disabled to avoid complains about sleeping under locks, that
@@ -535,11 +637,11 @@ GDALRasterBlock::GDALRasterBlock(GDALRasterBand *poBandIn, int nXOffIn,
     : eType(poBandIn->GetRasterDataType()), nXOff(nXOffIn), nYOff(nYOffIn),
       poBand(poBandIn), bMustDetach(true)
 {
-    if (!hRBLock)
+    if (!asShards[0].hLock)
     {
         // Needed for scenarios where GDALAllRegister() is called after
         // GDALDestroyDriverManager()
-        INITIALIZE_LOCK;
+        InitializeLocks();
     }
 
     CPLAssert(poBandIn != nullptr);
@@ -654,19 +756,25 @@ void GDALRasterBlock::Detach()
 {
     if (bMustDetach)
     {
-        TAKE_LOCK;
+        TAKE_LOCK(GetShard(this));
         Detach_unlocked();
     }
 }
 
 void GDALRasterBlock::Detach_unlocked()
 {
-    if (poOldest == this)
-        poOldest = poPrevious;
+    GDALRasterBlockCacheShard &oShard = GetShard(this);
+    if (oShard.poOldest == this)
+    {
+        oShard.poOldest = poPrevious;
+        oShard.nOldestStamp = oShard.poOldest
+                                  ? oShard.poOldest->nTouchStamp
+                                  : GDALRasterBlockCacheShard::NO_BLOCK_STAMP;
+    }
 
-    if (poNewest == this)
+    if (oShard.poNewest == this)
     {
-        poNewest = poNext;
+        oShard.poNewest = poNext;
     }
 
     if (poPrevious != nullptr)
@@ -700,26 +808,32 @@ void GDALRasterBlock::Detach_unlocked()
 void GDALRasterBlock::Verify()
 
 {
-    TAKE_LOCK;
-
-    CPLAssert((poNewest == nullptr && poOldest == nullptr) ||
-              (poNewest != nullptr && poOldest != nullptr));
-
-    if (poNewest != nullptr)
+    const int nShards = nShardCount.load(std::memory_order_relaxed);
+    for (int i = 0; i < nShards; ++i)
     {
-        CPLAssert(poNewest->poPrevious == nullptr);
-        CPLAssert(poOldest->poNext == nullptr);
+        GDALRasterBlockCacheShard &oShard = asShards[i];
+        TAKE_LOCK(oShard);
 
-        GDALRasterBlock *poLast = nullptr;
-        for (GDALRasterBlock *poBlock = poNewest; poBlock != nullptr;
-             poBlock = poBlock->poNext)
+        CPLAssert((oShard.poNewest == nullptr && oShard.poOldest == nullptr) ||
+                  (oShard.poNewest != nullptr && oShard.poOldest != nullptr));
+
+        if (oShard.poNewest != nullptr)
         {
-            CPLAssert(poBlock->poPrevious == poLast);
+            CPLAssert(oShard.poNewest->poPrevious == nullptr);
+            CPLAssert(oShard.poOldest->poNext == nullptr);
 
-            poLast = poBlock;
-        }
+            GDALRasterBlock *poLast = nullptr;
+            for (GDALRasterBlock *poBlock = oShard.poNewest;
+                 poBlock != nullptr; poBlock = poBlock->poNext)
+            {
+                CPLAssert(poBlock->poPrevious == poLast);
+                CPLAssert(&GetShard(poBlock) == &oShard);
+
+                poLast = poBlock;
+            }
 
-        CPLAssert(poOldest == poLast);
+            CPLAssert(oShard.poOldest == poLast);
+        }
     }
 }
 
@@ -732,24 +846,27 @@ void GDALRasterBlock::Verify()
 #ifdef notdef
 void GDALRasterBlock::CheckNonOrphanedBlocks(GDALRasterBand *poBand)
 {
-    TAKE_LOCK;
-    for (GDALRasterBlock *poBlock = poNewest; poBlock != nullptr;
-         poBlock = poBlock->poNext)
+    for (int i = 0; i < nShardCount; ++i)
     {
-        if (poBlock->GetBand() == poBand)
+        TAKE_LOCK(asShards[i]);
+        for (GDALRasterBlock *poBlock = asShards[i].poNewest;
+             poBlock != nullptr; poBlock = poBlock->poNext)
         {
-            printf("Cache has still blocks of band %p\n", poBand); /*ok*/
-            printf("Band : %d\n", poBand->GetBand());              /*ok*/
-            printf("nRasterXSize = %d\n", poBand->GetXSize());     /*ok*/
-            printf("nRasterYSize = %d\n", poBand->GetYSize());     /*ok*/
-            int nBlockXSize, nBlockYSize;
-            poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
-            printf("nBlockXSize = %d\n", nBlockXSize);      /*ok*/
-            printf("nBlockYSize = %d\n", nBlockYSize);      /*ok*/
-            printf("Dataset : %p\n", poBand->GetDataset()); /*ok*/
-            if (poBand->GetDataset())
-                printf("Dataset : %s\n", /*ok*/
-                       poBand->GetDataset()->GetDescription());
+            if (poBlock->GetBand() == poBand)
+            {
+                printf("Cache has still blocks of band %p\n", poBand); /*ok*/
+                printf("Band : %d\n", poBand->GetBand());              /*ok*/
+                printf("nRasterXSize = %d\n", poBand->GetXSize());     /*ok*/
+                printf("nRasterYSize = %d\n", poBand->GetYSize());     /*ok*/
+                int nBlockXSize, nBlockYSize;
+                poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+                printf("nBlockXSize = %d\n", nBlockXSize);      /*ok*/
+                printf("nBlockYSize = %d\n", nBlockYSize);      /*ok*/
+                printf("Dataset : %p\n", poBand->GetDataset()); /*ok*/
+                if (poBand->GetDataset())
+                    printf("Dataset : %s\n", /*ok*/
+                           poBand->GetDataset()->GetDescription());
+            }
         }
     }
 }
@@ -806,32 +923,38 @@ CPLErr GDALRasterBlock::Write()
 void GDALRasterBlock::Touch()
 
 {
+    GDALRasterBlockCacheShard &oShard = GetShard(this);
+
     // Can be safely tested outside the lock
-    if (poNewest == this)
+    if (oShard.poNewest == this)
         return;
 
-    TAKE_LOCK;
+    TAKE_LOCK(oShard);
     Touch_unlocked();
 }
 
 void GDALRasterBlock::Touch_unlocked()
 
 {
+    GDALRasterBlockCacheShard &oShard = GetShard(this);
+
     // Could happen even if tested in Touch() before taking the lock
     // Scenario would be :
     // 0. this is the second block (the one pointed by poNewest->poNext)
     // 1. Thread 1 calls Touch() and poNewest != this at that point
     // 2. Thread 2 detaches poNewest
     // 3. Thread 1 arrives here
-    if (poNewest == this)
+    if (oShard.poNewest == this)
         return;
 
     // We should not try to touch a block that has been detached.
     // If that happen, corruption has already occurred.
     CPLAssert(bMustDetach);
 
-    if (poOldest == this)
-        poOldest = this->poPrevious;
+    nTouchStamp = ++nTouchCounter;
+
+    if (oShard.poOldest == this)
+        oShard.poOldest = this->poPrevious;
 
     if (poPrevious != nullptr)
         poPrevious->poNext = poNext;
@@ -840,20 +963,21 @@ void GDALRasterBlock::Touch_unlocked()
         poNext->poPrevious = poPrevious;
 
     poPrevious = nullptr;
-    poNext = poNewest;
+    poNext = oShard.poNewest;
 
-    if (poNewest != nullptr)
+    if (oShard.poNewest != nullptr)
     {
-        CPLAssert(poNewest->poPrevious == nullptr);
-        poNewest->poPrevious = this;
+        CPLAssert(oShard.poNewest->poPrevious == nullptr);
+        oShard.poNewest->poPrevious = this;
     }
-    poNewest = this;
+    oShard.poNewest = this;
 
-    if (poOldest == nullptr)
+    if (oShard.poOldest == nullptr)
     {
         CPLAssert(poPrevious == nullptr && poNext == nullptr);
-        poOldest = this;
+        oShard.poOldest = this;
     }
+    oShard.nOldestStamp = oShard.poOldest->nTouchStamp;
 #ifdef ENABLE_DEBUG
     Verify();
 #endif
@@ -881,7 +1005,7 @@ CPLErr GDALRasterBlock::Internalize()
 
     void *pNewData = nullptr;
 
-    // This call will initialize the hRBLock mutex. Other call places can
+    // This call will initialize the shard locks. Other call places can
     // only be called if we have go through there.
     const GIntBig nCurCacheMax = GDALGetCacheMax64();
 
@@ -899,123 +1023,64 @@ CPLErr GDALRasterBlock::Internalize()
         bLoopAgain = false;
         GDALRasterBlock *apoBlocksToFree[64] = {nullptr};
         int nBlocksToFree = 0;
-        {
-            TAKE_LOCK;
 
-            if (bFirstIter)
-                nCacheUsed += GetEffectiveBlockSize(nSizeInBytes);
-            GDALRasterBlock *poTarget = poOldest;
-            while (nCacheUsed > nCurCacheMax)
-            {
-                GDALRasterBlock *poDirtyBlockOtherDataset = nullptr;
-                // In this first pass, only discard dirty blocks of this
-                // dataset. We do this to decrease significantly the likelihood
-                // of the following weakness of the block cache design:
-                // 1. Thread 1 fills block B with ones
-                // 2. Thread 2 evicts this dirty block, while thread 1 almost
-                //    at the same time (but slightly after) tries to reacquire
-                //    this block. As it has been removed from the block cache
-                //    array/set, thread 1 now tries to read block B from disk,
-                //    so gets the old value.
-                while (poTarget != nullptr)
-                {
-                    if (!poTarget->GetDirty())
-                    {
-                        if (CPLAtomicCompareAndExchange(&(poTarget->nLockCount),
-                                                        0, -1))
-                            break;
-                    }
-                    else if (nDisableDirtyBlockFlushCounter == 0)
-                    {
-                        if (poTarget->poBand->GetDataset() == poThisDS)
-                        {
-                            if (CPLAtomicCompareAndExchange(
-                                    &(poTarget->nLockCount), 0, -1))
-                                break;
-                        }
-                        else if (poDirtyBlockOtherDataset == nullptr)
-                        {
-                            poDirtyBlockOtherDataset = poTarget;
-                        }
-                    }
-                    poTarget = poTarget->poPrevious;
-                }
-                if (poTarget == nullptr && poDirtyBlockOtherDataset)
+        if (bFirstIter)
+            nCacheUsed += GetEffectiveBlockSize(nSizeInBytes);
+        while (nCacheUsed > nCurCacheMax)
+        {
+            const bool bCanFlushDirty = nDisableDirtyBlockFlushCounter == 0;
+            // In this first pass, only discard dirty blocks of this
+            // dataset. We do this to decrease significantly the likelihood
+            // of the following weakness of the block cache design:
+            // 1. Thread 1 fills block B with ones
+            // 2. Thread 2 evicts this dirty block, while thread 1 almost
+            //    at the same time (but slightly after) tries to reacquire
+            //    this block. As it has been removed from the block cache
+            //    array/set, thread 1 now tries to read block B from disk,
+            //    so gets the old value.
+            GDALRasterBlock *poTarget = DetachOldestEvictable(
+                [poThisDS, bCanFlushDirty](GDALRasterBlock *poBlock)
                 {
-                    if (CPLAtomicCompareAndExchange(
-                            &(poDirtyBlockOtherDataset->nLockCount), 0, -1))
-                    {
-                        CPLDebug("GDAL",
-                                 "Evicting dirty block of another dataset");
-                        poTarget = poDirtyBlockOtherDataset;
-                    }
-                    else
-                    {
-                        poTarget = poOldest;
-                        while (poTarget != nullptr)
-                        {
-                            if (CPLAtomicCompareAndExchange(
-                                    &(poTarget->nLockCount), 0, -1))
-                            {
-                                CPLDebug(
-                                    "GDAL",
-                                    "Evicting dirty block of another dataset");
-                                break;
-                            }
-                            poTarget = poTarget->poPrevious;
-                        }
-                    }
-                }
-
+                    return !poBlock->GetDirty() ||
+                           (bCanFlushDirty &&
+                            poBlock->GetBand()->GetDataset() == poThisDS);
+                },
+                "GDAL_RB_INTERNALIZE_SLEEP_AFTER_DROP_LOCK");
+            if (poTarget == nullptr && bCanFlushDirty)
+            {
+                poTarget = DetachOldestEvictable(
+                    [](GDALRasterBlock *poBlock)
+                    { return poBlock->GetDirty(); },
+                    "GDAL_RB_INTERNALIZE_SLEEP_AFTER_DROP_LOCK");
                 if (poTarget != nullptr)
                 {
-#ifndef __COVERITY__
-                    // Disabled to avoid complains about sleeping under locks,
-                    // that are only true for debug/testing code
-                    if (bSleepsForBockCacheDebug)
-                    {
-                        const double dfDelay = CPLAtof(CPLGetConfigOption(
-                            "GDAL_RB_INTERNALIZE_SLEEP_AFTER_DROP_LOCK", "0"));
-                        if (dfDelay > 0)
-                            CPLSleep(dfDelay);
-                    }
-#endif
-
-                    GDALRasterBlock *_poPrevious = poTarget->poPrevious;
-
-                    poTarget->Detach_unlocked();
-                    poTarget->GetBand()->UnreferenceBlock(poTarget);
-
-                    apoBlocksToFree[nBlocksToFree++] = poTarget;
-                    if (poTarget->GetDirty())
-                    {
-                        // Only free one dirty block at a time so that
-                        // other dirty blocks of other bands with the same
-                        // coordinates can be found with TryGetLockedBlock()
-                        bLoopAgain = nCacheUsed > nCurCacheMax;
-                        break;
-                    }
-                    if (nBlocksToFree == 64)
-                    {
-                        bLoopAgain = (nCacheUsed > nCurCacheMax);
-                        break;
-                    }
-
-                    poTarget = _poPrevious;
-                }
-                else
-                {
-                    break;
+                    CPLDebug("GDAL", "Evicting dirty block of another dataset");
                 }
             }
+            if (poTarget == nullptr)
+                break;
+
+            apoBlocksToFree[nBlocksToFree++] = poTarget;
+            if (poTarget->GetDirty())
+            {
+                // Only free one dirty block at a time so that
+                // other dirty blocks of other bands with the same
+                // coordinates can be found with TryGetLockedBlock()
+                bLoopAgain = nCacheUsed > nCurCacheMax;
+                break;
+            }
+            if (nBlocksToFree == 64)
+            {
+                bLoopAgain = (nCacheUsed > nCurCacheMax);
+                break;
+            }
+        }
 
-            /* ------------------------------------------------------------------
-             */
-            /*      Add this block to the list. */
-            /* ------------------------------------------------------------------
-             */
-            if (!bLoopAgain)
-                Touch_unlocked();
+        // Add this block to the list.
+        if (!bLoopAgain)
+        {
+            TAKE_LOCK(GetShard(this));
+            Touch_unlocked();
         }
 
         bFirstIter = false;
@@ -1126,9 +1191,12 @@ void GDALRasterBlock::MarkClean()
 /*! @cond Doxygen_Suppress */
 void GDALRasterBlock::DestroyRBMutex()
 {
-    if (hRBLock != nullptr)
-        DESTROY_LOCK;
-    hRBLock = nullptr;
+    for (auto &oShard : asShards)
+    {
+        if (oShard.hLock != nullptr)
+            DESTROY_LOCK(oShard);
+        oShard.hLock = nullptr;
+    }
 }
 
 /*! @endcond */
@@ -1211,7 +1279,7 @@ int GDALRasterBlock::DropLockForRemovalFromStorage()
 #endif
 
     // Wait for the block for having been unreferenced.
-    TAKE_LOCK;
+    TAKE_LOCK(GetShard(this));
 
     return FALSE;
 }
@@ -1220,7 +1288,8 @@ int GDALRasterBlock::DropLockForRemovalFromStorage()
 void GDALRasterBlock::DumpAll()
 {
     int iBlock = 0;
-    for( GDALRasterBlock *poBlock = poNewest;
+    for( int i = 0; i < nShardCount; ++i )
+    for( GDALRasterBlock *poBlock = asShards[i].poNewest;
          poBlock != nullptr;
          poBlock = poBlock->poNext )
     {
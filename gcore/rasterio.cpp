@@ -25,18 +25,25 @@
 #include <cstring>
 
 #include <algorithm>
+#include <condition_variable>
 #include <limits>
+#include <mutex>
 #include <stdexcept>
+#include <system_error>
+#include <thread>
 #include <type_traits>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_cpu_features.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_float.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 #include "gdal_vrt.h"
 #include "gdalwarper.h"
 #include "memdataset.h"
@@ -5067,6 +5074,264 @@ static void GDALCopyWholeRasterGetSwathSize(GDALRasterBand *poSrcPrototypeBand,
     *pnSwathLines = nSwathLines;
 }
 
+/************************************************************************/
+/*                 GDALDatasetCopyWholeRasterPipelined()                */
+/************************************************************************/
+
+namespace
+{
+struct GDALCopySwath
+{
+    // 0 for a pixel interleaved swath covering all bands
+    int nBand = 0;
+    int iX = 0;
+    int iY = 0;
+    int nCols = 0;
+    int nLines = 0;
+};
+
+struct GDALCopySwathSlot
+{
+    enum class State
+    {
+        FREE,
+        READING,
+        READY,
+        EMPTY,
+    };
+
+    GIntBig iSwath = -1;
+    State eState = State::FREE;
+    void *pBuffer = nullptr;
+};
+}  // namespace
+
+// Reader threads fetch swaths of the source dataset into a ring of
+// nQueueDepth + 1 buffers, while the calling thread writes them, in order,
+// to the target dataset. Readers can thus be at most nQueueDepth swaths ahead
+// of the writer. Only the readers access the source dataset, and only the
+// calling thread accesses the target dataset, so several readers are only used
+// when the source dataset is thread-safe.
+static CPLErr GDALDatasetCopyWholeRasterPipelined(
+    GDALDataset *poSrcDS, GDALDataset *poDstDS, GDALDataType eDT,
+    bool bInterleave, bool bCheckHoles, int nSwathCols, int nSwathLines,
+    GIntBig nSwathCount, int nReaders, int nQueueDepth,
+    GDALProgressFunc pfnProgress, void *pProgressData)
+{
+    const int nXSize = poDstDS->GetRasterXSize();
+    const int nYSize = poDstDS->GetRasterYSize();
+    const int nBandCount = poDstDS->GetRasterCount();
+    const int nSwathsPerRow = DIV_ROUND_UP(nXSize, nSwathCols);
+    const GIntBig nSwathsPerBand =
+        static_cast<GIntBig>(DIV_ROUND_UP(nYSize, nSwathLines)) * nSwathsPerRow;
+
+    // Swaths are enumerated in the same order as the sequential code path.
+    const auto GetSwath = [=](GIntBig iSwath)
+    {
+        GDALCopySwath sSwath;
+        sSwath.nBand =
+            bInterleave ? 0 : static_cast<int>(iSwath / nSwathsPerBand) + 1;
+        iSwath %= nSwathsPerBand;
+        sSwath.iY = static_cast<int>(iSwath / nSwathsPerRow) * nSwathLines;
+        sSwath.iX = static_cast<int>(iSwath % nSwathsPerRow) * nSwathCols;
+        sSwath.nCols = std::min(nSwathCols, nXSize - sSwath.iX);
+        sSwath.nLines = std::min(nSwathLines, nYSize - sSwath.iY);
+        return sSwath;
+    };
+
+    const int nPixelSize =
+        GDALGetDataTypeSizeBytes(eDT) * (bInterleave ? nBandCount : 1);
+    std::vector<GDALCopySwathSlot> asSlots(static_cast<size_t>(
+        std::min(static_cast<GIntBig>(nQueueDepth), nSwathCount) + 1));
+    const GIntBig nSlots = static_cast<GIntBig>(asSlots.size());
+    bool bAllocOK = true;
+    for (auto &sSlot : asSlots)
+    {
+        sSlot.pBuffer =
+            VSI_MALLOC3_VERBOSE(nSwathCols, nSwathLines, nPixelSize);
+        bAllocOK = bAllocOK && sSlot.pBuffer != nullptr;
+    }
+    const auto FreeBuffers = [&asSlots]()
+    {
+        for (auto &sSlot : asSlots)
+            CPLFree(sSlot.pBuffer);
+    };
+    if (!bAllocOK)
+    {
+        FreeBuffers();
+        return CE_Failure;
+    }
+
+    CPLDebug("GDAL",
+             "GDALDatasetCopyWholeRaster(): pipelined with %d reader(s) and "
+             "a queue depth of %d",
+             nReaders, static_cast<int>(nSlots - 1));
+
+    std::mutex oMutex;
+    std::condition_variable oCV;
+    GIntBig nNextToRead = 0;  // protected by oMutex
+    GIntBig nWritten = 0;     // protected by oMutex
+    bool bStop = false;       // protected by oMutex
+    CPLErr eErr = CE_None;    // protected by oMutex
+    CPLErrorAccumulator oErrorAccumulator;
+
+    const auto ReaderMain = [&]()
+    {
+        auto oAccumulator = oErrorAccumulator.InstallForCurrentScope();
+        CPL_IGNORE_RET_VAL(oAccumulator);
+
+        std::unique_lock oLock(oMutex);
+        while (true)
+        {
+            // The slot of swath nNextToRead is free once the swath that
+            // used it previously has been written.
+            while (!bStop && nNextToRead < nSwathCount &&
+                   nNextToRead >= nWritten + nSlots)
+            {
+                oCV.wait(oLock);
+            }
+            if (bStop || nNextToRead >= nSwathCount)
+                break;
+            const GIntBig iSwath = nNextToRead++;
+            GDALCopySwathSlot &sSlot = asSlots[iSwath % nSlots];
+            sSlot.iSwath = iSwath;
+            sSlot.eState = GDALCopySwathSlot::State::READING;
+            oLock.unlock();
+
+            const GDALCopySwath sSwath = GetSwath(iSwath);
+            int nStatus = GDAL_DATA_COVERAGE_STATUS_DATA;
+            if (bCheckHoles)
+            {
+                nStatus = 0;
+                for (int iBand = 0; iBand < nBandCount; iBand++)
+                {
+                    if (sSwath.nBand != 0 && sSwath.nBand != iBand + 1)
+                        continue;
+                    nStatus |= poSrcDS->GetRasterBand(iBand + 1)
+                                   ->GetDataCoverageStatus(
+                                       sSwath.iX, sSwath.iY, sSwath.nCols,
+                                       sSwath.nLines,
+                                       GDAL_DATA_COVERAGE_STATUS_DATA);
+                    if (nStatus & GDAL_DATA_COVERAGE_STATUS_DATA)
+                        break;
+                }
+            }
+
+            CPLErr eReadErr = CE_None;
+            const bool bHasData =
+                (nStatus & GDAL_DATA_COVERAGE_STATUS_DATA) != 0;
+            if (bHasData)
+            {
+                int nBand = sSwath.nBand;
+                const int nIOBandCount = nBand == 0 ? nBandCount : 1;
+                int *panBandMap = nBand == 0 ? nullptr : &nBand;
+                // Lets drivers able to do so (e.g. cloud optimized GeoTIFF
+                // over /vsicurl/) fetch all blocks of the swath at once.
+                poSrcDS->AdviseRead(sSwath.iX, sSwath.iY, sSwath.nCols,
+                                    sSwath.nLines, sSwath.nCols, sSwath.nLines,
+                                    eDT, nIOBandCount, panBandMap, nullptr);
+                eReadErr = poSrcDS->RasterIO(
+                    GF_Read, sSwath.iX, sSwath.iY, sSwath.nCols,
+                    sSwath.nLines, sSlot.pBuffer, sSwath.nCols, sSwath.nLines,
+                    eDT, nIOBandCount, panBandMap, 0, 0, 0, nullptr);
+            }
+
+            oLock.lock();
+            if (eReadErr != CE_None)
+            {
+                eErr = eReadErr;
+                bStop = true;
+            }
+            else
+            {
+                sSlot.eState = bHasData ? GDALCopySwathSlot::State::READY
+                                        : GDALCopySwathSlot::State::EMPTY;
+            }
+            oCV.notify_all();
+        }
+    };
+
+    std::vector<std::thread> aoReaders;
+    try
+    {
+        for (int i = 0; i < nReaders; ++i)
+            aoReaders.emplace_back(ReaderMain);
+    }
+    catch (const std::system_error &)
+    {
+        // Go on with the readers we could create, if any.
+        if (aoReaders.empty())
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Cannot create reader thread in "
+                     "GDALDatasetCopyWholeRaster()");
+            eErr = CE_Failure;
+            bStop = true;
+        }
+    }
+
+    for (GIntBig iSwath = 0; iSwath < nSwathCount; ++iSwath)
+    {
+        GDALCopySwathSlot &sSlot = asSlots[iSwath % nSlots];
+        std::unique_lock oLock(oMutex);
+        while (!bStop &&
+               (sSlot.iSwath != iSwath ||
+                sSlot.eState == GDALCopySwathSlot::State::READING))
+        {
+            oCV.wait(oLock);
+        }
+        if (bStop)
+            break;
+        const bool bHasData =
+            sSlot.eState == GDALCopySwathSlot::State::READY;
+        oLock.unlock();
+
+        CPLErr eWriteErr = CE_None;
+        if (bHasData)
+        {
+            const GDALCopySwath sSwath = GetSwath(iSwath);
+            int nBand = sSwath.nBand;
+            eWriteErr = poDstDS->RasterIO(
+                GF_Write, sSwath.iX, sSwath.iY, sSwath.nCols, sSwath.nLines,
+                sSlot.pBuffer, sSwath.nCols, sSwath.nLines, eDT,
+                nBand == 0 ? nBandCount : 1, nBand == 0 ? nullptr : &nBand, 0,
+                0, 0, nullptr);
+        }
+        if (eWriteErr == CE_None &&
+            !pfnProgress(static_cast<double>(iSwath + 1) / nSwathCount,
+                         nullptr, pProgressData))
+        {
+            eWriteErr = CE_Failure;
+            CPLError(CE_Failure, CPLE_UserInterrupt,
+                     "User terminated CreateCopy()");
+        }
+
+        oLock.lock();
+        sSlot.eState = GDALCopySwathSlot::State::FREE;
+        nWritten = iSwath + 1;
+        if (eWriteErr != CE_None)
+        {
+            eErr = eWriteErr;
+            bStop = true;
+        }
+        oCV.notify_all();
+    }
+
+    {
+        std::lock_guard oLock(oMutex);
+        bStop = true;
+        oCV.notify_all();
+    }
+    for (auto &oThread : aoReaders)
+        oThread.join();
+
+    oErrorAccumulator.ReplayErrors();
+
+    FreeBuffers();
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                     GDALDatasetCopyWholeRaster()                     */
 /************************************************************************/
@@ -5092,9 +5357,22 @@ static void GDALCopyWholeRasterGetSwathSize(GDALRasterBand *poSrcPrototypeBand,
  * sizes to achieve best compression.</li> <li>"SKIP_HOLES=YES" to skip chunks
  * for which GDALGetDataCoverageStatus() returns GDAL_DATA_COVERAGE_STATUS_EMPTY
  * (GDAL &gt;= 2.2)</li>
+ * <li>"QUEUE_DEPTH=n" to set the maximum number of chunks that may be read
+ * ahead of the one being written, when reading and writing are pipelined
+ * (see below). Defaults to the number of reader threads plus one.
+ * (GDAL &gt;= 3.12)</li>
  * </ul>
  * More options may be supported in the future.
  *
+ * Starting with GDAL 3.12, when the GDAL_NUM_THREADS configuration option is
+ * set to a value greater than one, chunks are read from the source dataset by
+ * one or more background threads while the calling thread writes them to the
+ * destination dataset, so that decoding of the source overlaps with encoding
+ * of the destination. Several reader threads are only used if the source
+ * dataset is thread-safe (cf GDALDataset::IsThreadSafe()). Chunks are still
+ * written in the same order as in the sequential case, and memory usage is
+ * bounded to QUEUE_DEPTH + 1 chunk buffers.
+ *
  * @param hSrcDS the source dataset
  * @param hDstDS the destination dataset
  * @param papszOptions transfer hints in "StringList" Name=Value format.
@@ -5207,16 +5485,6 @@ CPLErr CPL_STDCALL GDALDatasetCopyWholeRaster(GDALDatasetH hSrcDS,
                                     nBandCount, bDstIsCompressed, bInterleave,
                                     &nSwathCols, &nSwathLines);
 
-    int nPixelSize = GDALGetDataTypeSizeBytes(eDT);
-    if (bInterleave)
-        nPixelSize *= nBandCount;
-
-    void *pSwathBuf = VSI_MALLOC3_VERBOSE(nSwathCols, nSwathLines, nPixelSize);
-    if (pSwathBuf == nullptr)
-    {
-        return CE_Failure;
-    }
-
     CPLDebug("GDAL",
              "GDALDatasetCopyWholeRaster(): %d*%d swaths, bInterleave=%d",
              nSwathCols, nSwathLines, static_cast<int>(bInterleave));
@@ -5227,12 +5495,49 @@ CPLErr CPL_STDCALL GDALDatasetCopyWholeRaster(GDALDatasetH hSrcDS,
     poSrcDS->AdviseRead(0, 0, nXSize, nYSize, nXSize, nYSize, eDT, nBandCount,
                         nullptr, nullptr);
 
+    const bool bCheckHoles =
+        CPLTestBool(CSLFetchNameValueDef(papszOptions, "SKIP_HOLES", "NO"));
+
+    /* -------------------------------------------------------------------- */
+    /*      Overlap reading and writing of swaths if several threads are    */
+    /*      allowed and there is more than one swath.                       */
+    /* -------------------------------------------------------------------- */
+    const GIntBig nSwathCount =
+        static_cast<GIntBig>(DIV_ROUND_UP(nYSize, nSwathLines)) *
+        DIV_ROUND_UP(nXSize, nSwathCols) * (bInterleave ? 1 : nBandCount);
+    const int nThreads = GDALGetNumThreads();
+    if (nThreads > 1 && nSwathCount > 1)
+    {
+        // The calling thread is the writer. Several readers can only be used
+        // if the source dataset can be accessed concurrently.
+        const int nReaders =
+            poSrcDS->IsThreadSafe(GDAL_OF_RASTER)
+                ? static_cast<int>(std::min(static_cast<GIntBig>(nThreads - 1),
+                                            nSwathCount - 1))
+                : 1;
+        const int nQueueDepth = std::max(
+            1, atoi(CSLFetchNameValueDef(papszOptions, "QUEUE_DEPTH",
+                                         CPLSPrintf("%d", nReaders + 1))));
+        return GDALDatasetCopyWholeRasterPipelined(
+            poSrcDS, poDstDS, eDT, bInterleave, bCheckHoles, nSwathCols,
+            nSwathLines, nSwathCount, nReaders, nQueueDepth, pfnProgress,
+            pProgressData);
+    }
+
+    int nPixelSize = GDALGetDataTypeSizeBytes(eDT);
+    if (bInterleave)
+        nPixelSize *= nBandCount;
+
+    void *pSwathBuf = VSI_MALLOC3_VERBOSE(nSwathCols, nSwathLines, nPixelSize);
+    if (pSwathBuf == nullptr)
+    {
+        return CE_Failure;
+    }
+
     /* ==================================================================== */
     /*      Band oriented (uninterleaved) case.                             */
     /* ==================================================================== */
     CPLErr eErr = CE_None;
-    const bool bCheckHoles =
-        CPLTestBool(CSLFetchNameValueDef(papszOptions, "SKIP_HOLES", "NO"));
 
     if (!bInterleave)
     {
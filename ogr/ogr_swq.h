@@ -27,6 +27,7 @@
 #include "cpl_string.h"
 #include "ogr_core.h"
 
+#include <limits>
 #include <list>
 #include <map>
 #include <vector>
@@ -320,6 +321,7 @@ const char CPL_UNSTABLE_API *SWQFieldTypeToString(swq_field_type field_type);
 #define SWQM_SUMMARY_RECORD 1
 #define SWQM_RECORDSET 2
 #define SWQM_DISTINCT_LIST 3
+#define SWQM_GROUP_BY 4
 
 typedef enum
 {
@@ -385,16 +387,16 @@ class CPL_UNSTABLE_API swq_summary
     double sum_acc = 0.0;
     // Sum correction term.
     double sum_correction = 0.0;
-    double min = 0.0;
-    double max = 0.0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
 
     // Welford's online algorithm for variance:
     // https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance#Welford's_online_algorithm
     double mean_for_variance = 0.0;
     double sq_dist_from_mean_acc = 0.0;  // "M2"
 
-    CPLString osMin{};
-    CPLString osMax{};
+    CPLString osMin{"9999/99/99 99:99:99"};
+    CPLString osMax{"0000/00/00 00:00:00"};
 };
 
 typedef struct
@@ -406,6 +408,14 @@ typedef struct
     int ascending_flag;
 } swq_order_def;
 
+typedef struct
+{
+    char *table_name;
+    char *field_name;
+    int table_index;
+    int field_index;
+} swq_group_by_def;
+
 typedef struct
 {
     int secondary_table;
@@ -476,6 +486,10 @@ class CPL_UNSTABLE_API swq_select
     int order_specs = 0;
     swq_order_def *order_defs = nullptr;
 
+    void PushGroupBy(const char *pszTableName, const char *pszFieldName);
+    int group_by_count = 0;
+    swq_group_by_def *group_by_defs = nullptr;
+
     void SetLimit(GIntBig nLimit);
     GIntBig limit = -1;
 
@@ -498,6 +512,7 @@ class CPL_UNSTABLE_API swq_select
 
   private:
     bool IsFieldExcluded(int src_index, const char *table, const char *field);
+    CPLErr CheckGroupBy(swq_field_list *field_list);
 
     // map of EXCLUDE columns keyed according to the index of the
     // asterisk with which it should be associated. key of -1 is
@@ -516,6 +531,14 @@ const char CPL_UNSTABLE_API *swq_select_summarize(swq_select *select_info,
                                                   const char *pszValue,
                                                   const double *pdfValue);
 
+/* Accumulate a value into the summary of a non-DISTINCT column, with the same
+ * conventions for pszValue and pdfValue as swq_select_summarize().
+ */
+const char CPL_UNSTABLE_API *swq_summary_accumulate(const swq_col_def *def,
+                                                    swq_summary &summary,
+                                                    const char *pszValue,
+                                                    const double *pdfValue);
+
 int CPL_UNSTABLE_API swq_is_reserved_keyword(const char *pszStr);
 
 char CPL_UNSTABLE_API *OGRHStoreGetValue(const char *pszHStore,
@@ -15,17 +15,22 @@
 #include "ogr_spatialref.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
+#include <condition_variable>
 #include <cstring>
 #include <limits>
 #include <list>
+#include <memory>
 #include <mutex>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_mem_cache.h"
 #include "cpl_string.h"
+#include "gdal_thread_pool.h"
 #include "ogr_core.h"
 #include "ogr_srs_api.h"
 #include "ogr_proj_p.h"
@@ -832,6 +837,17 @@ class OGRProjCT final : public OGRCoordinateTransformation
                            const double xmax, const double ymax,
                            bool lon_lat_order);
 
+    int TransformPointWithProj(PJ *pj, PJ_CONTEXT *ctx, double &xInOut,
+                               double &yInOut, double *pz, double *pt,
+                               double dfDefaultTime);
+    bool TransformWithProjMultiThreaded(PJ *pj, int nThreads, size_t nCount,
+                                        double *x, double *y, double *z,
+                                        double *t, double dfDefaultTime,
+                                        int *panErrorCodes,
+                                        GByte *pabyInvalidInput);
+    void ReportTransformError(PJ_CONTEXT *ctx, int err, size_t iPoint,
+                              GUInt32 nLastErrorCounter);
+
   public:
     OGRProjCT();
     ~OGRProjCT() override;
@@ -2347,16 +2363,359 @@ int OGRProjCT::Transform(size_t nCount, double *x, double *y, double *z,
     return bRet;
 }
 
-/************************************************************************/
-/*                       TransformWithErrorCodes()                      */
-/************************************************************************/
-
 #ifndef PROJ_ERR_COORD_TRANSFM_INVALID_COORD
 #define PROJ_ERR_COORD_TRANSFM_INVALID_COORD 2049
 #define PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN 2050
 #define PROJ_ERR_COORD_TRANSFM_NO_OPERATION 2051
 #endif
 
+/************************************************************************/
+/*                  OGRProjCTGetTransformThreadCount()                  */
+/************************************************************************/
+
+// Minimum number of points each thread must process for the multi-threaded
+// code path to be worth the cost of cloning the PJ object.
+constexpr size_t OGR_CT_MIN_POINTS_PER_THREAD = 20000;
+
+static int OGRProjCTGetTransformThreadCount(size_t nCount)
+{
+    if (nCount < 2 * OGR_CT_MIN_POINTS_PER_THREAD)
+        return 1;
+
+    const char *pszNumThreads =
+        CPLGetConfigOption("OGR_CT_NUM_THREADS", nullptr);
+    int nThreads;
+    if (pszNumThreads == nullptr)
+        nThreads = GDALGetNumThreads();
+    else if (EQUAL(pszNumThreads, "ALL_CPUS"))
+        nThreads = CPLGetNumCPUs();
+    else
+        nThreads = atoi(pszNumThreads);
+    nThreads = std::clamp(nThreads, 1, 128);
+
+    return static_cast<int>(std::min<size_t>(
+        nThreads, nCount / OGR_CT_MIN_POINTS_PER_THREAD));
+}
+
+/************************************************************************/
+/*                       TransformPointWithProj()                       */
+/************************************************************************/
+
+/** Transform a single point with PROJ and return the PROJ error code, or 0
+ * in case of success. Errors are not reported through CPLError(), so that
+ * this method can be called from worker threads, provided each of them uses
+ * its own PJ object.
+ */
+int OGRProjCT::TransformPointWithProj(PJ *pj, PJ_CONTEXT *ctx, double &xInOut,
+                                      double &yInOut, double *pz, double *pt,
+                                      double dfDefaultTime)
+{
+    const double xIn = xInOut;
+    const double yIn = yInOut;
+    if (!std::isfinite(xIn))
+    {
+        xInOut = HUGE_VAL;
+        yInOut = HUGE_VAL;
+        return PROJ_ERR_COORD_TRANSFM_INVALID_COORD;
+    }
+
+    PJ_COORD coord;
+    coord.xyzt.x = xIn;
+    coord.xyzt.y = yIn;
+    coord.xyzt.z = pz ? *pz : 0;
+    coord.xyzt.t = pt ? *pt : dfDefaultTime;
+    proj_errno_reset(pj);
+    coord = proj_trans(pj, m_bReversePj ? PJ_INV : PJ_FWD, coord);
+#if 0
+    CPLDebug("OGRCT",
+             "Transforming (x=%f,y=%f,z=%f,time=%f) to "
+             "(x=%f,y=%f,z=%f,time=%f)",
+             xIn, yIn, pz ? *pz : 0, pt ? *pt : dfDefaultTime,
+             coord.xyzt.x, coord.xyzt.y, coord.xyzt.z, coord.xyzt.t);
+#endif
+    xInOut = coord.xyzt.x;
+    yInOut = coord.xyzt.y;
+    if (pz)
+        *pz = coord.xyzt.z;
+    if (pt)
+        *pt = coord.xyzt.t;
+    int err = 0;
+    if (std::isnan(coord.xyzt.x))
+    {
+        // This shouldn't normally happen if PROJ projections behave
+        // correctly, but e.g inverse laea before PROJ 8.1.1 could
+        // do that for points out of domain.
+        // See https://github.com/OSGeo/PROJ/pull/2800
+        xInOut = HUGE_VAL;
+        yInOut = HUGE_VAL;
+        err = PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN;
+
+#ifdef DEBUG
+        CPLErrorOnce(CE_Warning, CPLE_AppDefined,
+                     "PROJ returned a NaN value. It should be fixed");
+#else
+        CPLDebugOnce("OGR_CT", "PROJ returned a NaN value. It should be fixed");
+#endif
+    }
+    else if (coord.xyzt.x == HUGE_VAL)
+    {
+        err = proj_errno(pj);
+        // PROJ should normally emit an error, but in case it does not
+        // (e.g PROJ 6.3 with the +ortho projection), synthesize one
+        if (err == 0)
+            err = PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN;
+    }
+    else
+    {
+        if (m_recordDifferentOperationsUsed && !m_differentOperationsUsed)
+        {
+#if PROJ_VERSION_MAJOR > 9 ||                                                  \
+    (PROJ_VERSION_MAJOR == 9 && PROJ_VERSION_MINOR >= 1)
+
+            PJ *lastOp = proj_trans_get_last_used_operation(pj);
+            if (lastOp)
+            {
+                const char *projString =
+                    proj_as_proj_string(ctx, lastOp, PJ_PROJ_5, nullptr);
+                if (projString)
+                {
+                    if (m_lastPjUsedPROJString.empty())
+                    {
+                        m_lastPjUsedPROJString = projString;
+                    }
+                    else if (m_lastPjUsedPROJString != projString)
+                    {
+                        m_differentOperationsUsed = true;
+                    }
+                }
+                proj_destroy(lastOp);
+            }
+#else
+            CPL_IGNORE_RET_VAL(ctx);
+#endif
+        }
+
+        if (m_options.d->bCheckWithInvertProj)
+        {
+            // For some projections, we cannot detect if we are trying to
+            // reproject coordinates outside the validity area of the
+            // projection. So let's do the reverse reprojection and compare
+            // with the source coordinates.
+            coord = proj_trans(pj, m_bReversePj ? PJ_FWD : PJ_INV, coord);
+            if (fabs(coord.xyzt.x - xIn) > dfThreshold ||
+                fabs(coord.xyzt.y - yIn) > dfThreshold)
+            {
+                err = PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN;
+                xInOut = HUGE_VAL;
+                yInOut = HUGE_VAL;
+            }
+        }
+    }
+
+    return err;
+}
+
+/************************************************************************/
+/*                   TransformWithProjMultiThreaded()                   */
+/************************************************************************/
+
+/** Transform nCount points with PROJ, by splitting them into chunks that are
+ * processed concurrently by the global thread pool, each chunk with its own
+ * clone of pj.
+ *
+ * panErrorCodes and pabyInvalidInput must be arrays of nCount elements.
+ * pabyInvalidInput[i] is set to 1 when the input coordinate was not finite.
+ * Transformation errors are not reported through CPLError(), but errors
+ * emitted by PROJ in worker threads are replayed in the calling thread.
+ *
+ * @return false if at least one point failed to transform.
+ */
+bool OGRProjCT::TransformWithProjMultiThreaded(
+    PJ *pj, int nThreads, size_t nCount, double *x, double *y, double *z,
+    double *t, double dfDefaultTime, int *panErrorCodes,
+    GByte *pabyInvalidInput)
+{
+    PJ_CONTEXT *ctx = OSRGetProjTLSContext();
+
+    CPLWorkerThreadPool *poPool = GDALGetGlobalThreadPool(nThreads);
+
+    // A PJ object cannot be used concurrently by several threads, hence
+    // each chunk but the first one uses its own clone of it.
+    std::vector<PJ *> apj{pj};
+    for (int i = 1; poPool && i < nThreads; ++i)
+    {
+        PJ *pjClone = proj_clone(ctx, pj);
+        if (!pjClone)
+            break;
+        apj.push_back(pjClone);
+    }
+    const int nChunks = static_cast<int>(apj.size());
+    const size_t nChunkSize = (nCount + nChunks - 1) / nChunks;
+
+    CPLErrorAccumulator oErrorAccumulator;
+
+    const auto ProcessChunk = [this, &apj, nCount, nChunkSize, x, y, z, t,
+                               dfDefaultTime, panErrorCodes,
+                               pabyInvalidInput](int iChunk)
+    {
+        PJ_CONTEXT *ctxChunk = OSRGetProjTLSContext();
+        PJ *pjChunk = apj[iChunk];
+        proj_assign_context(pjChunk, ctxChunk);
+        const size_t iStart = iChunk * nChunkSize;
+        const size_t iEnd = std::min(nCount, iStart + nChunkSize);
+        bool bRetChunk = true;
+        for (size_t i = iStart; i < iEnd; ++i)
+        {
+            pabyInvalidInput[i] = !std::isfinite(x[i]);
+            const int err = TransformPointWithProj(
+                pjChunk, ctxChunk, x[i], y[i], z ? z + i : nullptr,
+                t ? t + i : nullptr, dfDefaultTime);
+            panErrorCodes[i] = err;
+            if (err != 0)
+                bRetChunk = false;
+        }
+        return bRetChunk;
+    };
+
+    // Shared with the jobs, that may outlive this function if they are only
+    // scheduled after all chunks have been processed.
+    struct State
+    {
+        std::atomic<int> nNextChunk{0};
+        std::mutex oMutex{};
+        std::condition_variable oCV{};
+        int nChunksDone = 0;
+        bool bRet = true;
+    };
+
+    auto poState = std::make_shared<State>();
+
+    const auto ProcessChunks =
+        [poState, nChunks, &ProcessChunk,
+         &oErrorAccumulator](bool bAccumulateErrors)
+    {
+        // Only dereference variables of the calling function once a chunk
+        // has been claimed.
+        for (int iChunk = poState->nNextChunk++; iChunk < nChunks;
+             iChunk = poState->nNextChunk++)
+        {
+            bool bRetChunk;
+            if (bAccumulateErrors)
+            {
+                auto oAccumulator = oErrorAccumulator.InstallForCurrentScope();
+                bRetChunk = ProcessChunk(iChunk);
+            }
+            else
+            {
+                bRetChunk = ProcessChunk(iChunk);
+            }
+
+            std::lock_guard oLock(poState->oMutex);
+            if (!bRetChunk)
+                poState->bRet = false;
+            if (++poState->nChunksDone == nChunks)
+                poState->oCV.notify_one();
+        }
+    };
+
+    // The calling thread also processes chunks, so that this does not
+    // deadlock if it is itself a worker thread of the global thread pool.
+    for (int i = 1; i < nChunks; ++i)
+    {
+        poPool->SubmitJob([ProcessChunks]() { ProcessChunks(true); });
+    }
+    ProcessChunks(false);
+
+    bool bRet;
+    {
+        std::unique_lock oLock(poState->oMutex);
+        poState->oCV.wait(oLock, [&poState, nChunks]
+                          { return poState->nChunksDone == nChunks; });
+        bRet = poState->bRet;
+    }
+
+    oErrorAccumulator.ReplayErrors();
+
+    proj_assign_context(pj, ctx);
+    for (int i = 1; i < nChunks; ++i)
+    {
+        proj_assign_context(apj[i], ctx);
+        proj_destroy(apj[i]);
+    }
+
+    return bRet;
+}
+
+/************************************************************************/
+/*                        ReportTransformError()                        */
+/************************************************************************/
+
+/** Try to report an error through CPL. Get proj error string if possible.
+ * Try to avoid reporting thousands of errors. Suppress further error
+ * reporting on this OGRProjCT if we have already reported 20 errors.
+ */
+void OGRProjCT::ReportTransformError(PJ_CONTEXT *ctx, int err, size_t iPoint,
+                                     GUInt32 nLastErrorCounter)
+{
+    if (++nErrorCount < 20)
+    {
+#if PROJ_VERSION_MAJOR >= 8
+        const char *pszError = proj_context_errno_string(ctx, err);
+#else
+        CPL_IGNORE_RET_VAL(ctx);
+        const char *pszError = proj_errno_string(err);
+#endif
+        if (m_bEmitErrors
+#ifdef PROJ_ERR_OTHER_NO_INVERSE_OP
+            || (iPoint == 0 && err == PROJ_ERR_OTHER_NO_INVERSE_OP)
+#endif
+        )
+        {
+            if (nLastErrorCounter != CPLGetErrorCounter() &&
+                CPLGetLastErrorType() == CE_Failure &&
+                strstr(CPLGetLastErrorMsg(), "PROJ:"))
+            {
+                // do nothing
+            }
+            else if (pszError == nullptr)
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Reprojection failed, err = %d", err);
+            else
+                CPLError(CE_Failure, CPLE_AppDefined, "%s", pszError);
+        }
+        else
+        {
+            if (pszError == nullptr)
+                CPLDebug("OGRCT", "Reprojection failed, err = %d", err);
+            else
+                CPLDebug("OGRCT", "%s", pszError);
+        }
+    }
+    else if (nErrorCount == 20)
+    {
+        if (m_bEmitErrors)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Reprojection failed, err = %d, further "
+                     "errors will be "
+                     "suppressed on the transform object.",
+                     err);
+        }
+        else
+        {
+            CPLDebug("OGRCT",
+                     "Reprojection failed, err = %d, further "
+                     "errors will be "
+                     "suppressed on the transform object.",
+                     err);
+        }
+    }
+}
+
+/************************************************************************/
+/*                       TransformWithErrorCodes()                      */
+/************************************************************************/
+
 int OGRProjCT::TransformWithErrorCodes(size_t nCount, double *x, double *y,
                                        double *z, double *t, int *panErrorCodes)
 
@@ -2759,183 +3118,59 @@ int OGRProjCT::TransformWithErrorCodes(size_t nCount, double *x, double *y,
     {
         const auto nLastErrorCounter = CPLGetErrorCounter();
 
-        for (size_t i = 0; i < nCount; i++)
+        const int nThreads = m_recordDifferentOperationsUsed
+                                 ? 1
+                                 : OGRProjCTGetTransformThreadCount(nCount);
+        std::vector<int> anErrorCodesMT;
+        std::vector<GByte> abyInvalidInput;
+        if (nThreads > 1)
         {
-            PJ_COORD coord;
-            const double xIn = x[i];
-            const double yIn = y[i];
-            if (!std::isfinite(xIn))
+            try
             {
-                bRet = FALSE;
-                x[i] = HUGE_VAL;
-                y[i] = HUGE_VAL;
-                if (panErrorCodes)
-                    panErrorCodes[i] = PROJ_ERR_COORD_TRANSFM_INVALID_COORD;
-                continue;
+                if (!panErrorCodes)
+                    anErrorCodesMT.resize(nCount);
+                abyInvalidInput.resize(nCount);
             }
-            coord.xyzt.x = x[i];
-            coord.xyzt.y = y[i];
-            coord.xyzt.z = z ? z[i] : 0;
-            coord.xyzt.t = t ? t[i] : dfDefaultTime;
-            proj_errno_reset(pj);
-            coord = proj_trans(pj, m_bReversePj ? PJ_INV : PJ_FWD, coord);
-#if 0
-            CPLDebug("OGRCT",
-                     "Transforming (x=%f,y=%f,z=%f,time=%f) to "
-                     "(x=%f,y=%f,z=%f,time=%f)",
-                     x[i], y[i], z ? z[i] : 0, t ? t[i] : dfDefaultTime,
-                     coord.xyzt.x, coord.xyzt.y, coord.xyzt.z, coord.xyzt.t);
-#endif
-            x[i] = coord.xyzt.x;
-            y[i] = coord.xyzt.y;
-            if (z)
-                z[i] = coord.xyzt.z;
-            if (t)
-                t[i] = coord.xyzt.t;
-            int err = 0;
-            if (std::isnan(coord.xyzt.x))
+            catch (const std::exception &)
             {
-                bRet = FALSE;
-                // This shouldn't normally happen if PROJ projections behave
-                // correctly, but e.g inverse laea before PROJ 8.1.1 could
-                // do that for points out of domain.
-                // See https://github.com/OSGeo/PROJ/pull/2800
-                x[i] = HUGE_VAL;
-                y[i] = HUGE_VAL;
-                err = PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN;
-
-#ifdef DEBUG
-                CPLErrorOnce(CE_Warning, CPLE_AppDefined,
-                             "PROJ returned a NaN value. It should be fixed");
-#else
-                CPLDebugOnce("OGR_CT",
-                             "PROJ returned a NaN value. It should be fixed");
-#endif
+                // Fallback to the single-threaded code path
+                abyInvalidInput.clear();
             }
-            else if (coord.xyzt.x == HUGE_VAL)
+        }
+
+        if (!abyInvalidInput.empty())
+        {
+            int *panErrorCodesMT =
+                panErrorCodes ? panErrorCodes : anErrorCodesMT.data();
+            if (!TransformWithProjMultiThreaded(
+                    pj, nThreads, nCount, x, y, z, t, dfDefaultTime,
+                    panErrorCodesMT, abyInvalidInput.data()))
             {
                 bRet = FALSE;
-                err = proj_errno(pj);
-                // PROJ should normally emit an error, but in case it does not
-                // (e.g PROJ 6.3 with the +ortho projection), synthesize one
-                if (err == 0)
-                    err = PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN;
             }
-            else
+            for (size_t i = 0; i < nCount; i++)
             {
-                if (m_recordDifferentOperationsUsed &&
-                    !m_differentOperationsUsed)
-                {
-#if PROJ_VERSION_MAJOR > 9 ||                                                  \
-    (PROJ_VERSION_MAJOR == 9 && PROJ_VERSION_MINOR >= 1)
-
-                    PJ *lastOp = proj_trans_get_last_used_operation(pj);
-                    if (lastOp)
-                    {
-                        const char *projString = proj_as_proj_string(
-                            ctx, lastOp, PJ_PROJ_5, nullptr);
-                        if (projString)
-                        {
-                            if (m_lastPjUsedPROJString.empty())
-                            {
-                                m_lastPjUsedPROJString = projString;
-                            }
-                            else if (m_lastPjUsedPROJString != projString)
-                            {
-                                m_differentOperationsUsed = true;
-                            }
-                        }
-                        proj_destroy(lastOp);
-                    }
-#endif
-                }
-
-                if (m_options.d->bCheckWithInvertProj)
-                {
-                    // For some projections, we cannot detect if we are trying to
-                    // reproject coordinates outside the validity area of the
-                    // projection. So let's do the reverse reprojection and compare
-                    // with the source coordinates.
-                    coord =
-                        proj_trans(pj, m_bReversePj ? PJ_FWD : PJ_INV, coord);
-                    if (fabs(coord.xyzt.x - xIn) > dfThreshold ||
-                        fabs(coord.xyzt.y - yIn) > dfThreshold)
-                    {
-                        bRet = FALSE;
-                        err = PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN;
-                        x[i] = HUGE_VAL;
-                        y[i] = HUGE_VAL;
-                    }
-                }
+                const int err = panErrorCodesMT[i];
+                if (err != 0 && !abyInvalidInput[i])
+                    ReportTransformError(ctx, err, i, nLastErrorCounter);
             }
-
-            if (panErrorCodes)
-                panErrorCodes[i] = err;
-
-            /* --------------------------------------------------------------------
-             */
-            /*      Try to report an error through CPL.  Get proj error string
-             */
-            /*      if possible.  Try to avoid reporting thousands of errors. */
-            /*      Suppress further error reporting on this OGRProjCT if we */
-            /*      have already reported 20 errors. */
-            /* --------------------------------------------------------------------
-             */
-            if (err != 0)
+        }
+        else
+        {
+            for (size_t i = 0; i < nCount; i++)
             {
-                if (++nErrorCount < 20)
-                {
-#if PROJ_VERSION_MAJOR >= 8
-                    const char *pszError = proj_context_errno_string(ctx, err);
-#else
-                    const char *pszError = proj_errno_string(err);
-#endif
-                    if (m_bEmitErrors
-#ifdef PROJ_ERR_OTHER_NO_INVERSE_OP
-                        || (i == 0 && err == PROJ_ERR_OTHER_NO_INVERSE_OP)
-#endif
-                    )
-                    {
-                        if (nLastErrorCounter != CPLGetErrorCounter() &&
-                            CPLGetLastErrorType() == CE_Failure &&
-                            strstr(CPLGetLastErrorMsg(), "PROJ:"))
-                        {
-                            // do nothing
-                        }
-                        else if (pszError == nullptr)
-                            CPLError(CE_Failure, CPLE_AppDefined,
-                                     "Reprojection failed, err = %d", err);
-                        else
-                            CPLError(CE_Failure, CPLE_AppDefined, "%s",
-                                     pszError);
-                    }
-                    else
-                    {
-                        if (pszError == nullptr)
-                            CPLDebug("OGRCT", "Reprojection failed, err = %d",
-                                     err);
-                        else
-                            CPLDebug("OGRCT", "%s", pszError);
-                    }
-                }
-                else if (nErrorCount == 20)
+                // Non-finite input coordinates are not reported as errors
+                const bool bValidInput = std::isfinite(x[i]);
+                const int err = TransformPointWithProj(
+                    pj, ctx, x[i], y[i], z ? z + i : nullptr,
+                    t ? t + i : nullptr, dfDefaultTime);
+                if (panErrorCodes)
+                    panErrorCodes[i] = err;
+                if (err != 0)
                 {
-                    if (m_bEmitErrors)
-                    {
-                        CPLError(CE_Failure, CPLE_AppDefined,
-                                 "Reprojection failed, err = %d, further "
-                                 "errors will be "
-                                 "suppressed on the transform object.",
-                                 err);
-                    }
-                    else
-                    {
-                        CPLDebug("OGRCT",
-                                 "Reprojection failed, err = %d, further "
-                                 "errors will be "
-                                 "suppressed on the transform object.",
-                                 err);
-                    }
+                    bRet = FALSE;
+                    if (bValidInput)
+                        ReportTransformError(ctx, err, i, nLastErrorCounter);
                 }
             }
         }
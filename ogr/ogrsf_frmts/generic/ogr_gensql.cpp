@@ -19,10 +19,13 @@
 #include "ogr_recordbatch.h"
 #include "ogrlayerarrow.h"
 #include "cpl_time.h"
+#include "cpl_vsi_virtual.h"
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 //! @cond Doxygen_Suppress
@@ -46,6 +49,62 @@ class OGRGenSQLGeomFieldDefn final : public OGRGeomFieldDefn
 
 OGRGenSQLGeomFieldDefn::~OGRGenSQLGeomFieldDefn() = default;
 
+/************************************************************************/
+/*                 OGRGenSQLResultsLayer::SortRun                       */
+/************************************************************************/
+
+// A sequence of records sorted according to the ORDER BY clause, stored in
+// a temporary file. Each record is made of the source FID, of the ORDER BY
+// key values, and optionally of the serialized source feature.
+struct OGRGenSQLResultsLayer::SortRun
+{
+    std::string osFilename{};
+    VSIVirtualHandleUniquePtr fp{};
+    std::vector<GByte> abyBuffer{};
+    bool bHasFeatures = false;
+
+    // Current record
+    GIntBig nFID = 0;
+    std::vector<OGRField> asFields{};
+    std::vector<std::string> aosStrings{};
+    std::vector<GByte> abyFeature{};
+
+    SortRun() = default;
+
+    ~SortRun()
+    {
+        fp.reset();
+        if (!osFilename.empty())
+            VSIUnlink(osFilename.c_str());
+    }
+
+    SortRun(const SortRun &) = delete;
+    SortRun &operator=(const SortRun &) = delete;
+};
+
+/************************************************************************/
+/*               OGRGenSQLResultsLayer::SortRunMerger                   */
+/************************************************************************/
+
+// k-way merge of sorted runs
+struct OGRGenSQLResultsLayer::SortRunMerger
+{
+    bool bCarryFeatures = false;
+    std::vector<std::unique_ptr<SortRun>> apoRuns{};
+
+    // Indices in apoRuns[] of the runs that have a pending record,
+    // organized as a heap whose top is the smallest record.
+    std::vector<size_t> anHeap{};
+
+    static constexpr size_t NO_RUN = std::numeric_limits<size_t>::max();
+
+    // Run whose current record has been returned last
+    size_t nLastRun = NO_RUN;
+
+    // Number of records returned since the merge was started
+    GIntBig nReturned = 0;
+};
+
 /************************************************************************/
 /*               OGRGenSQLResultsLayerHasSpecialField()                 */
 /************************************************************************/
@@ -644,7 +703,9 @@ OGRErr OGRGenSQLResultsLayer::SetNextByIndex(GIntBig nIndex)
         return OGRERR_NON_EXISTING_FEATURE;
     }
     if (psSelectInfo->query_mode == SWQM_SUMMARY_RECORD ||
-        psSelectInfo->query_mode == SWQM_DISTINCT_LIST || !m_anFIDIndex.empty())
+        psSelectInfo->query_mode == SWQM_DISTINCT_LIST ||
+        psSelectInfo->query_mode == SWQM_GROUP_BY || !m_anFIDIndex.empty() ||
+        m_poSortRunMerger)
     {
         m_nNextIndexFID = nIndex + psSelectInfo->offset;
         return OGRERR_NONE;
@@ -703,6 +764,13 @@ GIntBig OGRGenSQLResultsLayer::GetFeatureCount(int bForce)
 
         nRet = psSelectInfo->column_summary[0].count;
     }
+    else if (psSelectInfo->query_mode == SWQM_GROUP_BY)
+    {
+        if (!PrepareGroupBy())
+            return 0;
+
+        nRet = static_cast<GIntBig>(m_apoGroupByFeatures.size());
+    }
     else if (psSelectInfo->query_mode != SWQM_RECORDSET)
         return 1;
     else if (m_poAttrQuery == nullptr && !MustEvaluateSpatialFilterOnGenSQL())
@@ -735,8 +803,11 @@ int OGRGenSQLResultsLayer::TestCapability(const char *pszCap) const
     {
         if (psSelectInfo->query_mode == SWQM_SUMMARY_RECORD ||
             psSelectInfo->query_mode == SWQM_DISTINCT_LIST ||
+            psSelectInfo->query_mode == SWQM_GROUP_BY ||
             !m_anFIDIndex.empty())
             return TRUE;
+        else if (m_poSortRunMerger)
+            return FALSE;
         else
             return m_poSrcLayer->TestCapability(pszCap);
     }
@@ -746,6 +817,12 @@ int OGRGenSQLResultsLayer::TestCapability(const char *pszCap) const
          EQUAL(pszCap, OLCFastGetExtent)))
         return m_poSrcLayer->TestCapability(pszCap);
 
+    else if (psSelectInfo->query_mode == SWQM_GROUP_BY)
+    {
+        if (EQUAL(pszCap, OLCFastFeatureCount))
+            return m_bGroupByDone;
+    }
+
     else if (psSelectInfo->query_mode != SWQM_RECORDSET)
     {
         if (EQUAL(pszCap, OLCFastFeatureCount))
@@ -848,6 +925,71 @@ int OGRGenSQLResultsLayer::ContainGeomSpecialField(
     return FALSE;
 }
 
+/************************************************************************/
+/*                        GetSummaryInputValue()                        */
+/*                                                                      */
+/*      Fetch the value of a source feature to accumulate into the      */
+/*      summary of a column, following the conventions of               */
+/*      swq_select_summarize(). Returns false if the feature must not   */
+/*      be accounted for that column.                                   */
+/************************************************************************/
+
+static bool GetSummaryInputValue(const swq_col_def *psColDef,
+                                 OGRFeatureDefn *poSrcLayerDefn,
+                                 OGRFeature *poSrcFeature,
+                                 const char *&pszValue, double &dfValue,
+                                 const double *&pdfValue)
+{
+    pszValue = nullptr;
+    pdfValue = nullptr;
+
+    if (psColDef->col_func == SWQCF_COUNT)
+    {
+        /* psColDef->field_index can be -1 in the case of a COUNT(*) */
+        if (psColDef->field_index < 0)
+        {
+            pszValue = "";
+        }
+        else if (IS_GEOM_FIELD_INDEX(poSrcLayerDefn, psColDef->field_index))
+        {
+            const int iSrcGeomField = ALL_FIELD_INDEX_TO_GEOM_FIELD_INDEX(
+                poSrcLayerDefn, psColDef->field_index);
+            if (poSrcFeature->GetGeomFieldRef(iSrcGeomField) == nullptr)
+                return false;
+            pszValue = "";
+        }
+        else if (poSrcFeature->IsFieldSetAndNotNull(psColDef->field_index))
+        {
+            pszValue = psColDef->distinct_flag
+                           ? poSrcFeature->GetFieldAsString(
+                                 psColDef->field_index)
+                           : "";
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else if (poSrcFeature->IsFieldSetAndNotNull(psColDef->field_index))
+    {
+        if (!psColDef->distinct_flag &&
+            (psColDef->field_type == SWQ_BOOLEAN ||
+             psColDef->field_type == SWQ_INTEGER ||
+             psColDef->field_type == SWQ_INTEGER64 ||
+             psColDef->field_type == SWQ_FLOAT))
+        {
+            dfValue = poSrcFeature->GetFieldAsDouble(psColDef->field_index);
+            pdfValue = &dfValue;
+        }
+        else
+        {
+            pszValue = poSrcFeature->GetFieldAsString(psColDef->field_index);
+        }
+    }
+
+    return true;
+}
+
 /************************************************************************/
 /*                           PrepareSummary()                           */
 /************************************************************************/
@@ -976,69 +1118,15 @@ bool OGRGenSQLResultsLayer::PrepareSummary() const
             const swq_col_def *psColDef = &psSelectInfo->column_defs[iField];
             const char *pszError = nullptr;
 
-            if (psColDef->col_func == SWQCF_COUNT)
+            const char *pszValue = nullptr;
+            double dfValue = 0;
+            const double *pdfValue = nullptr;
+            if (GetSummaryInputValue(psColDef, poSrcLayerDefn,
+                                     poSrcFeature.get(), pszValue, dfValue,
+                                     pdfValue))
             {
-                /* psColDef->field_index can be -1 in the case of a COUNT(*) */
-                if (psColDef->field_index < 0)
-                    pszError =
-                        swq_select_summarize(psSelectInfo, iField, "", nullptr);
-                else if (IS_GEOM_FIELD_INDEX(poSrcLayerDefn,
-                                             psColDef->field_index))
-                {
-                    const int iSrcGeomField =
-                        ALL_FIELD_INDEX_TO_GEOM_FIELD_INDEX(
-                            poSrcLayerDefn, psColDef->field_index);
-                    const OGRGeometry *poGeom =
-                        poSrcFeature->GetGeomFieldRef(iSrcGeomField);
-                    if (poGeom != nullptr)
-                        pszError = swq_select_summarize(psSelectInfo, iField,
-                                                        "", nullptr);
-                }
-                else if (poSrcFeature->IsFieldSetAndNotNull(
-                             psColDef->field_index))
-                {
-                    if (!psColDef->distinct_flag)
-                    {
-                        pszError = swq_select_summarize(psSelectInfo, iField,
-                                                        "", nullptr);
-                    }
-                    else
-                    {
-                        const char *pszVal = poSrcFeature->GetFieldAsString(
-                            psColDef->field_index);
-                        pszError = swq_select_summarize(psSelectInfo, iField,
-                                                        pszVal, nullptr);
-                    }
-                }
-            }
-            else
-            {
-                if (poSrcFeature->IsFieldSetAndNotNull(psColDef->field_index))
-                {
-                    if (!psColDef->distinct_flag &&
-                        (psColDef->field_type == SWQ_BOOLEAN ||
-                         psColDef->field_type == SWQ_INTEGER ||
-                         psColDef->field_type == SWQ_INTEGER64 ||
-                         psColDef->field_type == SWQ_FLOAT))
-                    {
-                        const double dfValue = poSrcFeature->GetFieldAsDouble(
-                            psColDef->field_index);
-                        pszError = swq_select_summarize(psSelectInfo, iField,
-                                                        nullptr, &dfValue);
-                    }
-                    else
-                    {
-                        const char *pszVal = poSrcFeature->GetFieldAsString(
-                            psColDef->field_index);
-                        pszError = swq_select_summarize(psSelectInfo, iField,
-                                                        pszVal, nullptr);
-                    }
-                }
-                else
-                {
-                    pszError = swq_select_summarize(psSelectInfo, iField,
-                                                    nullptr, nullptr);
-                }
+                pszError = swq_select_summarize(psSelectInfo, iField, pszValue,
+                                                pdfValue);
             }
 
             if (pszError)
@@ -1092,126 +1180,431 @@ bool OGRGenSQLResultsLayer::PrepareSummary() const
             const swq_col_def *psColDef = &psSelectInfo->column_defs[iField];
             if (!psSelectInfo->column_summary.empty())
             {
-                const swq_summary &oSummary =
-                    psSelectInfo->column_summary[iField];
+                SetSummaryFieldValue(m_poSummaryFeature.get(), iField,
+                                     psColDef,
+                                     psSelectInfo->column_summary[iField]);
+            }
+            else if (psColDef->col_func == SWQCF_COUNT)
+                m_poSummaryFeature->SetField(iField, 0);
+        }
+    }
+
+    return TRUE;
+}
 
-                switch (psColDef->col_func)
+/************************************************************************/
+/*                        SetSummaryFieldValue()                        */
+/*                                                                      */
+/*      Set the value of a column function result from its summary.     */
+/************************************************************************/
+
+void OGRGenSQLResultsLayer::SetSummaryFieldValue(
+    OGRFeature *poFeature, int iDstField, const swq_col_def *psColDef,
+    const swq_summary &oSummary) const
+{
+    switch (psColDef->col_func)
+    {
+        case SWQCF_NONE:
+        case SWQCF_CUSTOM:
+            break;
+
+        case SWQCF_AVG:
+        {
+            if (oSummary.count > 0)
+            {
+                const double dfAvg = oSummary.sum() / oSummary.count;
+                if (psColDef->field_type == SWQ_DATE ||
+                    psColDef->field_type == SWQ_TIME ||
+                    psColDef->field_type == SWQ_TIMESTAMP)
                 {
-                    case SWQCF_NONE:
-                    case SWQCF_CUSTOM:
-                        break;
+                    struct tm brokendowntime;
+                    CPLUnixTimeToYMDHMS(static_cast<GIntBig>(dfAvg),
+                                        &brokendowntime);
+                    poFeature->SetField(
+                        iDstField, brokendowntime.tm_year + 1900,
+                        brokendowntime.tm_mon + 1, brokendowntime.tm_mday,
+                        brokendowntime.tm_hour, brokendowntime.tm_min,
+                        static_cast<float>(brokendowntime.tm_sec +
+                                           fmod(dfAvg, 1)),
+                        0);
+                }
+                else
+                {
+                    poFeature->SetField(iDstField, dfAvg);
+                }
+            }
+            break;
+        }
 
-                    case SWQCF_AVG:
-                    {
-                        if (oSummary.count > 0)
-                        {
-                            const double dfAvg =
-                                oSummary.sum() / oSummary.count;
-                            if (psColDef->field_type == SWQ_DATE ||
-                                psColDef->field_type == SWQ_TIME ||
-                                psColDef->field_type == SWQ_TIMESTAMP)
-                            {
-                                struct tm brokendowntime;
-                                CPLUnixTimeToYMDHMS(static_cast<GIntBig>(dfAvg),
-                                                    &brokendowntime);
-                                m_poSummaryFeature->SetField(
-                                    iField, brokendowntime.tm_year + 1900,
-                                    brokendowntime.tm_mon + 1,
-                                    brokendowntime.tm_mday,
-                                    brokendowntime.tm_hour,
-                                    brokendowntime.tm_min,
-                                    static_cast<float>(brokendowntime.tm_sec +
-                                                       fmod(dfAvg, 1)),
-                                    0);
-                            }
-                            else
-                            {
-                                m_poSummaryFeature->SetField(iField, dfAvg);
-                            }
-                        }
-                        break;
-                    }
+        case SWQCF_MIN:
+        {
+            if (oSummary.count > 0)
+            {
+                if (psColDef->field_type == SWQ_DATE ||
+                    psColDef->field_type == SWQ_TIME ||
+                    psColDef->field_type == SWQ_TIMESTAMP ||
+                    psColDef->field_type == SWQ_STRING)
+                    poFeature->SetField(iDstField, oSummary.osMin.c_str());
+                else
+                    poFeature->SetField(iDstField, oSummary.min);
+            }
+            break;
+        }
 
-                    case SWQCF_MIN:
-                    {
-                        if (oSummary.count > 0)
-                        {
-                            if (psColDef->field_type == SWQ_DATE ||
-                                psColDef->field_type == SWQ_TIME ||
-                                psColDef->field_type == SWQ_TIMESTAMP ||
-                                psColDef->field_type == SWQ_STRING)
-                                m_poSummaryFeature->SetField(
-                                    iField, oSummary.osMin.c_str());
-                            else
-                                m_poSummaryFeature->SetField(iField,
-                                                             oSummary.min);
-                        }
-                        break;
-                    }
+        case SWQCF_MAX:
+        {
+            if (oSummary.count > 0)
+            {
+                if (psColDef->field_type == SWQ_DATE ||
+                    psColDef->field_type == SWQ_TIME ||
+                    psColDef->field_type == SWQ_TIMESTAMP ||
+                    psColDef->field_type == SWQ_STRING)
+                    poFeature->SetField(iDstField, oSummary.osMax.c_str());
+                else
+                    poFeature->SetField(iDstField, oSummary.max);
+            }
+            break;
+        }
+
+        case SWQCF_COUNT:
+        {
+            poFeature->SetField(iDstField, oSummary.count);
+            break;
+        }
+
+        case SWQCF_SUM:
+        {
+            if (oSummary.count > 0)
+                poFeature->SetField(iDstField, oSummary.sum());
+            break;
+        }
+
+        case SWQCF_STDDEV_POP:
+        {
+            if (oSummary.count > 0)
+            {
+                const double dfVariance =
+                    oSummary.sq_dist_from_mean_acc / oSummary.count;
+                poFeature->SetField(iDstField, sqrt(dfVariance));
+            }
+            break;
+        }
+
+        case SWQCF_STDDEV_SAMP:
+        {
+            if (oSummary.count > 1)
+            {
+                const double dfSampleVariance =
+                    oSummary.sq_dist_from_mean_acc / (oSummary.count - 1);
+                poFeature->SetField(iDstField, sqrt(dfSampleVariance));
+            }
+            break;
+        }
+    }
+}
+
+/************************************************************************/
+/*                           PrepareGroupBy()                           */
+/*                                                                      */
+/*      Compute the result of a GROUP BY query in a single pass over    */
+/*      the source layer.  Groups are looked up in a hash table keyed   */
+/*      on a binary serialization of the GROUP BY field values, and     */
+/*      each group accumulates its own column summaries.  Only one      */
+/*      feature per group is kept in memory.                            */
+/************************************************************************/
+
+bool OGRGenSQLResultsLayer::PrepareGroupBy()
+
+{
+    if (m_bGroupByDone)
+        return true;
+
+    swq_select *psSelectInfo = m_pSelectInfo.get();
+    OGRFeatureDefn *poSrcLayerDefn = m_poSrcLayer->GetLayerDefn();
+    const int nOrderItems = psSelectInfo->order_specs;
+    const int nColumns = psSelectInfo->result_columns();
+
+    /* -------------------------------------------------------------------- */
+    /*      Map result columns to fields of the output layer definition.    */
+    /* -------------------------------------------------------------------- */
+    std::vector<int> anDstField(nColumns, -1);
+    for (int iField = 0, iDstField = 0; iField < nColumns; iField++)
+    {
+        if (!psSelectInfo->column_defs[iField].bHidden)
+            anDstField[iField] = iDstField++;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Determine how to serialize the GROUP BY keys.                   */
+    /* -------------------------------------------------------------------- */
+    std::vector<std::pair<int, OGRFieldType>> aoKeyFields;
+    for (int iKey = 0; iKey < psSelectInfo->group_by_count; iKey++)
+    {
+        const int iSrcField = psSelectInfo->group_by_defs[iKey].field_index;
+        OGRFieldType eType = OFTString;
+        if (iSrcField < m_iFIDFieldIndex)
+        {
+            eType = poSrcLayerDefn->GetFieldDefn(iSrcField)->GetType();
+        }
+        else
+        {
+            switch (SpecialFieldTypes[iSrcField - m_iFIDFieldIndex])
+            {
+                case SWQ_INTEGER:
+                case SWQ_INTEGER64:
+                    eType = OFTInteger64;
+                    break;
+                case SWQ_FLOAT:
+                    eType = OFTReal;
+                    break;
+                default:
+                    break;
+            }
+        }
+        aoKeyFields.emplace_back(iSrcField, eType);
+    }
+
+    std::vector<swq_summary> aoInitialSummaries(nColumns);
+    for (int iField = 0; iField < nColumns; iField++)
+    {
+        const swq_col_def *psColDef = &psSelectInfo->column_defs[iField];
+        if (psColDef->distinct_flag)
+        {
+            swq_summary::Comparator oComparator;
+            if (psColDef->field_type == SWQ_INTEGER ||
+                psColDef->field_type == SWQ_INTEGER64)
+                oComparator.eType = SWQ_INTEGER64;
+            else if (psColDef->field_type == SWQ_FLOAT)
+                oComparator.eType = SWQ_FLOAT;
+            aoInitialSummaries[iField].oSetDistinctValues =
+                std::set<CPLString, swq_summary::Comparator>(oComparator);
+        }
+    }
+
+    struct Group
+    {
+        std::unique_ptr<OGRFeature> poFeature{};
+        std::vector<swq_summary> aoSummaries{};
+    };
+
+    std::vector<Group> aoGroups;
+    std::unordered_map<std::string, size_t> oMapKeyToGroup;
+    // nOrderItems values per group, to sort groups with Compare()
+    std::vector<OGRField> asIndexFields;
+    const char *pszError = nullptr;
+
+    ApplyFiltersToSource();
+
+    try
+    {
+        std::string osKey;
+        for (auto &&poSrcFeature : *m_poSrcLayer)
+        {
+            /* ------------------------------------------------------------ */
+            /*      Build the group key.                                    */
+            /* ------------------------------------------------------------ */
+            osKey.clear();
+            for (const auto &[iSrcField, eType] : aoKeyFields)
+            {
+                if (!poSrcFeature->IsFieldSetAndNotNull(iSrcField))
+                {
+                    osKey += '\0';
+                    continue;
+                }
+                osKey += '\1';
+                if (eType == OFTInteger || eType == OFTInteger64)
+                {
+                    const GIntBig nVal =
+                        poSrcFeature->GetFieldAsInteger64(iSrcField);
+                    osKey.append(reinterpret_cast<const char *>(&nVal),
+                                 sizeof(nVal));
+                }
+                else if (eType == OFTReal)
+                {
+                    double dfVal = poSrcFeature->GetFieldAsDouble(iSrcField);
+                    // Make -0 and 0, and all NaN values, fall in the same group
+                    if (dfVal == 0)
+                        dfVal = 0;
+                    else if (std::isnan(dfVal))
+                        dfVal = std::numeric_limits<double>::quiet_NaN();
+                    osKey.append(reinterpret_cast<const char *>(&dfVal),
+                                 sizeof(dfVal));
+                }
+                else
+                {
+                    const char *pszVal =
+                        poSrcFeature->GetFieldAsString(iSrcField);
+                    const size_t nLen = strlen(pszVal);
+                    osKey.append(reinterpret_cast<const char *>(&nLen),
+                                 sizeof(nLen));
+                    osKey.append(pszVal, nLen);
+                }
+            }
 
-                    case SWQCF_MAX:
+            /* ------------------------------------------------------------ */
+            /*      Find or create the group.                               */
+            /* ------------------------------------------------------------ */
+            const auto oInsertPair =
+                oMapKeyToGroup.emplace(osKey, aoGroups.size());
+            if (oInsertPair.second)
+            {
+                Group oGroup;
+                oGroup.poFeature = std::make_unique<OGRFeature>(m_poDefn);
+                oGroup.aoSummaries = aoInitialSummaries;
+                for (int iField = 0; iField < nColumns; iField++)
+                {
+                    const swq_col_def *psColDef =
+                        &psSelectInfo->column_defs[iField];
+                    const int iDstField = anDstField[iField];
+                    if (psColDef->col_func != SWQCF_NONE || iDstField < 0)
+                        continue;
+                    const int iSrcField = psColDef->field_index;
+                    OGRFeature *poDstFeature = oGroup.poFeature.get();
+                    if (!poSrcFeature->IsFieldSetAndNotNull(iSrcField))
                     {
-                        if (oSummary.count > 0)
-                        {
-                            if (psColDef->field_type == SWQ_DATE ||
-                                psColDef->field_type == SWQ_TIME ||
-                                psColDef->field_type == SWQ_TIMESTAMP ||
-                                psColDef->field_type == SWQ_STRING)
-                                m_poSummaryFeature->SetField(
-                                    iField, oSummary.osMax.c_str());
-                            else
-                                m_poSummaryFeature->SetField(iField,
-                                                             oSummary.max);
-                        }
-                        break;
+                        poDstFeature->SetFieldNull(iDstField);
+                        continue;
                     }
-
-                    case SWQCF_COUNT:
+                    const OGRFieldType eDstType =
+                        m_poDefn->GetFieldDefn(iDstField)->GetType();
+                    if (iSrcField < m_iFIDFieldIndex &&
+                        poSrcLayerDefn->GetFieldDefn(iSrcField)->GetType() ==
+                            eDstType)
                     {
-                        m_poSummaryFeature->SetField(iField, oSummary.count);
-                        break;
+                        poDstFeature->SetField(
+                            iDstField, poSrcFeature->GetRawFieldRef(iSrcField));
                     }
-
-                    case SWQCF_SUM:
+                    else if (eDstType == OFTInteger ||
+                             eDstType == OFTInteger64)
                     {
-                        if (oSummary.count > 0)
-                            m_poSummaryFeature->SetField(iField,
-                                                         oSummary.sum());
-                        break;
+                        poDstFeature->SetField(
+                            iDstField,
+                            poSrcFeature->GetFieldAsInteger64(iSrcField));
                     }
-
-                    case SWQCF_STDDEV_POP:
+                    else if (eDstType == OFTReal)
                     {
-                        if (oSummary.count > 0)
-                        {
-                            const double dfVariance =
-                                oSummary.sq_dist_from_mean_acc / oSummary.count;
-                            m_poSummaryFeature->SetField(iField,
-                                                         sqrt(dfVariance));
-                        }
-                        break;
+                        poDstFeature->SetField(
+                            iDstField,
+                            poSrcFeature->GetFieldAsDouble(iSrcField));
                     }
-
-                    case SWQCF_STDDEV_SAMP:
+                    else
                     {
-                        if (oSummary.count > 1)
-                        {
-                            const double dfSampleVariance =
-                                oSummary.sq_dist_from_mean_acc /
-                                (oSummary.count - 1);
-                            m_poSummaryFeature->SetField(
-                                iField, sqrt(dfSampleVariance));
-                        }
-                        break;
+                        poDstFeature->SetField(
+                            iDstField,
+                            poSrcFeature->GetFieldAsString(iSrcField));
                     }
                 }
+                aoGroups.push_back(std::move(oGroup));
+
+                if (nOrderItems > 0)
+                {
+                    asIndexFields.resize(asIndexFields.size() + nOrderItems);
+                    ReadIndexFields(poSrcFeature.get(), nOrderItems,
+                                    asIndexFields.data() +
+                                        asIndexFields.size() - nOrderItems);
+                }
             }
-            else if (psColDef->col_func == SWQCF_COUNT)
-                m_poSummaryFeature->SetField(iField, 0);
+            Group &oGroup = aoGroups[oInsertPair.first->second];
+
+            /* ------------------------------------------------------------ */
+            /*      Accumulate the column functions.                        */
+            /* ------------------------------------------------------------ */
+            for (int iField = 0; iField < nColumns && !pszError; iField++)
+            {
+                const swq_col_def *psColDef =
+                    &psSelectInfo->column_defs[iField];
+                if (psColDef->col_func == SWQCF_NONE)
+                    continue;
+
+                const char *pszValue = nullptr;
+                double dfValue = 0;
+                const double *pdfValue = nullptr;
+                if (!GetSummaryInputValue(psColDef, poSrcLayerDefn,
+                                          poSrcFeature.get(), pszValue,
+                                          dfValue, pdfValue))
+                    continue;
+
+                swq_summary &oSummary = oGroup.aoSummaries[iField];
+                if (psColDef->distinct_flag)
+                {
+                    if (oSummary.oSetDistinctValues
+                            .insert(pszValue ? pszValue : SZ_OGR_NULL)
+                            .second)
+                        oSummary.count++;
+                }
+                else
+                {
+                    pszError = swq_summary_accumulate(psColDef, oSummary,
+                                                      pszValue, pdfValue);
+                }
+            }
+            if (pszError)
+                break;
         }
     }
+    catch (const std::bad_alloc &)
+    {
+        pszError = "Out of memory";
+    }
 
-    return TRUE;
+    ClearFilters();
+
+    if (pszError)
+    {
+        FreeIndexFields(asIndexFields.data(), asIndexFields.size() /
+                                                  std::max(nOrderItems, 1));
+        CPLError(CE_Failure, CPLE_AppDefined, "%s", pszError);
+        return false;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Set the column function results.                                */
+    /* -------------------------------------------------------------------- */
+    for (auto &oGroup : aoGroups)
+    {
+        for (int iField = 0; iField < nColumns; iField++)
+        {
+            const swq_col_def *psColDef = &psSelectInfo->column_defs[iField];
+            if (psColDef->col_func != SWQCF_NONE && anDstField[iField] >= 0)
+            {
+                SetSummaryFieldValue(oGroup.poFeature.get(), anDstField[iField],
+                                     psColDef, oGroup.aoSummaries[iField]);
+            }
+        }
+        oGroup.aoSummaries.clear();
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Order the groups, if requested.                                 */
+    /* -------------------------------------------------------------------- */
+    std::vector<size_t> anOrder(aoGroups.size());
+    for (size_t i = 0; i < anOrder.size(); ++i)
+        anOrder[i] = i;
+    if (nOrderItems > 0)
+    {
+        std::stable_sort(anOrder.begin(), anOrder.end(),
+                         [this, &asIndexFields, nOrderItems](size_t a, size_t b)
+                         {
+                             return Compare(&asIndexFields[a * nOrderItems],
+                                            &asIndexFields[b * nOrderItems]) <
+                                    0;
+                         });
+        FreeIndexFields(asIndexFields.data(), aoGroups.size());
+    }
+
+    m_apoGroupByFeatures.reserve(aoGroups.size());
+    for (size_t i = 0; i < anOrder.size(); ++i)
+    {
+        auto &poFeature = aoGroups[anOrder[i]].poFeature;
+        poFeature->SetFID(static_cast<GIntBig>(i));
+        m_apoGroupByFeatures.push_back(std::move(poFeature));
+    }
+
+    CPLDebug("GenSQL", "GROUP BY: " CPL_FRMT_GUIB " groups",
+             static_cast<GUIntBig>(aoGroups.size()));
+    m_bGroupByDone = true;
+
+    return true;
 }
 
 /************************************************************************/
@@ -1476,10 +1869,374 @@ static CPLString GetFilterForJoin(swq_expr_node *poExpr, OGRFeature *poSrcFeat,
         for (int i = 0; i < poExpr->nSubExprCount; i++)
             CPLFree(apszSubExpr[i]);
 
-        return osExpr;
+        return osExpr;
+    }
+
+    return "";
+}
+
+/************************************************************************/
+/*                       GetJoinHashKeyFields()                         */
+/************************************************************************/
+
+// Determine if the ON expression of a join is of the form
+// "primary.field = secondary.field" (or the reverse), with fields of
+// compatible types, in which case a hash join can be used.
+static bool GetJoinHashKeyFields(const swq_expr_node *poExpr,
+                                 int secondary_table, OGRLayer *poPrimaryLayer,
+                                 OGRLayer *poJoinLayer, int &iPrimaryField,
+                                 int &iSecondaryField, OGRFieldType &eKeyType,
+                                 std::string &osReason)
+{
+    if (poExpr->eNodeType != SNT_OPERATION || poExpr->nOperation != SWQ_EQ ||
+        poExpr->nSubExprCount != 2 ||
+        poExpr->papoSubExpr[0]->eNodeType != SNT_COLUMN ||
+        poExpr->papoSubExpr[1]->eNodeType != SNT_COLUMN)
+    {
+        osReason = "ON expression is not a single equality between fields";
+        return false;
+    }
+
+    const swq_expr_node *poPrimary = poExpr->papoSubExpr[0];
+    const swq_expr_node *poSecondary = poExpr->papoSubExpr[1];
+    if (poPrimary->table_index == secondary_table &&
+        poSecondary->table_index == 0)
+    {
+        std::swap(poPrimary, poSecondary);
+    }
+    if (poPrimary->table_index != 0 ||
+        poSecondary->table_index != secondary_table)
+    {
+        osReason = "ON expression does not compare the primary and "
+                   "secondary tables";
+        return false;
+    }
+
+    const OGRFeatureDefn *poPrimaryDefn = poPrimaryLayer->GetLayerDefn();
+    const OGRFeatureDefn *poSecondaryDefn = poJoinLayer->GetLayerDefn();
+    if (poPrimary->field_index < 0 ||
+        poPrimary->field_index >= poPrimaryDefn->GetFieldCount() ||
+        poSecondary->field_index < 0 ||
+        poSecondary->field_index >= poSecondaryDefn->GetFieldCount())
+    {
+        osReason = "join key is a special field";
+        return false;
+    }
+
+    const auto GetKeyType = [](OGRFieldType eType)
+    {
+        return eType == OFTInteger ? OFTInteger64 : eType;
+    };
+    const OGRFieldType ePrimaryType = GetKeyType(
+        poPrimaryDefn->GetFieldDefn(poPrimary->field_index)->GetType());
+    const OGRFieldType eSecondaryType = GetKeyType(
+        poSecondaryDefn->GetFieldDefn(poSecondary->field_index)->GetType());
+    if (ePrimaryType != eSecondaryType ||
+        (ePrimaryType != OFTInteger64 && ePrimaryType != OFTReal &&
+         ePrimaryType != OFTString))
+    {
+        osReason = "join key fields are not of the same Integer, Real or "
+                   "String type";
+        return false;
+    }
+
+    iPrimaryField = poPrimary->field_index;
+    iSecondaryField = poSecondary->field_index;
+    eKeyType = ePrimaryType;
+    return true;
+}
+
+/************************************************************************/
+/*                     IsTimestampLikeJoinKey()                         */
+/************************************************************************/
+
+// String equality in OGR SQL has special rules to compare timestamps with
+// and without a "+00" timezone suffix (see swq_op_general.cpp). Keys that
+// could trigger them cannot be looked up in a hash table.
+static bool IsTimestampLikeJoinKey(const char *pszKey)
+{
+    const size_t nLen = strlen(pszKey);
+    return nLen > 3 &&
+           (strcmp(pszKey + nLen - 3, "+00") == 0 || pszKey[nLen - 3] == ':');
+}
+
+/************************************************************************/
+/*                       GetJoinHashStringKey()                         */
+/************************************************************************/
+
+// String equality in OGR SQL is case insensitive.
+static std::string GetJoinHashStringKey(const char *pszKey)
+{
+    return CPLString(pszKey).toupper();
+}
+
+/************************************************************************/
+/*                       EstimateFeatureMemory()                        */
+/************************************************************************/
+
+static size_t EstimateFeatureMemory(const OGRFeature *poFeature)
+{
+    const OGRFeatureDefn *poDefn = poFeature->GetDefnRef();
+    const int nFieldCount = poDefn->GetFieldCount();
+    size_t nSize = sizeof(OGRFeature) + nFieldCount * sizeof(OGRField);
+    for (int i = 0; i < nFieldCount; ++i)
+    {
+        if (!poFeature->IsFieldSetAndNotNull(i))
+            continue;
+        const OGRField *psField = poFeature->GetRawFieldRef(i);
+        switch (poDefn->GetFieldDefn(i)->GetType())
+        {
+            case OFTString:
+                nSize += strlen(psField->String) + 1;
+                break;
+            case OFTIntegerList:
+                nSize += psField->IntegerList.nCount * sizeof(int);
+                break;
+            case OFTInteger64List:
+                nSize += psField->Integer64List.nCount * sizeof(GIntBig);
+                break;
+            case OFTRealList:
+                nSize += psField->RealList.nCount * sizeof(double);
+                break;
+            case OFTStringList:
+                for (int j = 0; j < psField->StringList.nCount; ++j)
+                    nSize += sizeof(char *) +
+                             strlen(psField->StringList.paList[j]) + 1;
+                break;
+            case OFTBinary:
+                nSize += psField->Binary.nCount;
+                break;
+            default:
+                break;
+        }
+    }
+    for (int i = 0; i < poDefn->GetGeomFieldCount(); ++i)
+    {
+        const OGRGeometry *poGeom = poFeature->GetGeomFieldRef(i);
+        if (poGeom)
+            nSize += poGeom->WkbSize();
+    }
+    return nSize;
+}
+
+/************************************************************************/
+/*                         BuildJoinHashTable()                         */
+/************************************************************************/
+
+bool OGRGenSQLResultsLayer::BuildJoinHashTable(int iJoin, int iSecondaryField,
+                                               std::string &osReason)
+{
+    const swq_join_def *psJoinInfo = m_pSelectInfo->join_defs + iJoin;
+    OGRLayer *poJoinLayer = m_apoTableLayers[psJoinInfo->secondary_table];
+    JoinState &oState = m_aoJoinStates[iJoin];
+
+    const char *pszMaxMem =
+        CPLGetConfigOption("OGR_GENSQL_JOIN_HASH_MAX_MEMORY", "10%");
+    GIntBig nMaxMem = 0;
+    if (CPLParseMemorySize(pszMaxMem, &nMaxMem, nullptr) != CE_None)
+    {
+        osReason = "invalid value for OGR_GENSQL_JOIN_HASH_MAX_MEMORY";
+        return false;
+    }
+
+    // Overhead of a hash table entry, and of its key
+    constexpr size_t ENTRY_OVERHEAD = 64;
+
+    poJoinLayer->SetAttributeFilter(nullptr);
+    poJoinLayer->ResetReading();
+    GIntBig nMem = 0;
+    GIntBig nFeatures = 0;
+    bool bOK = true;
+    try
+    {
+        while (auto poFeature = std::unique_ptr<OGRFeature>(
+                   poJoinLayer->GetNextFeature()))
+        {
+            ++nFeatures;
+            if (!poFeature->IsFieldSetAndNotNull(iSecondaryField))
+                continue;
+
+            nMem += EstimateFeatureMemory(poFeature.get()) + ENTRY_OVERHEAD;
+            if (nMem > nMaxMem)
+            {
+                osReason = CPLSPrintf(
+                    "secondary layer does not fit in "
+                    "OGR_GENSQL_JOIN_HASH_MAX_MEMORY=%s",
+                    pszMaxMem);
+                bOK = false;
+                break;
+            }
+
+            // Only the first matching feature is used, as with the nested
+            // loop strategy.
+            const OGRField *psField =
+                poFeature->GetRawFieldRef(iSecondaryField);
+            if (oState.eKeyType == OFTString)
+            {
+                if (IsTimestampLikeJoinKey(psField->String))
+                {
+                    osReason = "secondary layer has timestamp-like keys";
+                    bOK = false;
+                    break;
+                }
+                oState.oMapString.emplace(
+                    GetJoinHashStringKey(psField->String),
+                    std::move(poFeature));
+            }
+            else if (oState.eKeyType == OFTReal)
+            {
+                if (!std::isnan(psField->Real))
+                    oState.oMapReal.emplace(psField->Real,
+                                            std::move(poFeature));
+            }
+            else
+            {
+                oState.oMapInt.emplace(poFeature->GetFieldAsInteger64(
+                                           iSecondaryField),
+                                       std::move(poFeature));
+            }
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        osReason = "out of memory";
+        bOK = false;
+    }
+    poJoinLayer->ResetReading();
+
+    if (!bOK)
+    {
+        oState.oMapInt.clear();
+        oState.oMapReal.clear();
+        oState.oMapString.clear();
+        return false;
+    }
+
+    osReason = CPLSPrintf(
+        CPL_FRMT_GIB " features read, " CPL_FRMT_GIB
+                     " distinct keys, about " CPL_FRMT_GIB " bytes",
+        nFeatures,
+        static_cast<GIntBig>(oState.oMapInt.size() + oState.oMapReal.size() +
+                             oState.oMapString.size()),
+        nMem);
+    return true;
+}
+
+/************************************************************************/
+/*                            PrepareJoin()                             */
+/************************************************************************/
+
+void OGRGenSQLResultsLayer::PrepareJoin(int iJoin)
+{
+    const swq_join_def *psJoinInfo = m_pSelectInfo->join_defs + iJoin;
+    OGRLayer *poJoinLayer = m_apoTableLayers[psJoinInfo->secondary_table];
+    JoinState &oState = m_aoJoinStates[iJoin];
+
+    std::string osReason;
+    int iSecondaryField = -1;
+    if (!EQUAL(CPLGetConfigOption("OGR_GENSQL_JOIN_STRATEGY", "AUTO"),
+               "AUTO"))
+    {
+        osReason = "OGR_GENSQL_JOIN_STRATEGY is not AUTO";
+    }
+    else if (GetJoinHashKeyFields(psJoinInfo->poExpr,
+                                  psJoinInfo->secondary_table, m_poSrcLayer,
+                                  poJoinLayer, oState.iPrimaryField,
+                                  iSecondaryField, oState.eKeyType, osReason) &&
+             BuildJoinHashTable(iJoin, iSecondaryField, osReason))
+    {
+        oState.eStrategy = JoinStrategy::HASH;
+    }
+    else
+    {
+        oState.eStrategy = JoinStrategy::NESTED_LOOP;
+    }
+
+    char *pszExpr = psJoinInfo->poExpr->Unparse(nullptr, '"');
+    CPLDebug("GenSQL", "JOIN %s ON %s: %s strategy (%s)",
+             m_pSelectInfo->table_defs[psJoinInfo->secondary_table].table_name,
+             pszExpr,
+             oState.eStrategy == JoinStrategy::HASH ? "hash join"
+                                                    : "nested loop",
+             osReason.c_str());
+    CPLFree(pszExpr);
+}
+
+/************************************************************************/
+/*                          FindJoinFeature()                           */
+/************************************************************************/
+
+std::unique_ptr<OGRFeature>
+OGRGenSQLResultsLayer::FindJoinFeature(int iJoin, OGRFeature *poSrcFeat)
+{
+    const swq_join_def *psJoinInfo = m_pSelectInfo->join_defs + iJoin;
+    OGRLayer *poJoinLayer = m_apoTableLayers[psJoinInfo->secondary_table];
+
+    if (m_aoJoinStates.empty())
+        m_aoJoinStates.resize(m_pSelectInfo->join_count);
+    JoinState &oState = m_aoJoinStates[iJoin];
+    if (oState.eStrategy == JoinStrategy::UNDECIDED)
+        PrepareJoin(iJoin);
+
+    if (oState.eStrategy == JoinStrategy::HASH)
+    {
+        // if source key is null, we can't do join.
+        if (!poSrcFeat->IsFieldSetAndNotNull(oState.iPrimaryField))
+            return nullptr;
+
+        const OGRFeature *poJoinFeature = nullptr;
+        const OGRField *psField =
+            poSrcFeat->GetRawFieldRef(oState.iPrimaryField);
+        if (oState.eKeyType == OFTString)
+        {
+            if (!IsTimestampLikeJoinKey(psField->String))
+            {
+                const auto oIter = oState.oMapString.find(
+                    GetJoinHashStringKey(psField->String));
+                if (oIter != oState.oMapString.end())
+                    poJoinFeature = oIter->second.get();
+                return std::unique_ptr<OGRFeature>(
+                    poJoinFeature ? poJoinFeature->Clone() : nullptr);
+            }
+            // else go on with the nested loop strategy for that feature
+        }
+        else if (oState.eKeyType == OFTReal)
+        {
+            const auto oIter = oState.oMapReal.find(psField->Real);
+            if (oIter != oState.oMapReal.end())
+                poJoinFeature = oIter->second.get();
+            return std::unique_ptr<OGRFeature>(
+                poJoinFeature ? poJoinFeature->Clone() : nullptr);
+        }
+        else
+        {
+            const auto oIter = oState.oMapInt.find(
+                poSrcFeat->GetFieldAsInteger64(oState.iPrimaryField));
+            if (oIter != oState.oMapInt.end())
+                poJoinFeature = oIter->second.get();
+            return std::unique_ptr<OGRFeature>(
+                poJoinFeature ? poJoinFeature->Clone() : nullptr);
+        }
+    }
+
+    const std::string osFilter =
+        GetFilterForJoin(psJoinInfo->poExpr, poSrcFeat, poJoinLayer,
+                         psJoinInfo->secondary_table);
+    // CPLDebug("OGR", "Filter = %s\n", osFilter.c_str());
+
+    // if source key is null, we can't do join.
+    if (osFilter.empty())
+    {
+        return nullptr;
     }
 
-    return "";
+    std::unique_ptr<OGRFeature> poJoinFeature;
+
+    poJoinLayer->ResetReading();
+    if (poJoinLayer->SetAttributeFilter(osFilter.c_str()) == OGRERR_NONE)
+        poJoinFeature.reset(poJoinLayer->GetNextFeature());
+
+    return poJoinFeature;
 }
 
 /************************************************************************/
@@ -1513,27 +2270,7 @@ std::unique_ptr<OGRFeature> OGRGenSQLResultsLayer::TranslateFeature(
         /* we have taken care of this */
         CPLAssert(psJoinInfo->secondary_table == iJoin + 1);
 
-        OGRLayer *poJoinLayer = m_apoTableLayers[psJoinInfo->secondary_table];
-
-        const std::string osFilter =
-            GetFilterForJoin(psJoinInfo->poExpr, poSrcFeat, poJoinLayer,
-                             psJoinInfo->secondary_table);
-        // CPLDebug("OGR", "Filter = %s\n", osFilter.c_str());
-
-        // if source key is null, we can't do join.
-        if (osFilter.empty())
-        {
-            apoFeatures.push_back(nullptr);
-            continue;
-        }
-
-        std::unique_ptr<OGRFeature> poJoinFeature;
-
-        poJoinLayer->ResetReading();
-        if (poJoinLayer->SetAttributeFilter(osFilter.c_str()) == OGRERR_NONE)
-            poJoinFeature.reset(poJoinLayer->GetNextFeature());
-
-        apoFeatures.push_back(std::move(poJoinFeature));
+        apoFeatures.push_back(FindJoinFeature(iJoin, poSrcFeat));
     }
 
     /* -------------------------------------------------------------------- */
@@ -1870,8 +2607,9 @@ OGRFeature *OGRGenSQLResultsLayer::GetNextFeature()
         return nullptr;
 
     CreateOrderByIndex();
-    if (m_anFIDIndex.empty() && m_nIteratedFeatures < 0 &&
-        psSelectInfo->offset > 0 && psSelectInfo->query_mode == SWQM_RECORDSET)
+    if (m_anFIDIndex.empty() && !m_poSortRunMerger &&
+        m_nIteratedFeatures < 0 && psSelectInfo->offset > 0 &&
+        psSelectInfo->query_mode == SWQM_RECORDSET)
     {
         m_poSrcLayer->SetNextByIndex(psSelectInfo->offset);
     }
@@ -1882,7 +2620,8 @@ OGRFeature *OGRGenSQLResultsLayer::GetNextFeature()
     /*      Handle summary sets.                                            */
     /* -------------------------------------------------------------------- */
     if (psSelectInfo->query_mode == SWQM_SUMMARY_RECORD ||
-        psSelectInfo->query_mode == SWQM_DISTINCT_LIST)
+        psSelectInfo->query_mode == SWQM_DISTINCT_LIST ||
+        psSelectInfo->query_mode == SWQM_GROUP_BY)
     {
         m_nIteratedFeatures++;
         return GetFeature(m_nNextIndexFID++);
@@ -1896,7 +2635,11 @@ OGRFeature *OGRGenSQLResultsLayer::GetNextFeature()
     while (true)
     {
         std::unique_ptr<OGRFeature> poSrcFeat;
-        if (!m_anFIDIndex.empty())
+        if (m_poSortRunMerger)
+        {
+            poSrcFeat = GetNextExternallySortedFeature();
+        }
+        else if (!m_anFIDIndex.empty())
         {
             /* --------------------------------------------------------------------
              */
@@ -2027,6 +2770,18 @@ OGRFeature *OGRGenSQLResultsLayer::GetFeature(GIntBig nFID)
         return m_poSummaryFeature->Clone();
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Handle request for a GROUP BY record.                           */
+    /* -------------------------------------------------------------------- */
+    if (psSelectInfo->query_mode == SWQM_GROUP_BY)
+    {
+        if (!PrepareGroupBy() || nFID < 0 ||
+            nFID >= static_cast<GIntBig>(m_apoGroupByFeatures.size()))
+            return nullptr;
+
+        return m_apoGroupByFeatures[static_cast<size_t>(nFID)]->Clone();
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Handle request for random record.                               */
     /* -------------------------------------------------------------------- */
@@ -2189,6 +2944,382 @@ void OGRGenSQLResultsLayer::ReadIndexFields(OGRFeature *poSrcFeat,
     }
 }
 
+/************************************************************************/
+/*                        IsStringOrderByKey()                          */
+/************************************************************************/
+
+bool OGRGenSQLResultsLayer::IsStringOrderByKey(int iKey) const
+{
+    const swq_order_def *psKeyDef = m_pSelectInfo->order_defs + iKey;
+    if (psKeyDef->field_index >= m_iFIDFieldIndex)
+    {
+        return SpecialFieldTypes[psKeyDef->field_index - m_iFIDFieldIndex] ==
+               SWQ_STRING;
+    }
+    return m_poSrcLayer->GetLayerDefn()
+               ->GetFieldDefn(psKeyDef->field_index)
+               ->GetType() == OFTString;
+}
+
+/************************************************************************/
+/*                        WriteSortRunRecord()                          */
+/************************************************************************/
+
+bool OGRGenSQLResultsLayer::WriteSortRunRecord(SortRun &oRun, GIntBig nFID,
+                                               const OGRField *pasFields,
+                                               const GByte *pabyFeature,
+                                               size_t nFeatureSize)
+{
+    // Temporary files are only read back by this process, so values are
+    // written in native byte order.
+    auto &abyBuffer = oRun.abyBuffer;
+    abyBuffer.clear();
+    const auto Append = [&abyBuffer](const void *pData, size_t nSize)
+    {
+        const GByte *pabyData = static_cast<const GByte *>(pData);
+        abyBuffer.insert(abyBuffer.end(), pabyData, pabyData + nSize);
+    };
+
+    Append(&nFID, sizeof(nFID));
+    for (int iKey = 0; iKey < m_pSelectInfo->order_specs; iKey++)
+    {
+        const OGRField *psField = pasFields + iKey;
+        if (IsStringOrderByKey(iKey) && !OGR_RawField_IsUnset(psField) &&
+            !OGR_RawField_IsNull(psField))
+        {
+            const GByte byTag = 1;
+            const uint32_t nLen = static_cast<uint32_t>(
+                std::min<size_t>(strlen(psField->String),
+                                 std::numeric_limits<uint32_t>::max()));
+            Append(&byTag, sizeof(byTag));
+            Append(&nLen, sizeof(nLen));
+            Append(psField->String, nLen);
+        }
+        else
+        {
+            const GByte byTag = 0;
+            Append(&byTag, sizeof(byTag));
+            Append(psField, sizeof(OGRField));
+        }
+    }
+    if (pabyFeature)
+    {
+        if (nFeatureSize > std::numeric_limits<uint32_t>::max())
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "CreateOrderByIndex(): too large feature");
+            return false;
+        }
+        const uint32_t nSize = static_cast<uint32_t>(nFeatureSize);
+        Append(&nSize, sizeof(nSize));
+        Append(pabyFeature, nFeatureSize);
+    }
+
+    if (oRun.fp->Write(abyBuffer.data(), 1, abyBuffer.size()) !=
+        abyBuffer.size())
+    {
+        CPLError(CE_Failure, CPLE_FileIO,
+                 "CreateOrderByIndex(): cannot write in %s",
+                 oRun.osFilename.c_str());
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                            WriteSortRun()                            */
+/*                                                                      */
+/*      Write the nIndexSize records of pasIndexFields/panFIDs, in      */
+/*      the order of m_anFIDIndex, into a new temporary file.           */
+/************************************************************************/
+
+bool OGRGenSQLResultsLayer::WriteSortRun(
+    const OGRField *pasIndexFields, const GIntBig *panFIDs,
+    const std::vector<std::vector<GByte>> &aabyFeatures, size_t nIndexSize,
+    const std::string &osFilename, SortRun &oRun)
+{
+    const int nOrderItems = m_pSelectInfo->order_specs;
+
+    oRun.osFilename = osFilename;
+    oRun.bHasFeatures = !aabyFeatures.empty();
+    oRun.fp.reset(VSIFOpenL(osFilename.c_str(), "wb"));
+    if (!oRun.fp)
+    {
+        CPLError(CE_Failure, CPLE_FileIO,
+                 "CreateOrderByIndex(): cannot create %s", osFilename.c_str());
+        oRun.osFilename.clear();
+        return false;
+    }
+
+    for (size_t i = 0; i < nIndexSize; i++)
+    {
+        const size_t nIdx = static_cast<size_t>(m_anFIDIndex[i]);
+        const GByte *pabyFeature = nullptr;
+        size_t nFeatureSize = 0;
+        if (!aabyFeatures.empty())
+        {
+            pabyFeature = aabyFeatures[nIdx].data();
+            nFeatureSize = aabyFeatures[nIdx].size();
+        }
+        if (!WriteSortRunRecord(oRun, panFIDs[nIdx],
+                                pasIndexFields + nIdx * nOrderItems,
+                                pabyFeature, nFeatureSize))
+        {
+            return false;
+        }
+    }
+
+    if (oRun.fp->Close() != 0)
+    {
+        CPLError(CE_Failure, CPLE_FileIO,
+                 "CreateOrderByIndex(): cannot write in %s",
+                 osFilename.c_str());
+        return false;
+    }
+    oRun.fp.reset();
+    return true;
+}
+
+/************************************************************************/
+/*                         ReadSortRunRecord()                          */
+/*                                                                      */
+/*      Read the next record of a run into its current record.          */
+/*      Returns false at end of run or on error.                        */
+/************************************************************************/
+
+bool OGRGenSQLResultsLayer::ReadSortRunRecord(SortRun &oRun)
+{
+    VSIVirtualHandle *fp = oRun.fp.get();
+    if (fp->Read(&oRun.nFID, sizeof(oRun.nFID), 1) != 1)
+        return false;
+
+    const int nOrderItems = m_pSelectInfo->order_specs;
+    oRun.asFields.resize(nOrderItems);
+    oRun.aosStrings.resize(nOrderItems);
+    bool bOK = true;
+    for (int iKey = 0; bOK && iKey < nOrderItems; iKey++)
+    {
+        GByte byTag = 0;
+        bOK = fp->Read(&byTag, 1, 1) == 1;
+        if (bOK && byTag == 0)
+        {
+            bOK = fp->Read(&oRun.asFields[iKey], sizeof(OGRField), 1) == 1;
+        }
+        else if (bOK)
+        {
+            uint32_t nLen = 0;
+            bOK = fp->Read(&nLen, sizeof(nLen), 1) == 1;
+            if (bOK)
+            {
+                std::string &osStr = oRun.aosStrings[iKey];
+                osStr.resize(nLen);
+                bOK = fp->Read(osStr.data(), 1, nLen) == nLen;
+                oRun.asFields[iKey].String = osStr.data();
+            }
+        }
+    }
+
+    if (bOK && oRun.bHasFeatures)
+    {
+        uint32_t nSize = 0;
+        bOK = fp->Read(&nSize, sizeof(nSize), 1) == 1;
+        if (bOK)
+        {
+            oRun.abyFeature.resize(nSize);
+            bOK = fp->Read(oRun.abyFeature.data(), 1, nSize) == nSize;
+        }
+    }
+
+    if (!bOK)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Truncated sort run %s",
+                 oRun.osFilename.c_str());
+    }
+    return bOK;
+}
+
+/************************************************************************/
+/*                         StartSortRunMerge()                          */
+/************************************************************************/
+
+bool OGRGenSQLResultsLayer::StartSortRunMerge(SortRunMerger &oMerger)
+{
+    oMerger.anHeap.clear();
+    oMerger.nLastRun = SortRunMerger::NO_RUN;
+    oMerger.nReturned = 0;
+
+    for (size_t i = 0; i < oMerger.apoRuns.size(); i++)
+    {
+        SortRun &oRun = *(oMerger.apoRuns[i]);
+        oRun.fp.reset(VSIFOpenL(oRun.osFilename.c_str(), "rb"));
+        if (!oRun.fp)
+        {
+            CPLError(CE_Failure, CPLE_FileIO,
+                     "CreateOrderByIndex(): cannot open %s",
+                     oRun.osFilename.c_str());
+            return false;
+        }
+        if (ReadSortRunRecord(oRun))
+            oMerger.anHeap.push_back(i);
+    }
+
+    const auto IsAfter = [this, &oMerger](size_t a, size_t b)
+    {
+        const int nRes = Compare(oMerger.apoRuns[a]->asFields.data(),
+                                 oMerger.apoRuns[b]->asFields.data());
+        // On ties, earlier runs come first, so that the sort is stable.
+        return nRes > 0 || (nRes == 0 && a > b);
+    };
+    std::make_heap(oMerger.anHeap.begin(), oMerger.anHeap.end(), IsAfter);
+    return true;
+}
+
+/************************************************************************/
+/*                     GetNextMergedSortRunRecord()                     */
+/*                                                                      */
+/*      Return the run whose current record is the next one in the      */
+/*      merged order, or nullptr when all runs are exhausted. The       */
+/*      current record remains valid until the next call.               */
+/************************************************************************/
+
+OGRGenSQLResultsLayer::SortRun *
+OGRGenSQLResultsLayer::GetNextMergedSortRunRecord(SortRunMerger &oMerger)
+{
+    const auto IsAfter = [this, &oMerger](size_t a, size_t b)
+    {
+        const int nRes = Compare(oMerger.apoRuns[a]->asFields.data(),
+                                 oMerger.apoRuns[b]->asFields.data());
+        return nRes > 0 || (nRes == 0 && a > b);
+    };
+
+    if (oMerger.nLastRun != SortRunMerger::NO_RUN)
+    {
+        if (ReadSortRunRecord(*(oMerger.apoRuns[oMerger.nLastRun])))
+        {
+            oMerger.anHeap.push_back(oMerger.nLastRun);
+            std::push_heap(oMerger.anHeap.begin(), oMerger.anHeap.end(),
+                           IsAfter);
+        }
+        oMerger.nLastRun = SortRunMerger::NO_RUN;
+    }
+
+    if (oMerger.anHeap.empty())
+        return nullptr;
+
+    std::pop_heap(oMerger.anHeap.begin(), oMerger.anHeap.end(), IsAfter);
+    oMerger.nLastRun = oMerger.anHeap.back();
+    oMerger.anHeap.pop_back();
+    oMerger.nReturned++;
+    return oMerger.apoRuns[oMerger.nLastRun].get();
+}
+
+/************************************************************************/
+/*                           MergeSortRuns()                            */
+/*                                                                      */
+/*      Merge runs together until there are no more than                */
+/*      nMaxOpenRuns of them, to bound the number of simultaneously     */
+/*      opened files during the final merge.                            */
+/************************************************************************/
+
+bool OGRGenSQLResultsLayer::MergeSortRuns(SortRunMerger &oMerger,
+                                          size_t nMaxOpenRuns)
+{
+    while (oMerger.apoRuns.size() > nMaxOpenRuns)
+    {
+        SortRunMerger oPartialMerger;
+        oPartialMerger.bCarryFeatures = oMerger.bCarryFeatures;
+        for (size_t i = 0; i < nMaxOpenRuns; ++i)
+            oPartialMerger.apoRuns.push_back(std::move(oMerger.apoRuns[i]));
+        oMerger.apoRuns.erase(oMerger.apoRuns.begin(),
+                              oMerger.apoRuns.begin() + nMaxOpenRuns);
+
+        auto poRun = std::make_unique<SortRun>();
+        poRun->bHasFeatures = oMerger.bCarryFeatures;
+        poRun->osFilename = CPLGenerateTempFilenameSafe("ogr_gensql_sort");
+        poRun->fp.reset(VSIFOpenL(poRun->osFilename.c_str(), "wb"));
+        if (!poRun->fp)
+        {
+            CPLError(CE_Failure, CPLE_FileIO,
+                     "CreateOrderByIndex(): cannot create %s",
+                     poRun->osFilename.c_str());
+            poRun->osFilename.clear();
+            return false;
+        }
+
+        if (!StartSortRunMerge(oPartialMerger))
+            return false;
+        while (const SortRun *poCurRun =
+                   GetNextMergedSortRunRecord(oPartialMerger))
+        {
+            if (!WriteSortRunRecord(
+                    *poRun, poCurRun->nFID, poCurRun->asFields.data(),
+                    oMerger.bCarryFeatures ? poCurRun->abyFeature.data()
+                                           : nullptr,
+                    poCurRun->abyFeature.size()))
+            {
+                return false;
+            }
+        }
+        if (poRun->fp->Close() != 0)
+        {
+            CPLError(CE_Failure, CPLE_FileIO,
+                     "CreateOrderByIndex(): cannot write in %s",
+                     poRun->osFilename.c_str());
+            return false;
+        }
+        poRun->fp.reset();
+
+        // The merged run replaces the runs it was made of, which were the
+        // first ones, so that the relative order of records is preserved.
+        oMerger.apoRuns.insert(oMerger.apoRuns.begin(), std::move(poRun));
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                   GetNextExternallySortedFeature()                   */
+/************************************************************************/
+
+std::unique_ptr<OGRFeature>
+OGRGenSQLResultsLayer::GetNextExternallySortedFeature()
+{
+    SortRunMerger &oMerger = *m_poSortRunMerger;
+
+    // Rewind if we need to go backwards, and skip records until the
+    // requested position.
+    if (oMerger.nReturned > m_nNextIndexFID)
+    {
+        if (!StartSortRunMerge(oMerger))
+            return nullptr;
+    }
+    while (oMerger.nReturned < m_nNextIndexFID)
+    {
+        if (!GetNextMergedSortRunRecord(oMerger))
+            return nullptr;
+    }
+
+    const SortRun *poRun = GetNextMergedSortRunRecord(oMerger);
+    if (!poRun)
+        return nullptr;
+    m_nNextIndexFID++;
+
+    if (oMerger.bCarryFeatures)
+    {
+        auto poSrcFeat =
+            std::make_unique<OGRFeature>(m_poSrcLayer->GetLayerDefn());
+        if (!poSrcFeat->DeserializeFromBinary(poRun->abyFeature.data(),
+                                              poRun->abyFeature.size()))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Cannot deserialize feature");
+            return nullptr;
+        }
+        return poSrcFeat;
+    }
+
+    return std::unique_ptr<OGRFeature>(m_poSrcLayer->GetFeature(poRun->nFID));
+}
+
 /************************************************************************/
 /*                         CreateOrderByIndex()                         */
 /*                                                                      */
@@ -2198,12 +3329,18 @@ void OGRGenSQLResultsLayer::ReadIndexFields(OGRFeature *poSrcFeat,
 /*                                                                      */
 /*      This is accomplished by making one pass through all the         */
 /*      eligible source features, and capturing the order by fields     */
-/*      of all records in memory.  A quick sort is then applied to      */
+/*      of all records in memory.  A merge sort is then applied to      */
 /*      this in memory copy of the order-by fields to create the        */
 /*      required index.                                                 */
 /*                                                                      */
-/*      Keeping all the key values in memory will *not* scale up to     */
-/*      very large input datasets.                                      */
+/*      When the order by fields do not fit within the                  */
+/*      OGR_GENSQL_ORDER_BY_MAX_MEMORY budget, an external merge sort   */
+/*      is used instead: each time the budget is reached, the records   */
+/*      collected so far are sorted and written as a run in a           */
+/*      temporary file, and the runs are merged on the fly by           */
+/*      GetNextFeature().  When random access to the source layer is    */
+/*      not available, the serialized source features are stored with  */
+/*      their keys, so that they do not need to be fetched back.        */
 /************************************************************************/
 
 void OGRGenSQLResultsLayer::CreateOrderByIndex()
@@ -2220,6 +3357,7 @@ void OGRGenSQLResultsLayer::CreateOrderByIndex()
 
     m_bOrderByValid = true;
     m_anFIDIndex.clear();
+    m_poSortRunMerger.reset();
 
     ResetReading();
 
@@ -2263,6 +3401,27 @@ void OGRGenSQLResultsLayer::CreateOrderByIndex()
         return;
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Determine the memory budget, and whether source features        */
+    /*      must be carried with their keys.                                */
+    /* -------------------------------------------------------------------- */
+    const char *pszMaxMem =
+        CPLGetConfigOption("OGR_GENSQL_ORDER_BY_MAX_MEMORY", "10%");
+    GIntBig nMaxMem = 0;
+    if (CPLParseMemorySize(pszMaxMem, &nMaxMem, nullptr) != CE_None)
+    {
+        CPLError(CE_Warning, CPLE_AppDefined,
+                 "Invalid value for OGR_GENSQL_ORDER_BY_MAX_MEMORY. "
+                 "Sorting in memory");
+        nMaxMem = std::numeric_limits<GIntBig>::max();
+    }
+
+    const char *pszCarryFeatures =
+        CPLGetConfigOption("OGR_GENSQL_ORDER_BY_CARRY_FEATURES", nullptr);
+    const bool bCarryFeatures =
+        pszCarryFeatures ? CPLTestBool(pszCarryFeatures)
+                         : !m_poSrcLayer->TestCapability(OLCRandomRead);
+
     /* -------------------------------------------------------------------- */
     /*      Allocate set of key values, and the output index.               */
     /* -------------------------------------------------------------------- */
@@ -2272,6 +3431,7 @@ void OGRGenSQLResultsLayer::CreateOrderByIndex()
     memset(asIndexFields.data(), 0,
            sizeof(OGRField) * nOrderItems * nFeaturesAlloc);
     std::vector<GIntBig> anFIDList;
+    std::vector<std::vector<GByte>> aabyFeatures;
 
     // Frees nIndexSize rows of asIndexFields
     struct IndexFieldsFreer
@@ -2299,10 +3459,78 @@ void OGRGenSQLResultsLayer::CreateOrderByIndex()
 
     IndexFieldsFreer oIndexFieldsFreer(*this, asIndexFields, nIndexSize);
 
+    // Sort the nIndexSize first rows of asIndexFields: on success,
+    // m_anFIDIndex contains their indices in sorted order.
+    const auto SortIndex = [this, &asIndexFields, &nIndexSize]()
+    {
+        m_anFIDIndex.clear();
+        try
+        {
+            m_anFIDIndex.reserve(nIndexSize);
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "CreateOrderByIndex(): out of memory");
+            return false;
+        }
+        for (size_t i = 0; i < nIndexSize; i++)
+            m_anFIDIndex.push_back(static_cast<GIntBig>(i));
+
+        GIntBig *panMerged = static_cast<GIntBig *>(
+            VSI_MALLOC_VERBOSE(sizeof(GIntBig) * nIndexSize));
+        if (panMerged == nullptr && nIndexSize > 0)
+        {
+            m_anFIDIndex.clear();
+            return false;
+        }
+
+        // Note: this merge sort is slightly faster than std::sort()
+        SortIndexSection(asIndexFields.data(), panMerged, 0, nIndexSize);
+        VSIFree(panMerged);
+        return true;
+    };
+
+    // Sort the nIndexSize first rows of asIndexFields, write them in a
+    // new run, and release them.
+    auto poMerger = std::make_unique<SortRunMerger>();
+    poMerger->bCarryFeatures = bCarryFeatures;
+    const auto FlushRun = [this, &poMerger, &SortIndex, &asIndexFields,
+                           &anFIDList, &aabyFeatures, &nIndexSize,
+                           nOrderItems](const std::string &osFilename)
+    {
+        if (!SortIndex())
+            return false;
+        auto poRun = std::make_unique<SortRun>();
+        const bool bOK =
+            WriteSortRun(asIndexFields.data(), anFIDList.data(), aabyFeatures,
+                         nIndexSize, osFilename, *poRun);
+        m_anFIDIndex.clear();
+        if (!bOK)
+            return false;
+        poMerger->apoRuns.push_back(std::move(poRun));
+
+        FreeIndexFields(asIndexFields.data(), nIndexSize);
+        memset(asIndexFields.data(), 0,
+               sizeof(OGRField) * nOrderItems * nIndexSize);
+        nIndexSize = 0;
+        anFIDList.clear();
+        aabyFeatures.clear();
+        return true;
+    };
+
     /* -------------------------------------------------------------------- */
     /*      Read in all the key values.                                     */
     /* -------------------------------------------------------------------- */
 
+    // Per record: key values, FID, m_anFIDIndex and merge buffer entries
+    const GIntBig nRecordOverhead =
+        static_cast<GIntBig>(sizeof(OGRField)) * nOrderItems +
+        3 * static_cast<GIntBig>(sizeof(GIntBig)) +
+        (bCarryFeatures ? static_cast<GIntBig>(sizeof(std::vector<GByte>))
+                        : 0);
+    GIntBig nMem = 0;
+
     for (auto &&poSrcFeat : *m_poSrcLayer)
     {
         if (nIndexSize == nFeaturesAlloc)
@@ -2344,47 +3572,108 @@ void OGRGenSQLResultsLayer::CreateOrderByIndex()
             nFeaturesAlloc = nNewFeaturesAlloc;
         }
 
-        ReadIndexFields(poSrcFeat.get(), nOrderItems,
-                        asIndexFields.data() + nIndexSize * nOrderItems);
+        OGRField *pasRecordFields =
+            asIndexFields.data() + nIndexSize * nOrderItems;
+        ReadIndexFields(poSrcFeat.get(), nOrderItems, pasRecordFields);
 
         anFIDList.push_back(poSrcFeat->GetFID());
 
+        nMem += nRecordOverhead;
+        for (int iKey = 0; iKey < nOrderItems; iKey++)
+        {
+            if (IsStringOrderByKey(iKey) &&
+                !OGR_RawField_IsUnset(&pasRecordFields[iKey]) &&
+                !OGR_RawField_IsNull(&pasRecordFields[iKey]))
+            {
+                nMem += strlen(pasRecordFields[iKey].String) + 1;
+            }
+        }
+
+        if (bCarryFeatures)
+        {
+            try
+            {
+                aabyFeatures.emplace_back();
+                poSrcFeat->SerializeToBinary(aabyFeatures.back());
+            }
+            catch (const std::bad_alloc &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "CreateOrderByIndex(): out of memory");
+                return;
+            }
+            nMem += aabyFeatures.back().size();
+        }
+
         nIndexSize++;
+
+        if (nMem > nMaxMem)
+        {
+            if (poMerger->apoRuns.empty())
+            {
+                CPLDebug("GenSQL",
+                         "ORDER BY keys exceed "
+                         "OGR_GENSQL_ORDER_BY_MAX_MEMORY=%s. "
+                         "Using external sort",
+                         pszMaxMem);
+            }
+            if (!FlushRun(CPLGenerateTempFilenameSafe("ogr_gensql_sort")))
+                return;
+            nMem = 0;
+        }
     }
 
     // CPLDebug("GenSQL", "CreateOrderByIndex() = %zu features", nIndexSize);
 
     /* -------------------------------------------------------------------- */
-    /*      Initialize m_anFIDIndex                                         */
+    /*      External sort: the last run is small enough to be kept in       */
+    /*      memory. Then merge runs if there are too many of them.          */
     /* -------------------------------------------------------------------- */
-    try
+    if (!poMerger->apoRuns.empty() || bCarryFeatures)
     {
-        m_anFIDIndex.reserve(nIndexSize);
-    }
-    catch (const std::bad_alloc &)
-    {
-        CPLError(CE_Failure, CPLE_OutOfMemory,
-                 "CreateOrderByIndex(): out of memory");
+        if (poMerger->apoRuns.empty())
+        {
+            // Everything fits in memory. If the source layer is already
+            // sorted, keep on reading it sequentially (see below), otherwise
+            // the features collected in memory are returned.
+            if (!SortIndex())
+                return;
+            bool bAlreadySorted = true;
+            for (size_t i = 0; bAlreadySorted && i < nIndexSize; i++)
+                bAlreadySorted = m_anFIDIndex[i] == static_cast<GIntBig>(i);
+            m_anFIDIndex.clear();
+            if (bAlreadySorted)
+            {
+                ResetReading();
+                return;
+            }
+        }
+
+        if (nIndexSize > 0 &&
+            !FlushRun(VSIMemGenerateHiddenFilename("ogr_gensql_sort")))
+        {
+            return;
+        }
+
+        // Cap the number of temporary files opened simultaneously
+        constexpr size_t MAX_OPEN_RUNS = 64;
+        m_poSortRunMerger = std::move(poMerger);
+        if (!MergeSortRuns(*m_poSortRunMerger, MAX_OPEN_RUNS) ||
+            !StartSortRunMerge(*m_poSortRunMerger))
+        {
+            m_poSortRunMerger.reset();
+            return;
+        }
+
+        ResetReading();
         return;
     }
-    for (size_t i = 0; i < nIndexSize; i++)
-        m_anFIDIndex.push_back(static_cast<GIntBig>(i));
 
     /* -------------------------------------------------------------------- */
     /*      Quick sort the records.                                         */
     /* -------------------------------------------------------------------- */
-
-    GIntBig *panMerged = static_cast<GIntBig *>(
-        VSI_MALLOC_VERBOSE(sizeof(GIntBig) * nIndexSize));
-    if (panMerged == nullptr)
-    {
-        m_anFIDIndex.clear();
+    if (!SortIndex())
         return;
-    }
-
-    // Note: this merge sort is slightly faster than std::sort()
-    SortIndexSection(asIndexFields.data(), panMerged, 0, nIndexSize);
-    VSIFree(panMerged);
 
     /* -------------------------------------------------------------------- */
     /*      Rework the FID map to map to real FIDs.                         */
@@ -2685,6 +3974,13 @@ void OGRGenSQLResultsLayer::FindAndSetIgnoredFields()
                           hSet);
     }
 
+    for (int iGroupBy = 0; iGroupBy < psSelectInfo->group_by_count; iGroupBy++)
+    {
+        swq_group_by_def *psGroupByDef = psSelectInfo->group_by_defs + iGroupBy;
+        AddFieldDefnToSet(psGroupByDef->table_index, psGroupByDef->field_index,
+                          hSet);
+    }
+
     /* -------------------------------------------------------------------- */
     /*      2nd phase : now, we can exclude the unused fields               */
     /* -------------------------------------------------------------------- */
@@ -2734,6 +4030,7 @@ void OGRGenSQLResultsLayer::FindAndSetIgnoredFields()
 void OGRGenSQLResultsLayer::InvalidateOrderByIndex()
 {
     m_anFIDIndex.clear();
+    m_poSortRunMerger.reset();
     m_bOrderByValid = false;
 }
 
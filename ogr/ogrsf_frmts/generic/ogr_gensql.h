@@ -19,6 +19,9 @@
 #include "cpl_hash_set.h"
 #include "cpl_string.h"
 
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 /*! @cond Doxygen_Suppress */
@@ -65,6 +68,13 @@ class OGRGenSQLResultsLayer final : public OGRLayer
     std::vector<GIntBig> m_anFIDIndex{};
     bool m_bOrderByValid = false;
 
+    // Sorted runs spilled to temporary files by CreateOrderByIndex() when the
+    // ORDER BY keys do not fit in OGR_GENSQL_ORDER_BY_MAX_MEMORY, and state
+    // of their k-way merge. Used instead of m_anFIDIndex when set.
+    struct SortRun;
+    struct SortRunMerger;
+    std::unique_ptr<SortRunMerger> m_poSortRunMerger{};
+
     GIntBig m_nNextIndexFID = 0;
     mutable std::unique_ptr<OGRFeature> m_poSummaryFeature{};
 
@@ -73,10 +83,59 @@ class OGRGenSQLResultsLayer final : public OGRLayer
     GIntBig m_nIteratedFeatures = -1;
     std::vector<std::string> m_aosDistinctList{};
 
+    // Strategy used to fetch the features of the secondary layer of a JOIN
+    enum class JoinStrategy
+    {
+        UNDECIDED,
+        // SetAttributeFilter() on the secondary layer for each feature
+        NESTED_LOOP,
+        // In-memory hash table over the join key of the secondary layer
+        HASH,
+    };
+
+    struct JoinState
+    {
+        JoinStrategy eStrategy = JoinStrategy::UNDECIDED;
+        int iPrimaryField = -1;
+        OGRFieldType eKeyType = OFTInteger;
+        std::unordered_map<GIntBig, std::unique_ptr<OGRFeature>> oMapInt{};
+        std::unordered_map<double, std::unique_ptr<OGRFeature>> oMapReal{};
+        std::unordered_map<std::string, std::unique_ptr<OGRFeature>>
+            oMapString{};
+    };
+
+    std::vector<JoinState> m_aoJoinStates{};
+
+    // Result features of a GROUP BY query, one per group, in output order
+    std::vector<std::unique_ptr<OGRFeature>> m_apoGroupByFeatures{};
+    bool m_bGroupByDone = false;
+
     bool PrepareSummary() const;
+    bool PrepareGroupBy();
+    void SetSummaryFieldValue(OGRFeature *poFeature, int iDstField,
+                              const swq_col_def *psColDef,
+                              const swq_summary &oSummary) const;
 
     std::unique_ptr<OGRFeature> TranslateFeature(std::unique_ptr<OGRFeature>);
+    void PrepareJoin(int iJoin);
+    bool BuildJoinHashTable(int iJoin, int iSecondaryField,
+                            std::string &osReason);
+    std::unique_ptr<OGRFeature> FindJoinFeature(int iJoin,
+                                                OGRFeature *poSrcFeat);
     void CreateOrderByIndex();
+    bool IsStringOrderByKey(int iKey) const;
+    bool WriteSortRun(const OGRField *pasIndexFields, const GIntBig *panFIDs,
+                      const std::vector<std::vector<GByte>> &aabyFeatures,
+                      size_t nIndexSize, const std::string &osFilename,
+                      SortRun &oRun);
+    bool WriteSortRunRecord(SortRun &oRun, GIntBig nFID,
+                            const OGRField *pasFields, const GByte *pabyFeature,
+                            size_t nFeatureSize);
+    bool ReadSortRunRecord(SortRun &oRun);
+    bool StartSortRunMerge(SortRunMerger &oMerger);
+    SortRun *GetNextMergedSortRunRecord(SortRunMerger &oMerger);
+    bool MergeSortRuns(SortRunMerger &oMerger, size_t nMaxOpenRuns);
+    std::unique_ptr<OGRFeature> GetNextExternallySortedFeature();
     void ReadIndexFields(OGRFeature *poSrcFeat, int nOrderItems,
                          OGRField *pasIndexFields);
     void SortIndexSection(const OGRField *pasIndexFields, GIntBig *panMerged,
@@ -20,12 +20,15 @@
 #include "ogr_wkb.h"
 #include "ogrlayer_private.h"
 
+#include "cpl_quad_tree.h"
 #include "cpl_time.h"
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <limits>
 #include <memory>
 #include <set>
+#include <vector>
 
 /************************************************************************/
 /*                              OGRLayer()                              */
@@ -3223,6 +3226,219 @@ static OGRErr set_result_schema(OGRLayer *pLayerResult,
     return ret;
 }
 
+/************************************************************************/
+/*                     OGRLayerAlgebraMethodIndex                       */
+/************************************************************************/
+
+namespace
+{
+// In-memory copy of the method layer of the layer algebra methods, with a
+// spatial index on its first geometry field, so that setting a spatial filter
+// for each input feature does not result in a full scan of the method layer.
+class OGRLayerAlgebraMethodIndex final : public OGRLayer
+{
+    OGRLayer *const m_poSrcLayer;
+    std::vector<OGRFeatureUniquePtr> m_apoFeatures{};
+    OGREnvelope m_sExtent{};
+    CPLQuadTree *m_hQuadTree = nullptr;
+
+    // Features matching the current spatial filter, in source order.
+    std::vector<int> m_anCandidates{};
+    size_t m_iNext = 0;
+
+    CPL_DISALLOW_COPY_ASSIGN(OGRLayerAlgebraMethodIndex)
+
+  public:
+    explicit OGRLayerAlgebraMethodIndex(OGRLayer *poSrcLayer);
+    ~OGRLayerAlgebraMethodIndex() override;
+
+    void Load();
+
+    const OGRFeatureDefn *GetLayerDefn() const override
+    {
+        return m_poSrcLayer->GetLayerDefn();
+    }
+
+    void ResetReading() override;
+    OGRFeature *GetNextFeature() override;
+
+    GIntBig GetFeatureCount(int bForce) override
+    {
+        if (m_poFilterGeom == nullptr)
+            return static_cast<GIntBig>(m_apoFeatures.size());
+        return OGRLayer::GetFeatureCount(bForce);
+    }
+
+    int TestCapability(const char *pszCap) const override
+    {
+        return EQUAL(pszCap, OLCFastSpatialFilter) ||
+               EQUAL(pszCap, OLCFastFeatureCount) ||
+               EQUAL(pszCap, OLCFastGetExtent);
+    }
+
+  protected:
+    OGRErr IGetExtent(int iGeomField, OGREnvelope *psExtent,
+                      bool bForce) override
+    {
+        if (iGeomField != 0)
+            return OGRLayer::IGetExtent(iGeomField, psExtent, bForce);
+        if (!m_sExtent.IsInit())
+            return OGRERR_FAILURE;
+        *psExtent = m_sExtent;
+        return OGRERR_NONE;
+    }
+};
+
+/************************************************************************/
+/*                     OGRLayerAlgebraMethodIndex()                     */
+/************************************************************************/
+
+OGRLayerAlgebraMethodIndex::OGRLayerAlgebraMethodIndex(OGRLayer *poSrcLayer)
+    : m_poSrcLayer(poSrcLayer)
+{
+    SetDescription(poSrcLayer->GetDescription());
+}
+
+/************************************************************************/
+/*                    ~OGRLayerAlgebraMethodIndex()                     */
+/************************************************************************/
+
+OGRLayerAlgebraMethodIndex::~OGRLayerAlgebraMethodIndex()
+{
+    if (m_hQuadTree)
+        CPLQuadTreeDestroy(m_hQuadTree);
+}
+
+/************************************************************************/
+/*                                Load()                                */
+/************************************************************************/
+
+// Read once all features of the source layer (honoring its current
+// attribute and spatial filters) and index the envelope of their geometry.
+void OGRLayerAlgebraMethodIndex::Load()
+{
+    std::vector<OGREnvelope> asEnvelopes;
+    for (auto &&poFeature : m_poSrcLayer)
+    {
+        OGREnvelope sEnvelope;
+        const OGRGeometry *poGeom = poFeature->GetGeometryRef();
+        if (poGeom && !poGeom->IsEmpty())
+        {
+            poGeom->getEnvelope(&sEnvelope);
+            m_sExtent.Merge(sEnvelope);
+        }
+        asEnvelopes.push_back(sEnvelope);
+        m_apoFeatures.push_back(std::move(poFeature));
+    }
+
+    if (m_sExtent.IsInit())
+    {
+        CPLRectObj sGlobalBounds;
+        sGlobalBounds.minx = m_sExtent.MinX;
+        sGlobalBounds.miny = m_sExtent.MinY;
+        sGlobalBounds.maxx = m_sExtent.MaxX;
+        sGlobalBounds.maxy = m_sExtent.MaxY;
+        m_hQuadTree = CPLQuadTreeCreate(&sGlobalBounds, nullptr);
+        for (size_t i = 0; i < asEnvelopes.size(); ++i)
+        {
+            const OGREnvelope &sEnvelope = asEnvelopes[i];
+            if (!sEnvelope.IsInit())
+                continue;
+            CPLRectObj sBounds;
+            sBounds.minx = sEnvelope.MinX;
+            sBounds.miny = sEnvelope.MinY;
+            sBounds.maxx = sEnvelope.MaxX;
+            sBounds.maxy = sEnvelope.MaxY;
+            CPLQuadTreeInsertWithBounds(
+                m_hQuadTree,
+                reinterpret_cast<void *>(static_cast<uintptr_t>(i)), &sBounds);
+        }
+    }
+
+    SetSpatialFilter(m_poSrcLayer->GetSpatialFilter());
+}
+
+/************************************************************************/
+/*                            ResetReading()                            */
+/************************************************************************/
+
+void OGRLayerAlgebraMethodIndex::ResetReading()
+{
+    m_anCandidates.clear();
+    m_iNext = 0;
+    if (m_poFilterGeom == nullptr)
+    {
+        m_anCandidates.resize(m_apoFeatures.size());
+        for (size_t i = 0; i < m_apoFeatures.size(); ++i)
+            m_anCandidates[i] = static_cast<int>(i);
+    }
+    else if (m_hQuadTree)
+    {
+        CPLRectObj sAoi;
+        sAoi.minx = m_sFilterEnvelope.MinX;
+        sAoi.miny = m_sFilterEnvelope.MinY;
+        sAoi.maxx = m_sFilterEnvelope.MaxX;
+        sAoi.maxy = m_sFilterEnvelope.MaxY;
+        int nFeatureCount = 0;
+        void **pahFeatures =
+            CPLQuadTreeSearch(m_hQuadTree, &sAoi, &nFeatureCount);
+        m_anCandidates.reserve(nFeatureCount);
+        for (int i = 0; i < nFeatureCount; ++i)
+        {
+            m_anCandidates.push_back(
+                static_cast<int>(reinterpret_cast<uintptr_t>(pahFeatures[i])));
+        }
+        CPLFree(pahFeatures);
+        // Return features in the same order as the source layer would.
+        std::sort(m_anCandidates.begin(), m_anCandidates.end());
+    }
+}
+
+/************************************************************************/
+/*                           GetNextFeature()                           */
+/************************************************************************/
+
+OGRFeature *OGRLayerAlgebraMethodIndex::GetNextFeature()
+{
+    while (m_iNext < m_anCandidates.size())
+    {
+        const OGRFeature *poFeature =
+            m_apoFeatures[m_anCandidates[m_iNext++]].get();
+        if (m_poFilterGeom == nullptr ||
+            FilterGeometry(poFeature->GetGeometryRef()))
+        {
+            return poFeature->Clone();
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+/************************************************************************/
+/*                       index_method_layer()                           */
+/************************************************************************/
+
+// Returns an in-memory indexed copy of pLayerMethod if requested by the
+// METHOD_LAYER_INDEX option, or nullptr otherwise.
+static std::unique_ptr<OGRLayer> index_method_layer(OGRLayer *pLayerMethod,
+                                                    CSLConstList papszOptions)
+{
+    const char *pszIndex =
+        CSLFetchNameValueDef(papszOptions, "METHOD_LAYER_INDEX", "NO");
+    const bool bIndex =
+        EQUAL(pszIndex, "AUTO")
+            ? !pLayerMethod->TestCapability(OLCFastSpatialFilter)
+            : CPLTestBool(pszIndex);
+    if (!bIndex)
+        return nullptr;
+    CPLDebug("OGR", "Building in-memory spatial index of method layer %s",
+             pLayerMethod->GetDescription());
+    auto poIndex = std::make_unique<OGRLayerAlgebraMethodIndex>(pLayerMethod);
+    poIndex->Load();
+    return poIndex;
+}
+
 static OGRGeometry *set_filter_from(OGRLayer *pLayer,
                                     OGRGeometry *pGeometryExistingFilter,
                                     OGRFeature *pFeature)
@@ -3317,6 +3533,15 @@ static OGRGeometry *promote_to_multi(OGRGeometry *poGeom)
  *     features with lower dimension geometry, but only if the result layer
  *     has an unknown geometry type.
  * </li>
+ * <li>METHOD_LAYER_INDEX=YES/NO/AUTO. Set to YES to load the features of
+ *     the method layer once into an in-memory spatial index, instead of
+ *     setting a spatial filter on the method layer for each feature of
+ *     this layer. This will speed up the method significantly when the
+ *     method layer has no efficient spatial filtering (e.g. GeoJSON or CSV),
+ *     at the expense of memory usage. AUTO does it only if the method layer
+ *     does not advertise the OLCFastSpatialFilter capability. Defaults to NO.
+ *     (since GDAL 3.12)
+ * </li>
  * </ul>
  *
  * This method is the same as the C function OGR_L_Intersection().
@@ -3377,6 +3602,11 @@ OGRErr OGRLayer::Intersection(OGRLayer *pLayerMethod, OGRLayer *pLayerResult,
         return OGRERR_UNSUPPORTED_OPERATION;
     }
 
+    // use an in-memory spatial index of the method layer if asked for
+    auto poIndexedMethodLayer = index_method_layer(pLayerMethod, papszOptions);
+    if (poIndexedMethodLayer)
+        pLayerMethod = poIndexedMethodLayer.get();
+
     // get resources
     ret = clone_spatial_filter(pLayerMethod, &pGeometryMethodFilter);
     if (ret != OGRERR_NONE)
@@ -3639,6 +3869,15 @@ done:
  *     features with lower dimension geometry, but only if the result layer
  *     has an unknown geometry type.
  * </li>
+ * <li>METHOD_LAYER_INDEX=YES/NO/AUTO. Set to YES to load the features of
+ *     the method layer once into an in-memory spatial index, instead of
+ *     setting a spatial filter on the method layer for each feature of
+ *     this layer. This will speed up the method significantly when the
+ *     method layer has no efficient spatial filtering (e.g. GeoJSON or CSV),
+ *     at the expense of memory usage. AUTO does it only if the method layer
+ *     does not advertise the OLCFastSpatialFilter capability. Defaults to NO.
+ *     (since GDAL 3.12)
+ * </li>
  * </ul>
  *
  * This function is the same as the C++ method OGRLayer::Intersection().
@@ -3735,6 +3974,15 @@ OGRErr OGR_L_Intersection(OGRLayerH pLayerInput, OGRLayerH pLayerMethod,
  *     features with lower dimension geometry, but only if the result layer
  *     has an unknown geometry type.
  * </li>
+ * <li>METHOD_LAYER_INDEX=YES/NO/AUTO. Set to YES to load the features of
+ *     the method layer once into an in-memory spatial index, instead of
+ *     setting a spatial filter on the method layer for each feature of
+ *     this layer. This will speed up the method significantly when the
+ *     method layer has no efficient spatial filtering (e.g. GeoJSON or CSV),
+ *     at the expense of memory usage. AUTO does it only if the method layer
+ *     does not advertise the OLCFastSpatialFilter capability. Defaults to NO.
+ *     (since GDAL 3.12)
+ * </li>
  * </ul>
  *
  * This method is the same as the C function OGR_L_Union().
@@ -3794,6 +4042,11 @@ OGRErr OGRLayer::Union(OGRLayer *pLayerMethod, OGRLayer *pLayerResult,
         return OGRERR_UNSUPPORTED_OPERATION;
     }
 
+    // use an in-memory spatial index of the method layer if asked for
+    auto poIndexedMethodLayer = index_method_layer(pLayerMethod, papszOptions);
+    if (poIndexedMethodLayer)
+        pLayerMethod = poIndexedMethodLayer.get();
+
     // get resources
     ret = clone_spatial_filter(this, &pGeometryInputFilter);
     if (ret != OGRERR_NONE)
@@ -4189,6 +4442,15 @@ done:
  *     features with lower dimension geometry, but only if the result layer
  *     has an unknown geometry type.
  * </li>
+ * <li>METHOD_LAYER_INDEX=YES/NO/AUTO. Set to YES to load the features of
+ *     the method layer once into an in-memory spatial index, instead of
+ *     setting a spatial filter on the method layer for each feature of
+ *     this layer. This will speed up the method significantly when the
+ *     method layer has no efficient spatial filtering (e.g. GeoJSON or CSV),
+ *     at the expense of memory usage. AUTO does it only if the method layer
+ *     does not advertise the OLCFastSpatialFilter capability. Defaults to NO.
+ *     (since GDAL 3.12)
+ * </li>
  * </ul>
  *
  * This function is the same as the C++ method OGRLayer::Union().
@@ -4272,6 +4534,15 @@ OGRErr OGR_L_Union(OGRLayerH pLayerInput, OGRLayerH pLayerMethod,
  * <li>METHOD_PREFIX=string. Set a prefix for the field names that
  *     will be created from the fields of the method layer.
  * </li>
+ * <li>METHOD_LAYER_INDEX=YES/NO/AUTO. Set to YES to load the features of
+ *     the method layer once into an in-memory spatial index, instead of
+ *     setting a spatial filter on the method layer for each feature of
+ *     this layer. This will speed up the method significantly when the
+ *     method layer has no efficient spatial filtering (e.g. GeoJSON or CSV),
+ *     at the expense of memory usage. AUTO does it only if the method layer
+ *     does not advertise the OLCFastSpatialFilter capability. Defaults to NO.
+ *     (since GDAL 3.12)
+ * </li>
  * </ul>
  *
  * This method is the same as the C function OGR_L_SymDifference().
@@ -4327,6 +4598,11 @@ OGRErr OGRLayer::SymDifference(OGRLayer *pLayerMethod, OGRLayer *pLayerResult,
         return OGRERR_UNSUPPORTED_OPERATION;
     }
 
+    // use an in-memory spatial index of the method layer if asked for
+    auto poIndexedMethodLayer = index_method_layer(pLayerMethod, papszOptions);
+    if (poIndexedMethodLayer)
+        pLayerMethod = poIndexedMethodLayer.get();
+
     // get resources
     ret = clone_spatial_filter(this, &pGeometryInputFilter);
     if (ret != OGRERR_NONE)
@@ -4607,6 +4883,15 @@ done:
  * <li>METHOD_PREFIX=string. Set a prefix for the field names that
  *     will be created from the fields of the method layer.
  * </li>
+ * <li>METHOD_LAYER_INDEX=YES/NO/AUTO. Set to YES to load the features of
+ *     the method layer once into an in-memory spatial index, instead of
+ *     setting a spatial filter on the method layer for each feature of
+ *     this layer. This will speed up the method significantly when the
+ *     method layer has no efficient spatial filtering (e.g. GeoJSON or CSV),
+ *     at the expense of memory usage. AUTO does it only if the method layer
+ *     does not advertise the OLCFastSpatialFilter capability. Defaults to NO.
+ *     (since GDAL 3.12)
+ * </li>
  * </ul>
  *
  * This function is the same as the C++ method OGRLayer::SymDifference().
@@ -4702,6 +4987,15 @@ OGRErr OGR_L_SymDifference(OGRLayerH pLayerInput, OGRLayerH pLayerMethod,
  *     features with lower dimension geometry, but only if the result layer
  *     has an unknown geometry type.
  * </li>
+ * <li>METHOD_LAYER_INDEX=YES/NO/AUTO. Set to YES to load the features of
+ *     the method layer once into an in-memory spatial index, instead of
+ *     setting a spatial filter on the method layer for each feature of
+ *     this layer. This will speed up the method significantly when the
+ *     method layer has no efficient spatial filtering (e.g. GeoJSON or CSV),
+ *     at the expense of memory usage. AUTO does it only if the method layer
+ *     does not advertise the OLCFastSpatialFilter capability. Defaults to NO.
+ *     (since GDAL 3.12)
+ * </li>
  * </ul>
  *
  * This method is the same as the C function OGR_L_Identity().
@@ -4757,6 +5051,11 @@ OGRErr OGRLayer::Identity(OGRLayer *pLayerMethod, OGRLayer *pLayerResult,
                  "OGRLayer::Identity() requires GEOS support");
         return OGRERR_UNSUPPORTED_OPERATION;
     }
+
+    // use an in-memory spatial index of the method layer if asked for
+    auto poIndexedMethodLayer = index_method_layer(pLayerMethod, papszOptions);
+    if (poIndexedMethodLayer)
+        pLayerMethod = poIndexedMethodLayer.get();
     if (bKeepLowerDimGeom)
     {
         // require that the result layer is of geom type unknown
@@ -5036,6 +5335,15 @@ done:
  *     features with lower dimension geometry, but only if the result layer
  *     has an unknown geometry type.
  * </li>
+ * <li>METHOD_LAYER_INDEX=YES/NO/AUTO. Set to YES to load the features of
+ *     the method layer once into an in-memory spatial index, instead of
+ *     setting a spatial filter on the method layer for each feature of
+ *     this layer. This will speed up the method significantly when the
+ *     method layer has no efficient spatial filtering (e.g. GeoJSON or CSV),
+ *     at the expense of memory usage. AUTO does it only if the method layer
+ *     does not advertise the OLCFastSpatialFilter capability. Defaults to NO.
+ *     (since GDAL 3.12)
+ * </li>
  * </ul>
  *
  * This function is the same as the C++ method OGRLayer::Identity().
@@ -5120,6 +5428,15 @@ OGRErr OGR_L_Identity(OGRLayerH pLayerInput, OGRLayerH pLayerMethod,
  * <li>METHOD_PREFIX=string. Set a prefix for the field names that
  *     will be created from the fields of the method layer.
  * </li>
+ * <li>METHOD_LAYER_INDEX=YES/NO/AUTO. Set to YES to load the features of
+ *     the method layer once into an in-memory spatial index, instead of
+ *     setting a spatial filter on the method layer for each feature of
+ *     this layer. This will speed up the method significantly when the
+ *     method layer has no efficient spatial filtering (e.g. GeoJSON or CSV),
+ *     at the expense of memory usage. AUTO does it only if the method layer
+ *     does not advertise the OLCFastSpatialFilter capability. Defaults to NO.
+ *     (since GDAL 3.12)
+ * </li>
  * </ul>
  *
  * This method is the same as the C function OGR_L_Update().
@@ -5174,6 +5491,11 @@ OGRErr OGRLayer::Update(OGRLayer *pLayerMethod, OGRLayer *pLayerResult,
         return OGRERR_UNSUPPORTED_OPERATION;
     }
 
+    // use an in-memory spatial index of the method layer if asked for
+    auto poIndexedMethodLayer = index_method_layer(pLayerMethod, papszOptions);
+    if (poIndexedMethodLayer)
+        pLayerMethod = poIndexedMethodLayer.get();
+
     // get resources
     ret = clone_spatial_filter(pLayerMethod, &pGeometryMethodFilter);
     if (ret != OGRERR_NONE)
@@ -5392,6 +5714,15 @@ done:
  * <li>METHOD_PREFIX=string. Set a prefix for the field names that
  *     will be created from the fields of the method layer.
  * </li>
+ * <li>METHOD_LAYER_INDEX=YES/NO/AUTO. Set to YES to load the features of
+ *     the method layer once into an in-memory spatial index, instead of
+ *     setting a spatial filter on the method layer for each feature of
+ *     this layer. This will speed up the method significantly when the
+ *     method layer has no efficient spatial filtering (e.g. GeoJSON or CSV),
+ *     at the expense of memory usage. AUTO does it only if the method layer
+ *     does not advertise the OLCFastSpatialFilter capability. Defaults to NO.
+ *     (since GDAL 3.12)
+ * </li>
  * </ul>
  *
  * This function is the same as the C++ method OGRLayer::Update().
@@ -5469,6 +5800,15 @@ OGRErr OGR_L_Update(OGRLayerH pLayerInput, OGRLayerH pLayerMethod,
  * <li>METHOD_PREFIX=string. Set a prefix for the field names that
  *     will be created from the fields of the method layer.
  * </li>
+ * <li>METHOD_LAYER_INDEX=YES/NO/AUTO. Set to YES to load the features of
+ *     the method layer once into an in-memory spatial index, instead of
+ *     setting a spatial filter on the method layer for each feature of
+ *     this layer. This will speed up the method significantly when the
+ *     method layer has no efficient spatial filtering (e.g. GeoJSON or CSV),
+ *     at the expense of memory usage. AUTO does it only if the method layer
+ *     does not advertise the OLCFastSpatialFilter capability. Defaults to NO.
+ *     (since GDAL 3.12)
+ * </li>
  * </ul>
  *
  * This method is the same as the C function OGR_L_Clip().
@@ -5519,6 +5859,11 @@ OGRErr OGRLayer::Clip(OGRLayer *pLayerMethod, OGRLayer *pLayerResult,
         return OGRERR_UNSUPPORTED_OPERATION;
     }
 
+    // use an in-memory spatial index of the method layer if asked for
+    auto poIndexedMethodLayer = index_method_layer(pLayerMethod, papszOptions);
+    if (poIndexedMethodLayer)
+        pLayerMethod = poIndexedMethodLayer.get();
+
     ret = clone_spatial_filter(pLayerMethod, &pGeometryMethodFilter);
     if (ret != OGRERR_NONE)
         goto done;
@@ -5701,6 +6046,15 @@ done:
  * <li>METHOD_PREFIX=string. Set a prefix for the field names that
  *     will be created from the fields of the method layer.
  * </li>
+ * <li>METHOD_LAYER_INDEX=YES/NO/AUTO. Set to YES to load the features of
+ *     the method layer once into an in-memory spatial index, instead of
+ *     setting a spatial filter on the method layer for each feature of
+ *     this layer. This will speed up the method significantly when the
+ *     method layer has no efficient spatial filtering (e.g. GeoJSON or CSV),
+ *     at the expense of memory usage. AUTO does it only if the method layer
+ *     does not advertise the OLCFastSpatialFilter capability. Defaults to NO.
+ *     (since GDAL 3.12)
+ * </li>
  * </ul>
  *
  * This function is the same as the C++ method OGRLayer::Clip().
@@ -5778,6 +6132,15 @@ OGRErr OGR_L_Clip(OGRLayerH pLayerInput, OGRLayerH pLayerMethod,
  * <li>METHOD_PREFIX=string. Set a prefix for the field names that
  *     will be created from the fields of the method layer.
  * </li>
+ * <li>METHOD_LAYER_INDEX=YES/NO/AUTO. Set to YES to load the features of
+ *     the method layer once into an in-memory spatial index, instead of
+ *     setting a spatial filter on the method layer for each feature of
+ *     this layer. This will speed up the method significantly when the
+ *     method layer has no efficient spatial filtering (e.g. GeoJSON or CSV),
+ *     at the expense of memory usage. AUTO does it only if the method layer
+ *     does not advertise the OLCFastSpatialFilter capability. Defaults to NO.
+ *     (since GDAL 3.12)
+ * </li>
  * </ul>
  *
  * This method is the same as the C function OGR_L_Erase().
@@ -5828,6 +6191,11 @@ OGRErr OGRLayer::Erase(OGRLayer *pLayerMethod, OGRLayer *pLayerResult,
         return OGRERR_UNSUPPORTED_OPERATION;
     }
 
+    // use an in-memory spatial index of the method layer if asked for
+    auto poIndexedMethodLayer = index_method_layer(pLayerMethod, papszOptions);
+    if (poIndexedMethodLayer)
+        pLayerMethod = poIndexedMethodLayer.get();
+
     // get resources
     ret = clone_spatial_filter(pLayerMethod, &pGeometryMethodFilter);
     if (ret != OGRERR_NONE)
@@ -5989,6 +6357,15 @@ done:
  * <li>METHOD_PREFIX=string. Set a prefix for the field names that
  *     will be created from the fields of the method layer.
  * </li>
+ * <li>METHOD_LAYER_INDEX=YES/NO/AUTO. Set to YES to load the features of
+ *     the method layer once into an in-memory spatial index, instead of
+ *     setting a spatial filter on the method layer for each feature of
+ *     this layer. This will speed up the method significantly when the
+ *     method layer has no efficient spatial filtering (e.g. GeoJSON or CSV),
+ *     at the expense of memory usage. AUTO does it only if the method layer
+ *     does not advertise the OLCFastSpatialFilter capability. Defaults to NO.
+ *     (since GDAL 3.12)
+ * </li>
  * </ul>
  *
  * This function is the same as the C++ method OGRLayer::Erase().
@@ -16,6 +16,7 @@
 #include "ogrsf_frmts.h"
 
 #include "cpl_json.h"
+#include "cpl_vsi_virtual.h"
 
 #include <functional>
 #include <map>
@@ -333,12 +334,37 @@ class OGRParquetWriterLayer final : public OGRArrowWriterLayer
     bool m_bForceCounterClockwiseOrientation = false;
     parquet::WriterProperties::Builder m_oWriterPropertiesBuilder{};
 
-    //! Temporary GeoPackage dataset. Only used in SORT_BY_BBOX mode
-    std::unique_ptr<GDALDataset> m_poTmpGPKG{};
-    //! Temporary GeoPackage layer. Only used in SORT_BY_BBOX mode
-    OGRLayer *m_poTmpGPKGLayer = nullptr;
-    //! Number of features written by ICreateFeature(). Only used in SORT_BY_BBOX mode
+    //! Serialized feature, with the center of the bounding box of its geometry
+    struct SortItem
+    {
+        double dfX = 0;
+        double dfY = 0;
+        bool bHasGeom = false;
+        //! Hilbert code of (dfX, dfY), or 0 if no geometry. Set at the end
+        uint64_t nKey = 0;
+        std::vector<GByte> abyFeature{};
+    };
+
+    //! Whether SORT_BY_BBOX=YES
+    bool m_bSortByBBOX = false;
+    //! Features buffered in memory. Only used in SORT_BY_BBOX mode
+    std::vector<SortItem> m_aoSortItems{};
+    //! Memory used by m_aoSortItems. Only used in SORT_BY_BBOX mode
+    size_t m_nSortItemsMemory = 0;
+    //! Maximum value of m_nSortItemsMemory before spilling to a temporary file
+    size_t m_nSortMaxMemory = 0;
+    //! Extent of the centers of geometry bounding boxes
+    OGREnvelope m_oSortExtent{};
+    //! Temporary file where runs of features are spilled
+    std::string m_osSortTmpFilename{};
+    VSIVirtualHandleUniquePtr m_fpSortTmp{};
+    //! Offset in m_fpSortTmp and number of features of spilled runs
+    std::vector<std::pair<vsi_l_offset, size_t>> m_anSortRuns{};
+    //! Number of features written by ICreateFeature(). Only used in
+    //! SORT_BY_BBOX mode
     GIntBig m_nTmpFeatureCount = 0;
+    //! Whether features with geometries have started to be written to final file
+    bool m_bSortHasGeomWritten = false;
 
     //! Whether to write "geo" footer metadata;
     bool m_bWriteGeoMetadata = true;
@@ -375,8 +401,24 @@ class OGRParquetWriterLayer final : public OGRArrowWriterLayer
 
     std::string GetGeoMetadata() const;
 
-    //! Copy temporary GeoPackage layer to final Parquet file
-    bool CopyTmpGpkgLayerToFinalFile();
+    //! Spill features buffered in SORT_BY_BBOX mode to the temporary file
+    bool SpillSortItems();
+
+    //! Compute the sort keys of features buffered in SORT_BY_BBOX mode
+    void ComputeSortKeys(std::vector<SortItem> &aoItems) const;
+
+    //! Write features in SORT_BY_BBOX mode to final Parquet file
+    bool WriteSortedFeatures();
+
+    //! Merge sorted runs of a temporary file, passing features to fnWrite
+    bool
+    MergeSortedRuns(const std::string &osFilename,
+                    const std::pair<vsi_l_offset, size_t> *panRuns,
+                    size_t nRuns,
+                    const std::function<bool(const SortItem &)> &fnWrite);
+
+    //! Write a serialized feature to final Parquet file
+    bool WriteSerializedFeature(OGRFeature &oFeat, const SortItem &oItem);
 
   public:
     OGRParquetWriterLayer(
@@ -384,6 +426,8 @@ class OGRParquetWriterLayer final : public OGRArrowWriterLayer
         const std::shared_ptr<arrow::io::OutputStream> &poOutputStream,
         const char *pszLayerName);
 
+    ~OGRParquetWriterLayer() override;
+
     CPLErr SetMetadata(char **papszMetadata, const char *pszDomain) override;
 
     bool SetOptions(CSLConstList papszOptions,
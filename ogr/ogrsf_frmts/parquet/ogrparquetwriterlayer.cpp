@@ -23,7 +23,10 @@
 
 #include "ogr_wkb.h"
 
-#include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
 #include <utility>
 
 /************************************************************************/
@@ -41,15 +44,30 @@ OGRParquetWriterLayer::OGRParquetWriterLayer(
         CPLGetConfigOption("OGR_PARQUET_WRITE_ARROW_EXTENSION_NAME", "NO"));
 }
 
+/************************************************************************/
+/*                     ~OGRParquetWriterLayer()                         */
+/************************************************************************/
+
+OGRParquetWriterLayer::~OGRParquetWriterLayer()
+{
+    // In case Close() has not been called or has failed
+    if (m_fpSortTmp)
+    {
+        m_fpSortTmp.reset();
+        VSIUnlink(m_osSortTmpFilename.c_str());
+    }
+}
+
 /************************************************************************/
 /*                                Close()                               */
 /************************************************************************/
 
 bool OGRParquetWriterLayer::Close()
 {
-    if (m_poTmpGPKGLayer)
+    if (m_bSortByBBOX)
     {
-        if (!CopyTmpGpkgLayerToFinalFile())
+        m_bSortByBBOX = false;
+        if (!WriteSortedFeatures())
             return false;
     }
 
@@ -63,220 +81,460 @@ bool OGRParquetWriterLayer::Close()
 }
 
 /************************************************************************/
-/*                     CopyTmpGpkgLayerToFinalFile()                    */
+/*                            Hilbert()                                 */
+/************************************************************************/
+
+// Based on public domain code at
+// https://github.com/rawrunprotected/hilbert_curves
+static uint32_t Hilbert(uint32_t x, uint32_t y)
+{
+    uint32_t a = x ^ y;
+    uint32_t b = 0xFFFF ^ a;
+    uint32_t c = 0xFFFF ^ (x | y);
+    uint32_t d = x & (y ^ 0xFFFF);
+
+    uint32_t A = a | (b >> 1);
+    uint32_t B = (a >> 1) ^ a;
+    uint32_t C = ((c >> 1) ^ (b & (d >> 1))) ^ c;
+    uint32_t D = ((a & (c >> 1)) ^ (d >> 1)) ^ d;
+
+    a = A;
+    b = B;
+    c = C;
+    d = D;
+    A = ((a & (a >> 2)) ^ (b & (b >> 2)));
+    B = ((a & (b >> 2)) ^ (b & ((a ^ b) >> 2)));
+    C ^= ((a & (c >> 2)) ^ (b & (d >> 2)));
+    D ^= ((b & (c >> 2)) ^ ((a ^ b) & (d >> 2)));
+
+    a = A;
+    b = B;
+    c = C;
+    d = D;
+    A = ((a & (a >> 4)) ^ (b & (b >> 4)));
+    B = ((a & (b >> 4)) ^ (b & ((a ^ b) >> 4)));
+    C ^= ((a & (c >> 4)) ^ (b & (d >> 4)));
+    D ^= ((b & (c >> 4)) ^ ((a ^ b) & (d >> 4)));
+
+    a = A;
+    b = B;
+    c = C;
+    d = D;
+    C ^= ((a & (c >> 8)) ^ (b & (d >> 8)));
+    D ^= ((b & (c >> 8)) ^ ((a ^ b) & (d >> 8)));
+
+    a = C ^ (C >> 1);
+    b = D ^ (D >> 1);
+
+    uint32_t i0 = x ^ y;
+    uint32_t i1 = b | (0xFFFF ^ (i0 | a));
+
+    i0 = (i0 | (i0 << 8)) & 0x00FF00FF;
+    i0 = (i0 | (i0 << 4)) & 0x0F0F0F0F;
+    i0 = (i0 | (i0 << 2)) & 0x33333333;
+    i0 = (i0 | (i0 << 1)) & 0x55555555;
+
+    i1 = (i1 | (i1 << 8)) & 0x00FF00FF;
+    i1 = (i1 | (i1 << 4)) & 0x0F0F0F0F;
+    i1 = (i1 | (i1 << 2)) & 0x33333333;
+    i1 = (i1 | (i1 << 1)) & 0x55555555;
+
+    return (i1 << 1) | i0;
+}
+
+/************************************************************************/
+/*                          ComputeSortKeys()                           */
 /************************************************************************/
 
-bool OGRParquetWriterLayer::CopyTmpGpkgLayerToFinalFile()
+void OGRParquetWriterLayer::ComputeSortKeys(
+    std::vector<SortItem> &aoItems) const
 {
-    if (!m_poTmpGPKGLayer)
+    constexpr double HILBERT_MAX = 0xFFFF;
+    const double dfWidth = m_oSortExtent.MaxX - m_oSortExtent.MinX;
+    const double dfHeight = m_oSortExtent.MaxY - m_oSortExtent.MinY;
+    for (auto &oItem : aoItems)
     {
-        return true;
+        if (!oItem.bHasGeom)
+        {
+            // Features without geometry are written first
+            oItem.nKey = 0;
+            continue;
+        }
+        uint32_t x = 0;
+        uint32_t y = 0;
+        if (dfWidth > 0)
+            x = static_cast<uint32_t>(
+                std::floor(HILBERT_MAX * (oItem.dfX - m_oSortExtent.MinX) /
+                           dfWidth));
+        if (dfHeight > 0)
+            y = static_cast<uint32_t>(
+                std::floor(HILBERT_MAX * (oItem.dfY - m_oSortExtent.MinY) /
+                           dfHeight));
+        oItem.nKey = 1 + static_cast<uint64_t>(Hilbert(x, y));
     }
+    // Stable sort to preserve the order of features without geometry
+    std::stable_sort(aoItems.begin(), aoItems.end(),
+                     [](const SortItem &a, const SortItem &b)
+                     { return a.nKey < b.nKey; });
+}
 
-    CPLDebug("PARQUET", "CopyTmpGpkgLayerToFinalFile(): start...");
-
-    VSIUnlink(m_poTmpGPKG->GetDescription());
+/************************************************************************/
+/*                         WriteSortItem()                              */
+/************************************************************************/
 
-    OGRFeature oFeat(m_poFeatureDefn);
+static bool WriteSortItem(VSILFILE *fp, double dfX, double dfY, bool bHasGeom,
+                          uint64_t nKey, const std::vector<GByte> &abyFeature)
+{
+    const uint8_t nHasGeom = bHasGeom ? 1 : 0;
+    const uint64_t nSize = abyFeature.size();
+    return VSIFWriteL(&dfX, sizeof(dfX), 1, fp) == 1 &&
+           VSIFWriteL(&dfY, sizeof(dfY), 1, fp) == 1 &&
+           VSIFWriteL(&nHasGeom, sizeof(nHasGeom), 1, fp) == 1 &&
+           VSIFWriteL(&nKey, sizeof(nKey), 1, fp) == 1 &&
+           VSIFWriteL(&nSize, sizeof(nSize), 1, fp) == 1 &&
+           VSIFWriteL(abyFeature.data(), 1, abyFeature.size(), fp) ==
+               abyFeature.size();
+}
 
-    // Interval in terms of features between 2 debug progress report messages
-    constexpr int PROGRESS_FC_INTERVAL = 100 * 1000;
+/************************************************************************/
+/*                          ReadSortItem()                              */
+/************************************************************************/
 
-    // First, write features without geometries
+static bool ReadSortItem(VSILFILE *fp, double &dfX, double &dfY,
+                         bool &bHasGeom, uint64_t &nKey,
+                         std::vector<GByte> &abyFeature)
+{
+    uint8_t nHasGeom = 0;
+    uint64_t nSize = 0;
+    if (VSIFReadL(&dfX, sizeof(dfX), 1, fp) != 1 ||
+        VSIFReadL(&dfY, sizeof(dfY), 1, fp) != 1 ||
+        VSIFReadL(&nHasGeom, sizeof(nHasGeom), 1, fp) != 1 ||
+        VSIFReadL(&nKey, sizeof(nKey), 1, fp) != 1 ||
+        VSIFReadL(&nSize, sizeof(nSize), 1, fp) != 1 ||
+        static_cast<uint64_t>(static_cast<size_t>(nSize)) != nSize)
     {
-        auto poTmpLayer = std::unique_ptr<OGRLayer>(m_poTmpGPKG->ExecuteSQL(
-            "SELECT serialized_feature FROM tmp WHERE fid NOT IN (SELECT id "
-            "FROM rtree_tmp_geom)",
-            nullptr, nullptr));
-        if (!poTmpLayer)
-            return false;
-        for (const auto &poSrcFeature : poTmpLayer.get())
-        {
-            int nBytesFeature = 0;
-            const GByte *pabyFeatureData =
-                poSrcFeature->GetFieldAsBinary(0, &nBytesFeature);
-            if (!oFeat.DeserializeFromBinary(pabyFeatureData, nBytesFeature))
-            {
-                CPLError(CE_Failure, CPLE_AppDefined,
-                         "Cannot deserialize feature");
-                return false;
-            }
-            if (OGRArrowWriterLayer::ICreateFeature(&oFeat) != OGRERR_NONE)
-            {
-                return false;
-            }
+        CPLError(CE_Failure, CPLE_FileIO,
+                 "Cannot read feature from temporary file");
+        return false;
+    }
+    bHasGeom = nHasGeom != 0;
+    try
+    {
+        abyFeature.resize(static_cast<size_t>(nSize));
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate memory for feature");
+        return false;
+    }
+    if (VSIFReadL(abyFeature.data(), 1, abyFeature.size(), fp) !=
+        abyFeature.size())
+    {
+        CPLError(CE_Failure, CPLE_FileIO,
+                 "Cannot read feature from temporary file");
+        return false;
+    }
+    return true;
+}
 
-            if ((m_nFeatureCount % PROGRESS_FC_INTERVAL) == 0)
-            {
-                CPLDebugProgress(
-                    "PARQUET",
-                    "CopyTmpGpkgLayerToFinalFile(): %.02f%% progress",
-                    100.0 * double(m_nFeatureCount) /
-                        double(m_nTmpFeatureCount));
-            }
-        }
+/************************************************************************/
+/*                          SpillSortItems()                            */
+/************************************************************************/
 
-        if (!FlushFeatures())
+bool OGRParquetWriterLayer::SpillSortItems()
+{
+    if (!m_fpSortTmp)
+    {
+        const char *pszDSName = m_poDataset->GetDescription();
+        if (VSISupportsRandomWrite(pszDSName, false))
+            m_osSortTmpFilename = pszDSName;
+        else
+            m_osSortTmpFilename = CPLGenerateTempFilenameSafe(
+                CPLGetBasenameSafe(pszDSName).c_str());
+        m_osSortTmpFilename += ".sort.tmp";
+        m_fpSortTmp.reset(VSIFOpenL(m_osSortTmpFilename.c_str(), "wb+"));
+        if (!m_fpSortTmp)
         {
+            CPLError(CE_Failure, CPLE_FileIO, "Cannot create %s",
+                     m_osSortTmpFilename.c_str());
             return false;
         }
     }
 
-    // Now walk through the GPKG RTree for features with geometries
-    // Cf https://github.com/sqlite/sqlite/blob/master/ext/rtree/rtree.c
-    // for the description of the content of the rtree _node table
-    std::vector<std::pair<int64_t, int>> aNodeNoDepthPair;
-    int nTreeDepth = 0;
-    // Queue the root node
-    aNodeNoDepthPair.emplace_back(
-        std::make_pair(/* nodeNo = */ 1, /* depth = */ 0));
-    int nCountWrittenFeaturesSinceLastFlush = 0;
-    while (!aNodeNoDepthPair.empty())
+    CPLDebug("PARQUET", "Spilling %d features to temporary file",
+             static_cast<int>(m_aoSortItems.size()));
+    m_anSortRuns.emplace_back(m_fpSortTmp->Tell(), m_aoSortItems.size());
+    for (const auto &oItem : m_aoSortItems)
     {
-        const auto &oLastPair = aNodeNoDepthPair.back();
-        const int64_t nNodeNo = oLastPair.first;
-        const int nCurDepth = oLastPair.second;
-        //CPLDebug("PARQUET", "Reading nodeNode=%d, curDepth=%d", int(nNodeNo), nCurDepth);
-        aNodeNoDepthPair.pop_back();
-
-        auto poRTreeLayer = std::unique_ptr<OGRLayer>(m_poTmpGPKG->ExecuteSQL(
-            CPLSPrintf("SELECT data FROM rtree_tmp_geom_node WHERE nodeno "
-                       "= " CPL_FRMT_GIB,
-                       static_cast<GIntBig>(nNodeNo)),
-            nullptr, nullptr));
-        if (!poRTreeLayer)
+        if (!WriteSortItem(m_fpSortTmp.get(), oItem.dfX, oItem.dfY,
+                           oItem.bHasGeom, 0, oItem.abyFeature))
         {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Cannot read node " CPL_FRMT_GIB,
-                     static_cast<GIntBig>(nNodeNo));
+            CPLError(CE_Failure, CPLE_FileIO, "Cannot write into %s",
+                     m_osSortTmpFilename.c_str());
             return false;
         }
-        const auto poRTreeFeature =
-            std::unique_ptr<const OGRFeature>(poRTreeLayer->GetNextFeature());
-        if (!poRTreeFeature)
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Cannot read node " CPL_FRMT_GIB,
-                     static_cast<GIntBig>(nNodeNo));
+    }
+    m_aoSortItems.clear();
+    m_nSortItemsMemory = 0;
+    return true;
+}
+
+/************************************************************************/
+/*                       WriteSerializedFeature()                       */
+/************************************************************************/
+
+bool OGRParquetWriterLayer::WriteSerializedFeature(OGRFeature &oFeat,
+                                                   const SortItem &oItem)
+{
+    // Interval in terms of features between 2 debug progress report messages
+    constexpr int PROGRESS_FC_INTERVAL = 100 * 1000;
+
+    // Write features without geometries in their own row groups
+    if (oItem.bHasGeom && m_nFeatureCount > 0 && !m_bSortHasGeomWritten)
+    {
+        if (!FlushFeatures())
             return false;
-        }
+    }
+    m_bSortHasGeomWritten = oItem.bHasGeom;
+
+    if (!oFeat.DeserializeFromBinary(oItem.abyFeature.data(),
+                                     oItem.abyFeature.size()))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot deserialize feature");
+        return false;
+    }
+    if (OGRArrowWriterLayer::ICreateFeature(&oFeat) != OGRERR_NONE)
+    {
+        return false;
+    }
+
+    if ((m_nFeatureCount % PROGRESS_FC_INTERVAL) == 0)
+    {
+        CPLDebugProgress("PARQUET", "WriteSortedFeatures(): %.02f%% progress",
+                         100.0 * double(m_nFeatureCount) /
+                             double(m_nTmpFeatureCount));
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                          MergeSortedRuns()                           */
+/************************************************************************/
 
-        int nNodeBytes = 0;
-        const GByte *pabyNodeData =
-            poRTreeFeature->GetFieldAsBinary(0, &nNodeBytes);
-        constexpr int BLOB_HEADER_SIZE = 4;
-        if (nNodeBytes < BLOB_HEADER_SIZE)
+/** K-way merge of nRuns sorted runs of osFilename, each run being defined
+ * by its offset and number of features. Features are passed to fnWrite by
+ * increasing key, and in the order of the runs for equal keys, so that the
+ * order of insertion is preserved.
+ */
+bool OGRParquetWriterLayer::MergeSortedRuns(
+    const std::string &osFilename,
+    const std::pair<vsi_l_offset, size_t> *panRuns, size_t nRuns,
+    const std::function<bool(const SortItem &)> &fnWrite)
+{
+    std::vector<VSIVirtualHandleUniquePtr> apoRunFiles(nRuns);
+    std::vector<SortItem> aoHeads(nRuns);
+    std::vector<size_t> anRemaining(nRuns);
+    // Heap of run indices, ordered by key of their head feature, and by
+    // run index for equal keys
+    const auto cmp = [&aoHeads](size_t a, size_t b)
+    {
+        return aoHeads[a].nKey > aoHeads[b].nKey ||
+               (aoHeads[a].nKey == aoHeads[b].nKey && a > b);
+    };
+    std::priority_queue<size_t, std::vector<size_t>, decltype(cmp)> oHeap(
+        cmp);
+    const auto ReadHead = [&](size_t iRun)
+    {
+        auto &oItem = aoHeads[iRun];
+        if (!ReadSortItem(apoRunFiles[iRun].get(), oItem.dfX, oItem.dfY,
+                          oItem.bHasGeom, oItem.nKey, oItem.abyFeature))
+            return false;
+        --anRemaining[iRun];
+        oHeap.push(iRun);
+        return true;
+    };
+    for (size_t iRun = 0; iRun < nRuns; ++iRun)
+    {
+        apoRunFiles[iRun].reset(VSIFOpenL(osFilename.c_str(), "rb"));
+        if (!apoRunFiles[iRun])
         {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Not enough bytes when reading node " CPL_FRMT_GIB,
-                     static_cast<GIntBig>(nNodeNo));
+            CPLError(CE_Failure, CPLE_FileIO, "Cannot open %s",
+                     osFilename.c_str());
             return false;
         }
-        if (nNodeNo == 1)
+        apoRunFiles[iRun]->Seek(panRuns[iRun].first, SEEK_SET);
+        anRemaining[iRun] = panRuns[iRun].second;
+        if (anRemaining[iRun] > 0 && !ReadHead(iRun))
+            return false;
+    }
+    while (!oHeap.empty())
+    {
+        const size_t iRun = oHeap.top();
+        oHeap.pop();
+        if (!fnWrite(aoHeads[iRun]))
+            return false;
+        if (anRemaining[iRun] > 0)
         {
-            // Get the RTree depth from the root node
-            nTreeDepth = (pabyNodeData[0] << 8) | pabyNodeData[1];
-            //CPLDebug("PARQUET", "nTreeDepth = %d", nTreeDepth);
+            if (!ReadHead(iRun))
+                return false;
         }
-
-        const int nCellCount = (pabyNodeData[2] << 8) | pabyNodeData[3];
-        constexpr int SIZEOF_CELL = 24;  // int64_t + 4 float
-        if (nNodeBytes < BLOB_HEADER_SIZE + SIZEOF_CELL * nCellCount)
+        else
         {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Not enough bytes when reading node " CPL_FRMT_GIB,
-                     static_cast<GIntBig>(nNodeNo));
-            return false;
+            apoRunFiles[iRun].reset();
         }
+    }
+    return true;
+}
 
-        size_t nOffset = BLOB_HEADER_SIZE;
-        if (nCurDepth == nTreeDepth)
-        {
-            // Leaf node: it references feature IDs.
+/************************************************************************/
+/*                        WriteSortedFeatures()                         */
+/************************************************************************/
 
-            // If we are about to go above m_nRowGroupSize, flush past
-            // features now, to improve the spatial compacity of the row group.
-            if (m_nRowGroupSize > nCellCount &&
-                nCountWrittenFeaturesSinceLastFlush + nCellCount >
-                    m_nRowGroupSize)
-            {
-                nCountWrittenFeaturesSinceLastFlush = 0;
-                if (!FlushFeatures())
-                {
-                    return false;
-                }
-            }
+/** Write features buffered in SORT_BY_BBOX mode in the order of the Hilbert
+ * code of the center of the bounding box of their geometry.
+ *
+ * If all features fit in memory, they are sorted in memory. Otherwise, this
+ * is an external sort: each run spilled to the temporary file is reloaded,
+ * sorted and written to a second temporary file, and sorted runs are then
+ * merged. When there are more than MAX_RUNS_PER_MERGE runs, groups of
+ * consecutive runs are first merged into longer runs, in as many passes as
+ * needed, to bound the number of simultaneously opened files.
+ */
+bool OGRParquetWriterLayer::WriteSortedFeatures()
+{
+    CPLDebug("PARQUET", "WriteSortedFeatures(): start...");
 
-            // nCellCount shouldn't be over 51 normally, but even 65535
-            // would be fine...
-            assert(nCellCount <= 65535);
-            for (int i = 0; i < nCellCount; ++i)
-            {
-                int64_t nFID;
-                memcpy(&nFID, pabyNodeData + nOffset, sizeof(int64_t));
-                CPL_MSBPTR64(&nFID);
+    OGRFeature oFeat(m_poFeatureDefn);
 
-                const auto poSrcFeature = std::unique_ptr<const OGRFeature>(
-                    m_poTmpGPKGLayer->GetFeature(nFID));
-                if (!poSrcFeature)
-                {
-                    CPLError(CE_Failure, CPLE_AppDefined,
-                             "Cannot get feature " CPL_FRMT_GIB,
-                             static_cast<GIntBig>(nFID));
-                    return false;
-                }
+    if (m_anSortRuns.empty())
+    {
+        ComputeSortKeys(m_aoSortItems);
+        for (const auto &oItem : m_aoSortItems)
+        {
+            if (!WriteSerializedFeature(oFeat, oItem))
+                return false;
+        }
+        m_aoSortItems.clear();
+        m_nSortItemsMemory = 0;
+        CPLDebug("PARQUET",
+                 "WriteSortedFeatures(): 100%%, successfully finished");
+        return true;
+    }
 
-                int nBytesFeature = 0;
-                const GByte *pabyFeatureData =
-                    poSrcFeature->GetFieldAsBinary(0, &nBytesFeature);
-                if (!oFeat.DeserializeFromBinary(pabyFeatureData,
-                                                 nBytesFeature))
-                {
-                    CPLError(CE_Failure, CPLE_AppDefined,
-                             "Cannot deserialize feature");
-                    return false;
-                }
-                if (OGRArrowWriterLayer::ICreateFeature(&oFeat) != OGRERR_NONE)
-                {
-                    return false;
-                }
+    if (!m_aoSortItems.empty() && !SpillSortItems())
+        return false;
 
-                nOffset += SIZEOF_CELL;
+    // Sort each run
+    const std::string osSortedTmpFilename(m_osSortTmpFilename + "2");
+    struct SortedTmpFileRemover
+    {
+        const std::string &m_osFilename;
 
-                ++nCountWrittenFeaturesSinceLastFlush;
+        ~SortedTmpFileRemover()
+        {
+            VSIUnlink(m_osFilename.c_str());
+        }
+    } oRemover{osSortedTmpFilename};
+    auto fpSorted = VSIVirtualHandleUniquePtr(
+        VSIFOpenL(osSortedTmpFilename.c_str(), "wb+"));
+    if (!fpSorted)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot create %s",
+                 osSortedTmpFilename.c_str());
+        return false;
+    }
 
-                if ((m_nFeatureCount % PROGRESS_FC_INTERVAL) == 0 ||
-                    m_nFeatureCount == m_nTmpFeatureCount / 2)
-                {
-                    CPLDebugProgress(
-                        "PARQUET",
-                        "CopyTmpGpkgLayerToFinalFile(): %.02f%% progress",
-                        100.0 * double(m_nFeatureCount) /
-                            double(m_nTmpFeatureCount));
-                }
+    std::vector<std::pair<vsi_l_offset, size_t>> anSortedRuns;
+    for (const auto &oRun : m_anSortRuns)
+    {
+        m_fpSortTmp->Seek(oRun.first, SEEK_SET);
+        m_aoSortItems.resize(oRun.second);
+        for (auto &oItem : m_aoSortItems)
+        {
+            if (!ReadSortItem(m_fpSortTmp.get(), oItem.dfX, oItem.dfY,
+                              oItem.bHasGeom, oItem.nKey, oItem.abyFeature))
+                return false;
+        }
+        ComputeSortKeys(m_aoSortItems);
+        anSortedRuns.emplace_back(fpSorted->Tell(), oRun.second);
+        for (const auto &oItem : m_aoSortItems)
+        {
+            if (!WriteSortItem(fpSorted.get(), oItem.dfX, oItem.dfY,
+                               oItem.bHasGeom, oItem.nKey, oItem.abyFeature))
+            {
+                CPLError(CE_Failure, CPLE_FileIO, "Cannot write into %s",
+                         osSortedTmpFilename.c_str());
+                return false;
             }
         }
-        else
+    }
+    m_aoSortItems.clear();
+    m_anSortRuns.clear();
+    m_fpSortTmp.reset();
+    VSIUnlink(m_osSortTmpFilename.c_str());
+    fpSorted.reset();
+
+    // Intermediate merge passes, alternating between the two temporary files
+    constexpr size_t MAX_RUNS_PER_MERGE = 64;
+    std::string osRunsFilename(osSortedTmpFilename);
+    std::string osMergedFilename(m_osSortTmpFilename);
+    SortedTmpFileRemover oRemover2{m_osSortTmpFilename};
+    while (anSortedRuns.size() > MAX_RUNS_PER_MERGE)
+    {
+        auto fpMerged = VSIVirtualHandleUniquePtr(
+            VSIFOpenL(osMergedFilename.c_str(), "wb+"));
+        if (!fpMerged)
         {
-            // Non-leaf node: it references child nodes.
-
-            // nCellCount shouldn't be over 51 normally, but even 65535
-            // would be fine...
-            assert(nCellCount <= 65535);
-            for (int i = 0; i < nCellCount; ++i)
+            CPLError(CE_Failure, CPLE_FileIO, "Cannot create %s",
+                     osMergedFilename.c_str());
+            return false;
+        }
+        const auto WriteMergedItem = [&](const SortItem &oItem)
+        {
+            if (!WriteSortItem(fpMerged.get(), oItem.dfX, oItem.dfY,
+                               oItem.bHasGeom, oItem.nKey, oItem.abyFeature))
             {
-                int64_t nNode;
-                memcpy(&nNode, pabyNodeData + nOffset, sizeof(int64_t));
-                CPL_MSBPTR64(&nNode);
-                aNodeNoDepthPair.emplace_back(
-                    std::make_pair(nNode, nCurDepth + 1));
-                nOffset += SIZEOF_CELL;
+                CPLError(CE_Failure, CPLE_FileIO, "Cannot write into %s",
+                         osMergedFilename.c_str());
+                return false;
             }
+            return true;
+        };
+
+        std::vector<std::pair<vsi_l_offset, size_t>> anMergedRuns;
+        for (size_t iFirst = 0; iFirst < anSortedRuns.size();
+             iFirst += MAX_RUNS_PER_MERGE)
+        {
+            const size_t nRuns =
+                std::min(MAX_RUNS_PER_MERGE, anSortedRuns.size() - iFirst);
+            size_t nFeatures = 0;
+            for (size_t i = iFirst; i < iFirst + nRuns; ++i)
+                nFeatures += anSortedRuns[i].second;
+            anMergedRuns.emplace_back(fpMerged->Tell(), nFeatures);
+            if (!MergeSortedRuns(osRunsFilename, anSortedRuns.data() + iFirst,
+                                 nRuns, WriteMergedItem))
+                return false;
         }
+        CPLDebug("PARQUET", "WriteSortedFeatures(): merged %d runs into %d",
+                 static_cast<int>(anSortedRuns.size()),
+                 static_cast<int>(anMergedRuns.size()));
+        fpMerged.reset();
+        VSIUnlink(osRunsFilename.c_str());
+        std::swap(osRunsFilename, osMergedFilename);
+        anSortedRuns = std::move(anMergedRuns);
     }
 
-    CPLDebug("PARQUET",
-             "CopyTmpGpkgLayerToFinalFile(): 100%%, successfully finished");
+    // Final merge into the Parquet file
+    CPLDebug("PARQUET", "WriteSortedFeatures(): merging %d runs",
+             static_cast<int>(anSortedRuns.size()));
+    const auto WriteFinalItem = [this, &oFeat](const SortItem &oItem)
+    { return WriteSerializedFeature(oFeat, oItem); };
+    if (!MergeSortedRuns(osRunsFilename, anSortedRuns.data(),
+                         anSortedRuns.size(), WriteFinalItem))
+        return false;
+
+    CPLDebug("PARQUET", "WriteSortedFeatures(): 100%%, successfully finished");
     return true;
 }
 
@@ -323,29 +581,18 @@ bool OGRParquetWriterLayer::SetOptions(CSLConstList papszOptions,
 
     if (CPLTestBool(CSLFetchNameValueDef(papszOptions, "SORT_BY_BBOX", "NO")))
     {
-        const std::string osTmpGPKG(std::string(m_poDataset->GetDescription()) +
-                                    ".tmp.gpkg");
-        auto poGPKGDrv = GetGDALDriverManager()->GetDriverByName("GPKG");
-        if (!poGPKGDrv)
+        m_bSortByBBOX = true;
+        const char *pszMaxMemory = CPLGetConfigOption(
+            "OGR_PARQUET_SORT_BY_BBOX_MAX_MEMORY", "10%");
+        GIntBig nMaxMemory = 0;
+        bool bUnitSpecified = false;
+        if (CPLParseMemorySize(pszMaxMemory, &nMaxMemory, &bUnitSpecified) !=
+            CE_None)
         {
-            CPLError(
-                CE_Failure, CPLE_AppDefined,
-                "Driver GPKG required for SORT_BY_BBOX layer creation option");
             return false;
         }
-        m_poTmpGPKG.reset(poGPKGDrv->Create(osTmpGPKG.c_str(), 0, 0, 0,
-                                            GDT_Unknown, nullptr));
-        if (!m_poTmpGPKG)
-            return false;
-        m_poTmpGPKG->MarkSuppressOnClose();
-        m_poTmpGPKGLayer = m_poTmpGPKG->CreateLayer("tmp");
-        if (!m_poTmpGPKGLayer)
-            return false;
-        // Serialized feature
-        m_poTmpGPKGLayer->CreateField(
-            std::make_unique<OGRFieldDefn>("serialized_feature", OFTBinary)
-                .get());
-        CPL_IGNORE_RET_VAL(m_poTmpGPKGLayer->StartTransaction());
+        m_nSortMaxMemory = static_cast<size_t>(std::min<GIntBig>(
+            nMaxMemory, std::numeric_limits<size_t>::max() / 2));
     }
 
     const char *pszGeomEncoding =
@@ -942,11 +1189,12 @@ OGRErr OGRParquetWriterLayer::ICreateFeature(OGRFeature *poFeature)
 {
     // If not using SORT_BY_BBOX=YES layer creation option, we can directly
     // write features to the final Parquet file
-    if (!m_poTmpGPKGLayer)
+    if (!m_bSortByBBOX)
         return OGRArrowWriterLayer::ICreateFeature(poFeature);
 
-    // SORT_BY_BBOX=YES case: we write for now a serialized version of poFeature
-    // in a temporary GeoPackage file.
+    // SORT_BY_BBOX=YES case: we buffer for now a serialized version of
+    // poFeature, and spill it to a temporary file when exceeding the allowed
+    // memory.
 
     GIntBig nFID = poFeature->GetFID();
     if (!m_osFIDColumn.empty() && nFID == OGRNullFID)
@@ -956,44 +1204,31 @@ OGRErr OGRParquetWriterLayer::ICreateFeature(OGRFeature *poFeature)
     }
     ++m_nTmpFeatureCount;
 
-    std::vector<GByte> abyBuffer;
+    SortItem oItem;
     // Serialize the source feature as a single array of bytes to preserve it
     // fully
-    if (!poFeature->SerializeToBinary(abyBuffer))
-    {
-        return OGRERR_FAILURE;
-    }
-
-    // SQLite3 limitation: a row must fit in slightly less than 1 GB.
-    constexpr int SOME_MARGIN = 128;
-    if (abyBuffer.size() > 1024 * 1024 * 1024 - SOME_MARGIN)
+    if (!poFeature->SerializeToBinary(oItem.abyFeature))
     {
-        CPLError(CE_Failure, CPLE_NotSupported,
-                 "Features larger than 1 GB are not supported");
         return OGRERR_FAILURE;
     }
 
-    OGRFeature oFeat(m_poTmpGPKGLayer->GetLayerDefn());
-    oFeat.SetFID(nFID);
-    oFeat.SetField(0, static_cast<int>(abyBuffer.size()), abyBuffer.data());
     const auto poSrcGeom = poFeature->GetGeometryRef();
     if (poSrcGeom && !poSrcGeom->IsEmpty())
     {
-        // For the purpose of building an RTree, just use the bounding box of
-        // the geometry as the geometry.
         OGREnvelope sEnvelope;
         poSrcGeom->getEnvelope(&sEnvelope);
-        auto poPoly = std::make_unique<OGRPolygon>();
-        auto poLR = std::make_unique<OGRLinearRing>();
-        poLR->addPoint(sEnvelope.MinX, sEnvelope.MinY);
-        poLR->addPoint(sEnvelope.MinX, sEnvelope.MaxY);
-        poLR->addPoint(sEnvelope.MaxX, sEnvelope.MaxY);
-        poLR->addPoint(sEnvelope.MaxX, sEnvelope.MinY);
-        poLR->addPoint(sEnvelope.MinX, sEnvelope.MinY);
-        poPoly->addRingDirectly(poLR.release());
-        oFeat.SetGeometryDirectly(poPoly.release());
+        oItem.bHasGeom = true;
+        oItem.dfX = (sEnvelope.MinX + sEnvelope.MaxX) / 2;
+        oItem.dfY = (sEnvelope.MinY + sEnvelope.MaxY) / 2;
+        m_oSortExtent.Merge(oItem.dfX, oItem.dfY);
     }
-    return m_poTmpGPKGLayer->CreateFeature(&oFeat);
+
+    m_nSortItemsMemory += sizeof(SortItem) + oItem.abyFeature.size();
+    m_aoSortItems.push_back(std::move(oItem));
+    if (m_nSortItemsMemory > m_nSortMaxMemory && !SpillSortItems())
+        return OGRERR_FAILURE;
+
+    return OGRERR_NONE;
 }
 
 /************************************************************************/
@@ -1092,7 +1327,7 @@ OGRParquetWriterLayer::WriteArrowBatch(const struct ArrowSchema *schema,
                                        struct ArrowArray *array,
                                        CSLConstList papszOptions)
 {
-    if (m_poTmpGPKGLayer)
+    if (m_bSortByBBOX)
     {
         // When using SORT_BY_BBOX=YES option, we can't directly write the
         // input array, because we need to sort features. Hence we fallback
@@ -1139,7 +1374,7 @@ inline int OGRParquetWriterLayer::TestCapability(const char *pszCap) const
         return false;
 #endif
 
-    if (m_poTmpGPKGLayer && EQUAL(pszCap, OLCFastWriteArrowBatch))
+    if (m_bSortByBBOX && EQUAL(pszCap, OLCFastWriteArrowBatch))
     {
         // When using SORT_BY_BBOX=YES option, we can't directly write the
         // input array, because we need to sort features. So this is not
@@ -1158,7 +1393,7 @@ inline int OGRParquetWriterLayer::TestCapability(const char *pszCap) const
 bool OGRParquetWriterLayer::CreateFieldFromArrowSchema(
     const struct ArrowSchema *schema, CSLConstList papszOptions)
 {
-    if (m_poTmpGPKGLayer)
+    if (m_bSortByBBOX)
     {
         // When using SORT_BY_BBOX=YES option, we can't directly write the
         // input array, because we need to sort features. But this process
@@ -1181,7 +1416,7 @@ bool OGRParquetWriterLayer::IsArrowSchemaSupported(
     const struct ArrowSchema *schema, CSLConstList papszOptions,
     std::string &osErrorMsg) const
 {
-    if (m_poTmpGPKGLayer)
+    if (m_bSortByBBOX)
     {
         // When using SORT_BY_BBOX=YES option, we can't directly write the
         // input array, because we need to sort features. But this process
@@ -269,6 +269,27 @@ int swqlex(YYSTYPE *ppNode, swq_parse_context *context)
             nReturn = SWQT_ON;
         else if (EQUAL(osToken, "ORDER"))
             nReturn = SWQT_ORDER;
+        else if (EQUAL(osToken, "GROUP"))
+        {
+            // Only consider GROUP as a keyword when followed by BY, so that
+            // it can still be used as an unquoted column name.
+            const char *pszAfter = pszNext;
+            while (*pszAfter == ' ' || *pszAfter == '\t' ||
+                   *pszAfter == '\r' || *pszAfter == '\n')
+                ++pszAfter;
+            if (STARTS_WITH_CI(pszAfter, "BY") &&
+                !isalnum(static_cast<unsigned char>(pszAfter[2])) &&
+                pszAfter[2] != '_' &&
+                static_cast<unsigned char>(pszAfter[2]) <= 127)
+            {
+                nReturn = SWQT_GROUP;
+            }
+            else
+            {
+                *ppNode = new swq_expr_node(osToken);
+                nReturn = SWQT_IDENTIFIER;
+            }
+        }
         else if (EQUAL(osToken, "BY"))
             nReturn = SWQT_BY;
         else if (EQUAL(osToken, "FROM"))
@@ -428,10 +449,16 @@ const char *swq_select_summarize(swq_select *select_info, int dest_column,
         return nullptr;
     }
 
-    /* -------------------------------------------------------------------- */
-    /*      Process various options.                                        */
-    /* -------------------------------------------------------------------- */
+    return swq_summary_accumulate(def, summary, pszValue, pdfValue);
+}
 
+/************************************************************************/
+/*                       swq_summary_accumulate()                       */
+/************************************************************************/
+
+const char *swq_summary_accumulate(const swq_col_def *def, swq_summary &summary,
+                                   const char *pszValue, const double *pdfValue)
+{
     switch (def->col_func)
     {
         case SWQCF_MIN:
@@ -946,7 +973,8 @@ CPLErr swq_expr_compile2(const char *where_clause, swq_field_list *field_list,
 static const char *const apszSQLReservedKeywords[] = {
     "OR",    "AND",      "NOT",    "LIKE",   "IS",   "NULL", "IN",    "BETWEEN",
     "CAST",  "DISTINCT", "ESCAPE", "SELECT", "LEFT", "JOIN", "WHERE", "ON",
-    "ORDER", "BY",       "FROM",   "AS",     "ASC",  "DESC", "UNION", "ALL"};
+    "ORDER", "BY",       "FROM",   "AS",     "ASC",  "DESC", "UNION", "ALL",
+    "GROUP"};
 
 int swq_is_reserved_keyword(const char *pszStr)
 {
@@ -84,6 +84,14 @@ swq_select::~swq_select()
 
     CPLFree(order_defs);
 
+    for (int i = 0; i < group_by_count; i++)
+    {
+        CPLFree(group_by_defs[i].table_name);
+        CPLFree(group_by_defs[i].field_name);
+    }
+
+    CPLFree(group_by_defs);
+
     for (int i = 0; i < join_count; i++)
     {
         delete join_defs[i].poExpr;
@@ -288,6 +296,18 @@ char *swq_select::Unparse()
         CPLFree(pszTmp);
     }
 
+    if (group_by_count > 0)
+    {
+        osSelect += " GROUP BY ";
+        for (int i = 0; i < group_by_count; i++)
+        {
+            if (i > 0)
+                osSelect += ", ";
+            osSelect += swq_expr_node::QuoteIfNecessary(
+                group_by_defs[i].field_name, '"');
+        }
+    }
+
     if (order_specs > 0)
     {
         osSelect += " ORDER BY ";
@@ -716,6 +736,24 @@ void swq_select::PushOrderBy(const char *pszTableName, const char *pszFieldName,
     order_defs[order_specs - 1].ascending_flag = bAscending;
 }
 
+/************************************************************************/
+/*                            PushGroupBy()                             */
+/************************************************************************/
+
+void swq_select::PushGroupBy(const char *pszTableName, const char *pszFieldName)
+
+{
+    group_by_count++;
+    group_by_defs = static_cast<swq_group_by_def *>(
+        CPLRealloc(group_by_defs, sizeof(swq_group_by_def) * group_by_count));
+
+    group_by_defs[group_by_count - 1].table_name =
+        CPLStrdup(pszTableName ? pszTableName : "");
+    group_by_defs[group_by_count - 1].field_name = CPLStrdup(pszFieldName);
+    group_by_defs[group_by_count - 1].table_index = -1;
+    group_by_defs[group_by_count - 1].field_index = -1;
+}
+
 /************************************************************************/
 /*                              PushJoin()                              */
 /************************************************************************/
@@ -1040,6 +1078,13 @@ CPLErr swq_select::parse(swq_field_list *field_list,
     /*      indications.                                                    */
     /* -------------------------------------------------------------------- */
 
+    if (group_by_count > 0)
+    {
+        eError = CheckGroupBy(field_list);
+        if (eError != CE_None)
+            return eError;
+    }
+
     int bAllowDistinctOnMultipleFields =
         (poParseOptions && poParseOptions->bAllowDistinctOnMultipleFields);
     if (query_mode == SWQM_DISTINCT_LIST && result_columns() > 1 &&
@@ -1050,7 +1095,7 @@ CPLErr swq_select::parse(swq_field_list *field_list,
         return CE_Failure;
     }
 
-    for (int i = 0; i < result_columns(); i++)
+    for (int i = 0; i < result_columns() && query_mode != SWQM_GROUP_BY; i++)
     {
         swq_col_def *def = &column_defs[i];
         int this_indicator = -1;
@@ -1159,6 +1204,28 @@ CPLErr swq_select::parse(swq_field_list *field_list,
                      def->field_name);
             return CE_Failure;
         }
+
+        if (query_mode == SWQM_GROUP_BY)
+        {
+            bool bFound = false;
+            for (int j = 0; j < group_by_count; j++)
+            {
+                if (group_by_defs[j].table_index == def->table_index &&
+                    group_by_defs[j].field_index == def->field_index)
+                {
+                    bFound = true;
+                    break;
+                }
+            }
+            if (!bFound)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Field '%s' used in ORDER BY clause must appear in "
+                         "the GROUP BY clause",
+                         def->field_name);
+                return CE_Failure;
+            }
+        }
     }
 
     /* -------------------------------------------------------------------- */
@@ -1179,6 +1246,114 @@ CPLErr swq_select::parse(swq_field_list *field_list,
     return CE_None;
 }
 
+/************************************************************************/
+/*                            CheckGroupBy()                            */
+/*                                                                      */
+/*      Validate the GROUP BY clause and the field list of a query      */
+/*      using it, and switch to SWQM_GROUP_BY mode.                     */
+/************************************************************************/
+
+CPLErr swq_select::CheckGroupBy(swq_field_list *field_list)
+{
+    if (query_mode == SWQM_DISTINCT_LIST)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "SELECT DISTINCT not supported with GROUP BY.");
+        return CE_Failure;
+    }
+
+    for (int i = 0; i < group_by_count; i++)
+    {
+        swq_group_by_def *def = group_by_defs + i;
+
+        swq_field_type field_type;
+        def->field_index =
+            swq_identify_field(def->table_name, def->field_name, field_list,
+                               &field_type, &(def->table_index));
+        if (def->field_index == -1)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Unrecognized field name %s in GROUP BY.",
+                     def->table_name[0]
+                         ? CPLSPrintf("%s.%s", def->table_name, def->field_name)
+                         : def->field_name);
+            return CE_Failure;
+        }
+
+        if (def->table_index != 0)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Cannot use field '%s' of a secondary table in "
+                     "a GROUP BY clause",
+                     def->field_name);
+            return CE_Failure;
+        }
+
+        if (field_type == SWQ_GEOMETRY)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Cannot use geometry field '%s' in a GROUP BY clause",
+                     def->field_name);
+            return CE_Failure;
+        }
+    }
+
+    for (const auto &col_def : column_defs)
+    {
+        if (col_def.col_func == SWQCF_NONE)
+        {
+            bool bFound = false;
+            if ((col_def.expr == nullptr ||
+                 col_def.expr->eNodeType == SNT_COLUMN) &&
+                col_def.target_type != SWQ_GEOMETRY)
+            {
+                for (int i = 0; i < group_by_count; i++)
+                {
+                    if (group_by_defs[i].table_index == col_def.table_index &&
+                        group_by_defs[i].field_index == col_def.field_index)
+                    {
+                        bFound = true;
+                        break;
+                    }
+                }
+            }
+            if (!bFound)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Column '%s' must appear in the GROUP BY clause or "
+                         "be used in an aggregate function.",
+                         col_def.field_alias ? col_def.field_alias
+                                             : col_def.field_name);
+                return CE_Failure;
+            }
+        }
+        else if (col_def.col_func == SWQCF_CUSTOM)
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "Custom functions not supported with GROUP BY.");
+            return CE_Failure;
+        }
+        else if (col_def.table_index > 0)
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "Cannot use field '%s' of a secondary table in an "
+                     "aggregate function with GROUP BY.",
+                     col_def.field_name);
+            return CE_Failure;
+        }
+        else if (col_def.field_type == SWQ_GEOMETRY &&
+                 col_def.col_func == SWQCF_COUNT && col_def.distinct_flag)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "SELECT COUNT DISTINCT on a geometry not supported.");
+            return CE_Failure;
+        }
+    }
+
+    query_mode = SWQM_GROUP_BY;
+    return CE_None;
+}
+
 bool swq_select::IsFieldExcluded(int src_index, const char *pszTableName,
                                  const char *pszFieldName)
 {
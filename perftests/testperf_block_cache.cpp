@@ -0,0 +1,131 @@
+/******************************************************************************
+ * Project:  GDAL Core
+ * Purpose:  Test performance of the global raster block cache when accessed
+ *           by several threads.
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "cpl_conv.h"
+#include "cpl_string.h"
+#include "gdal_priv.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Run with GDAL_BLOCK_CACHE_SHARDS=1 in the environment to compare with a
+// single LRU list.
+
+constexpr int SIZE = 4096;
+constexpr int BLOCK_SIZE = 128;
+constexpr int READS_PER_THREAD = 200000;
+constexpr const char *FILENAME = "/vsimem/testperf_block_cache.tif";
+
+template <class T> static auto ElapsedMs(const T &start, const T &end)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(end - start)
+        .count();
+}
+
+static void CreateDataset()
+{
+    CPLStringList aosOptions;
+    aosOptions.SetNameValue("TILED", "YES");
+    aosOptions.SetNameValue("BLOCKXSIZE", CPLSPrintf("%d", BLOCK_SIZE));
+    aosOptions.SetNameValue("BLOCKYSIZE", CPLSPrintf("%d", BLOCK_SIZE));
+    auto poDS = std::unique_ptr<GDALDataset>(
+        GDALDriver::FromHandle(GDALGetDriverByName("GTiff"))
+            ->Create(FILENAME, SIZE, SIZE, 1, GDT_Byte, aosOptions.List()));
+    std::vector<GByte> abyLine(SIZE);
+    for (int iY = 0; iY < SIZE; ++iY)
+    {
+        for (int iX = 0; iX < SIZE; ++iX)
+            abyLine[iX] = static_cast<GByte>(iX + iY);
+        CPL_IGNORE_RET_VAL(poDS->GetRasterBand(1)->RasterIO(
+            GF_Write, 0, iY, SIZE, 1, abyLine.data(), SIZE, 1, GDT_Byte, 0, 0,
+            nullptr));
+    }
+}
+
+// Each thread uses its own dataset handle, and reads random blocks.
+static void ReadBlocks(int iThread)
+{
+    auto poDS = std::unique_ptr<GDALDataset>(
+        GDALDataset::Open(FILENAME, GDAL_OF_RASTER));
+    auto poBand = poDS->GetRasterBand(1);
+    constexpr int nBlocksPerDim = SIZE / BLOCK_SIZE;
+    std::mt19937 gen{static_cast<unsigned>(iThread)};
+    std::uniform_int_distribution<int> dist{0, nBlocksPerDim - 1};
+    for (int i = 0; i < READS_PER_THREAD; ++i)
+    {
+        const int nXBlock = dist(gen);
+        const int nYBlock = dist(gen);
+        GDALRasterBlock *poBlock =
+            poBand->GetLockedBlockRef(nXBlock, nYBlock);
+        if (poBlock == nullptr)
+        {
+            fprintf(stderr, "GetLockedBlockRef() failed\n");
+            exit(1);
+        }
+        if (static_cast<GByte *>(poBlock->GetDataRef())[0] !=
+            static_cast<GByte>((nXBlock + nYBlock) * BLOCK_SIZE))
+        {
+            fprintf(stderr, "Wrong block content\n");
+            exit(1);
+        }
+        poBlock->DropLock();
+    }
+}
+
+static void bench(const char *pszTitle, GIntBig nCacheMax)
+{
+    GDALSetCacheMax64(nCacheMax);
+    printf("%s (GDAL_CACHEMAX=" CPL_FRMT_GIB " bytes):\n", pszTitle,
+           nCacheMax);
+
+    const int nMaxThreads = std::max(1, CPLGetNumCPUs());
+    for (int nThreads = 1;; nThreads = std::min(nThreads * 2, nMaxThreads))
+    {
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> aoThreads;
+        for (int i = 0; i < nThreads; ++i)
+            aoThreads.emplace_back(ReadBlocks, i);
+        for (auto &oThread : aoThreads)
+            oThread.join();
+        const auto end = std::chrono::steady_clock::now();
+        const auto nMs = std::max<decltype(ElapsedMs(start, end))>(
+            1, ElapsedMs(start, end));
+        printf("-> %d thread(s): elapsed=%d ms, %.0f blocks/s\n", nThreads,
+               static_cast<int>(nMs),
+               1000.0 * READS_PER_THREAD * nThreads / static_cast<double>(nMs));
+        if (nThreads == nMaxThreads)
+            break;
+    }
+}
+
+int main(int /* argc */, char * /* argv */[])
+{
+    GDALAllRegister();
+
+    CreateDataset();
+
+    const GIntBig nDatasetSize = static_cast<GIntBig>(SIZE) * SIZE;
+
+    // All blocks of all threads fit in the cache: mostly stresses Touch().
+    bench("Cache hits", nDatasetSize * 4 * CPLGetNumCPUs());
+
+    // Only a fraction of the blocks fit: mostly stresses evictions.
+    bench("Cache misses", nDatasetSize / 4);
+
+    VSIUnlink(FILENAME);
+
+    GDALDestroyDriverManager();
+
+    return 0;
+}
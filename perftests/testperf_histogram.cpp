@@ -0,0 +1,123 @@
+/******************************************************************************
+ * Project:  GDAL Core
+ * Purpose:  Test performance of GDALRasterBand::GetHistogram()
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "cpl_conv.h"
+#include "gdal_priv.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+constexpr int SIZE_X = 4000;
+constexpr int SIZE_Y = 4000;
+constexpr int N_BUCKETS = 256;
+
+static void CheckEqual(const std::vector<GUIntBig> &anOptim,
+                       const std::vector<GUIntBig> &anRef)
+{
+    if (anOptim != anRef)
+    {
+        fprintf(stderr, "Optim histogram != ref histogram\n");
+        exit(1);
+    }
+}
+
+template <class T>
+static std::vector<GUIntBig> ReferenceHistogram(const std::vector<T> &values,
+                                                double dfMin, double dfMax,
+                                                double dfNoData)
+{
+    std::vector<GUIntBig> anHistogram(N_BUCKETS);
+    const double dfScale = N_BUCKETS / (dfMax - dfMin);
+    for (const T v : values)
+    {
+        const double dfValue = static_cast<double>(v);
+        if (std::isnan(dfValue) || dfValue == dfNoData)
+            continue;
+        const double dfIndex = floor((dfValue - dfMin) * dfScale);
+        if (dfIndex >= 0 && dfIndex < N_BUCKETS)
+            ++anHistogram[static_cast<int>(dfIndex)];
+    }
+    return anHistogram;
+}
+
+template <class T>
+static void bench(GDALDataType eDT, double dfMin, double dfMax,
+                  double dfNoData)
+{
+    std::vector<T> values(static_cast<size_t>(SIZE_X) * SIZE_Y);
+    std::mt19937 gen{0};
+    std::normal_distribution<> dist{(dfMin + dfMax) / 2,
+                                    (dfMax - dfMin) / 6};
+    for (auto &v : values)
+    {
+        double dfValue = dist(gen);
+        if constexpr (std::is_integral_v<T>)
+        {
+            dfValue = std::clamp(
+                dfValue, static_cast<double>(std::numeric_limits<T>::lowest()),
+                static_cast<double>(std::numeric_limits<T>::max()));
+        }
+        v = static_cast<T>(dfValue);
+    }
+
+    auto poDS = std::unique_ptr<GDALDataset>(
+        GDALDriver::FromHandle(GDALGetDriverByName("MEM"))
+            ->Create("", SIZE_X, SIZE_Y, 1, eDT, nullptr));
+    auto poBand = poDS->GetRasterBand(1);
+    poBand->SetNoDataValue(dfNoData);
+    CPL_IGNORE_RET_VAL(poBand->RasterIO(GF_Write, 0, 0, SIZE_X, SIZE_Y,
+                                        values.data(), SIZE_X, SIZE_Y, eDT, 0,
+                                        0, nullptr));
+
+    printf("Data type %s:\n", GDALGetDataTypeName(eDT));
+
+    std::vector<GUIntBig> anRef;
+    {
+        const auto start = std::chrono::steady_clock::now();
+        anRef = ReferenceHistogram(values, dfMin, dfMax, dfNoData);
+        const auto end = std::chrono::steady_clock::now();
+        printf("-> reference: elapsed=%d\n",
+               static_cast<int>((end - start).count()));
+    }
+
+    for (const char *pszThreads : {"1", "ALL_CPUS"})
+    {
+        CPLConfigOptionSetter oSetter("GDAL_NUM_THREADS", pszThreads, false);
+        std::vector<GUIntBig> anOptim(N_BUCKETS);
+        const auto start = std::chrono::steady_clock::now();
+        CPL_IGNORE_RET_VAL(poBand->GetHistogram(dfMin, dfMax, N_BUCKETS,
+                                                anOptim.data(), FALSE, FALSE,
+                                                nullptr, nullptr));
+        const auto end = std::chrono::steady_clock::now();
+        printf("-> GDAL_NUM_THREADS=%s: elapsed=%d\n", pszThreads,
+               static_cast<int>((end - start).count()));
+        CheckEqual(anOptim, anRef);
+    }
+}
+
+int main(int /* argc */, char * /* argv */[])
+{
+    GDALAllRegister();
+
+    bench<GByte>(GDT_Byte, -0.5, 255.5, 0);
+    bench<GUInt16>(GDT_UInt16, 0, 4096, 0);
+    bench<GInt16>(GDT_Int16, -2048, 2048, -2048);
+    bench<float>(GDT_Float32, -1000, 1000, -1000);
+    bench<double>(GDT_Float64, -1000, 1000, -1000);
+
+    GDALDestroyDriverManager();
+
+    return 0;
+}
@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Project:  GDAL Algorithms
+ * Purpose:  Test performance of GDALComputeProximity()
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "cpl_conv.h"
+#include "gdal_alg.h"
+#include "gdal_priv.h"
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+constexpr int SIZE_X = 4000;
+constexpr int SIZE_Y = 4000;
+
+template <class T> static auto ElapsedMs(const T &start, const T &end)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(end - start)
+        .count();
+}
+
+static std::vector<float> ComputeProximity(GDALRasterBand *poSrcBand,
+                                           const char *pszAlgorithm)
+{
+    auto poDstDS = std::unique_ptr<GDALDataset>(
+        GDALDriver::FromHandle(GDALGetDriverByName("MEM"))
+            ->Create("", SIZE_X, SIZE_Y, 1, GDT_Float32, nullptr));
+    auto poDstBand = poDstDS->GetRasterBand(1);
+
+    CPLStringList aosOptions;
+    aosOptions.SetNameValue("ALGORITHM", pszAlgorithm);
+    if (GDALComputeProximity(GDALRasterBand::ToHandle(poSrcBand),
+                             GDALRasterBand::ToHandle(poDstBand),
+                             aosOptions.List(), nullptr, nullptr) != CE_None)
+    {
+        fprintf(stderr, "GDALComputeProximity() failed\n");
+        exit(1);
+    }
+
+    std::vector<float> afValues(static_cast<size_t>(SIZE_X) * SIZE_Y);
+    CPL_IGNORE_RET_VAL(poDstBand->RasterIO(GF_Read, 0, 0, SIZE_X, SIZE_Y,
+                                           afValues.data(), SIZE_X, SIZE_Y,
+                                           GDT_Float32, 0, 0, nullptr));
+    return afValues;
+}
+
+static void bench(double dfTargetDensity)
+{
+    std::vector<GByte> values(static_cast<size_t>(SIZE_X) * SIZE_Y);
+    std::mt19937 gen{0};
+    std::uniform_real_distribution<> dist{0, 1};
+    for (auto &v : values)
+        v = dist(gen) < dfTargetDensity ? 1 : 0;
+
+    auto poDS = std::unique_ptr<GDALDataset>(
+        GDALDriver::FromHandle(GDALGetDriverByName("MEM"))
+            ->Create("", SIZE_X, SIZE_Y, 1, GDT_Byte, nullptr));
+    auto poBand = poDS->GetRasterBand(1);
+    CPL_IGNORE_RET_VAL(poBand->RasterIO(GF_Write, 0, 0, SIZE_X, SIZE_Y,
+                                        values.data(), SIZE_X, SIZE_Y,
+                                        GDT_Byte, 0, 0, nullptr));
+
+    printf("Target density %g:\n", dfTargetDensity);
+
+    std::vector<float> afSweep;
+    {
+        const auto start = std::chrono::steady_clock::now();
+        afSweep = ComputeProximity(poBand, "SWEEP");
+        const auto end = std::chrono::steady_clock::now();
+        printf("-> ALGORITHM=SWEEP: elapsed=%d ms\n",
+               static_cast<int>(ElapsedMs(start, end)));
+    }
+
+    std::vector<float> afRef;
+    for (const char *pszThreads : {"1", "ALL_CPUS"})
+    {
+        CPLConfigOptionSetter oSetter("GDAL_NUM_THREADS", pszThreads, false);
+        const auto start = std::chrono::steady_clock::now();
+        auto afEDT = ComputeProximity(poBand, "EDT");
+        const auto end = std::chrono::steady_clock::now();
+        printf("-> ALGORITHM=EDT, GDAL_NUM_THREADS=%s: elapsed=%d ms\n",
+               pszThreads, static_cast<int>(ElapsedMs(start, end)));
+
+        // The sweep algorithm is not exact: it may only over-estimate
+        // distances.
+        size_t nDiff = 0;
+        for (size_t i = 0; i < afEDT.size(); ++i)
+        {
+            if (afEDT[i] > afSweep[i])
+            {
+                fprintf(stderr, "EDT distance > SWEEP distance\n");
+                exit(1);
+            }
+            if (afEDT[i] != afSweep[i])
+                ++nDiff;
+        }
+        printf("   %d pixels closer than with ALGORITHM=SWEEP\n",
+               static_cast<int>(nDiff));
+
+        if (afRef.empty())
+        {
+            afRef = std::move(afEDT);
+        }
+        else if (afEDT != afRef)
+        {
+            fprintf(stderr, "Multi-threaded EDT != single-threaded EDT\n");
+            exit(1);
+        }
+    }
+}
+
+int main(int /* argc */, char * /* argv */[])
+{
+    GDALAllRegister();
+
+    bench(1e-2);
+    bench(1e-4);
+    bench(1e-6);
+
+    GDALDestroyDriverManager();
+
+    return 0;
+}
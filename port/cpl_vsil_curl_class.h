@@ -26,6 +26,8 @@
 #include "cpl_multiproc.h"
 
 #include "cpl_curl_priv.h"
+#include "cpl_error_internal.h"
+#include "cpl_worker_thread_pool.h"
 
 #include <algorithm>
 #include <atomic>
@@ -658,6 +660,8 @@ class IVSIS3LikeFSHandlerWithMultipartUpload /* non final */
 {
     CPL_DISALLOW_COPY_ASSIGN(IVSIS3LikeFSHandlerWithMultipartUpload)
 
+    friend class VSIMultipartWriteHandle;
+
   protected:
     IVSIS3LikeFSHandlerWithMultipartUpload() = default;
 
@@ -839,9 +843,27 @@ class VSIMultipartWriteHandle final : public VSIVirtualHandle
     std::vector<std::string> m_aosEtags{};
     bool m_bError = false;
 
+    // Asynchronous upload of parts, when m_nMaxBuffers > 1
+    int m_nUploadThreads = 1;
+    size_t m_nMaxBuffers = 1;
+    size_t m_nAllocatedBuffers = 1;
+    std::unique_ptr<CPLWorkerThreadPool> m_poThreadPool{};
+    std::mutex m_oMutex{};
+    std::condition_variable m_oCV{};
+    // Below members protected by m_oMutex
+    std::vector<GByte *> m_apabyFreeBuffers{};
+    int m_nPendingParts = 0;
+    bool m_bAsyncError = false;
+    // Errors emitted by worker threads, replayed in the calling thread
+    CPLErrorAccumulator m_oErrorAccumulator{};
+    bool m_bAsyncErrorsReplayed = false;
+
     WriteFuncStruct m_sWriteFuncHeaderData{};
 
     bool UploadPart();
+    bool UploadPartAsync();
+    void UploadPartJob(GByte *pabyBuffer, size_t nBufferSize, int nPartNumber);
+    bool WaitForPendingParts();
     bool DoSinglePartPUT();
 
     void InvalidateParentDirectory();
@@ -892,6 +892,53 @@ VSIMultipartWriteHandle::VSIMultipartWriteHandle(
                  "Cannot allocate working buffer for %s",
                  m_poFS->GetFSPrefix().c_str());
     }
+
+    // Number of parts that may be uploaded concurrently, while the caller
+    // keeps on filling another buffer.
+    if (poFS->SupportsParallelMultipartUpload())
+    {
+        const char *pszNumThreads = VSIGetPathSpecificOption(
+            pszFilename,
+            std::string("VSI")
+                .append(poFS->GetDebugKey())
+                .append("_UPLOAD_NUM_THREADS")
+                .c_str(),
+            "1");
+        m_nUploadThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                               ? CPLGetNumCPUs()
+                               : std::max(1, atoi(pszNumThreads));
+        m_nUploadThreads = std::min(m_nUploadThreads, 128);
+        if (m_nUploadThreads > 1)
+        {
+            m_nMaxBuffers = static_cast<size_t>(m_nUploadThreads) + 1;
+            const char *pszMaxMemory = VSIGetPathSpecificOption(
+                pszFilename,
+                std::string("VSI")
+                    .append(poFS->GetDebugKey())
+                    .append("_UPLOAD_MAX_MEMORY")
+                    .c_str(),
+                nullptr);
+            if (pszMaxMemory)
+            {
+                const GIntBig nMaxMemory =
+                    CPLAtoGIntBig(pszMaxMemory) * MIB_CONSTANT;
+                m_nMaxBuffers = std::min(
+                    m_nMaxBuffers,
+                    static_cast<size_t>(std::max<GIntBig>(
+                        1, nMaxMemory / static_cast<GIntBig>(m_nBufferSize))));
+                if (m_nMaxBuffers < 2)
+                {
+                    CPLDebug(poFS->GetDebugKey(),
+                             "VSI%s_UPLOAD_MAX_MEMORY too small to hold "
+                             "two parts. Uploading parts synchronously",
+                             poFS->GetDebugKey());
+                    m_nMaxBuffers = 1;
+                }
+            }
+            m_nUploadThreads = std::min(m_nUploadThreads,
+                                        static_cast<int>(m_nMaxBuffers - 1));
+        }
+    }
 }
 
 /************************************************************************/
@@ -964,6 +1011,8 @@ VSIMultipartWriteHandle::~VSIMultipartWriteHandle()
     VSIMultipartWriteHandle::Close();
     delete m_poS3HandleHelper;
     CPLFree(m_pabyBuffer);
+    for (GByte *pabyBuffer : m_apabyFreeBuffers)
+        CPLFree(pabyBuffer);
     CPLFree(m_sWriteFuncHeaderData.pBuffer);
 }
 
@@ -1132,6 +1181,9 @@ bool VSIMultipartWriteHandle::UploadPart()
                  m_poFS->GetDebugKey());
         return false;
     }
+    if (m_nMaxBuffers > 1)
+        return UploadPartAsync();
+
     const std::string osEtag = m_poFS->UploadPart(
         m_osFilename, m_nPartNumber, m_osUploadID,
         static_cast<vsi_l_offset>(m_nBufferSize) * (m_nPartNumber - 1),
@@ -1145,6 +1197,146 @@ bool VSIMultipartWriteHandle::UploadPart()
     return !osEtag.empty();
 }
 
+/************************************************************************/
+/*                          UploadPartAsync()                           */
+/************************************************************************/
+
+/** Submit the upload of the current buffer to the thread pool, and acquire
+ * a new buffer, waiting for a previous upload to complete if the maximum
+ * number of buffers has been reached.
+ */
+bool VSIMultipartWriteHandle::UploadPartAsync()
+{
+    if (m_poThreadPool == nullptr)
+    {
+        m_poThreadPool = std::make_unique<CPLWorkerThreadPool>();
+        if (!m_poThreadPool->Setup(m_nUploadThreads, nullptr, nullptr, false))
+        {
+            m_poThreadPool.reset();
+            m_bError = true;
+            return false;
+        }
+    }
+
+    GByte *const pabyBuffer = m_pabyBuffer;
+    const size_t nBufferSize = m_nBufferOff;
+    const int nPartNumber = m_nPartNumber;
+    {
+        std::lock_guard oLock(m_oMutex);
+        if (m_bAsyncError)
+            return false;
+        m_aosEtags.resize(nPartNumber);
+        ++m_nPendingParts;
+    }
+    m_pabyBuffer = nullptr;
+    m_nBufferOff = 0;
+    m_poThreadPool->SubmitJob(
+        [this, pabyBuffer, nBufferSize, nPartNumber]()
+        { UploadPartJob(pabyBuffer, nBufferSize, nPartNumber); });
+
+    std::unique_lock oLock(m_oMutex);
+    while (true)
+    {
+        if (m_bAsyncError)
+            return false;
+        if (!m_apabyFreeBuffers.empty())
+        {
+            m_pabyBuffer = m_apabyFreeBuffers.back();
+            m_apabyFreeBuffers.pop_back();
+            return true;
+        }
+        if (m_nAllocatedBuffers < m_nMaxBuffers)
+        {
+            m_pabyBuffer = static_cast<GByte *>(VSIMalloc(m_nBufferSize));
+            if (m_pabyBuffer)
+            {
+                ++m_nAllocatedBuffers;
+                return true;
+            }
+            // Wait for a buffer in use to be released
+            m_nMaxBuffers = m_nAllocatedBuffers;
+        }
+        m_oCV.wait(oLock);
+    }
+}
+
+/************************************************************************/
+/*                           UploadPartJob()                            */
+/************************************************************************/
+
+/** Executed by a worker thread to upload a part. */
+void VSIMultipartWriteHandle::UploadPartJob(GByte *pabyBuffer,
+                                            size_t nBufferSize,
+                                            int nPartNumber)
+{
+    std::string osEtag;
+    {
+        auto oAccumulator = m_oErrorAccumulator.InstallForCurrentScope();
+
+        bool bSkip;
+        {
+            std::lock_guard oLock(m_oMutex);
+            bSkip = m_bAsyncError;
+        }
+        if (!bSkip)
+        {
+            // Handle helpers are not thread-safe, hence use a dedicated one
+            std::unique_ptr<IVSIS3LikeHandleHelper> poS3HandleHelper(
+                m_poFS->CreateHandleHelper(
+                    m_osFilename.c_str() + m_poFS->GetFSPrefix().size(),
+                    false));
+            if (poS3HandleHelper)
+            {
+                osEtag = m_poFS->UploadPart(
+                    m_osFilename, nPartNumber, m_osUploadID,
+                    static_cast<vsi_l_offset>(m_nBufferSize) *
+                        (nPartNumber - 1),
+                    pabyBuffer, nBufferSize, poS3HandleHelper.get(),
+                    m_oRetryParameters, nullptr);
+            }
+        }
+    }
+
+    std::lock_guard oLock(m_oMutex);
+    if (osEtag.empty())
+        m_bAsyncError = true;
+    else
+        m_aosEtags[nPartNumber - 1] = std::move(osEtag);
+    m_apabyFreeBuffers.push_back(pabyBuffer);
+    --m_nPendingParts;
+    // Notify while holding the lock, as the handle may be destroyed as soon
+    // as the last pending part is completed
+    m_oCV.notify_all();
+}
+
+/************************************************************************/
+/*                        WaitForPendingParts()                         */
+/************************************************************************/
+
+/** Wait for asynchronous part uploads to complete, and replay in the calling
+ * thread errors emitted by them.
+ *
+ * @return true if all parts have been successfully uploaded.
+ */
+bool VSIMultipartWriteHandle::WaitForPendingParts()
+{
+    if (m_poThreadPool == nullptr)
+        return true;
+
+    bool bAsyncError;
+    {
+        std::unique_lock oLock(m_oMutex);
+        m_oCV.wait(oLock, [this] { return m_nPendingParts == 0; });
+        bAsyncError = m_bAsyncError;
+    }
+    if (!m_bAsyncErrorsReplayed)
+    {
+        m_bAsyncErrorsReplayed = true;
+        m_oErrorAccumulator.ReplayErrors();
+    }
+    return !bAsyncError;
+}
+
 std::string IVSIS3LikeFSHandlerWithMultipartUpload::UploadPart(
     const std::string &osFilename, int nPartNumber,
     const std::string &osUploadID, vsi_l_offset /* nPosition */,
@@ -1299,6 +1491,7 @@ size_t VSIMultipartWriteHandle::Write(const void *pBuffer, size_t nSize,
             if (!UploadPart())
             {
                 m_bError = true;
+                WaitForPendingParts();
                 return 0;
             }
             m_nBufferOff = 0;
@@ -1843,6 +2036,14 @@ int VSIMultipartWriteHandle::Close()
         }
         else
         {
+            if (!m_bError && m_nBufferOff > 0 && !UploadPart())
+                nRet = -1;
+            if (!WaitForPendingParts())
+            {
+                m_bError = true;
+                nRet = -1;
+            }
+
             if (m_bError)
             {
                 if (!m_poFS->AbortMultipart(m_osFilename, m_osUploadID,
@@ -1850,9 +2051,8 @@ int VSIMultipartWriteHandle::Close()
                                             m_oRetryParameters))
                     nRet = -1;
             }
-            else if (m_nBufferOff > 0 && !UploadPart())
-                nRet = -1;
-            else if (m_poFS->CompleteMultipart(
+            else if (nRet == 0 &&
+                     m_poFS->CompleteMultipart(
                          m_osFilename, m_osUploadID, m_aosEtags, m_nCurOffset,
                          m_poS3HandleHelper, m_oRetryParameters))
             {